@@ -75,6 +75,9 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    hybridization = NULL;
    precompute_sparsity = 0;
    diag_policy = DIAG_KEEP;
+   pa_simd = false;
+   pa_fused = false;
+   pa_storage = PAStorage::DOUBLE;
 
    assembly = AssemblyLevel::LEGACY;
    batch = 1;
@@ -93,6 +96,9 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    hybridization = NULL;
    precompute_sparsity = ps;
    diag_policy = DIAG_KEEP;
+   pa_simd = false;
+   pa_fused = false;
+   pa_storage = PAStorage::DOUBLE;
 
    assembly = AssemblyLevel::LEGACY;
    batch = 1;
@@ -116,6 +116,16 @@ protected:
    DiagonalPolicy diag_policy;
 
    int precompute_sparsity;
+
+   /// Use the CPU partial assembly kernels vectorized across elements.
+   bool pa_simd;
+
+   /// Fuse the element restriction with the partial assembly kernels.
+   bool pa_fused;
+
+   /// Storage of the partial assembly data of the domain integrators.
+   PAStorage pa_storage;
+
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
@@ -128,6 +138,9 @@ protected:
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
       static_cond = NULL; hybridization = NULL;
       precompute_sparsity = 0;
+      pa_simd = false;
+      pa_fused = false;
+      pa_storage = PAStorage::DOUBLE;
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::LEGACY;
       batch = 1;
@@ -176,6 +189,50 @@ public:
    /// Returns the assembly level
    AssemblyLevel GetAssemblyLevel() const { return assembly; }
 
+   /** @brief Use the CPU kernels vectorized across elements in the action of a
+       partially assembled form, see BilinearFormIntegrator::AddMultPASIMD().
+
+       The vectorized kernels are used on host (non-GPU) devices when all the
+       domain integrators support them for the current discretization (see
+       BilinearFormIntegrator::SupportsPASIMD()); otherwise the standard PA
+       kernels are used. This method can be called at any time. */
+   void UsePASIMD(bool use = true) { pa_simd = use; }
+
+   /// Return true if the vectorized PA kernels are enabled, see UsePASIMD().
+   bool UsesPASIMD() const { return pa_simd; }
+
+   /** @brief Fuse the element restriction, the partially assembled kernels and
+       the transposed restriction in the action of the form, see
+       BilinearFormIntegrator::AddMultPAFused().
+
+       In the fused action each element gathers its dofs from the input vector
+       and adds its contribution to the output vector directly, avoiding the
+       E-vector temporaries and their memory traffic. It is used for scalar
+       H1 spaces when all the domain integrators support it (see
+       BilinearFormIntegrator::SupportsPAFused()), e.g. MassIntegrator and
+       DiffusionIntegrator; otherwise the standard PA action is used. On the
+       host, the result does not depend on the number of threads. This method
+       can be called at any time. */
+   void UsePAFused(bool use = true) { pa_fused = use; }
+
+   /// Return true if the fused PA action is enabled, see UsePAFused().
+   bool UsesPAFused() const { return pa_fused; }
+
+   /** @brief Set the storage of the quadrature point data of the partially
+       assembled domain integrators, see PAStorage.
+
+       PAStorage::FLOAT halves the memory of the data, with an accuracy of
+       single precision in the operator, and PAStorage::ON_THE_FLY stores only
+       the mesh nodes and the coefficient values and recomputes the data in each
+       action. The storage is passed to the integrators by Assemble(), see
+       BilinearFormIntegrator::SetPAStorage(); the integrators that do not
+       support it use PAStorage::DOUBLE. This method should be called before
+       assembly. */
+   void SetPAStorage(PAStorage storage) { pa_storage = storage; }
+
+   /// Return the storage set with SetPAStorage().
+   PAStorage GetPAStorage() const { return pa_storage; }
+
    /** @brief Enable the use of static condensation. For details see the
        description for class StaticCondensation in fem/staticcond.hpp This method
        should be called before assembly. If the number of unknowns after static
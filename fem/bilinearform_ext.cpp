@@ -16,6 +16,7 @@
 #include "bilinearform.hpp"
 #include "pbilinearform.hpp"
 #include "pgridfunc.hpp"
+#include "pa_simd.hpp"
 #include "ceed/util.hpp"
 
 namespace mfem
@@ -294,6 +295,7 @@ void PABilinearFormExtension::Assemble()
    const int integratorCount = integrators.Size();
    for (int i = 0; i < integratorCount; ++i)
    {
+      integrators[i]->SetPAStorage(a->GetPAStorage());
       integrators[i]->AssemblePA(*a->FESpace());
    }
 
@@ -365,6 +367,13 @@ void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                                OperatorHandle &A)
 {
    Operator *oper;
+#ifdef MFEM_USE_MPI
+   if (Operator *rap = NewPAOverlapOperator())
+   {
+      A.Reset(new ConstrainedOperator(rap, ess_tdof_list, true));
+      return;
+   }
+#endif
    Operator::FormSystemOperator(ess_tdof_list, oper);
    A.Reset(oper); // A will own oper
 }
@@ -376,10 +385,261 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
                                                int copy_interior)
 {
    Operator *oper;
+#ifdef MFEM_USE_MPI
+   if (Operator *rap = NewPAOverlapOperator())
+   {
+      // Same as Operator::FormLinearSystem() with P^T A P replaced by 'rap'
+      const Operator *P = GetProlongation();
+      InitTVectors(P, GetRestriction(), P, x, b, X, B);
+      if (!copy_interior) { X.SetSubVectorComplement(ess_tdof_list, 0.0); }
+      ConstrainedOperator *constrainedA =
+         new ConstrainedOperator(rap, ess_tdof_list, true);
+      constrainedA->EliminateRHS(X, B);
+      A.Reset(constrainedA);
+      return;
+   }
+#endif
    Operator::FormLinearSystem(ess_tdof_list, x, b, oper, X, B, copy_interior);
    A.Reset(oper); // A will own oper
 }
 
+#ifdef MFEM_USE_MPI
+Operator *PABilinearFormExtension::NewPAOverlapOperator() const
+{
+   const ParBilinearForm *pa = dynamic_cast<const ParBilinearForm*>(a);
+   const ConformingProlongationOperator *P =
+      dynamic_cast<const ConformingProlongationOperator*>(GetProlongation());
+   if (!pa || !pa->UsesPAOverlap() || !P || !UsePAElements())
+   {
+      return NULL;
+   }
+   return new PAOverlapOperator(
+             *this, *P, static_cast<const ElementRestriction&>(*elem_restrict),
+             *trialFes);
+}
+
+PAOverlapOperator::PAOverlapOperator(const PABilinearFormExtension &ext_,
+                                     const ConformingProlongationOperator &P_,
+                                     const ElementRestriction &R_,
+                                     const FiniteElementSpace &fes)
+   : Operator(P_.Width()), ext(ext_), P(P_), R(R_),
+     px(P_.Height()), apx(P_.Height()), ey(R_.Height())
+{
+   // Mark the (scalar) dofs with an external ldof, i.e. owned by another rank
+   const int ndofs = fes.GetNDofs();
+   const Array<int> &ext_ldofs = P.GetExternalLDofs();
+   Array<bool> external(ndofs);
+   external = false;
+   for (int i = 0; i < ext_ldofs.Size(); i++)
+   {
+      external[fes.VDofToDof(ext_ldofs[i])] = true;
+   }
+   for (int j = 0; j < ndofs; j++)
+   {
+      if (external[j]) { ext_dofs.Append(j); }
+      else { own_dofs.Append(j); }
+   }
+
+   // Split the elements into shared elements, i.e. with an external dof, and
+   // two halves of the interior elements
+   const int ne = fes.GetNE();
+   const Array<int> &gmap = R.GatherMap();
+   const int nd = ne > 0 ? gmap.Size() / ne : 0;
+   Array<int> int_elems;
+   for (int e = 0; e < ne; e++)
+   {
+      bool ext_dof = false;
+      for (int d = 0; d < nd && !ext_dof; d++)
+      {
+         const int j = gmap[e*nd + d];
+         ext_dof = external[j >= 0 ? j : -1-j];
+      }
+      if (ext_dof) { shared.Append(e); }
+      else { int_elems.Append(e); }
+   }
+   const int ni = int_elems.Size() / 2;
+   interior[0].Append(int_elems.GetData(), ni);
+   interior[1].Append(int_elems.GetData() + ni, int_elems.Size() - ni);
+   px.UseDevice(true);
+   apx.UseDevice(true);
+   ey.UseDevice(true);
+}
+
+void PAOverlapOperator::Apply(const Vector &x, Vector &y,
+                              const bool transpose) const
+{
+   ey = 0.0;
+   P.MultBegin(x, px);
+   // Interior elements only read ldofs owned by this rank
+   ext.AddMultElements(interior[0], px, ey, transpose);
+   P.MultEnd(px);
+   ext.AddMultElements(shared, px, ey, transpose);
+   // The external ldofs only receive contributions from the shared elements
+   R.MultTransposeDofs(ext_dofs, ey, apx);
+   P.MultTransposeBegin(apx);
+   ext.AddMultElements(interior[1], px, ey, transpose);
+   R.MultTransposeDofs(own_dofs, ey, apx);
+   P.MultTransposeEnd(apx, y);
+}
+#endif
+
+FloatPABilinearFormOperator::FloatPABilinearFormOperator(
+   BilinearForm &a_, const Array<int> &ess_tdof_list_)
+   : FloatOperator(a_.Height()), a(a_), R(NULL),
+     ess_tdof_list(ess_tdof_list_), z(a_.Height())
+{
+   const FiniteElementSpace &fes = *a.FESpace();
+   MFEM_VERIFY(a.GetAssemblyLevel() == AssemblyLevel::PARTIAL,
+               "the form must be partially assembled");
+   MFEM_VERIFY(fes.GetVDim() == 1 && !fes.GetProlongationMatrix(),
+               "only scalar spaces without prolongation are supported");
+   MFEM_VERIFY(a.GetBBFI()->Size() == 0 && a.GetFBFI()->Size() == 0 &&
+               a.GetBFBFI()->Size() == 0,
+               "only domain integrators are supported");
+   Array<BilinearFormIntegrator*> &integrators = *a.GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      MFEM_VERIFY(integrators[i]->SupportsPAFloat(),
+                  "the integrators must be assembled with PAStorage::FLOAT");
+   }
+   if (fes.GetNE() > 0)
+   {
+      R = dynamic_cast<const ElementRestriction*>(
+             fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC));
+      MFEM_VERIFY(R, "unsupported element restriction");
+   }
+}
+
+void FloatPABilinearFormOperator::Mult(const FloatVector &x,
+                                       FloatVector &y) const
+{
+   // Zero the essential dofs of the input, apply the domain integrators and
+   // copy the essential dofs of the input to the output
+   z = x;
+   z.SetSubVector(ess_tdof_list, 0.0f);
+   y.SetSize(height);
+   y = 0.0f;
+   if (R)
+   {
+      const Table &colors = R->GetElementColoring();
+      Array<BilinearFormIntegrator*> &integrators = *a.GetDBFI();
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         integrators[i]->AddMultPAFloat(*R, colors, z, y);
+      }
+   }
+   const int n = ess_tdof_list.Size();
+   const auto I = ess_tdof_list.Read();
+   const auto X = x.Read();
+   auto Y = y.ReadWrite();
+   MFEM_FORALL(i, n, Y[I[i]] = X[I[i]]; );
+}
+
+void FloatPABilinearFormOperator::AssembleDiagonal(FloatVector &diag) const
+{
+   Vector d(height);
+   d.UseDevice(true);
+   a.AssembleDiagonal(d);
+   d.SetSubVector(ess_tdof_list, 1.0);
+   diag.SetFromDouble(d);
+}
+
+bool PABilinearFormExtension::UsePASIMD() const
+{
+   if (!a->UsesPASIMD() || !elem_restrict || DeviceCanUseCeed() ||
+       Device::Allows(Backend::DEVICE_MASK | Backend::OCCA_MASK) ||
+       trialFes->GetNE() == 0 || !UsesTensorBasis(*trialFes))
+   {
+      return false;
+   }
+   if (!dynamic_cast<const ElementRestriction*>(elem_restrict) &&
+       !dynamic_cast<const L2ElementRestriction*>(elem_restrict))
+   {
+      return false;
+   }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (!integrators[i]->SupportsPASIMD()) { return false; }
+   }
+   return true;
+}
+
+bool PABilinearFormExtension::UsePAFused() const
+{
+   if (!a->UsesPAFused() || DeviceCanUseCeed() ||
+       trialFes->GetVDim() != 1 || trialFes->GetNE() == 0 ||
+       !UsesTensorBasis(*trialFes) ||
+       !dynamic_cast<const ElementRestriction*>(elem_restrict))
+   {
+      return false;
+   }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (!integrators[i]->SupportsPAFused()) { return false; }
+   }
+   return true;
+}
+
+void PABilinearFormExtension::AddMultFused(const Table &colors,
+                                           const Vector &x, Vector &y,
+                                           const bool transpose) const
+{
+   MFEM_ASSERT(UsePAFused(), "the fused action is not supported");
+   const ElementRestriction &R =
+      static_cast<const ElementRestriction&>(*elem_restrict);
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (transpose)
+      {
+         integrators[i]->AddMultTransposePAFused(R, colors, x, y);
+      }
+      else
+      {
+         integrators[i]->AddMultPAFused(R, colors, x, y);
+      }
+   }
+}
+
+bool PABilinearFormExtension::UsePAElements() const
+{
+   if (DeviceCanUseCeed() || UsePAFused() || UsePASIMD() ||
+       !dynamic_cast<const ElementRestriction*>(elem_restrict) ||
+       a->GetFBFI()->Size() > 0 || a->GetBFBFI()->Size() > 0)
+   {
+      return false;
+   }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (!integrators[i]->SupportsPAElements()) { return false; }
+   }
+   return true;
+}
+
+void PABilinearFormExtension::AddMultElements(const Array<int> &elems,
+                                              const Vector &x, Vector &y,
+                                              const bool transpose) const
+{
+   const ElementRestriction &R =
+      static_cast<const ElementRestriction&>(*elem_restrict);
+   R.MultElements(elems, x, localX);
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (transpose)
+      {
+         integrators[i]->AddMultTransposePAElements(elems, localX, y);
+      }
+      else
+      {
+         integrators[i]->AddMultPAElements(elems, localX, y);
+      }
+   }
+}
+
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -394,6 +654,39 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
          integrators[i]->AddMultPA(x, y);
       }
    }
+   else if (UsePAFused())
+   {
+      const ElementRestriction *H1elem_restrict =
+         static_cast<const ElementRestriction*>(elem_restrict);
+      y.UseDevice(true);
+      y = 0.0;
+      AddMultFused(H1elem_restrict->GetElementColoring(), x, y);
+   }
+   else if (UsePASIMD())
+   {
+      const int ne = trialFes->GetNE();
+      const int vdim = trialFes->GetVDim();
+      const int nd = elem_restrict->Height() / (ne * vdim);
+      // The restriction gathers directly into the interleaved layout
+      const ElementRestriction* H1elem_restrict =
+         dynamic_cast<const ElementRestriction*>(elem_restrict);
+      const L2ElementRestriction* L2elem_restrict =
+         dynamic_cast<const L2ElementRestriction*>(elem_restrict);
+      simdX.SetSize(PASIMDSize(ne, nd, vdim));
+      simdY.SetSize(simdX.Size());
+      if (H1elem_restrict) { H1elem_restrict->MultInterleaved(x, simdX); }
+      else { L2elem_restrict->MultInterleaved(x, simdX); }
+      simdY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultPASIMD(simdX, simdY);
+      }
+      if (H1elem_restrict)
+      {
+         H1elem_restrict->MultTransposeInterleaved(simdY, y);
+      }
+      else { L2elem_restrict->MultTransposeInterleaved(simdY, y); }
+   }
    else
    {
       elem_restrict->Mult(x, localX);
@@ -442,7 +735,15 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
-   if (elem_restrict)
+   if (UsePAFused())
+   {
+      const ElementRestriction *H1elem_restrict =
+         static_cast<const ElementRestriction*>(elem_restrict);
+      y.UseDevice(true);
+      y = 0.0;
+      AddMultFused(H1elem_restrict->GetElementColoring(), x, y, true);
+   }
+   else if (elem_restrict)
    {
       elem_restrict->Mult(x, localX);
       localY = 0.0;
@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 #include "fespace.hpp"
 #include "../general/device.hpp"
+#include "../linalg/fsolvers.hpp"
 
 namespace mfem
 {
@@ -74,6 +75,8 @@ protected:
    const Operator *elem_restrict; // Not owned
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
+   // E-vectors in the interleaved layout used by the SIMD kernels
+   mutable Vector simdX, simdY;
 
 public:
    PABilinearFormExtension(BilinearForm*);
@@ -89,8 +92,125 @@ public:
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
 
+   /** @brief Add to the L-vector @a y the fused action (or transposed action)
+       of the domain integrators on the L-vector @a x, restricted to the
+       elements listed in @a colors, see
+       BilinearFormIntegrator::AddMultPAFused(). */
+   void AddMultFused(const Table &colors, const Vector &x, Vector &y,
+                     const bool transpose = false) const;
+
+   /** @brief Add to the E-vector @a y the action (or transposed action) of the
+       domain integrators on the L-vector @a x, restricted to the elements
+       listed in @a elems, see BilinearFormIntegrator::AddMultPAElements().
+
+       The entries of these elements are gathered from @a x and the integrators
+       are applied in the same way as in Mult(), so the sum of the E-vector
+       @a y with the element restriction gives the same result as Mult(). All
+       the domain integrators must support subsets of the elements, see
+       BilinearFormIntegrator::SupportsPAElements(). */
+   void AddMultElements(const Array<int> &elems, const Vector &x, Vector &y,
+                        const bool transpose = false) const;
+
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Return a new PAOverlapOperator for P^T A P if the form is a
+       ParBilinearForm with overlap enabled, see
+       ParBilinearForm::UsePAOverlap(), its action supports subsets of the
+       elements, see UsePAElements(), and P is a conforming prolongation;
+       otherwise return NULL. */
+   Operator *NewPAOverlapOperator() const;
+#endif
+
+   /// Return true if the action can use the SIMD kernels of the integrators,
+   /// see BilinearForm::UsePASIMD().
+   bool UsePASIMD() const;
+
+   /// Return true if the action can use the fused kernels of the integrators,
+   /// see BilinearForm::UsePAFused().
+   bool UsePAFused() const;
+
+   /** @brief Return true if Mult() uses the standard action of the domain
+       integrators of a form without face integrators, and all of them support
+       the action on a subset of the elements, see AddMultElements(). */
+   bool UsePAElements() const;
+};
+
+#ifdef MFEM_USE_MPI
+class ConformingProlongationOperator;
+
+/** @brief The operator P^T A P of a partially assembled ParBilinearForm, where
+    P is the conforming prolongation, overlapping the halo exchanges of P and
+    P^T with the action on the local elements.
+
+    The local elements are split into shared elements, which have external
+    dofs (owned by other ranks), and two sets of interior elements. The action
+    of A on the first interior set is computed during the exchange of P
+    (MultBegin/MultEnd) and on the second one during the exchange of P^T
+    (MultTransposeBegin/MultTransposeEnd), see ParBilinearForm::UsePAOverlap().
+
+    The elements are applied to the E-vector with
+    PABilinearFormExtension::AddMultElements(), which writes only the entries
+    of the listed elements, and the E-vector is summed into the L-vector dof by
+    dof in a fixed order. So the result does not depend on the split and is
+    bitwise identical to the one of PABilinearFormExtension::Mult(), on the
+    host and on devices. */
+class PAOverlapOperator : public Operator
+{
+protected:
+   const PABilinearFormExtension &ext;
+   const ConformingProlongationOperator &P;
+   const ElementRestriction &R;
+   Array<int> interior[2], shared; // elements
+   Array<int> ext_dofs, own_dofs; // scalar dofs, see ElementRestriction
+   mutable Vector px, apx, ey;
+
+   void Apply(const Vector &x, Vector &y, const bool transpose) const;
+
+public:
+   PAOverlapOperator(const PABilinearFormExtension &ext_,
+                     const ConformingProlongationOperator &P_,
+                     const ElementRestriction &R_,
+                     const FiniteElementSpace &fes);
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   { Apply(x, y, false); }
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const
+   { Apply(x, y, true); }
+};
+#endif
+
+/** @brief Single precision version of the operator of a partially assembled
+    BilinearForm with essential dofs, for smoothers and preconditioners, e.g.
+    FloatOperatorChebyshevSmoother.
+
+    The form must be assembled with AssemblyLevel::PARTIAL and
+    PAStorage::FLOAT, see BilinearForm::SetPAStorage(), and all its domain
+    integrators must support BilinearFormIntegrator::AddMultPAFloat(). Only
+    domain integrators and scalar spaces without prolongation, i.e. serial
+    conforming spaces, are supported. As with the DIAG_ONE policy, the rows and
+    columns of the essential dofs are replaced by those of the identity. The
+    action uses the kernels fused with the element restriction, so it reads and
+    writes only single precision L-vectors. */
+class FloatPABilinearFormOperator : public FloatOperator
+{
+protected:
+   BilinearForm &a;
+   const ElementRestriction *R; // not owned
+   Array<int> ess_tdof_list;
+   mutable FloatVector z;
+
+public:
+   FloatPABilinearFormOperator(BilinearForm &a_,
+                               const Array<int> &ess_tdof_list_);
+
+   virtual void Mult(const FloatVector &x, FloatVector &y) const;
+
+   /// Compute the diagonal of the operator in double precision, see
+   /// BilinearForm::AssembleDiagonal(), and round it to @a diag.
+   void AssembleDiagonal(FloatVector &diag) const;
 };
 
 /// Data and methods for element-assembled bilinear forms
@@ -12,6 +12,8 @@
 // Implementation of Bilinear Form Integrators
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -33,6 +35,13 @@ void BilinearFormIntegrator::AssemblePA(const FiniteElementSpace&,
                "   is not implemented for this class.");
 }
 
+long BilinearFormIntegrator::GetPAMemoryUsage() const
+{
+   mfem_error ("BilinearFormIntegrator::GetPAMemoryUsage()\n"
+               "   is not implemented for this class.");
+   return 0;
+}
+
 void BilinearFormIntegrator::AssemblePAInteriorFaces(const FiniteElementSpace&)
 {
    mfem_error ("BilinearFormIntegrator::AssemblePAInteriorFaces(...)\n"
@@ -96,6 +105,53 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAElements(const Array<int> &,
+                                               const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAElements(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposePAElements(const Array<int> &,
+                                                        const Vector &,
+                                                        Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultTransposePAElements(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultPASIMD(const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPASIMD(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultPAFused(const ElementRestriction &,
+                                            const Table &,
+                                            const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAFused(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposePAFused(const ElementRestriction &,
+                                                     const Table &,
+                                                     const Vector &,
+                                                     Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultTransposePAFused(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultPAFloat(const ElementRestriction &,
+                                            const Table &,
+                                            const FloatVector &,
+                                            FloatVector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAFloat(...)\n"
+               "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &fes)
 {
    mfem_error ("BilinearFormIntegrator::AssembleMF(...)\n"
@@ -1088,6 +1144,173 @@ double DiffusionIntegrator::ComputeFluxEnergy
    return energy;
 }
 
+// Check that the space has the same scalar element of fixed order in all
+// elements of a 2D or 3D mesh without embedding, as required by the batched
+// flux evaluations with the QuadratureInterpolator.
+static bool UniformScalarSpace(const FiniteElementSpace &fes)
+{
+   const Mesh &mesh = *fes.GetMesh();
+   const int dim = mesh.Dimension();
+   return fes.GetNE() > 0 && dim > 1 && mesh.SpaceDimension() == dim &&
+          mesh.GetNumGeometries(dim) == 1 && !fes.IsVariableOrder() &&
+          !fes.GetNURBSext() &&
+          fes.GetFE(0)->GetRangeType() == FiniteElement::SCALAR;
+}
+
+bool DiffusionIntegrator::ComputeElementFluxes(
+   const FiniteElementSpace &fes, const Vector &u,
+   const FiniteElementSpace &flux_fes, Vector &flux, bool with_coef)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int dim = mesh.Dimension();
+   if (VQ || MQ || SMQ || fes.GetVDim() != 1 || !UniformScalarSpace(fes) ||
+       !UniformScalarSpace(flux_fes) || flux_fes.GetVDim() != dim)
+   {
+      return false;
+   }
+   const int ne = fes.GetNE();
+   const IntegrationRule &ir = flux_fes.GetFE(0)->GetNodes();
+   const int nq = ir.GetNPoints();
+
+   // The nodes of the flux element are not a tensor product rule, so the
+   // native ordering and the full evaluation are used.
+   const Operator *R = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector u_e(R->Height()), du(nq*dim*ne);
+   R->Mult(u, u_e);
+   QuadratureInterpolator qi(fes, ir);
+   qi.DisableTensorProducts();
+   qi.Derivatives(u_e, du);
+
+   const bool use_coef = Q && with_coef;
+   QuadratureSpace qs(&mesh, ir);
+   QuadratureFunction q_coef;
+   if (use_coef)
+   {
+      q_coef.SetSpace(&qs, 1);
+      Q->Project(q_coef);
+   }
+
+   const int flags = GeometricFactors::JACOBIANS;
+   // Meshes without nodes are not modified: their factors are not cached
+   GeometricFactors *own_geom = mesh.GetNodes() ? NULL :
+                                new GeometricFactors(&mesh, ir, flags);
+   const GeometricFactors *geom =
+      own_geom ? own_geom : mesh.GetGeometricFactors(ir, flags);
+
+   const int NQ = nq, DIM = dim;
+   flux.SetSize(nq*dim*ne);
+   const auto J = geom->J.Read();
+   const auto DU = du.Read();
+   const auto C = use_coef ? q_coef.Read() : NULL;
+   auto F = flux.Write();
+   MFEM_FORALL(i, NQ*ne,
+   {
+      const int q = i % NQ, e = i / NQ;
+      double Jq[9], iJ[9];
+      for (int k = 0; k < DIM*DIM; k++) { Jq[k] = J[q + NQ*(k + DIM*DIM*e)]; }
+      if (DIM == 2) { kernels::CalcInverse<2>(Jq, iJ); }
+      else { kernels::CalcInverse<3>(Jq, iJ); }
+      const double c = use_coef ? C[i] : 1.0;
+      // physical gradient: J^{-t} times the reference gradient
+      for (int j = 0; j < DIM; j++)
+      {
+         double g = 0.0;
+         for (int k = 0; k < DIM; k++)
+         {
+            g += iJ[k + DIM*j]*DU[q + NQ*(k + DIM*e)];
+         }
+         F[q + NQ*(j + DIM*e)] = c*g;
+      }
+   });
+   delete own_geom;
+   return true;
+}
+
+bool DiffusionIntegrator::ComputeFluxEnergies(
+   const FiniteElementSpace &flux_fes, const Vector &flux, Vector &energy,
+   DenseMatrix *d_energy)
+{
+   Mesh &mesh = *flux_fes.GetMesh();
+   const int dim = mesh.Dimension();
+   if (MQ || !UniformScalarSpace(flux_fes) || flux_fes.GetVDim() != dim)
+   {
+      return false;
+   }
+   const int ne = flux_fes.GetNE();
+   const FiniteElement &fe = *flux_fes.GetFE(0);
+   const int order = 2 * fe.GetOrder(); // same as ComputeFluxEnergy()
+   const IntegrationRule &ir = IntRules.Get(fe.GetGeomType(), order);
+   const int nq = ir.GetNPoints();
+
+   QuadratureInterpolator qi(flux_fes, ir);
+   qi.DisableTensorProducts();
+   Vector flux_q(nq*dim*ne);
+   qi.Values(flux, flux_q);
+
+   QuadratureSpace qs(&mesh, ir);
+   QuadratureFunction q_coef;
+   if (Q)
+   {
+      q_coef.SetSpace(&qs, 1);
+      Q->Project(q_coef);
+   }
+
+   const bool aniso = (d_energy != NULL);
+   const int flags = GeometricFactors::DETERMINANTS |
+                     (aniso ? GeometricFactors::JACOBIANS : 0);
+   GeometricFactors *own_geom = mesh.GetNodes() ? NULL :
+                                new GeometricFactors(&mesh, ir, flags);
+   const GeometricFactors *geom =
+      own_geom ? own_geom : mesh.GetGeometricFactors(ir, flags);
+
+   energy.SetSize(ne);
+   if (aniso) { d_energy->SetSize(dim, ne); }
+   const int NQ = nq, DIM = dim;
+   const bool use_coef = (Q != NULL);
+   const auto W = ir.GetWeights().Read();
+   const auto DJ = geom->detJ.Read();
+   const auto J = aniso ? geom->J.Read() : NULL;
+   const auto FQ = flux_q.Read();
+   const auto C = use_coef ? q_coef.Read() : NULL;
+   auto E = energy.Write();
+   auto DE = aniso ? d_energy->Write() : NULL;
+   MFEM_FORALL(e, ne,
+   {
+      double en = 0.0, de[3] = { 0.0, 0.0, 0.0 };
+      for (int q = 0; q < NQ; q++)
+      {
+         double pf[3], pf2 = 0.0;
+         for (int d = 0; d < DIM; d++)
+         {
+            pf[d] = FQ[q + NQ*(d + DIM*e)];
+            pf2 += pf[d]*pf[d];
+         }
+         const double w = W[q]*DJ[q + NQ*e];
+         en += w*(use_coef ? C[q + NQ*e]*pf2 : pf2);
+         if (aniso)
+         {
+            // transform the flux to the reference domain
+            for (int k = 0; k < DIM; k++)
+            {
+               double v = 0.0;
+               for (int d = 0; d < DIM; d++)
+               {
+                  v += J[q + NQ*(d + DIM*(k + DIM*e))]*pf[d];
+               }
+               de[k] += w*v*v;
+            }
+         }
+      }
+      E[e] = en;
+      if (aniso)
+      {
+         for (int k = 0; k < DIM; k++) { DE[k + DIM*e] = de[k]; }
+      }
+   });
+   delete own_geom;
+   return true;
+}
+
 const IntegrationRule &DiffusionIntegrator::GetRule(
    const FiniteElement &trial_fe, const FiniteElement &test_fe)
 {
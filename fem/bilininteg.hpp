@@ -13,6 +13,7 @@
 #define MFEM_BILININTEG
 
 #include "../config/config.hpp"
+#include "../linalg/fvector.hpp"
 #include "nonlininteg.hpp"
 #include "fespace.hpp"
 
@@ -26,12 +27,32 @@ constexpr int HCURL_MAX_Q1D = 6;
 constexpr int HDIV_MAX_D1D = 5;
 constexpr int HDIV_MAX_Q1D = 6;
 
+/** @brief Storage of the quadrature point data computed by
+    BilinearFormIntegrator::AssemblePA(), see
+    BilinearFormIntegrator::SetPAStorage(). */
+enum class PAStorage
+{
+   /// The data is stored in double precision (default).
+   DOUBLE,
+   /** @brief The data is stored in single precision, halving its memory. The
+       action is computed in double precision from the rounded data. */
+   FLOAT,
+   /** @brief Only the mesh nodes and the coefficient values are stored, and
+       the data is recomputed from them in each action. If this does not save
+       memory, e.g. for the mass integrator with a non-constant coefficient,
+       the data is stored in double precision instead. */
+   ON_THE_FLY
+};
+
 /// Abstract base class BilinearFormIntegrator
 class BilinearFormIntegrator : public NonlinearFormIntegrator
 {
 protected:
+   /// Requested storage of the partial assembly data, see SetPAStorage().
+   PAStorage pa_storage;
+
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
-      : NonlinearFormIntegrator(ir) { }
+      : NonlinearFormIntegrator(ir), pa_storage(PAStorage::DOUBLE) { }
 
 public:
    // TODO: add support for other assembly levels (in addition to PA) and their
@@ -56,6 +77,23 @@ public:
    virtual void AssemblePA(const FiniteElementSpace &trial_fes,
                            const FiniteElementSpace &test_fes);
 
+   /** @brief Set the storage of the quadrature point data computed by
+       AssemblePA(), used by the next call to AssemblePA().
+
+       The low-memory storage options are supported by MassIntegrator and
+       DiffusionIntegrator with scalar coefficients on tensor product elements;
+       in all other cases PAStorage::DOUBLE is used, see GetPAStorageUsed().
+       This method is called by BilinearForm::Assemble(), see
+       BilinearForm::SetPAStorage(). */
+   void SetPAStorage(PAStorage storage) { pa_storage = storage; }
+
+   /// Return the storage used by the last call to AssemblePA().
+   virtual PAStorage GetPAStorageUsed() const { return PAStorage::DOUBLE; }
+
+   /** @brief Return the memory, in bytes, used by the quadrature point data
+       computed by the last call to AssemblePA(), see GetPAStorageUsed(). */
+   virtual long GetPAMemoryUsage() const;
+
    virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
 
    virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
@@ -84,6 +122,85 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /** @brief Return true if the methods AddMultPAElements() and
+       AddMultTransposePAElements() can be used for the data computed by the
+       last call to AssemblePA(). */
+   virtual bool SupportsPAElements() const { return false; }
+
+   /// Method for partially assembled action on a subset of the elements.
+   /** Same as AddMultPA(), restricted to the elements listed in @a elems: only
+       the entries of these elements are read from the E-vector @a x and added
+       to the E-vector @a y. Each element is computed in the same way as in
+       AddMultPA(), so splitting the elements into several subsets gives the
+       same result.
+
+       This method can be called only if SupportsPAElements() returns true. */
+   virtual void AddMultPAElements(const Array<int> &elems, const Vector &x,
+                                  Vector &y) const;
+
+   /// Method for partially assembled transposed action on a subset of the
+   /// elements, see AddMultPAElements().
+   virtual void AddMultTransposePAElements(const Array<int> &elems,
+                                           const Vector &x, Vector &y) const;
+
+   /** @brief Return true if the method AddMultPASIMD() can be used, i.e. if the
+       integrator has a CPU kernel vectorized across elements for the data
+       computed by the last call to AssemblePA(). */
+   virtual bool SupportsPASIMD() const { return false; }
+
+   /// Method for partially assembled action vectorized across elements.
+   /** Same as AddMultPA(), using a CPU kernel that processes PA_SIMD_WIDTH
+       elements at a time, one in each SIMD lane. Both @a x and @a y are
+       E-vectors in the interleaved layout described in PASIMDNumBlocks().
+
+       This method can be called only if SupportsPASIMD() returns true. */
+   virtual void AddMultPASIMD(const Vector &x, Vector &y) const;
+
+   /** @brief Return true if the method AddMultPAFused() can be used, i.e. if
+       the integrator has a kernel fused with the element restriction for the
+       data computed by the last call to AssemblePA(). */
+   virtual bool SupportsPAFused() const { return false; }
+
+   /// Method for partially assembled action fused with the element restriction.
+   /** Add to the L-vector @a y the action of R^T A R on the L-vector @a x,
+       where A is the block diagonal operator defined by AddMultPA() and R is
+       the scalar, lexicographic ElementRestriction @a R, restricted to the
+       elements listed in the rows of @a colors. Each element gathers its dofs
+       from @a x, applies the sum-factorized kernel and adds its result to @a y,
+       so no E-vectors are formed.
+
+       The elements in a row of @a colors must not share dofs, see
+       ElementRestriction::GetElementColoring(). On the host, the rows are
+       processed in order, so the result is deterministic; on devices, all the
+       elements are processed together and the additions use atomics.
+
+       This method can be called only if SupportsPAFused() returns true. */
+   virtual void AddMultPAFused(const ElementRestriction &R, const Table &colors,
+                               const Vector &x, Vector &y) const;
+
+   /// Method for partially assembled transposed action fused with the element
+   /// restriction, see AddMultPAFused().
+   virtual void AddMultTransposePAFused(const ElementRestriction &R,
+                                        const Table &colors,
+                                        const Vector &x, Vector &y) const;
+
+   /** @brief Return true if the method AddMultPAFloat() can be used, i.e. if
+       the data computed by the last call to AssemblePA() is stored in single
+       precision, see PAStorage::FLOAT. */
+   virtual bool SupportsPAFloat() const { return false; }
+
+   /** @brief Single precision version of AddMultPAFused(), used by
+       FloatPABilinearFormOperator.
+
+       The L-vectors @a x and @a y and the quadrature point data are read and
+       written in single precision; the sum factorization is computed in double
+       precision. There is no transposed version: the integrators supporting
+       it are symmetric.
+
+       This method can be called only if SupportsPAFloat() returns true. */
+   virtual void AddMultPAFloat(const ElementRestriction &R, const Table &colors,
+                               const FloatVector &x, FloatVector &y) const;
+
    /// Method defining element assembly.
    /** The result of the element assembly is added to the @a emat Vector if
        @a add is true. Otherwise, if @a add is false, we set @a emat. */
@@ -240,6 +357,44 @@ public:
                                     Vector &flux, Vector *d_energy = NULL)
    { return 0.0; }
 
+   /** @brief Batched version of ComputeElementFlux() for all elements of the
+       FiniteElementSpace @a fes.
+
+       @param[in] fes  The FiniteElementSpace of the solution.
+       @param[in] u    The solution, a local vector (L-vector) on @a fes.
+       @param[in] flux_fes  The FiniteElementSpace of the "flux".
+       @param[out] flux  The "flux" coefficients of all elements: the
+                         coefficients of element e start at e*nvd, where nvd
+                         is the number of vdofs of the elements of
+                         @a flux_fes, in the order of ComputeElementFlux().
+       @param[in] with_coef  See ComputeElementFlux().
+       @returns False, without computing anything, if the integrator or the
+                spaces are not supported, in which case ComputeElementFlux()
+                must be called for each element. The default implementation
+                returns false. */
+   virtual bool ComputeElementFluxes(const FiniteElementSpace &fes,
+                                     const Vector &u,
+                                     const FiniteElementSpace &flux_fes,
+                                     Vector &flux, bool with_coef = true)
+   { return false; }
+
+   /** @brief Batched version of ComputeFluxEnergy() for all elements of the
+       FiniteElementSpace @a flux_fes.
+
+       @param[in] flux_fes  The FiniteElementSpace of the "flux".
+       @param[in] flux   The "flux" coefficients of all elements, in the layout
+                         of ComputeElementFluxes().
+       @param[out] energy  The energy of each element.
+       @param[out] d_energy  If not NULL, the directional energy split of each
+                             element is stored in its columns.
+       @returns False, without computing anything, if the integrator or the
+                space are not supported. The default implementation returns
+                false. */
+   virtual bool ComputeFluxEnergies(const FiniteElementSpace &flux_fes,
+                                    const Vector &flux, Vector &energy,
+                                    DenseMatrix *d_energy = NULL)
+   { return false; }
+
    virtual ~BilinearFormIntegrator() { }
 };
 
@@ -1942,6 +2097,108 @@ public:
                                          ElementTransformation &Trans);
 };
 
+/** @brief Knot span-wise 1D bases used for the partial assembly of the mass
+    and diffusion integrators on NURBS spaces.
+
+    The basis functions of a NURBS element are R_i = w_i B_i / W, where the B_i
+    are tensor products of 1D B-splines on the knot spans of the element, the
+    w_i are the weights of the element dofs and W = sum_i w_i B_i. The rational
+    factors are folded into the quadrature point data, so the action of the
+    operators is computed with sum factorization in terms of the 1D B-splines.
+    Their values and derivatives at the 1D quadrature points are tabulated once
+    per knot span and shared by all elements on that span. */
+class NURBSTensorBasis
+{
+public:
+   int dim, ne, dofs1D, quad1D, nspans;
+   /** B-spline values and derivatives at the 1D quadrature points, of size
+       quad1D x dofs1D x nspans. */
+   Vector B, G;
+   /// Knot span index of the elements in each direction, dim x ne.
+   Array<int> spans;
+   /// Weights of the element dofs in lexicographic order, dofs1D^dim x ne.
+   Vector weights;
+
+   NURBSTensorBasis() : dim(0), ne(0), dofs1D(0), quad1D(0), nspans(0) { }
+
+   /** @brief Setup the bases of the elements of the NURBS space @a fes for
+       the tensor product integration rule @a ir. */
+   void Setup(const FiniteElementSpace &fes, const IntegrationRule &ir);
+
+   /** @brief Compute the weight function W and its reference gradient divided
+       by W at the quadrature points. The sizes of @a W and @a dW_W are
+       quad1D^dim x ne and quad1D^dim x dim x ne. */
+   void GetWeightFunction(Vector &W, Vector &dW_W) const;
+};
+
+/** @brief Low-memory storage of the partial assembly data of the mass and
+    diffusion integrators, see PAStorage.
+
+    With PAStorage::ON_THE_FLY, the lexicographic E-vector of the mesh nodes
+    and the coefficient values are stored, and the quadrature point data of a
+    batch of elements is recomputed from the Jacobians at the quadrature points
+    in each action. With PAStorage::FLOAT, the data is computed in the same way
+    at assembly and stored in single precision. In both cases the action is
+    applied batch by batch with the standard PA kernels, so the double precision
+    data exists only for one batch at a time. */
+class PALowMemData
+{
+public:
+   /// The storage in use, PAStorage::DOUBLE if the data is not used.
+   PAStorage storage;
+   int dim, ne, nq;
+   /// Number of values per quadrature point.
+   int qd_size;
+   /// Number of elements per batch.
+   int batch_ne;
+   const IntegrationRule *IntRule; ///< Not owned
+   const DofToQuad *node_maps;     ///< Not owned
+   /// Single precision quadrature point data, nq x qd_size x ne.
+   Array<float> data;
+   /// Lexicographic E-vector of the mesh nodes and the coefficient values.
+   Vector nodes, coeff;
+   /// Buffer for the double precision data of a batch of elements.
+   mutable Vector qdata;
+
+protected:
+   mutable Vector jac;
+
+public:
+   PALowMemData()
+      : storage(PAStorage::DOUBLE), dim(0), ne(0), nq(0), qd_size(0),
+        batch_ne(0), IntRule(NULL), node_maps(NULL) { }
+
+   /** @brief Setup the storage of the nodes and of the values of the scalar
+       coefficient @a Q for the space @a fes and the integration rule @a ir.
+
+       Returns false, leaving #storage as PAStorage::DOUBLE, if @a storage is
+       PAStorage::DOUBLE, if the space or the mesh are not supported, or if
+       PAStorage::ON_THE_FLY would use more memory than the double precision
+       data, i.e. if the nodes and the coefficient values are larger. With
+       PAStorage::FLOAT, the data must then be stored with StoreData() and the
+       nodes and coefficient values can be released. */
+   bool Setup(PAStorage storage, const FiniteElementSpace &fes,
+              const IntegrationRule &ir, Coefficient *Q, const int qd_size);
+
+   void Clear();
+
+   /** @brief Return the Jacobians at the quadrature points of the @a neb
+       elements starting with @a e0, in the layout of GeometricFactors::J. */
+   const Vector &GetJacobians(const int e0, const int neb) const;
+
+   /// Set @a c to the coefficient values of the given elements.
+   void GetCoefficient(const int e0, const int neb, Vector &c) const;
+
+   /// Store in single precision the data @a d of the given elements.
+   void StoreData(const int e0, const int neb, const Vector &d);
+
+   /// Return the stored data of the given elements in double precision.
+   const Vector &LoadData(const int e0, const int neb) const;
+
+   /// Return the memory, in bytes, used by the stored data.
+   long MemoryUsage() const;
+};
+
 /** Class for integrating the bilinear form a(u,v) := (Q grad u, grad v) where Q
     can be a scalar or a matrix coefficient. */
 class DiffusionIntegrator: public BilinearFormIntegrator
@@ -1967,6 +2224,18 @@ private:
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
    bool symmetric = true; ///< False if using a nonsymmetric matrix coefficient
+   bool use_nurbs = false; ///< True if assembled on a NURBS space
+   NURBSTensorBasis nurbs;
+   PALowMemData lowmem;
+
+   void AssemblePANURBS(const FiniteElementSpace &fes,
+                        const IntegrationRule &ir);
+   void AddMultPANURBS(const Vector &x, Vector &y) const;
+   void AssembleDiagonalPANURBS(Vector &diag) const;
+
+   /// Return the PA data of the elements e0,...,e0+neb-1 with low-memory
+   /// storage.
+   const Vector &GetLowMemData(const int e0, const int neb) const;
 
 public:
    /// Construct a diffusion integrator with coefficient Q = 1
@@ -2015,12 +2284,34 @@ public:
                                     ElementTransformation &Trans,
                                     Vector &flux, Vector *d_energy = NULL);
 
+   /** @brief Compute the fluxes of all elements with the
+       QuadratureInterpolator. Supports scalar spaces of fixed order on 2D and
+       3D meshes with one element geometry, and scalar coefficients. */
+   virtual bool ComputeElementFluxes(const FiniteElementSpace &fes,
+                                     const Vector &u,
+                                     const FiniteElementSpace &flux_fes,
+                                     Vector &flux, bool with_coef = true);
+
+   /** @brief Compute the flux energies of all elements with the
+       QuadratureInterpolator. Same restrictions as ComputeElementFluxes(). */
+   virtual bool ComputeFluxEnergies(const FiniteElementSpace &flux_fes,
+                                    const Vector &flux, Vector &energy,
+                                    DenseMatrix *d_energy = NULL);
+
    using BilinearFormIntegrator::AssemblePA;
 
    virtual void AssembleMF(const FiniteElementSpace &fes);
 
    virtual void AssemblePA(const FiniteElementSpace &fes);
 
+   virtual PAStorage GetPAStorageUsed() const { return lowmem.storage; }
+
+   virtual long GetPAMemoryUsage() const
+   {
+      return lowmem.storage == PAStorage::DOUBLE ?
+             pa_data.Size()*sizeof(double) : lowmem.MemoryUsage();
+   }
+
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
                            const bool add);
 
@@ -2032,6 +2323,31 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsPAElements() const;
+
+   virtual void AddMultPAElements(const Array<int>&, const Vector&,
+                                  Vector&) const;
+
+   virtual void AddMultTransposePAElements(const Array<int>&, const Vector&,
+                                           Vector&) const;
+
+   virtual bool SupportsPASIMD() const;
+
+   virtual void AddMultPASIMD(const Vector&, Vector&) const;
+
+   virtual bool SupportsPAFused() const;
+
+   virtual void AddMultPAFused(const ElementRestriction&, const Table&,
+                               const Vector&, Vector&) const;
+
+   virtual void AddMultTransposePAFused(const ElementRestriction&, const Table&,
+                                        const Vector&, Vector&) const;
+
+   virtual bool SupportsPAFloat() const;
+
+   virtual void AddMultPAFloat(const ElementRestriction&, const Table&,
+                               const FloatVector&, FloatVector&) const;
+
    virtual void AddMultTransposePA(const Vector&, Vector&) const;
 
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
@@ -2054,6 +2370,18 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   bool use_nurbs = false; ///< True if assembled on a NURBS space
+   NURBSTensorBasis nurbs;
+   PALowMemData lowmem;
+
+   void AssemblePANURBS(const FiniteElementSpace &fes,
+                        const IntegrationRule &ir);
+   void AddMultPANURBS(const Vector &x, Vector &y) const;
+   void AssembleDiagonalPANURBS(Vector &diag) const;
+
+   /// Return the PA data of the elements e0,...,e0+neb-1 with low-memory
+   /// storage.
+   const Vector &GetLowMemData(const int e0, const int neb) const;
 
 public:
    MassIntegrator(const IntegrationRule *ir = NULL)
@@ -2079,6 +2407,14 @@ public:
 
    virtual void AssemblePA(const FiniteElementSpace &fes);
 
+   virtual PAStorage GetPAStorageUsed() const { return lowmem.storage; }
+
+   virtual long GetPAMemoryUsage() const
+   {
+      return lowmem.storage == PAStorage::DOUBLE ?
+             pa_data.Size()*sizeof(double) : lowmem.MemoryUsage();
+   }
+
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
                            const bool add);
 
@@ -2090,6 +2426,31 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsPAElements() const;
+
+   virtual void AddMultPAElements(const Array<int>&, const Vector&,
+                                  Vector&) const;
+
+   virtual void AddMultTransposePAElements(const Array<int>&, const Vector&,
+                                           Vector&) const;
+
+   virtual bool SupportsPASIMD() const;
+
+   virtual void AddMultPASIMD(const Vector&, Vector&) const;
+
+   virtual bool SupportsPAFused() const;
+
+   virtual void AddMultPAFused(const ElementRestriction&, const Table&,
+                               const Vector&, Vector&) const;
+
+   virtual void AddMultTransposePAFused(const ElementRestriction&, const Table&,
+                                        const Vector&, Vector&) const;
+
+   virtual bool SupportsPAFloat() const;
+
+   virtual void AddMultPAFloat(const ElementRestriction&, const Table&,
+                               const FloatVector&, FloatVector&) const;
+
    virtual void AddMultTransposePA(const Vector&, Vector&) const;
 
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
@@ -2156,6 +2517,10 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsPASIMD() const;
+
+   virtual void AddMultPASIMD(const Vector&, Vector&) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &el,
                                          ElementTransformation &Trans);
 
@@ -2253,6 +2618,8 @@ public:
    virtual void AssembleDiagonalPA(Vector &diag);
    virtual void AssembleDiagonalMF(Vector &diag);
    virtual void AddMultPA(const Vector &x, Vector &y) const;
+   virtual bool SupportsPASIMD() const;
+   virtual void AddMultPASIMD(const Vector &x, Vector &y) const;
    virtual void AddMultMF(const Vector &x, Vector &y) const;
    bool SupportsCeed() const { return DeviceCanUseCeed(); }
 };
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/kernel_dispatch.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "ceed/diffusion.hpp"
@@ -357,6 +358,12 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    if (mesh->GetNE() == 0) { return; }
    const FiniteElement &el = *fes.GetFE(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
+   use_nurbs = dynamic_cast<const NURBSFiniteElement*>(&el) != NULL;
+   if (use_nurbs)
+   {
+      AssemblePANURBS(fes, *ir);
+      return;
+   }
    if (DeviceCanUseCeed())
    {
       delete ceedOp;
@@ -366,6 +373,30 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
       ceedOp = new ceed::PADiffusionIntegrator(fes, *ir, Q);
       return;
    }
+   const int mdim = mesh->Dimension();
+   if (!VQ && !MQ && !SMQ &&
+       lowmem.Setup(pa_storage, fes, *ir, Q, (mdim*(mdim + 1))/2))
+   {
+      dim = mdim;
+      ne = fes.GetNE();
+      geom = NULL;
+      maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+      dofs1D = maps->ndof;
+      quad1D = maps->nqpt;
+      symmetric = true;
+      pa_data.Destroy();
+      if (lowmem.storage == PAStorage::FLOAT)
+      {
+         for (int e0 = 0; e0 < ne; e0 += lowmem.batch_ne)
+         {
+            const int neb = std::min(lowmem.batch_ne, ne - e0);
+            lowmem.StoreData(e0, neb, GetLowMemData(e0, neb));
+         }
+         lowmem.nodes.Destroy();
+         lowmem.coeff.Destroy();
+      }
+      return;
+   }
    const int dims = el.GetDim();
    const int symmDims = (dims * (dims + 1)) / 2; // 1x1: 1, 2x2: 3, 3x3: 6
    const int nq = ir->GetNPoints();
@@ -452,41 +483,9 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
          }
       }
    }
-   else if (Q == nullptr)
-   {
-      coeff.SetSize(1);
-      coeff(0) = 1.0;
-   }
-   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
-   {
-      coeff.SetSize(1);
-      coeff(0) = cQ->constant;
-   }
-   else if (QuadratureFunctionCoefficient* cQ =
-               dynamic_cast<QuadratureFunctionCoefficient*>(Q))
-   {
-      const QuadratureFunction &qFun = cQ->GetQuadFunction();
-      MFEM_VERIFY(qFun.Size() == ne*nq,
-                  "Incompatible QuadratureFunction dimension \n");
-
-      MFEM_VERIFY(ir == &qFun.GetSpace()->GetElementIntRule(0),
-                  "IntegrationRule used within integrator and in"
-                  " QuadratureFunction appear to be different");
-      qFun.Read();
-      coeff.MakeRef(const_cast<QuadratureFunction &>(qFun),0);
-   }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      EvalPACoefficient(Q, *mesh, *ir, coeff);
    }
    pa_data.SetSize((symmetric ? symmDims : MQfullDim) * nq * ne,
                    Device::GetDeviceMemoryType());
@@ -494,6 +493,21 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
                     geom->J, coeff, pa_data);
 }
 
+const Vector &DiffusionIntegrator::GetLowMemData(const int e0,
+                                                 const int neb) const
+{
+   // The data is recomputed while the nodes are stored
+   if (lowmem.nodes.Size() == 0) { return lowmem.LoadData(e0, neb); }
+   Vector coeff;
+   lowmem.GetCoefficient(e0, neb, coeff);
+   const Vector &J = lowmem.GetJacobians(e0, neb);
+   lowmem.qdata.SetSize(lowmem.qd_size * lowmem.nq * neb,
+                        Device::GetDeviceMemoryType());
+   PADiffusionSetup(dim, dim, dofs1D, quad1D, 1, neb,
+                    lowmem.IntRule->GetWeights(), J, coeff, lowmem.qdata);
+   return lowmem.qdata;
+}
+
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionDiagonal2D(const int NE,
                                   const bool symmetric,
@@ -873,6 +887,57 @@ static void SmemPADiffusionDiagonal3D(const int NE,
    });
 }
 
+// Dispatch of the PA diffusion diagonal kernels, see KernelDispatchTable.
+struct PADiffusionDiagonalKernel
+{
+   typedef void (*Signature)(const int, const bool, const Array<double>&,
+                             const Array<double>&, const Vector&, Vector&,
+                             const int, const int);
+
+   static const char *Name() { return "PADiffusionDiagonal"; }
+
+   // The shared memory kernels are used only for the (D1D, Q1D) they were
+   // written for: Q1D = D1D in 2D and Q1D = D1D + 1 in 3D.
+   template <int D1D, int Q1D>
+   static Signature Get2D(std::true_type)
+   {
+      constexpr int NBZ = (Q1D <= 3) ? 8 : (Q1D <= 5) ? 4 : (Q1D <= 7) ? 2 : 1;
+      return &SmemPADiffusionDiagonal2D<D1D,Q1D,NBZ>;
+   }
+
+   template <int D1D, int Q1D>
+   static Signature Get2D(std::false_type)
+   { return &PADiffusionDiagonal2D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get3D(std::true_type)
+   { return &SmemPADiffusionDiagonal3D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get3D(std::false_type)
+   { return &PADiffusionDiagonal3D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return Get2D<D1D,Q1D>(std::integral_constant<bool, Q1D == D1D>()); }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return Get3D<D1D,Q1D>(std::integral_constant<bool, Q1D == D1D+1>()); }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+
+   static Signature Fallback(const int dim, const int, const int)
+   {
+      if (dim == 2) { return &PADiffusionDiagonal2D<>; }
+      if (dim == 3) { return &PADiffusionDiagonal3D<>; }
+      MFEM_ABORT("Unknown kernel.");
+      return nullptr;
+   }
+};
+
 static void PADiffusionAssembleDiagonal(const int dim,
                                         const int D1D,
                                         const int Q1D,
@@ -883,45 +948,34 @@ static void PADiffusionAssembleDiagonal(const int dim,
                                         const Vector &D,
                                         Vector &Y)
 {
-   if (dim == 2)
-   {
-      switch ((D1D << 4 ) | Q1D)
-      {
-         case 0x22: return SmemPADiffusionDiagonal2D<2,2,8>(NE,symm,B,G,D,Y);
-         case 0x33: return SmemPADiffusionDiagonal2D<3,3,8>(NE,symm,B,G,D,Y);
-         case 0x44: return SmemPADiffusionDiagonal2D<4,4,4>(NE,symm,B,G,D,Y);
-         case 0x55: return SmemPADiffusionDiagonal2D<5,5,4>(NE,symm,B,G,D,Y);
-         case 0x66: return SmemPADiffusionDiagonal2D<6,6,2>(NE,symm,B,G,D,Y);
-         case 0x77: return SmemPADiffusionDiagonal2D<7,7,2>(NE,symm,B,G,D,Y);
-         case 0x88: return SmemPADiffusionDiagonal2D<8,8,1>(NE,symm,B,G,D,Y);
-         case 0x99: return SmemPADiffusionDiagonal2D<9,9,1>(NE,symm,B,G,D,Y);
-         default: return PADiffusionDiagonal2D(NE,symm,B,G,D,Y,D1D,Q1D);
-      }
-   }
-   else if (dim == 3)
-   {
-      switch ((D1D << 4 ) | Q1D)
-      {
-         case 0x23: return SmemPADiffusionDiagonal3D<2,3>(NE,symm,B,G,D,Y);
-         case 0x34: return SmemPADiffusionDiagonal3D<3,4>(NE,symm,B,G,D,Y);
-         case 0x45: return SmemPADiffusionDiagonal3D<4,5>(NE,symm,B,G,D,Y);
-         case 0x56: return SmemPADiffusionDiagonal3D<5,6>(NE,symm,B,G,D,Y);
-         case 0x67: return SmemPADiffusionDiagonal3D<6,7>(NE,symm,B,G,D,Y);
-         case 0x78: return SmemPADiffusionDiagonal3D<7,8>(NE,symm,B,G,D,Y);
-         case 0x89: return SmemPADiffusionDiagonal3D<8,9>(NE,symm,B,G,D,Y);
-         case 0x9A: return SmemPADiffusionDiagonal3D<9,10>(NE,symm,B,G,D,Y);
-         default: return PADiffusionDiagonal3D(NE,symm,B,G,D,Y,D1D,Q1D);
-      }
-   }
-   MFEM_ABORT("Unknown kernel.");
+   static const KernelDispatchTable<PADiffusionDiagonalKernel>
+   kernels{PAKernelSpecs()};
+   kernels.Get(dim, D1D, Q1D)(NE, symm, B, G, D, Y, D1D, Q1D);
 }
 
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
-   if (DeviceCanUseCeed())
+   if (use_nurbs)
+   {
+      AssembleDiagonalPANURBS(diag);
+   }
+   else if (DeviceCanUseCeed())
    {
       ceedOp->GetDiagonal(diag);
    }
+   else if (lowmem.storage != PAStorage::DOUBLE)
+   {
+      const int nd = diag.Size() / ne;
+      for (int e0 = 0; e0 < ne; e0 += lowmem.batch_ne)
+      {
+         const int neb = std::min(lowmem.batch_ne, ne - e0);
+         Vector diag_b;
+         diag_b.MakeRef(diag, e0*nd, neb*nd);
+         PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, neb, symmetric,
+                                     maps->B, maps->G, GetLowMemData(e0, neb),
+                                     diag_b);
+      }
+   }
    else
    {
       if (pa_data.Size()==0) { AssemblePA(*fespace); }
@@ -1031,9 +1085,14 @@ static void OccaPADiffusionApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
+// The action kernels below process the n elements listed in 'elems' out of
+// the NE elements of the E-vectors, or all of them when 'elems' is NULL.
+
 // PA Diffusion Apply 2D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionApply2D(const int NE,
+                               const int n,
+                               const int *elems,
                                const bool symmetric,
                                const Array<double> &b_,
                                const Array<double> &g_,
@@ -1056,8 +1115,9 @@ static void PADiffusionApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, n,
    {
+      const int e = elems ? elems[i] : i;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
@@ -1156,6 +1216,8 @@ static void PADiffusionApply2D(const int NE,
 // Shared memory PA Diffusion Apply 2D kernel
 template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void SmemPADiffusionApply2D(const int NE,
+                                   const int n,
+                                   const int *elems,
                                    const bool symmetric,
                                    const Array<double> &b_,
                                    const Array<double> &g_,
@@ -1177,8 +1239,9 @@ static void SmemPADiffusionApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   MFEM_FORALL_2D(i, n, Q1D, Q1D, NBZ,
    {
+      const int e = elems ? elems[i] : i;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1314,6 +1377,8 @@ static void SmemPADiffusionApply2D(const int NE,
 // PA Diffusion Apply 3D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionApply3D(const int NE,
+                               const int n,
+                               const int *elems,
                                const bool symmetric,
                                const Array<double> &b,
                                const Array<double> &g,
@@ -1335,8 +1400,9 @@ static void PADiffusionApply3D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, n,
    {
+      const int e = elems ? elems[i] : i;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -1533,6 +1599,8 @@ static MFEM_HOST_DEVICE inline double sign(const int q, const int d)
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void SmemPADiffusionApply3D(const int NE,
+                                   const int n,
+                                   const int *elems,
                                    const bool symmetric,
                                    const Array<double> &b_,
                                    const Array<double> &g_,
@@ -1553,8 +1621,9 @@ static void SmemPADiffusionApply3D(const int NE,
    auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, symmetric ? 6 : 9, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, 1,
+   MFEM_FORALL_3D(i, n, Q1D, Q1D, 1,
    {
+      const int e = elems ? elems[i] : i;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
@@ -1825,6 +1894,77 @@ static void SmemPADiffusionApply3D(const int NE,
    });
 }
 
+// Dispatch of the PA diffusion action kernels, see KernelDispatchTable.
+struct PADiffusionApplyKernel
+{
+   typedef void (*Signature)(const int, const int, const int*, const bool,
+                             const Array<double>&, const Array<double>&,
+                             const Array<double>&, const Array<double>&,
+                             const Vector&, const Vector&, Vector&,
+                             const int, const int);
+
+   static const char *Name() { return "PADiffusionApply"; }
+
+   // The shared memory kernels do not use the transposed B and G.
+   template <int D1D, int Q1D>
+   static void Smem2D(const int NE, const int n, const int *elems,
+                      const bool symm, const Array<double> &B,
+                      const Array<double> &G, const Array<double> &,
+                      const Array<double> &, const Vector &D, const Vector &X,
+                      Vector &Y, const int, const int)
+   {
+      constexpr int NBZ = (Q1D <= 3) ? 16 : (Q1D <= 5) ? 8 : (Q1D <= 7) ? 4 : 2;
+      SmemPADiffusionApply2D<D1D,Q1D,NBZ>(NE,n,elems,symm,B,G,D,X,Y);
+   }
+
+   template <int D1D, int Q1D>
+   static void Smem3D(const int NE, const int n, const int *elems,
+                      const bool symm, const Array<double> &B,
+                      const Array<double> &G, const Array<double> &,
+                      const Array<double> &, const Vector &D, const Vector &X,
+                      Vector &Y, const int, const int)
+   {
+      SmemPADiffusionApply3D<D1D,Q1D>(NE,n,elems,symm,B,G,D,X,Y);
+   }
+
+   // The shared memory kernels are used only for the (D1D, Q1D) they were
+   // written for: Q1D = D1D in 2D and Q1D = D1D + 1 in 3D (the 3D kernel
+   // stores B and G folded, assuming Q1D = D1D + 1).
+   template <int D1D, int Q1D>
+   static Signature Get2D(std::true_type) { return &Smem2D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get2D(std::false_type)
+   { return &PADiffusionApply2D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get3D(std::true_type) { return &Smem3D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get3D(std::false_type)
+   { return &PADiffusionApply3D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return Get2D<D1D,Q1D>(std::integral_constant<bool, Q1D == D1D>()); }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return Get3D<D1D,Q1D>(std::integral_constant<bool, Q1D == D1D+1>()); }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+
+   static Signature Fallback(const int dim, const int, const int)
+   {
+      if (dim == 2) { return &PADiffusionApply2D<>; }
+      if (dim == 3) { return &PADiffusionApply3D<>; }
+      MFEM_ABORT("Unknown kernel.");
+      return nullptr;
+   }
+};
+
 static void PADiffusionApply(const int dim,
                              const int D1D,
                              const int Q1D,
@@ -1836,10 +1976,11 @@ static void PADiffusionApply(const int dim,
                              const Array<double> &Gt,
                              const Vector &D,
                              const Vector &X,
-                             Vector &Y)
+                             Vector &Y,
+                             const Array<int> *elems = nullptr)
 {
 #ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
+   if (DeviceCanUseOcca() && !elems)
    {
       if (dim == 2)
       {
@@ -1854,50 +1995,40 @@ static void PADiffusionApply(const int dim,
       MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
-   const int ID = (D1D << 4) | Q1D;
-
-   if (dim == 2)
-   {
-      switch (ID)
-      {
-         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,symm,B,G,D,X,Y);
-         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,symm,B,G,D,X,Y);
-         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,symm,B,G,D,X,Y);
-         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,symm,B,G,D,X,Y);
-         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,symm,B,G,D,X,Y);
-         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,symm,B,G,D,X,Y);
-         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,symm,B,G,D,X,Y);
-         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,symm,B,G,D,X,Y);
-         default:   return PADiffusionApply2D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
-      }
-   }
-
-   if (dim == 3)
-   {
-      switch (ID)
-      {
-         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,symm,B,G,D,X,Y);
-         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,symm,B,G,D,X,Y);
-         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,symm,B,G,D,X,Y);
-         case 0x46: return SmemPADiffusionApply3D<4,6>(NE,symm,B,G,D,X,Y);
-         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,symm,B,G,D,X,Y);
-         case 0x58: return SmemPADiffusionApply3D<5,8>(NE,symm,B,G,D,X,Y);
-         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,symm,B,G,D,X,Y);
-         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,symm,B,G,D,X,Y);
-         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,symm,B,G,D,X,Y);
-         default:   return PADiffusionApply3D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
-      }
-   }
-   MFEM_ABORT("Unknown kernel.");
+   static const KernelDispatchTable<PADiffusionApplyKernel>
+   kernels{PAKernelSpecs()};
+   const int n = elems ? elems->Size() : NE;
+   const int *e = elems ? elems->Read() : nullptr;
+   kernels.Get(dim, D1D, Q1D)(NE, n, e, symm, B, G, Bt, Gt, D, X, Y, D1D,
+                              Q1D);
 }
 
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
-   if (DeviceCanUseCeed())
+   if (use_nurbs)
+   {
+      AddMultPANURBS(x, y);
+   }
+   else if (DeviceCanUseCeed())
    {
       ceedOp->AddMult(x, y);
    }
+   else if (lowmem.storage != PAStorage::DOUBLE)
+   {
+      // Apply the standard kernels batch by batch
+      const int nd = x.Size() / ne;
+      for (int e0 = 0; e0 < ne; e0 += lowmem.batch_ne)
+      {
+         const int neb = std::min(lowmem.batch_ne, ne - e0);
+         Vector x_b, y_b;
+         x_b.MakeRef(const_cast<Vector&>(x), e0*nd, neb*nd);
+         y_b.MakeRef(y, e0*nd, neb*nd);
+         PADiffusionApply(dim, dofs1D, quad1D, neb, symmetric,
+                          maps->B, maps->G, maps->Bt, maps->Gt,
+                          GetLowMemData(e0, neb), x_b, y_b);
+      }
+   }
    else
    {
       PADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
@@ -1919,4 +2050,28 @@ void DiffusionIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
    }
 }
 
+bool DiffusionIntegrator::SupportsPAElements() const
+{
+   return !use_nurbs && !DeviceCanUseCeed() && maps &&
+          lowmem.storage == PAStorage::DOUBLE;
+}
+
+void DiffusionIntegrator::AddMultPAElements(const Array<int> &elems,
+                                            const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(SupportsPAElements(), "");
+   PADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
+                    maps->B, maps->G, maps->Bt, maps->Gt,
+                    pa_data, x, y, &elems);
+}
+
+void DiffusionIntegrator::AddMultTransposePAElements(const Array<int> &elems,
+                                                     const Vector &x,
+                                                     Vector &y) const
+{
+   MFEM_VERIFY(symmetric, "DiffusionIntegrator::AddMultTransposePAElements "
+               "is only implemented in the symmetric case.");
+   AddMultPAElements(elems, x, y);
+}
+
 } // namespace mfem
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/kernel_dispatch.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "ceed/mass.hpp"
@@ -22,79 +23,23 @@ namespace mfem
 // PA Mass Integrator
 
 // PA Mass Assemble kernel
-
-void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
+static void PAMassSetup(const int dim,
+                        const int Q1D,
+                        const int NE,
+                        const Array<double> &w,
+                        const Vector &j,
+                        const Vector &coeff,
+                        Vector &d)
 {
-   // Assuming the same element type
-   fespace = &fes;
-   Mesh *mesh = fes.GetMesh();
-   if (mesh->GetNE() == 0) { return; }
-   const FiniteElement &el = *fes.GetFE(0);
-   ElementTransformation *T = mesh->GetElementTransformation(0);
-   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
-   if (DeviceCanUseCeed())
-   {
-      delete ceedOp;
-      ceedOp = new ceed::PAMassIntegrator(fes, *ir, Q);
-      return;
-   }
-   dim = mesh->Dimension();
-   ne = fes.GetMesh()->GetNE();
-   nq = ir->GetNPoints();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
-                                    GeometricFactors::JACOBIANS);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
-   dofs1D = maps->ndof;
-   quad1D = maps->nqpt;
-   pa_data.SetSize(ne*nq, Device::GetDeviceMemoryType());
-   Vector coeff;
-   if (Q == nullptr)
-   {
-      coeff.SetSize(1);
-      coeff(0) = 1.0;
-   }
-   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
-   {
-      coeff.SetSize(1);
-      coeff(0) = cQ->constant;
-   }
-   else if (QuadratureFunctionCoefficient* cQ =
-               dynamic_cast<QuadratureFunctionCoefficient*>(Q))
-   {
-      const QuadratureFunction &qFun = cQ->GetQuadFunction();
-      MFEM_VERIFY(qFun.Size() == nq * ne,
-                  "Incompatible QuadratureFunction dimension \n");
-
-      MFEM_VERIFY(ir == &qFun.GetSpace()->GetElementIntRule(0),
-                  "IntegrationRule used within integrator and in"
-                  " QuadratureFunction appear to be different");
-      qFun.Read();
-      coeff.MakeRef(const_cast<QuadratureFunction &>(qFun),0);
-   }
-   else
-   {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
-   }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
    {
-      const int NE = ne;
-      const int Q1D = quad1D;
       const bool const_c = coeff.Size() == 1;
-      const auto W = Reshape(ir->GetWeights().Read(), Q1D,Q1D);
-      const auto J = Reshape(geom->J.Read(), Q1D,Q1D,2,2,NE);
+      const auto W = Reshape(w.Read(), Q1D,Q1D);
+      const auto J = Reshape(j.Read(), Q1D,Q1D,2,2,NE);
       const auto C = const_c ? Reshape(coeff.Read(), 1,1,1) :
                      Reshape(coeff.Read(), Q1D,Q1D,NE);
-      auto v = Reshape(pa_data.Write(), Q1D,Q1D, NE);
+      auto v = Reshape(d.Write(), Q1D,Q1D, NE);
       MFEM_FORALL_2D(e, NE, Q1D,Q1D,1,
       {
          MFEM_FOREACH_THREAD(qx,x,Q1D)
@@ -114,14 +59,12 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    if (dim==3)
    {
-      const int NE = ne;
-      const int Q1D = quad1D;
       const bool const_c = coeff.Size() == 1;
-      const auto W = Reshape(ir->GetWeights().Read(), Q1D,Q1D,Q1D);
-      const auto J = Reshape(geom->J.Read(), Q1D,Q1D,Q1D,3,3,NE);
+      const auto W = Reshape(w.Read(), Q1D,Q1D,Q1D);
+      const auto J = Reshape(j.Read(), Q1D,Q1D,Q1D,3,3,NE);
       const auto C = const_c ? Reshape(coeff.Read(), 1,1,1,1) :
                      Reshape(coeff.Read(), Q1D,Q1D,Q1D,NE);
-      auto v = Reshape(pa_data.Write(), Q1D,Q1D,Q1D,NE);
+      auto v = Reshape(d.Write(), Q1D,Q1D,Q1D,NE);
       MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
       {
          MFEM_FOREACH_THREAD(qx,x,Q1D)
@@ -151,6 +94,70 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
 }
 
+void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   if (mesh->GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *T = mesh->GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
+   use_nurbs = dynamic_cast<const NURBSFiniteElement*>(&el) != NULL;
+   if (use_nurbs)
+   {
+      AssemblePANURBS(fes, *ir);
+      return;
+   }
+   if (DeviceCanUseCeed())
+   {
+      delete ceedOp;
+      ceedOp = new ceed::PAMassIntegrator(fes, *ir, Q);
+      return;
+   }
+   dim = mesh->Dimension();
+   ne = fes.GetMesh()->GetNE();
+   nq = ir->GetNPoints();
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   if (lowmem.Setup(pa_storage, fes, *ir, Q, 1))
+   {
+      geom = NULL;
+      pa_data.Destroy();
+      if (lowmem.storage == PAStorage::FLOAT)
+      {
+         for (int e0 = 0; e0 < ne; e0 += lowmem.batch_ne)
+         {
+            const int neb = std::min(lowmem.batch_ne, ne - e0);
+            lowmem.StoreData(e0, neb, GetLowMemData(e0, neb));
+         }
+         lowmem.nodes.Destroy();
+         lowmem.coeff.Destroy();
+      }
+      return;
+   }
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
+                                    GeometricFactors::JACOBIANS);
+   pa_data.SetSize(ne*nq, Device::GetDeviceMemoryType());
+   Vector coeff;
+   EvalPACoefficient(Q, *mesh, *ir, coeff);
+   PAMassSetup(dim, quad1D, ne, ir->GetWeights(), geom->J, coeff, pa_data);
+}
+
+const Vector &MassIntegrator::GetLowMemData(const int e0, const int neb) const
+{
+   // The data is recomputed while the nodes are stored
+   if (lowmem.nodes.Size() == 0) { return lowmem.LoadData(e0, neb); }
+   Vector coeff;
+   lowmem.GetCoefficient(e0, neb, coeff);
+   const Vector &J = lowmem.GetJacobians(e0, neb);
+   lowmem.qdata.SetSize(nq*neb, Device::GetDeviceMemoryType());
+   PAMassSetup(dim, quad1D, neb, lowmem.IntRule->GetWeights(), J, coeff,
+               lowmem.qdata);
+   return lowmem.qdata;
+}
+
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PAMassAssembleDiagonal2D(const int NE,
                                      const Array<double> &b,
@@ -418,54 +425,71 @@ static void SmemPAMassAssembleDiagonal3D(const int NE,
    });
 }
 
+// Dispatch of the PA mass diagonal kernels, see KernelDispatchTable.
+struct PAMassDiagonalKernel
+{
+   typedef void (*Signature)(const int, const Array<double>&, const Vector&,
+                             Vector&, const int, const int);
+
+   static const char *Name() { return "PAMassDiagonal"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   {
+      constexpr int NBZ = (Q1D <= 3) ? 16 : (Q1D <= 5) ? 8 : (Q1D <= 7) ? 4 : 2;
+      return &SmemPAMassAssembleDiagonal2D<D1D,Q1D,NBZ>;
+   }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &SmemPAMassAssembleDiagonal3D<D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+
+   static Signature Fallback(const int dim, const int, const int)
+   {
+      if (dim == 2) { return &PAMassAssembleDiagonal2D<>; }
+      if (dim == 3) { return &PAMassAssembleDiagonal3D<>; }
+      MFEM_ABORT("Unknown kernel.");
+      return nullptr;
+   }
+};
+
 static void PAMassAssembleDiagonal(const int dim, const int D1D,
                                    const int Q1D, const int NE,
                                    const Array<double> &B,
                                    const Vector &D,
                                    Vector &Y)
 {
-   if (dim == 2)
-   {
-      switch ((D1D << 4 ) | Q1D)
-      {
-         case 0x22: return SmemPAMassAssembleDiagonal2D<2,2,16>(NE,B,D,Y);
-         case 0x33: return SmemPAMassAssembleDiagonal2D<3,3,16>(NE,B,D,Y);
-         case 0x44: return SmemPAMassAssembleDiagonal2D<4,4,8>(NE,B,D,Y);
-         case 0x55: return SmemPAMassAssembleDiagonal2D<5,5,8>(NE,B,D,Y);
-         case 0x66: return SmemPAMassAssembleDiagonal2D<6,6,4>(NE,B,D,Y);
-         case 0x77: return SmemPAMassAssembleDiagonal2D<7,7,4>(NE,B,D,Y);
-         case 0x88: return SmemPAMassAssembleDiagonal2D<8,8,2>(NE,B,D,Y);
-         case 0x99: return SmemPAMassAssembleDiagonal2D<9,9,2>(NE,B,D,Y);
-         default:   return PAMassAssembleDiagonal2D(NE,B,D,Y,D1D,Q1D);
-      }
-   }
-   else if (dim == 3)
-   {
-      switch ((D1D << 4 ) | Q1D)
-      {
-         case 0x23: return SmemPAMassAssembleDiagonal3D<2,3>(NE,B,D,Y);
-         case 0x24: return SmemPAMassAssembleDiagonal3D<2,4>(NE,B,D,Y);
-         case 0x26: return SmemPAMassAssembleDiagonal3D<2,6>(NE,B,D,Y);
-         case 0x34: return SmemPAMassAssembleDiagonal3D<3,4>(NE,B,D,Y);
-         case 0x35: return SmemPAMassAssembleDiagonal3D<3,5>(NE,B,D,Y);
-         case 0x45: return SmemPAMassAssembleDiagonal3D<4,5>(NE,B,D,Y);
-         case 0x48: return SmemPAMassAssembleDiagonal3D<4,8>(NE,B,D,Y);
-         case 0x56: return SmemPAMassAssembleDiagonal3D<5,6>(NE,B,D,Y);
-         case 0x67: return SmemPAMassAssembleDiagonal3D<6,7>(NE,B,D,Y);
-         case 0x78: return SmemPAMassAssembleDiagonal3D<7,8>(NE,B,D,Y);
-         case 0x89: return SmemPAMassAssembleDiagonal3D<8,9>(NE,B,D,Y);
-         default:   return PAMassAssembleDiagonal3D(NE,B,D,Y,D1D,Q1D);
-      }
-   }
-   MFEM_ABORT("Unknown kernel.");
+   static const KernelDispatchTable<PAMassDiagonalKernel>
+   kernels{PAKernelSpecs()};
+   kernels.Get(dim, D1D, Q1D)(NE, B, D, Y, D1D, Q1D);
 }
 
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
-   if (DeviceCanUseCeed())
+   if (use_nurbs)
+   {
+      AssembleDiagonalPANURBS(diag);
+   }
+   else if (DeviceCanUseCeed())
    {
       ceedOp->GetDiagonal(diag);
    }
+   else if (lowmem.storage != PAStorage::DOUBLE)
+   {
+      const int nd = diag.Size() / ne;
+      for (int e0 = 0; e0 < ne; e0 += lowmem.batch_ne)
+      {
+         const int neb = std::min(lowmem.batch_ne, ne - e0);
+         Vector diag_b;
+         diag_b.MakeRef(diag, e0*nd, neb*nd);
+         PAMassAssembleDiagonal(dim, dofs1D, quad1D, neb, maps->B,
+                                GetLowMemData(e0, neb), diag_b);
+      }
+   }
    else
    {
       PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
@@ -565,8 +589,12 @@ static void OccaPAMassApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
+// The action kernels below process the n elements listed in 'elems' out of
+// the NE elements of the E-vectors, or all of them when 'elems' is NULL.
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PAMassApply2D(const int NE,
+                          const int n,
+                          const int *elems,
                           const Array<double> &b_,
                           const Array<double> &bt_,
                           const Vector &d_,
@@ -584,8 +612,9 @@ static void PAMassApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, n,
    {
+      const int e = elems ? elems[i] : i;
       const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
@@ -659,6 +688,8 @@ static void PAMassApply2D(const int NE,
 
 template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void SmemPAMassApply2D(const int NE,
+                              const int n,
+                              const int *elems,
                               const Array<double> &b_,
                               const Array<double> &bt_,
                               const Vector &d_,
@@ -679,8 +710,9 @@ static void SmemPAMassApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   MFEM_FORALL_2D(i, n, Q1D, Q1D, NBZ,
    {
+      const int e = elems ? elems[i] : i;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -782,6 +814,8 @@ static void SmemPAMassApply2D(const int NE,
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PAMassApply3D(const int NE,
+                          const int n,
+                          const int *elems,
                           const Array<double> &b_,
                           const Array<double> &bt_,
                           const Vector &d_,
@@ -799,8 +833,9 @@ static void PAMassApply3D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, n,
    {
+      const int e = elems ? elems[i] : i;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -923,6 +958,8 @@ static void PAMassApply3D(const int NE,
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void SmemPAMassApply3D(const int NE,
+                              const int n,
+                              const int *elems,
                               const Array<double> &b_,
                               const Array<double> &bt_,
                               const Vector &d_,
@@ -942,8 +979,9 @@ static void SmemPAMassApply3D(const int NE,
    auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, 1,
+   MFEM_FORALL_3D(i, n, Q1D, Q1D, 1,
    {
+      const int e = elems ? elems[i] : i;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
@@ -1148,6 +1186,40 @@ static void SmemPAMassApply3D(const int NE,
    });
 }
 
+// Dispatch of the PA mass action kernels, see KernelDispatchTable.
+struct PAMassApplyKernel
+{
+   typedef void (*Signature)(const int, const int, const int*,
+                             const Array<double>&, const Array<double>&,
+                             const Vector&, const Vector&, Vector&,
+                             const int, const int);
+
+   static const char *Name() { return "PAMassApply"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   {
+      constexpr int NBZ = (Q1D <= 3) ? 16 : (Q1D <= 5) ? 8 : (Q1D <= 7) ? 4 : 2;
+      return &SmemPAMassApply2D<D1D,Q1D,NBZ>;
+   }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &SmemPAMassApply3D<D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+
+   static Signature Fallback(const int dim, const int, const int)
+   {
+      if (dim == 2) { return &PAMassApply2D<>; }
+      if (dim == 3) { return &PAMassApply3D<>; }
+      MFEM_ABORT("Unknown kernel.");
+      return nullptr;
+   }
+};
+
 static void PAMassApply(const int dim,
                         const int D1D,
                         const int Q1D,
@@ -1156,10 +1228,11 @@ static void PAMassApply(const int dim,
                         const Array<double> &Bt,
                         const Vector &D,
                         const Vector &X,
-                        Vector &Y)
+                        Vector &Y,
+                        const Array<int> *elems = nullptr)
 {
 #ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
+   if (DeviceCanUseOcca() && !elems)
    {
       if (dim == 2)
       {
@@ -1172,62 +1245,37 @@ static void PAMassApply(const int dim,
       MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
-   const int id = (D1D << 4) | Q1D;
-   if (dim == 2)
-   {
-      switch (id)
-      {
-         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply2D<2,4,16>(NE,B,Bt,D,X,Y);
-         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply2D<3,4,16>(NE,B,Bt,D,X,Y);
-         case 0x35: return SmemPAMassApply2D<3,5,16>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply2D<3,6,16>(NE,B,Bt,D,X,Y);
-         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y);
-         case 0x46: return SmemPAMassApply2D<4,6,8>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply2D<4,8,4>(NE,B,Bt,D,X,Y);
-         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y);
-         case 0x57: return SmemPAMassApply2D<5,7,8>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply2D<5,8,2>(NE,B,Bt,D,X,Y);
-         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y);
-         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
-         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
-         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
-      }
-   }
-   else if (dim == 3)
-   {
-      switch (id)
-      {
-         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply3D<2,4>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y);
-         case 0x35: return SmemPAMassApply3D<3,5>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply3D<3,6>(NE,B,Bt,D,X,Y);
-         case 0x37: return SmemPAMassApply3D<3,7>(NE,B,Bt,D,X,Y);
-         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y);
-         case 0x46: return SmemPAMassApply3D<4,6>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply3D<4,8>(NE,B,Bt,D,X,Y);
-         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply3D<5,8>(NE,B,Bt,D,X,Y);
-         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y);
-         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
-         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
-         case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
-      }
-   }
-   mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
-   MFEM_ABORT("Unknown kernel.");
+   static const KernelDispatchTable<PAMassApplyKernel>
+   kernels{PAKernelSpecs()};
+   const int n = elems ? elems->Size() : NE;
+   const int *e = elems ? elems->Read() : nullptr;
+   kernels.Get(dim, D1D, Q1D)(NE, n, e, B, Bt, D, X, Y, D1D, Q1D);
 }
 
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
-   if (DeviceCanUseCeed())
+   if (use_nurbs)
+   {
+      AddMultPANURBS(x, y);
+   }
+   else if (DeviceCanUseCeed())
    {
       ceedOp->AddMult(x, y);
    }
+   else if (lowmem.storage != PAStorage::DOUBLE)
+   {
+      // Apply the standard kernels batch by batch
+      const int nd = x.Size() / ne;
+      for (int e0 = 0; e0 < ne; e0 += lowmem.batch_ne)
+      {
+         const int neb = std::min(lowmem.batch_ne, ne - e0);
+         Vector x_b, y_b;
+         x_b.MakeRef(const_cast<Vector&>(x), e0*nd, neb*nd);
+         y_b.MakeRef(y, e0*nd, neb*nd);
+         PAMassApply(dim, dofs1D, quad1D, neb, maps->B, maps->Bt,
+                     GetLowMemData(e0, neb), x_b, y_b);
+      }
+   }
    else
    {
       PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
@@ -1240,4 +1288,26 @@ void MassIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
    AddMultPA(x, y);
 }
 
+bool MassIntegrator::SupportsPAElements() const
+{
+   return !use_nurbs && !DeviceCanUseCeed() && maps &&
+          lowmem.storage == PAStorage::DOUBLE;
+}
+
+void MassIntegrator::AddMultPAElements(const Array<int> &elems,
+                                       const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(SupportsPAElements(), "");
+   PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y,
+               &elems);
+}
+
+void MassIntegrator::AddMultTransposePAElements(const Array<int> &elems,
+                                                const Vector &x,
+                                                Vector &y) const
+{
+   // Mass integrator is symmetric
+   AddMultPAElements(elems, x, y);
+}
+
 } // namespace mfem
@@ -0,0 +1,927 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "../mesh/nurbs.hpp"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA on NURBS spaces
+
+void NURBSTensorBasis::Setup(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir)
+{
+   dim = fes.GetMesh()->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(dim == 2 || dim == 3, "NURBS partial assembly is only "
+               "implemented in 2D and 3D");
+
+   const FiniteElement *fe = fes.GetFE(0);
+   const int nq = ir.GetNPoints();
+   dofs1D = fe->GetOrder() + 1;
+   quad1D = (int) floor(pow(nq, 1.0/dim) + 0.5);
+   const int ND = (dim == 2) ? dofs1D*dofs1D : dofs1D*dofs1D*dofs1D;
+   const int NQ = (dim == 2) ? quad1D*quad1D : quad1D*quad1D*quad1D;
+   MFEM_VERIFY(NQ == nq, "a tensor product integration rule is required");
+   MFEM_VERIFY(dofs1D <= MAX_D1D && quad1D <= MAX_Q1D,
+               "the order of the space or of the integration rule is too high");
+
+   // The knot spans are identified by their knot vector and index; the 1D
+   // bases are tabulated at the first quad1D points of ir, which are the
+   // points of the 1D rule in the tensor product ordering.
+   map<pair<const KnotVector*, int>, int> span_index;
+   vector<double> b, g;
+   Vector shape(dofs1D), dshape(dofs1D);
+   spans.SetSize(dim*ne);
+   weights.SetSize(ND*ne);
+   int *h_spans = spans.HostWrite();
+   double *h_weights = weights.HostWrite();
+   for (int e = 0; e < ne; e++)
+   {
+      const NURBSFiniteElement *nfe =
+         dynamic_cast<const NURBSFiniteElement*>(fes.GetFE(e));
+      MFEM_VERIFY(nfe && nfe->GetDof() == ND,
+                  "the NURBS elements must have the same order");
+      const int *ijk = nfe->GetIJK();
+      for (int d = 0; d < dim; d++)
+      {
+         const KnotVector *kv = nfe->KnotVectors()[d];
+         MFEM_VERIFY(kv->GetOrder() == dofs1D - 1,
+                     "anisotropic NURBS orders are not supported");
+         const pair<const KnotVector*, int> key(kv, ijk[d]);
+         map<pair<const KnotVector*, int>, int>::iterator it =
+            span_index.find(key);
+         if (it == span_index.end())
+         {
+            const int index = (int) span_index.size();
+            it = span_index.insert(make_pair(key, index)).first;
+            for (int q = 0; q < quad1D; q++)
+            {
+               kv->CalcShape(shape, ijk[d], ir.IntPoint(q).x);
+               kv->CalcDShape(dshape, ijk[d], ir.IntPoint(q).x);
+               for (int j = 0; j < dofs1D; j++)
+               {
+                  b.push_back(shape(j));
+                  g.push_back(dshape(j));
+               }
+            }
+         }
+         h_spans[d + dim*e] = it->second;
+      }
+      const Vector &w = nfe->Weights();
+      std::copy(w.GetData(), w.GetData() + ND, h_weights + ND*e);
+   }
+
+   // Transpose the tables from (dofs1D, quad1D) to (quad1D, dofs1D) per span
+   nspans = (int) span_index.size();
+   B.SetSize(quad1D*dofs1D*nspans);
+   G.SetSize(quad1D*dofs1D*nspans);
+   double *h_B = B.HostWrite(), *h_G = G.HostWrite();
+   for (int s = 0; s < nspans; s++)
+   {
+      for (int q = 0; q < quad1D; q++)
+      {
+         for (int j = 0; j < dofs1D; j++)
+         {
+            const int src = j + dofs1D*(q + quad1D*s);
+            const int dst = q + quad1D*(j + dofs1D*s);
+            h_B[dst] = b[src];
+            h_G[dst] = g[src];
+         }
+      }
+   }
+}
+
+void NURBSTensorBasis::GetWeightFunction(Vector &W, Vector &dW_W) const
+{
+   const int D1D = dofs1D, Q1D = quad1D;
+   const int ND = (dim == 2) ? D1D*D1D : D1D*D1D*D1D;
+   const int NQ = (dim == 2) ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   const auto b = Reshape(B.HostRead(), Q1D, D1D, nspans);
+   const auto g = Reshape(G.HostRead(), Q1D, D1D, nspans);
+   const auto s = Reshape(spans.HostRead(), dim, ne);
+   const auto w = Reshape(weights.HostRead(), ND, ne);
+   W.SetSize(NQ*ne);
+   dW_W.SetSize(NQ*dim*ne);
+   auto h_W = Reshape(W.HostWrite(), NQ, ne);
+   auto h_dW = Reshape(dW_W.HostWrite(), NQ, dim, ne);
+   for (int e = 0; e < ne; e++)
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         const int qi[3] = { q % Q1D, (q / Q1D) % Q1D, q / (Q1D*Q1D) };
+         double val = 0.0, grad[3] = { 0.0, 0.0, 0.0 };
+         for (int i = 0; i < ND; i++)
+         {
+            const int di[3] = { i % D1D, (i / D1D) % D1D, i / (D1D*D1D) };
+            double bi = w(i,e), gi[3] = { w(i,e), w(i,e), w(i,e) };
+            for (int d = 0; d < dim; d++)
+            {
+               const double bd = b(qi[d], di[d], s(d,e));
+               const double gd = g(qi[d], di[d], s(d,e));
+               bi *= bd;
+               for (int k = 0; k < dim; k++) { gi[k] *= (k == d) ? gd : bd; }
+            }
+            val += bi;
+            for (int k = 0; k < dim; k++) { grad[k] += gi[k]; }
+         }
+         h_W(q,e) = val;
+         for (int k = 0; k < dim; k++) { h_dW(q,k,e) = grad[k]/val; }
+      }
+   }
+}
+
+// PA NURBS Mass Assemble
+
+void MassIntegrator::AssemblePANURBS(const FiniteElementSpace &fes,
+                                     const IntegrationRule &ir)
+{
+   nurbs.Setup(fes, ir);
+   dim = nurbs.dim;
+   ne = nurbs.ne;
+   nq = ir.GetNPoints();
+   dofs1D = nurbs.dofs1D;
+   quad1D = nurbs.quad1D;
+   maps = NULL;
+   geom = NULL;
+
+   // The element matrix is w_i w_j (B_i B_j/W^2 Q det(J)), so the rational
+   // factor is included in the quadrature point data
+   Vector W, dW_W;
+   nurbs.GetWeightFunction(W, dW_W);
+   const auto h_W = Reshape(W.HostRead(), nq, ne);
+   pa_data.SetSize(nq*ne, Device::GetDeviceMemoryType());
+   auto op = Reshape(pa_data.HostWrite(), nq, ne);
+   Mesh *mesh = fes.GetMesh();
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         const double coeff = Q ? Q->Eval(T, ip) : 1.0;
+         op(q,e) = ip.weight * coeff * T.Weight() / (h_W(q,e)*h_W(q,e));
+      }
+   }
+}
+
+// PA NURBS Mass Apply 2D kernel
+static void PANURBSMassApply2D(const int NE, const int D1D, const int Q1D,
+                               const int NS, const Array<int> &spans,
+                               const Vector &b, const Vector &w,
+                               const Vector &op, const Vector &x, Vector &y)
+{
+   const auto S = Reshape(spans.Read(), 2, NE);
+   const auto B = Reshape(b.Read(), Q1D, D1D, NS);
+   const auto W = Reshape(w.Read(), D1D, D1D, NE);
+   const auto D = Reshape(op.Read(), Q1D, Q1D, NE);
+   const auto X = Reshape(x.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e);
+      double BX[max_D1D][max_Q1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double s = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               s += B(qx,dx,sx) * W(dx,dy,e) * X(dx,dy,e);
+            }
+            BX[dy][qx] = s;
+         }
+      }
+      double QQ[max_Q1D][max_Q1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double s = 0.0;
+            for (int dy = 0; dy < D1D; ++dy) { s += B(qy,dy,sy) * BX[dy][qx]; }
+            QQ[qy][qx] = s * D(qx,qy,e);
+         }
+      }
+      double BQ[max_Q1D][max_D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx) { s += B(qx,dx,sx) * QQ[qy][qx]; }
+            BQ[qy][dx] = s;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy) { s += B(qy,dy,sy) * BQ[qy][dx]; }
+            Y(dx,dy,e) += W(dx,dy,e) * s;
+         }
+      }
+   });
+}
+
+// PA NURBS Mass Apply 3D kernel
+static void PANURBSMassApply3D(const int NE, const int D1D, const int Q1D,
+                               const int NS, const Array<int> &spans,
+                               const Vector &b, const Vector &w,
+                               const Vector &op, const Vector &x, Vector &y)
+{
+   const auto S = Reshape(spans.Read(), 3, NE);
+   const auto B = Reshape(b.Read(), Q1D, D1D, NS);
+   const auto W = Reshape(w.Read(), D1D, D1D, D1D, NE);
+   const auto D = Reshape(op.Read(), Q1D, Q1D, Q1D, NE);
+   const auto X = Reshape(x.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e), sz = S(2,e);
+      double BX[max_D1D][max_D1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double s = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  s += B(qx,dx,sx) * W(dx,dy,dz,e) * X(dx,dy,dz,e);
+               }
+               BX[dz][dy][qx] = s;
+            }
+         }
+      }
+      double BBX[max_D1D][max_Q1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double s = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  s += B(qy,dy,sy) * BX[dz][dy][qx];
+               }
+               BBX[dz][qy][qx] = s;
+            }
+         }
+      }
+      double QQ[max_Q1D][max_Q1D][max_Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double s = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  s += B(qz,dz,sz) * BBX[dz][qy][qx];
+               }
+               QQ[qz][qy][qx] = s * D(qx,qy,qz,e);
+            }
+         }
+      }
+      double BQ[max_Q1D][max_Q1D][max_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  s += B(qx,dx,sx) * QQ[qz][qy][qx];
+               }
+               BQ[qz][qy][dx] = s;
+            }
+         }
+      }
+      double BBQ[max_Q1D][max_D1D][max_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  s += B(qy,dy,sy) * BQ[qz][qy][dx];
+               }
+               BBQ[qz][dy][dx] = s;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s += B(qz,dz,sz) * BBQ[qz][dy][dx];
+               }
+               Y(dx,dy,dz,e) += W(dx,dy,dz,e) * s;
+            }
+         }
+      }
+   });
+}
+
+// PA NURBS Mass Diagonal 2D kernel
+static void PANURBSMassDiagonal2D(const int NE, const int D1D, const int Q1D,
+                                  const int NS, const Array<int> &spans,
+                                  const Vector &b, const Vector &w,
+                                  const Vector &op, Vector &y)
+{
+   const auto S = Reshape(spans.Read(), 2, NE);
+   const auto B = Reshape(b.Read(), Q1D, D1D, NS);
+   const auto W = Reshape(w.Read(), D1D, D1D, NE);
+   const auto D = Reshape(op.Read(), Q1D, Q1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e);
+      double QD[max_Q1D][max_D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               s += B(qx,dx,sx) * B(qx,dx,sx) * D(qx,qy,e);
+            }
+            QD[qy][dx] = s;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               s += B(qy,dy,sy) * B(qy,dy,sy) * QD[qy][dx];
+            }
+            Y(dx,dy,e) += W(dx,dy,e) * W(dx,dy,e) * s;
+         }
+      }
+   });
+}
+
+// PA NURBS Mass Diagonal 3D kernel
+static void PANURBSMassDiagonal3D(const int NE, const int D1D, const int Q1D,
+                                  const int NS, const Array<int> &spans,
+                                  const Vector &b, const Vector &w,
+                                  const Vector &op, Vector &y)
+{
+   const auto S = Reshape(spans.Read(), 3, NE);
+   const auto B = Reshape(b.Read(), Q1D, D1D, NS);
+   const auto W = Reshape(w.Read(), D1D, D1D, D1D, NE);
+   const auto D = Reshape(op.Read(), Q1D, Q1D, Q1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e), sz = S(2,e);
+      double QQD[max_Q1D][max_Q1D][max_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  s += B(qx,dx,sx) * B(qx,dx,sx) * D(qx,qy,qz,e);
+               }
+               QQD[qz][qy][dx] = s;
+            }
+         }
+      }
+      double QDD[max_Q1D][max_D1D][max_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  s += B(qy,dy,sy) * B(qy,dy,sy) * QQD[qz][qy][dx];
+               }
+               QDD[qz][dy][dx] = s;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s += B(qz,dz,sz) * B(qz,dz,sz) * QDD[qz][dy][dx];
+               }
+               const double wd = W(dx,dy,dz,e);
+               Y(dx,dy,dz,e) += wd * wd * s;
+            }
+         }
+      }
+   });
+}
+
+void MassIntegrator::AddMultPANURBS(const Vector &x, Vector &y) const
+{
+   const NURBSTensorBasis &nb = nurbs;
+   if (dim == 2)
+   {
+      PANURBSMassApply2D(ne, dofs1D, quad1D, nb.nspans, nb.spans, nb.B,
+                         nb.weights, pa_data, x, y);
+   }
+   else
+   {
+      PANURBSMassApply3D(ne, dofs1D, quad1D, nb.nspans, nb.spans, nb.B,
+                         nb.weights, pa_data, x, y);
+   }
+}
+
+void MassIntegrator::AssembleDiagonalPANURBS(Vector &diag) const
+{
+   const NURBSTensorBasis &nb = nurbs;
+   if (dim == 2)
+   {
+      PANURBSMassDiagonal2D(ne, dofs1D, quad1D, nb.nspans, nb.spans, nb.B,
+                            nb.weights, pa_data, diag);
+   }
+   else
+   {
+      PANURBSMassDiagonal3D(ne, dofs1D, quad1D, nb.nspans, nb.spans, nb.B,
+                            nb.weights, pa_data, diag);
+   }
+}
+
+// PA NURBS Diffusion Assemble
+
+void DiffusionIntegrator::AssemblePANURBS(const FiniteElementSpace &fes,
+                                          const IntegrationRule &ir)
+{
+   MFEM_VERIFY(!VQ && !MQ && !SMQ, "Only scalar coefficients are supported "
+               "for DiffusionIntegrator partial assembly on NURBS spaces");
+   Mesh *mesh = fes.GetMesh();
+   MFEM_VERIFY(mesh->SpaceDimension() == mesh->Dimension(),
+               "NURBS surface meshes are not supported");
+   nurbs.Setup(fes, ir);
+   dim = nurbs.dim;
+   ne = nurbs.ne;
+   dofs1D = nurbs.dofs1D;
+   quad1D = nurbs.quad1D;
+   maps = NULL;
+   geom = NULL;
+   symmetric = true;
+
+   // With the reference gradients of the B-spline products b_i = w_i B_i, the
+   // reference gradient of R_i = b_i/W is (grad b_i - b_i grad(W)/W)/W. The
+   // quadrature point data holds the symmetric matrix
+   // Q adj(J) adj(J)^T/(|det(J)| W^2) followed by grad(W)/W.
+   Vector W, dW_W;
+   nurbs.GetWeightFunction(W, dW_W);
+   const int nq = ir.GetNPoints();
+   const int symmDims = (dim * (dim + 1)) / 2;
+   const auto h_W = Reshape(W.HostRead(), nq, ne);
+   const auto h_dW = Reshape(dW_W.HostRead(), nq, dim, ne);
+   pa_data.SetSize((symmDims + dim)*nq*ne, Device::GetDeviceMemoryType());
+   auto op = Reshape(pa_data.HostWrite(), nq, symmDims + dim, ne);
+   DenseMatrix adjJ(dim), D(dim);
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         const double coeff = Q ? Q->Eval(T, ip) : 1.0;
+         CalcAdjugate(T.Jacobian(), adjJ);
+         MultAAt(adjJ, D);
+         const double s = ip.weight * coeff /
+                          (T.Weight() * h_W(q,e) * h_W(q,e));
+         for (int i = 0, k = 0; i < dim; i++)
+         {
+            for (int j = i; j < dim; j++, k++) { op(q,k,e) = s * D(i,j); }
+         }
+         for (int k = 0; k < dim; k++) { op(q,symmDims+k,e) = h_dW(q,k,e); }
+      }
+   }
+}
+
+// PA NURBS Diffusion Apply 2D kernel
+static void PANURBSDiffusionApply2D(const int NE, const int D1D,
+                                    const int Q1D, const int NS,
+                                    const Array<int> &spans, const Vector &b,
+                                    const Vector &g, const Vector &w,
+                                    const Vector &op, const Vector &x,
+                                    Vector &y)
+{
+   const auto S = Reshape(spans.Read(), 2, NE);
+   const auto B = Reshape(b.Read(), Q1D, D1D, NS);
+   const auto G = Reshape(g.Read(), Q1D, D1D, NS);
+   const auto W = Reshape(w.Read(), D1D, D1D, NE);
+   const auto D = Reshape(op.Read(), Q1D, Q1D, 5, NE);
+   const auto X = Reshape(x.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e);
+      double BX[max_D1D][max_Q1D], GX[max_D1D][max_Q1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double bs = 0.0, gs = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx = W(dx,dy,e) * X(dx,dy,e);
+               bs += B(qx,dx,sx) * wx;
+               gs += G(qx,dx,sx) * wx;
+            }
+            BX[dy][qx] = bs;
+            GX[dy][qx] = gs;
+         }
+      }
+      // F0, F1: flux components, FS: rational correction term
+      double F0[max_Q1D][max_Q1D], F1[max_Q1D][max_Q1D], FS[max_Q1D][max_Q1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double u = 0.0, g0 = 0.0, g1 = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               u += B(qy,dy,sy) * BX[dy][qx];
+               g0 += B(qy,dy,sy) * GX[dy][qx];
+               g1 += G(qy,dy,sy) * BX[dy][qx];
+            }
+            const double v0 = D(qx,qy,3,e), v1 = D(qx,qy,4,e);
+            const double a0 = g0 - v0 * u, a1 = g1 - v1 * u;
+            const double f0 = D(qx,qy,0,e) * a0 + D(qx,qy,1,e) * a1;
+            const double f1 = D(qx,qy,1,e) * a0 + D(qx,qy,2,e) * a1;
+            F0[qy][qx] = f0;
+            F1[qy][qx] = f1;
+            FS[qy][qx] = -(v0 * f0 + v1 * f1);
+         }
+      }
+      double AB[max_Q1D][max_D1D], AG[max_Q1D][max_D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double bs = 0.0, gs = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               bs += G(qx,dx,sx) * F0[qy][qx] + B(qx,dx,sx) * FS[qy][qx];
+               gs += B(qx,dx,sx) * F1[qy][qx];
+            }
+            AB[qy][dx] = bs;
+            AG[qy][dx] = gs;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               s += B(qy,dy,sy) * AB[qy][dx] + G(qy,dy,sy) * AG[qy][dx];
+            }
+            Y(dx,dy,e) += W(dx,dy,e) * s;
+         }
+      }
+   });
+}
+
+// PA NURBS Diffusion Apply 3D kernel
+static void PANURBSDiffusionApply3D(const int NE, const int D1D,
+                                    const int Q1D, const int NS,
+                                    const Array<int> &spans, const Vector &b,
+                                    const Vector &g, const Vector &w,
+                                    const Vector &op, const Vector &x,
+                                    Vector &y)
+{
+   const auto S = Reshape(spans.Read(), 3, NE);
+   const auto B = Reshape(b.Read(), Q1D, D1D, NS);
+   const auto G = Reshape(g.Read(), Q1D, D1D, NS);
+   const auto W = Reshape(w.Read(), D1D, D1D, D1D, NE);
+   const auto D = Reshape(op.Read(), Q1D, Q1D, Q1D, 9, NE);
+   const auto X = Reshape(x.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e), sz = S(2,e);
+      double BX[max_D1D][max_D1D][max_Q1D], GX[max_D1D][max_D1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double bs = 0.0, gs = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx = W(dx,dy,dz,e) * X(dx,dy,dz,e);
+                  bs += B(qx,dx,sx) * wx;
+                  gs += G(qx,dx,sx) * wx;
+               }
+               BX[dz][dy][qx] = bs;
+               GX[dz][dy][qx] = gs;
+            }
+         }
+      }
+      double BBX[max_D1D][max_Q1D][max_Q1D];
+      double BGX[max_D1D][max_Q1D][max_Q1D];
+      double GBX[max_D1D][max_Q1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double bb = 0.0, bg = 0.0, gb = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  bb += B(qy,dy,sy) * BX[dz][dy][qx];
+                  bg += B(qy,dy,sy) * GX[dz][dy][qx];
+                  gb += G(qy,dy,sy) * BX[dz][dy][qx];
+               }
+               BBX[dz][qy][qx] = bb;
+               BGX[dz][qy][qx] = bg;
+               GBX[dz][qy][qx] = gb;
+            }
+         }
+      }
+      // F0, F1, F2: flux components, FS: rational correction term
+      double F0[max_Q1D][max_Q1D][max_Q1D], F1[max_Q1D][max_Q1D][max_Q1D];
+      double F2[max_Q1D][max_Q1D][max_Q1D], FS[max_Q1D][max_Q1D][max_Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double u = 0.0, g0 = 0.0, g1 = 0.0, g2 = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  u += B(qz,dz,sz) * BBX[dz][qy][qx];
+                  g0 += B(qz,dz,sz) * BGX[dz][qy][qx];
+                  g1 += B(qz,dz,sz) * GBX[dz][qy][qx];
+                  g2 += G(qz,dz,sz) * BBX[dz][qy][qx];
+               }
+               const double v0 = D(qx,qy,qz,6,e);
+               const double v1 = D(qx,qy,qz,7,e);
+               const double v2 = D(qx,qy,qz,8,e);
+               const double a0 = g0 - v0 * u;
+               const double a1 = g1 - v1 * u;
+               const double a2 = g2 - v2 * u;
+               const double O00 = D(qx,qy,qz,0,e), O01 = D(qx,qy,qz,1,e);
+               const double O02 = D(qx,qy,qz,2,e), O11 = D(qx,qy,qz,3,e);
+               const double O12 = D(qx,qy,qz,4,e), O22 = D(qx,qy,qz,5,e);
+               const double f0 = O00 * a0 + O01 * a1 + O02 * a2;
+               const double f1 = O01 * a0 + O11 * a1 + O12 * a2;
+               const double f2 = O02 * a0 + O12 * a1 + O22 * a2;
+               F0[qz][qy][qx] = f0;
+               F1[qz][qy][qx] = f1;
+               F2[qz][qy][qx] = f2;
+               FS[qz][qy][qx] = -(v0 * f0 + v1 * f1 + v2 * f2);
+            }
+         }
+      }
+      // After the x-contraction: ABB goes with By Bz, A1 with Gy Bz and A2
+      // with By Gz
+      double ABB[max_Q1D][max_Q1D][max_D1D], A1[max_Q1D][max_Q1D][max_D1D];
+      double A2[max_Q1D][max_Q1D][max_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double bb = 0.0, a1 = 0.0, a2 = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double bx = B(qx,dx,sx);
+                  bb += G(qx,dx,sx) * F0[qz][qy][qx] + bx * FS[qz][qy][qx];
+                  a1 += bx * F1[qz][qy][qx];
+                  a2 += bx * F2[qz][qy][qx];
+               }
+               ABB[qz][qy][dx] = bb;
+               A1[qz][qy][dx] = a1;
+               A2[qz][qy][dx] = a2;
+            }
+         }
+      }
+      double CB[max_Q1D][max_D1D][max_D1D], CG[max_Q1D][max_D1D][max_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double cb = 0.0, cg = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double by = B(qy,dy,sy);
+                  cb += by * ABB[qz][qy][dx] + G(qy,dy,sy) * A1[qz][qy][dx];
+                  cg += by * A2[qz][qy][dx];
+               }
+               CB[qz][dy][dx] = cb;
+               CG[qz][dy][dx] = cg;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s += B(qz,dz,sz) * CB[qz][dy][dx] +
+                       G(qz,dz,sz) * CG[qz][dy][dx];
+               }
+               Y(dx,dy,dz,e) += W(dx,dy,dz,e) * s;
+            }
+         }
+      }
+   });
+}
+
+// PA NURBS Diffusion Diagonal 2D kernel
+static void PANURBSDiffusionDiagonal2D(const int NE, const int D1D,
+                                       const int Q1D, const int NS,
+                                       const Array<int> &spans,
+                                       const Vector &b, const Vector &g,
+                                       const Vector &w, const Vector &op,
+                                       Vector &y)
+{
+   const auto S = Reshape(spans.Read(), 2, NE);
+   const auto B = Reshape(b.Read(), Q1D, D1D, NS);
+   const auto G = Reshape(g.Read(), Q1D, D1D, NS);
+   const auto W = Reshape(w.Read(), D1D, D1D, NE);
+   const auto D = Reshape(op.Read(), Q1D, Q1D, 5, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int sx = S(0,e), sy = S(1,e);
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double by = B(qy,dy,sy), gy = G(qy,dy,sy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double bx = B(qx,dx,sx), gx = G(qx,dx,sx);
+                  const double u = bx * by;
+                  const double a0 = gx * by - D(qx,qy,3,e) * u;
+                  const double a1 = bx * gy - D(qx,qy,4,e) * u;
+                  s += D(qx,qy,0,e) * a0 * a0 + 2.0 * D(qx,qy,1,e) * a0 * a1 +
+                       D(qx,qy,2,e) * a1 * a1;
+               }
+            }
+            Y(dx,dy,e) += W(dx,dy,e) * W(dx,dy,e) * s;
+         }
+      }
+   });
+}
+
+// PA NURBS Diffusion Diagonal 3D kernel
+static void PANURBSDiffusionDiagonal3D(const int NE, const int D1D,
+                                       const int Q1D, const int NS,
+                                       const Array<int> &spans,
+                                       const Vector &b, const Vector &g,
+                                       const Vector &w, const Vector &op,
+                                       Vector &y)
+{
+   const auto S = Reshape(spans.Read(), 3, NE);
+   const auto B = Reshape(b.Read(), Q1D, D1D, NS);
+   const auto G = Reshape(g.Read(), Q1D, D1D, NS);
+   const auto W = Reshape(w.Read(), D1D, D1D, D1D, NE);
+   const auto D = Reshape(op.Read(), Q1D, Q1D, Q1D, 9, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int sx = S(0,e), sy = S(1,e), sz = S(2,e);
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  const double bz = B(qz,dz,sz), gz = G(qz,dz,sz);
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     const double by = B(qy,dy,sy), gy = G(qy,dy,sy);
+                     for (int qx = 0; qx < Q1D; ++qx)
+                     {
+                        const double bx = B(qx,dx,sx), gx = G(qx,dx,sx);
+                        const double u = bx * by * bz;
+                        const double a0 = gx*by*bz - D(qx,qy,qz,6,e) * u;
+                        const double a1 = bx*gy*bz - D(qx,qy,qz,7,e) * u;
+                        const double a2 = bx*by*gz - D(qx,qy,qz,8,e) * u;
+                        s += D(qx,qy,qz,0,e) * a0 * a0 +
+                             D(qx,qy,qz,3,e) * a1 * a1 +
+                             D(qx,qy,qz,5,e) * a2 * a2 +
+                             2.0 * (D(qx,qy,qz,1,e) * a0 * a1 +
+                                    D(qx,qy,qz,2,e) * a0 * a2 +
+                                    D(qx,qy,qz,4,e) * a1 * a2);
+                     }
+                  }
+               }
+               const double wd = W(dx,dy,dz,e);
+               Y(dx,dy,dz,e) += wd * wd * s;
+            }
+         }
+      }
+   });
+}
+
+void DiffusionIntegrator::AddMultPANURBS(const Vector &x, Vector &y) const
+{
+   const NURBSTensorBasis &nb = nurbs;
+   if (dim == 2)
+   {
+      PANURBSDiffusionApply2D(ne, dofs1D, quad1D, nb.nspans, nb.spans, nb.B,
+                              nb.G, nb.weights, pa_data, x, y);
+   }
+   else
+   {
+      PANURBSDiffusionApply3D(ne, dofs1D, quad1D, nb.nspans, nb.spans, nb.B,
+                              nb.G, nb.weights, pa_data, x, y);
+   }
+}
+
+void DiffusionIntegrator::AssembleDiagonalPANURBS(Vector &diag) const
+{
+   const NURBSTensorBasis &nb = nurbs;
+   if (dim == 2)
+   {
+      PANURBSDiffusionDiagonal2D(ne, dofs1D, quad1D, nb.nspans, nb.spans,
+                                 nb.B, nb.G, nb.weights, pa_data, diag);
+   }
+   else
+   {
+      PANURBSDiffusionDiagonal3D(ne, dofs1D, quad1D, nb.nspans, nb.spans,
+                                 nb.B, nb.G, nb.weights, pa_data, diag);
+   }
+}
+
+} // namespace mfem
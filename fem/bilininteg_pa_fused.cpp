@@ -0,0 +1,666 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../general/kernel_dispatch.hpp"
+#include "bilininteg.hpp"
+
+namespace mfem
+{
+
+// PA kernels fused with the element restriction: each element reads its dofs
+// from the input L-vector, applies the sum-factorized operator in local arrays
+// and adds the result to the output L-vector. The kernels process the n
+// elements listed in 'elems'; the additions use atomics if 'atomic' is true,
+// otherwise the elements must not share dofs. With 'transpose', the kernels
+// apply the transposed operator. The L-vectors and the quadrature data have
+// the type T, double or float (see AddMultPAFloat()); the local arrays are in
+// double precision.
+
+/// Gather the ND values of element e from the L-vector x, using the signed
+/// gather map M of the ElementRestriction.
+template <int ND, typename T>
+MFEM_HOST_DEVICE inline void FusedGather(const int *M, const int e,
+                                         const T *x, double *X)
+{
+   for (int i = 0; i < ND; ++i)
+   {
+      const int gid = M[i + ND*e];
+      const int j = (gid >= 0) ? gid : -1-gid;
+      X[i] = (gid >= 0) ? x[j] : -x[j];
+   }
+}
+
+/// Add the ND values of element e to the L-vector y, see FusedGather().
+template <int ND, typename T>
+MFEM_HOST_DEVICE inline void FusedScatter(const int *M, const int e,
+                                          const bool atomic, const double *Y,
+                                          T *y)
+{
+   for (int i = 0; i < ND; ++i)
+   {
+      const int gid = M[i + ND*e];
+      const int j = (gid >= 0) ? gid : -1-gid;
+      const T val = (T) ((gid >= 0) ? Y[i] : -Y[i]);
+      if (atomic) { AtomicAdd(y[j], val); }
+      else { y[j] += val; }
+   }
+}
+
+// Fused PA Mass Apply 2D kernel
+template <typename T, int D1D, int Q1D>
+static void FusedPAMassApply2D(const int NE, const int, const bool,
+                               const int n, const int *elems,
+                               const bool atomic,
+                               const Array<double> &b_, const Array<double> &,
+                               const T *d_, const Array<int> &map_,
+                               const T *x, T *y)
+{
+   constexpr int ND = D1D*D1D;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto D = Reshape(d_, Q1D, Q1D, NE);
+   auto M = map_.Read();
+   MFEM_FORALL(i, n,
+   {
+      const int e = elems[i];
+      double X[D1D][D1D];
+      FusedGather<ND>(M, e, x, &X[0][0]);
+      double BX[D1D][Q1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double s = 0.0;
+            for (int dx = 0; dx < D1D; ++dx) { s += B(qx,dx) * X[dy][dx]; }
+            BX[dy][qx] = s;
+         }
+      }
+      double QQ[Q1D][Q1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double s = 0.0;
+            for (int dy = 0; dy < D1D; ++dy) { s += B(qy,dy) * BX[dy][qx]; }
+            QQ[qy][qx] = s * D(qx,qy,e);
+         }
+      }
+      double BQ[Q1D][D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx) { s += B(qx,dx) * QQ[qy][qx]; }
+            BQ[qy][dx] = s;
+         }
+      }
+      double Y[D1D][D1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy) { s += B(qy,dy) * BQ[qy][dx]; }
+            Y[dy][dx] = s;
+         }
+      }
+      FusedScatter<ND>(M, e, atomic, &Y[0][0], y);
+   });
+}
+
+// Fused PA Mass Apply 3D kernel
+template <typename T, int D1D, int Q1D>
+static void FusedPAMassApply3D(const int NE, const int, const bool,
+                               const int n, const int *elems,
+                               const bool atomic,
+                               const Array<double> &b_, const Array<double> &,
+                               const T *d_, const Array<int> &map_,
+                               const T *x, T *y)
+{
+   constexpr int ND = D1D*D1D*D1D;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto D = Reshape(d_, Q1D, Q1D, Q1D, NE);
+   auto M = map_.Read();
+   MFEM_FORALL(i, n,
+   {
+      const int e = elems[i];
+      double X[D1D][D1D][D1D];
+      FusedGather<ND>(M, e, x, &X[0][0][0]);
+      double BX[D1D][D1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double s = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  s += B(qx,dx) * X[dz][dy][dx];
+               }
+               BX[dz][dy][qx] = s;
+            }
+         }
+      }
+      double BBX[D1D][Q1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double s = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  s += B(qy,dy) * BX[dz][dy][qx];
+               }
+               BBX[dz][qy][qx] = s;
+            }
+         }
+      }
+      double QQ[Q1D][Q1D][Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double s = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  s += B(qz,dz) * BBX[dz][qy][qx];
+               }
+               QQ[qz][qy][qx] = s * D(qx,qy,qz,e);
+            }
+         }
+      }
+      double BQ[Q1D][Q1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  s += B(qx,dx) * QQ[qz][qy][qx];
+               }
+               BQ[qz][qy][dx] = s;
+            }
+         }
+      }
+      double BBQ[Q1D][D1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  s += B(qy,dy) * BQ[qz][qy][dx];
+               }
+               BBQ[qz][dy][dx] = s;
+            }
+         }
+      }
+      double Y[D1D][D1D][D1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s += B(qz,dz) * BBQ[qz][dy][dx];
+               }
+               Y[dz][dy][dx] = s;
+            }
+         }
+      }
+      FusedScatter<ND>(M, e, atomic, &Y[0][0][0], y);
+   });
+}
+
+// Fused PA Diffusion Apply 2D kernel, NC = 3 (symmetric) or 4 components
+template <typename T, int D1D, int Q1D>
+static void FusedPADiffusionApply2D(const int NE, const int NC,
+                                    const bool transpose, const int n,
+                                    const int *elems, const bool atomic,
+                                    const Array<double> &b_,
+                                    const Array<double> &g_,
+                                    const T *d_, const Array<int> &map_,
+                                    const T *x, T *y)
+{
+   constexpr int ND = D1D*D1D;
+   const bool symmetric = (NC == 3);
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto D = Reshape(d_, Q1D*Q1D, NC, NE);
+   auto M = map_.Read();
+   MFEM_FORALL(i, n,
+   {
+      const int e = elems[i];
+      double X[D1D][D1D];
+      FusedGather<ND>(M, e, x, &X[0][0]);
+      double BX[D1D][Q1D], GX[D1D][Q1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double b = 0.0, g = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               b += B(qx,dx) * X[dy][dx];
+               g += G(qx,dx) * X[dy][dx];
+            }
+            BX[dy][qx] = b;
+            GX[dy][qx] = g;
+         }
+      }
+      double grad[Q1D][Q1D][2];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double gX = 0.0, gY = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               gX += B(qy,dy) * GX[dy][qx];
+               gY += G(qy,dy) * BX[dy][qx];
+            }
+            const int q = qx + Q1D*qy;
+            const double O11 = D(q,0,e);
+            const double A21 = D(q,1,e);
+            const double A12 = symmetric ? A21 : D(q,2,e);
+            const double O22 = symmetric ? D(q,2,e) : D(q,3,e);
+            const double O12 = transpose ? A21 : A12;
+            const double O21 = transpose ? A12 : A21;
+            grad[qy][qx][0] = O11*gX + O12*gY;
+            grad[qy][qx][1] = O21*gX + O22*gY;
+         }
+      }
+      double GQ[Q1D][D1D], BQ[Q1D][D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double g = 0.0, b = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               g += G(qx,dx) * grad[qy][qx][0];
+               b += B(qx,dx) * grad[qy][qx][1];
+            }
+            GQ[qy][dx] = g;
+            BQ[qy][dx] = b;
+         }
+      }
+      double Y[D1D][D1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               s += B(qy,dy) * GQ[qy][dx] + G(qy,dy) * BQ[qy][dx];
+            }
+            Y[dy][dx] = s;
+         }
+      }
+      FusedScatter<ND>(M, e, atomic, &Y[0][0], y);
+   });
+}
+
+// Fused PA Diffusion Apply 3D kernel, NC = 6 (symmetric) or 9 components
+template <typename T, int D1D, int Q1D>
+static void FusedPADiffusionApply3D(const int NE, const int NC,
+                                    const bool transpose, const int n,
+                                    const int *elems, const bool atomic,
+                                    const Array<double> &b_,
+                                    const Array<double> &g_,
+                                    const T *d_, const Array<int> &map_,
+                                    const T *x, T *y)
+{
+   constexpr int ND = D1D*D1D*D1D;
+   const bool symmetric = (NC == 6);
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto D = Reshape(d_, Q1D*Q1D*Q1D, NC, NE);
+   auto M = map_.Read();
+   MFEM_FORALL(i, n,
+   {
+      const int e = elems[i];
+      double X[D1D][D1D][D1D];
+      FusedGather<ND>(M, e, x, &X[0][0][0]);
+      // Interpolate/differentiate in x, then y
+      double BX[D1D][D1D][Q1D], GX[D1D][D1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double b = 0.0, g = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  b += B(qx,dx) * X[dz][dy][dx];
+                  g += G(qx,dx) * X[dz][dy][dx];
+               }
+               BX[dz][dy][qx] = b;
+               GX[dz][dy][qx] = g;
+            }
+         }
+      }
+      double BBX[D1D][Q1D][Q1D], GBX[D1D][Q1D][Q1D], BGX[D1D][Q1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double bb = 0.0, gb = 0.0, bg = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  bb += B(qy,dy) * BX[dz][dy][qx];
+                  gb += G(qy,dy) * BX[dz][dy][qx];
+                  bg += B(qy,dy) * GX[dz][dy][qx];
+               }
+               BBX[dz][qy][qx] = bb;
+               GBX[dz][qy][qx] = gb;
+               BGX[dz][qy][qx] = bg;
+            }
+         }
+      }
+      // Gradient in z, then apply the quadrature data
+      double grad[Q1D][Q1D][Q1D][3];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double gX = 0.0, gY = 0.0, gZ = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  gX += B(qz,dz) * BGX[dz][qy][qx];
+                  gY += B(qz,dz) * GBX[dz][qy][qx];
+                  gZ += G(qz,dz) * BBX[dz][qy][qx];
+               }
+               const int q = qx + Q1D*(qy + Q1D*qz);
+               const double O11 = D(q,0,e);
+               const double A12 = D(q,1,e);
+               const double A13 = D(q,2,e);
+               const double A21 = symmetric ? A12 : D(q,3,e);
+               const double O22 = symmetric ? D(q,3,e) : D(q,4,e);
+               const double A23 = symmetric ? D(q,4,e) : D(q,5,e);
+               const double A31 = symmetric ? A13 : D(q,6,e);
+               const double A32 = symmetric ? A23 : D(q,7,e);
+               const double O33 = symmetric ? D(q,5,e) : D(q,8,e);
+               const double O12 = transpose ? A21 : A12;
+               const double O13 = transpose ? A31 : A13;
+               const double O21 = transpose ? A12 : A21;
+               const double O23 = transpose ? A32 : A23;
+               const double O31 = transpose ? A13 : A31;
+               const double O32 = transpose ? A23 : A32;
+               grad[qz][qy][qx][0] = O11*gX + O12*gY + O13*gZ;
+               grad[qz][qy][qx][1] = O21*gX + O22*gY + O23*gZ;
+               grad[qz][qy][qx][2] = O31*gX + O32*gY + O33*gZ;
+            }
+         }
+      }
+      // Apply the transposed gradient in x, then y, then z
+      double GQ[Q1D][Q1D][D1D], BQ1[Q1D][Q1D][D1D], BQ2[Q1D][Q1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double g = 0.0, b1 = 0.0, b2 = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  g += G(qx,dx) * grad[qz][qy][qx][0];
+                  b1 += B(qx,dx) * grad[qz][qy][qx][1];
+                  b2 += B(qx,dx) * grad[qz][qy][qx][2];
+               }
+               GQ[qz][qy][dx] = g;
+               BQ1[qz][qy][dx] = b1;
+               BQ2[qz][qy][dx] = b2;
+            }
+         }
+      }
+      double S1[Q1D][D1D][D1D], S2[Q1D][D1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s1 = 0.0, s2 = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  s1 += B(qy,dy) * GQ[qz][qy][dx] + G(qy,dy) * BQ1[qz][qy][dx];
+                  s2 += B(qy,dy) * BQ2[qz][qy][dx];
+               }
+               S1[qz][dy][dx] = s1;
+               S2[qz][dy][dx] = s2;
+            }
+         }
+      }
+      double Y[D1D][D1D][D1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s += B(qz,dz) * S1[qz][dy][dx] + G(qz,dz) * S2[qz][dy][dx];
+               }
+               Y[dz][dy][dx] = s;
+            }
+         }
+      }
+      FusedScatter<ND>(M, e, atomic, &Y[0][0][0], y);
+   });
+}
+
+/// Common part of the dispatch of the fused kernels. There is no generic
+/// version: the integrators report that the fused kernels are not supported
+/// for the sizes without specialization, see SupportsPAFused().
+template <typename T>
+struct FusedPAKernel
+{
+   typedef void (*Signature)(const int, const int, const bool, const int,
+                             const int*, const bool, const Array<double>&,
+                             const Array<double>&, const T*,
+                             const Array<int>&, const T*, T*);
+
+   static Signature Fallback(const int, const int, const int)
+   {
+      MFEM_ABORT("no fused kernel available");
+      return nullptr;
+   }
+};
+
+template <typename T>
+struct FusedPAMassApplyKernel : FusedPAKernel<T>
+{
+   typedef typename FusedPAKernel<T>::Signature Signature;
+
+   static const char *Name() { return "FusedPAMassApply"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return &FusedPAMassApply2D<T,D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &FusedPAMassApply3D<T,D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+};
+
+template <typename T>
+struct FusedPADiffusionApplyKernel : FusedPAKernel<T>
+{
+   typedef typename FusedPAKernel<T>::Signature Signature;
+
+   static const char *Name() { return "FusedPADiffusionApply"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return &FusedPADiffusionApply2D<T,D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &FusedPADiffusionApply3D<T,D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+};
+
+template <typename Kernel>
+static const KernelDispatchTable<Kernel> &FusedKernels()
+{
+   static const KernelDispatchTable<Kernel> kernels{PAKernelSpecs()};
+   return kernels;
+}
+
+/// Run the fused @a kernel on the elements listed in @a colors: on devices in
+/// a single launch with atomic additions, on the host color by color.
+template <typename T>
+static void FusedPAApply(typename FusedPAKernel<T>::Signature kernel,
+                         const ElementRestriction &R, const Table &colors,
+                         const int NE, const int NC, const bool transpose,
+                         const Array<double> &B, const Array<double> &G,
+                         const T *D, const T *x, T *y)
+{
+   if (colors.Size() <= 0) { return; }
+   const Array<int> &map = R.GatherMap();
+   if (Device::Allows(Backend::DEVICE_MASK))
+   {
+      const int n = colors.Size_of_connections();
+      const int *elems = Read(colors.GetJMemory(), n);
+      kernel(NE, NC, transpose, n, elems, true, B, G, D, map, x, y);
+      return;
+   }
+   for (int c = 0; c < colors.Size(); ++c)
+   {
+      kernel(NE, NC, transpose, colors.RowSize(c), colors.GetRow(c), false,
+             B, G, D, map, x, y);
+   }
+}
+
+typedef FusedPAMassApplyKernel<double> FusedMassKernel;
+typedef FusedPADiffusionApplyKernel<double> FusedDiffusionKernel;
+typedef FusedPAMassApplyKernel<float> FloatMassKernel;
+typedef FusedPADiffusionApplyKernel<float> FloatDiffusionKernel;
+
+bool MassIntegrator::SupportsPAFused() const
+{
+   return !DeviceCanUseCeed() && maps && ne > 0 &&
+          lowmem.storage == PAStorage::DOUBLE &&
+          FusedKernels<FusedMassKernel>().Has(dim, dofs1D, quad1D);
+}
+
+void MassIntegrator::AddMultPAFused(const ElementRestriction &R,
+                                    const Table &colors,
+                                    const Vector &x, Vector &y) const
+{
+   FusedPAApply(FusedKernels<FusedMassKernel>().Get(dim, dofs1D, quad1D),
+                R, colors, ne, 1, false, maps->B, maps->G, pa_data.Read(),
+                x.Read(), y.ReadWrite());
+}
+
+void MassIntegrator::AddMultTransposePAFused(const ElementRestriction &R,
+                                             const Table &colors,
+                                             const Vector &x, Vector &y) const
+{
+   AddMultPAFused(R, colors, x, y);
+}
+
+bool MassIntegrator::SupportsPAFloat() const
+{
+   return !DeviceCanUseCeed() && maps && ne > 0 &&
+          lowmem.storage == PAStorage::FLOAT &&
+          FusedKernels<FloatMassKernel>().Has(dim, dofs1D, quad1D);
+}
+
+void MassIntegrator::AddMultPAFloat(const ElementRestriction &R,
+                                    const Table &colors,
+                                    const FloatVector &x,
+                                    FloatVector &y) const
+{
+   FusedPAApply(FusedKernels<FloatMassKernel>().Get(dim, dofs1D, quad1D),
+                R, colors, ne, 1, false, maps->B, maps->G,
+                lowmem.data.Read(), x.Read(), y.ReadWrite());
+}
+
+bool DiffusionIntegrator::SupportsPAFused() const
+{
+   return !DeviceCanUseCeed() && maps && ne > 0 &&
+          lowmem.storage == PAStorage::DOUBLE &&
+          FusedKernels<FusedDiffusionKernel>().Has(dim, dofs1D, quad1D);
+}
+
+void DiffusionIntegrator::AddMultPAFused(const ElementRestriction &R,
+                                         const Table &colors,
+                                         const Vector &x, Vector &y) const
+{
+   const int NC = (dim == 2) ? (symmetric ? 3 : 4) : (symmetric ? 6 : 9);
+   FusedPAApply(FusedKernels<FusedDiffusionKernel>().Get(dim, dofs1D, quad1D),
+                R, colors, ne, NC, false, maps->B, maps->G, pa_data.Read(),
+                x.Read(), y.ReadWrite());
+}
+
+void DiffusionIntegrator::AddMultTransposePAFused(const ElementRestriction &R,
+                                                  const Table &colors,
+                                                  const Vector &x,
+                                                  Vector &y) const
+{
+   const int NC = (dim == 2) ? (symmetric ? 3 : 4) : (symmetric ? 6 : 9);
+   FusedPAApply(FusedKernels<FusedDiffusionKernel>().Get(dim, dofs1D, quad1D),
+                R, colors, ne, NC, !symmetric, maps->B, maps->G, pa_data.Read(),
+                x.Read(), y.ReadWrite());
+}
+
+bool DiffusionIntegrator::SupportsPAFloat() const
+{
+   return !DeviceCanUseCeed() && maps && ne > 0 &&
+          lowmem.storage == PAStorage::FLOAT &&
+          FusedKernels<FloatDiffusionKernel>().Has(dim, dofs1D, quad1D);
+}
+
+void DiffusionIntegrator::AddMultPAFloat(const ElementRestriction &R,
+                                         const Table &colors,
+                                         const FloatVector &x,
+                                         FloatVector &y) const
+{
+   // The data with low-memory storage is symmetric
+   const int NC = (dim == 2) ? 3 : 6;
+   FusedPAApply(FusedKernels<FloatDiffusionKernel>().Get(dim, dofs1D, quad1D),
+                R, colors, ne, NC, false, maps->B, maps->G,
+                lowmem.data.Read(), x.Read(), y.ReadWrite());
+}
+
+} // namespace mfem
@@ -0,0 +1,144 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+#include "quadinterpolator_dispatch.hpp"
+
+namespace mfem
+{
+
+// Low-memory storage of the quadrature point data of the PA mass and diffusion
+// integrators, see PAStorage. The data is computed and used in batches of
+// elements, so that the double precision temporaries stay small.
+
+bool PALowMemData::Setup(PAStorage storage_, const FiniteElementSpace &fes,
+                         const IntegrationRule &ir, Coefficient *Q,
+                         const int qd_size_)
+{
+   Clear();
+   if (storage_ == PAStorage::DOUBLE) { return false; }
+
+   Mesh *mesh = fes.GetMesh();
+   const int mdim = mesh->Dimension();
+   if (mdim < 2 || mesh->SpaceDimension() != mdim || fes.GetNE() == 0 ||
+       mesh->GetNumGeometries(mdim) != 1 || !UsesTensorBasis(fes) ||
+       !ir.IsTensorProduct(mdim))
+   {
+      return false;
+   }
+   // As in Mesh::GetGeometricFactors(), the geometry is given by the nodes
+   mesh->EnsureNodes();
+   const FiniteElementSpace *nfes = mesh->GetNodes()->FESpace();
+   if (!UsesTensorBasis(*nfes) || nfes->IsVariableOrder() ||
+       nfes->GetFE(0)->GetOrder() + 1 > MAX_D1D)
+   {
+      return false;
+   }
+
+   dim = mdim;
+   ne = fes.GetNE();
+   nq = ir.GetNPoints();
+   qd_size = qd_size_;
+   IntRule = &ir;
+   node_maps = &nfes->GetFE(0)->GetDofToQuad(ir, DofToQuad::TENSOR);
+   // Each batch holds about 2^14 quadrature points on the host, so that its
+   // data stays in cache, and 2^22 on devices
+   const int batch_nq = Device::Allows(Backend::DEVICE_MASK) ? 1<<22 : 1<<14;
+   batch_ne = std::max(1, std::min(ne, batch_nq/nq));
+
+   const Operator *R = nfes->GetElementRestriction(
+                          ElementDofOrdering::LEXICOGRAPHIC);
+   nodes.SetSize(R->Height(), Device::GetDeviceMemoryType());
+   R->Mult(*mesh->GetNodes(), nodes);
+   EvalPACoefficient(Q, *mesh, ir, coeff);
+
+   // The nodes and a non-constant coefficient can take more memory than the
+   // double precision data, e.g. for the mass integrator, with one value per
+   // point, or for high order nodes: the data is then stored as usual.
+   if (storage_ == PAStorage::ON_THE_FLY &&
+       nodes.Size() + (coeff.OwnsData() ? coeff.Size() : 0) >= qd_size*nq*ne)
+   {
+      Clear();
+      return false;
+   }
+
+   storage = storage_;
+   return true;
+}
+
+void PALowMemData::Clear()
+{
+   storage = PAStorage::DOUBLE;
+   data.DeleteAll();
+   nodes.Destroy();
+   coeff.Destroy();
+   jac.Destroy();
+   qdata.Destroy();
+}
+
+const Vector &PALowMemData::GetJacobians(const int e0, const int neb) const
+{
+   MFEM_ASSERT(nodes.Size() > 0, "the mesh nodes were not stored");
+   const int nd = nodes.Size() / (dim*ne);
+   Vector enodes;
+   enodes.MakeRef(const_cast<Vector&>(nodes), e0*nd*dim, neb*nd*dim);
+   jac.SetSize(nq*dim*dim*neb, Device::GetDeviceMemoryType());
+   internal::quadrature_interpolator::
+   TensorDerivatives<QVectorLayout::byNODES>(neb, dim, *node_maps, enodes,
+                                             jac);
+   return jac;
+}
+
+void PALowMemData::GetCoefficient(const int e0, const int neb,
+                                  Vector &c) const
+{
+   if (coeff.Size() == 1)
+   {
+      c.MakeRef(const_cast<Vector&>(coeff), 0, 1);
+   }
+   else
+   {
+      c.MakeRef(const_cast<Vector&>(coeff), e0*nq, neb*nq);
+   }
+}
+
+void PALowMemData::StoreData(const int e0, const int neb, const Vector &d)
+{
+   if (data.Size() == 0)
+   {
+      data.SetSize(nq*qd_size*ne, Device::GetDeviceMemoryType());
+   }
+   const int n = nq*qd_size*neb, offset = e0*nq*qd_size;
+   // The batches write disjoint parts of the data
+   const auto D = d.Read();
+   auto F = data.Write();
+   MFEM_FORALL(i, n, F[offset + i] = (float) D[i]; );
+}
+
+const Vector &PALowMemData::LoadData(const int e0, const int neb) const
+{
+   const int n = nq*qd_size*neb, offset = e0*nq*qd_size;
+   qdata.SetSize(n, Device::GetDeviceMemoryType());
+   const auto F = data.Read();
+   auto D = qdata.Write();
+   MFEM_FORALL(i, n, D[i] = F[offset + i]; );
+   return qdata;
+}
+
+long PALowMemData::MemoryUsage() const
+{
+   return data.Size()*sizeof(float) +
+          (nodes.Size() + (coeff.OwnsData() ? coeff.Size() : 0))*sizeof(double);
+}
+
+} // namespace mfem
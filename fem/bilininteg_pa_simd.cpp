@@ -0,0 +1,917 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../general/kernel_dispatch.hpp"
+#include "bilininteg.hpp"
+#include "pa_simd.hpp"
+
+namespace mfem
+{
+
+// PA kernels vectorized across elements: each iteration processes a block of
+// PA_SIMD_WIDTH elements stored in the interleaved E-vector layout, see
+// PASIMDNumBlocks(), with one element per SIMD lane. These kernels run on the
+// host only.
+
+void PASIMDInterleave(const int ne, const int nd, const int vdim,
+                      const Vector &x, Vector &xi)
+{
+   constexpr int W = PA_SIMD_WIDTH;
+   const int NB = PASIMDNumBlocks(ne);
+   xi.SetSize(PASIMDSize(ne, nd, vdim));
+   const auto X = Reshape(x.HostRead(), nd, vdim, ne);
+   auto XI = Reshape(xi.HostWrite(), W, nd, vdim, NB);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int b = 0; b < NB; ++b)
+   {
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int i = 0; i < nd; ++i)
+         {
+            for (int l = 0; l < W; ++l)
+            {
+               const int e = b*W + l;
+               XI(l,i,c,b) = (e < ne) ? X(i,c,e) : 0.0;
+            }
+         }
+      }
+   }
+}
+
+void PASIMDDeinterleave(const int ne, const int nd, const int vdim,
+                        const Vector &xi, Vector &x)
+{
+   constexpr int W = PA_SIMD_WIDTH;
+   const int NB = PASIMDNumBlocks(ne);
+   MFEM_VERIFY(xi.Size() == PASIMDSize(ne, nd, vdim), "invalid input size");
+   x.SetSize(ne*nd*vdim);
+   const auto XI = Reshape(xi.HostRead(), W, nd, vdim, NB);
+   auto X = Reshape(x.HostWrite(), nd, vdim, ne);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int e = 0; e < ne; ++e)
+   {
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int i = 0; i < nd; ++i)
+         {
+            X(i,c,e) = XI(e % W, i, c, e / W);
+         }
+      }
+   }
+}
+
+namespace internal
+{
+
+namespace simd
+{
+
+constexpr int W = PA_SIMD_WIDTH;
+
+/// Load the W consecutive values at @a p.
+inline MFEM_ALWAYS_INLINE void Load(const double *p, pa_simd_t &v)
+{
+   for (int l = 0; l < W; ++l) { v[l] = p[l]; }
+}
+
+/// Add @a v to the W consecutive values at @a p.
+inline MFEM_ALWAYS_INLINE void AddTo(const pa_simd_t &v, double *p)
+{
+   for (int l = 0; l < W; ++l) { p[l] += v[l]; }
+}
+
+/// Return {p[off[0]], ..., p[off[W-1]]}.
+inline MFEM_ALWAYS_INLINE pa_simd_t Gather(const double *p, const int *off)
+{
+   pa_simd_t v;
+   for (int l = 0; l < W; ++l) { v[l] = p[off[l]]; }
+   return v;
+}
+
+/** Set the offsets of the quadrature data of the elements of block @a b, where
+    @a stride is the size of the data of one element. The padding lanes of the
+    last block use the data of the last element. */
+inline MFEM_ALWAYS_INLINE void BlockOffsets(const int b, const int NE,
+                                            const int stride, int *off)
+{
+   for (int l = 0; l < W; ++l)
+   {
+      const int e = b*W + l;
+      off[l] = ((e < NE) ? e : NE - 1) * stride;
+   }
+}
+
+/// Add to y = [dy][dx] the action of B^T D B on x = [dy][dx], with the values
+/// of D at the quadrature point qx + Q1D*qy given by D[qx + Q1D*qy + off[l]].
+template <int D1D, int Q1D>
+inline void Mass2D(const double *B_, const double *D, const int *off,
+                   const double *x, double *y)
+{
+   const auto B = Reshape(B_, Q1D, D1D);
+   pa_simd_t BX[D1D][Q1D];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx) { BX[dy][qx] = 0.0; }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         pa_simd_t u;
+         Load(x + W*(dx + D1D*dy), u);
+         for (int qx = 0; qx < Q1D; ++qx) { BX[dy][qx].fma(u, B(qx,dx)); }
+      }
+   }
+   pa_simd_t QQ[Q1D][Q1D];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         pa_simd_t s;
+         s = 0.0;
+         for (int dy = 0; dy < D1D; ++dy) { s.fma(BX[dy][qx], B(qy,dy)); }
+         QQ[qy][qx] = s * Gather(D + qx + Q1D*qy, off);
+      }
+   }
+   pa_simd_t BQ[Q1D][D1D];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         BQ[qy][dx] = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            BQ[qy][dx].fma(QQ[qy][qx], B(qx,dx));
+         }
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         pa_simd_t s;
+         s = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy) { s.fma(BQ[qy][dx], B(qy,dy)); }
+         AddTo(s, y + W*(dx + D1D*dy));
+      }
+   }
+}
+
+/// 3D version of Mass2D().
+template <int D1D, int Q1D>
+inline void Mass3D(const double *B_, const double *D, const int *off,
+                   const double *x, double *y)
+{
+   const auto B = Reshape(B_, Q1D, D1D);
+   pa_simd_t BX[D1D][D1D][Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx) { BX[dz][dy][qx] = 0.0; }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            pa_simd_t u;
+            Load(x + W*(dx + D1D*(dy + D1D*dz)), u);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BX[dz][dy][qx].fma(u, B(qx,dx));
+            }
+         }
+      }
+   }
+   pa_simd_t BBX[D1D][Q1D][Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            BBX[dz][qy][qx] = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               BBX[dz][qy][qx].fma(BX[dz][dy][qx], B(qy,dy));
+            }
+         }
+      }
+   }
+   pa_simd_t QQ[Q1D][Q1D][Q1D];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            pa_simd_t s;
+            s = 0.0;
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               s.fma(BBX[dz][qy][qx], B(qz,dz));
+            }
+            QQ[qz][qy][qx] = s * Gather(D + qx + Q1D*(qy + Q1D*qz), off);
+         }
+      }
+   }
+   pa_simd_t BQ[Q1D][Q1D][D1D];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            BQ[qz][qy][dx] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BQ[qz][qy][dx].fma(QQ[qz][qy][qx], B(qx,dx));
+            }
+         }
+      }
+   }
+   pa_simd_t BBQ[Q1D][D1D][D1D];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            BBQ[qz][dy][dx] = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               BBQ[qz][dy][dx].fma(BQ[qz][qy][dx], B(qy,dy));
+            }
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            pa_simd_t s;
+            s = 0.0;
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               s.fma(BBQ[qz][dy][dx], B(qz,dz));
+            }
+            AddTo(s, y + W*(dx + D1D*(dy + D1D*dz)));
+         }
+      }
+   }
+}
+
+/// Compute the reference gradient G = [qy][qx][2] of x = [dy][dx].
+template <int D1D, int Q1D>
+inline void Grad2D(const double *B_, const double *G_, const double *x,
+                   pa_simd_t (&grad)[Q1D][Q1D][2])
+{
+   const auto B = Reshape(B_, Q1D, D1D);
+   const auto G = Reshape(G_, Q1D, D1D);
+   pa_simd_t BX[D1D][Q1D], GX[D1D][Q1D];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx) { BX[dy][qx] = 0.0; GX[dy][qx] = 0.0; }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         pa_simd_t u;
+         Load(x + W*(dx + D1D*dy), u);
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            BX[dy][qx].fma(u, B(qx,dx));
+            GX[dy][qx].fma(u, G(qx,dx));
+         }
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         grad[qy][qx][0] = 0.0;
+         grad[qy][qx][1] = 0.0;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            grad[qy][qx][0].fma(GX[dy][qx], B(qy,dy));
+            grad[qy][qx][1].fma(BX[dy][qx], G(qy,dy));
+         }
+      }
+   }
+}
+
+/// Add to y = [dy][dx] the transpose of Grad2D() applied to @a flux.
+template <int D1D, int Q1D>
+inline void GradT2D(const double *B_, const double *G_,
+                    const pa_simd_t (&flux)[Q1D][Q1D][2], double *y)
+{
+   const auto B = Reshape(B_, Q1D, D1D);
+   const auto G = Reshape(G_, Q1D, D1D);
+   pa_simd_t GF[Q1D][D1D], BF[Q1D][D1D];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         GF[qy][dx] = 0.0;
+         BF[qy][dx] = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            GF[qy][dx].fma(flux[qy][qx][0], G(qx,dx));
+            BF[qy][dx].fma(flux[qy][qx][1], B(qx,dx));
+         }
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         pa_simd_t s;
+         s = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            s.fma(GF[qy][dx], B(qy,dy));
+            s.fma(BF[qy][dx], G(qy,dy));
+         }
+         AddTo(s, y + W*(dx + D1D*dy));
+      }
+   }
+}
+
+/// Compute the reference gradient G = [qz][qy][qx][3] of x = [dz][dy][dx].
+template <int D1D, int Q1D>
+inline void Grad3D(const double *B_, const double *G_, const double *x,
+                   pa_simd_t (&grad)[Q1D][Q1D][Q1D][3])
+{
+   const auto B = Reshape(B_, Q1D, D1D);
+   const auto G = Reshape(G_, Q1D, D1D);
+   pa_simd_t BX[D1D][D1D][Q1D], GX[D1D][D1D][Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            BX[dz][dy][qx] = 0.0;
+            GX[dz][dy][qx] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            pa_simd_t u;
+            Load(x + W*(dx + D1D*(dy + D1D*dz)), u);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BX[dz][dy][qx].fma(u, B(qx,dx));
+               GX[dz][dy][qx].fma(u, G(qx,dx));
+            }
+         }
+      }
+   }
+   pa_simd_t BBX[D1D][Q1D][Q1D], BGX[D1D][Q1D][Q1D], GBX[D1D][Q1D][Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            BBX[dz][qy][qx] = 0.0;
+            BGX[dz][qy][qx] = 0.0;
+            GBX[dz][qy][qx] = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               BBX[dz][qy][qx].fma(BX[dz][dy][qx], B(qy,dy));
+               BGX[dz][qy][qx].fma(GX[dz][dy][qx], B(qy,dy));
+               GBX[dz][qy][qx].fma(BX[dz][dy][qx], G(qy,dy));
+            }
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qz][qy][qx][0] = 0.0;
+            grad[qz][qy][qx][1] = 0.0;
+            grad[qz][qy][qx][2] = 0.0;
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               grad[qz][qy][qx][0].fma(BGX[dz][qy][qx], B(qz,dz));
+               grad[qz][qy][qx][1].fma(GBX[dz][qy][qx], B(qz,dz));
+               grad[qz][qy][qx][2].fma(BBX[dz][qy][qx], G(qz,dz));
+            }
+         }
+      }
+   }
+}
+
+/// Add to y = [dz][dy][dx] the transpose of Grad3D() applied to @a flux.
+template <int D1D, int Q1D>
+inline void GradT3D(const double *B_, const double *G_,
+                    const pa_simd_t (&flux)[Q1D][Q1D][Q1D][3], double *y)
+{
+   const auto B = Reshape(B_, Q1D, D1D);
+   const auto G = Reshape(G_, Q1D, D1D);
+   pa_simd_t GF0[Q1D][Q1D][D1D], BF1[Q1D][Q1D][D1D], BF2[Q1D][Q1D][D1D];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            GF0[qz][qy][dx] = 0.0;
+            BF1[qz][qy][dx] = 0.0;
+            BF2[qz][qy][dx] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               GF0[qz][qy][dx].fma(flux[qz][qy][qx][0], G(qx,dx));
+               BF1[qz][qy][dx].fma(flux[qz][qy][qx][1], B(qx,dx));
+               BF2[qz][qy][dx].fma(flux[qz][qy][qx][2], B(qx,dx));
+            }
+         }
+      }
+   }
+   pa_simd_t BGF[Q1D][D1D][D1D], ZF[Q1D][D1D][D1D];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            BGF[qz][dy][dx] = 0.0;
+            ZF[qz][dy][dx] = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               BGF[qz][dy][dx].fma(GF0[qz][qy][dx], B(qy,dy));
+               BGF[qz][dy][dx].fma(BF1[qz][qy][dx], G(qy,dy));
+               ZF[qz][dy][dx].fma(BF2[qz][qy][dx], B(qy,dy));
+            }
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            pa_simd_t s;
+            s = 0.0;
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               s.fma(BGF[qz][dy][dx], B(qz,dz));
+               s.fma(ZF[qz][dy][dx], G(qz,dz));
+            }
+            AddTo(s, y + W*(dx + D1D*(dy + D1D*dz)));
+         }
+      }
+   }
+}
+
+} // namespace simd
+
+} // namespace internal
+
+// SIMD PA Mass Apply 2D kernel, VDIM > 1 is used by VectorMassIntegrator
+template <int D1D, int Q1D>
+static void SIMDPAMassApply2D(const int NE, const int VDIM, const int,
+                              const Array<double> &b_, const Array<double> &,
+                              const Vector &d_, const Vector &x_, Vector &y_)
+{
+   using namespace internal::simd;
+   constexpr int NQ = Q1D*Q1D;
+   constexpr int ND = D1D*D1D;
+   const int NB = PASIMDNumBlocks(NE);
+   const double *B = b_.HostRead();
+   const double *D = d_.HostRead();
+   const auto X = Reshape(x_.HostRead(), W*ND, VDIM, NB);
+   auto Y = Reshape(y_.HostReadWrite(), W*ND, VDIM, NB);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int b = 0; b < NB; ++b)
+   {
+      int off[W];
+      BlockOffsets(b, NE, NQ, off);
+      for (int c = 0; c < VDIM; ++c)
+      {
+         Mass2D<D1D,Q1D>(B, D, off, &X(0,c,b), &Y(0,c,b));
+      }
+   }
+}
+
+// SIMD PA Mass Apply 3D kernel, VDIM > 1 is used by VectorMassIntegrator
+template <int D1D, int Q1D>
+static void SIMDPAMassApply3D(const int NE, const int VDIM, const int,
+                              const Array<double> &b_, const Array<double> &,
+                              const Vector &d_, const Vector &x_, Vector &y_)
+{
+   using namespace internal::simd;
+   constexpr int NQ = Q1D*Q1D*Q1D;
+   constexpr int ND = D1D*D1D*D1D;
+   const int NB = PASIMDNumBlocks(NE);
+   const double *B = b_.HostRead();
+   const double *D = d_.HostRead();
+   const auto X = Reshape(x_.HostRead(), W*ND, VDIM, NB);
+   auto Y = Reshape(y_.HostReadWrite(), W*ND, VDIM, NB);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int b = 0; b < NB; ++b)
+   {
+      int off[W];
+      BlockOffsets(b, NE, NQ, off);
+      for (int c = 0; c < VDIM; ++c)
+      {
+         Mass3D<D1D,Q1D>(B, D, off, &X(0,c,b), &Y(0,c,b));
+      }
+   }
+}
+
+// SIMD PA Diffusion Apply 2D kernel, NC = 3 (symmetric) or 4 components
+template <int D1D, int Q1D>
+static void SIMDPADiffusionApply2D(const int NE, const int, const int NC,
+                                   const Array<double> &b_,
+                                   const Array<double> &g_,
+                                   const Vector &d_, const Vector &x_,
+                                   Vector &y_)
+{
+   using namespace internal::simd;
+   constexpr int NQ = Q1D*Q1D;
+   constexpr int ND = D1D*D1D;
+   const int NB = PASIMDNumBlocks(NE);
+   const bool symmetric = (NC == 3);
+   const double *B = b_.HostRead();
+   const double *G = g_.HostRead();
+   const double *D = d_.HostRead();
+   const auto X = Reshape(x_.HostRead(), W*ND, NB);
+   auto Y = Reshape(y_.HostReadWrite(), W*ND, NB);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int b = 0; b < NB; ++b)
+   {
+      int off[W];
+      BlockOffsets(b, NE, NQ*NC, off);
+      pa_simd_t grad[Q1D][Q1D][2];
+      Grad2D<D1D,Q1D>(B, G, &X(0,b), grad);
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double *Dq = D + qx + Q1D*qy;
+            const pa_simd_t O11 = Gather(Dq, off);
+            const pa_simd_t O21 = Gather(Dq + NQ, off);
+            const pa_simd_t O12 = symmetric ? O21 : Gather(Dq + 2*NQ, off);
+            const pa_simd_t O22 = Gather(Dq + (symmetric ? 2 : 3)*NQ, off);
+            const pa_simd_t gX = grad[qy][qx][0];
+            const pa_simd_t gY = grad[qy][qx][1];
+            grad[qy][qx][0] = O11*gX + O12*gY;
+            grad[qy][qx][1] = O21*gX + O22*gY;
+         }
+      }
+      GradT2D<D1D,Q1D>(B, G, grad, &Y(0,b));
+   }
+}
+
+// SIMD PA Diffusion Apply 3D kernel, NC = 6 (symmetric) or 9 components
+template <int D1D, int Q1D>
+static void SIMDPADiffusionApply3D(const int NE, const int, const int NC,
+                                   const Array<double> &b_,
+                                   const Array<double> &g_,
+                                   const Vector &d_, const Vector &x_,
+                                   Vector &y_)
+{
+   using namespace internal::simd;
+   constexpr int NQ = Q1D*Q1D*Q1D;
+   constexpr int ND = D1D*D1D*D1D;
+   const int NB = PASIMDNumBlocks(NE);
+   const bool symmetric = (NC == 6);
+   const double *B = b_.HostRead();
+   const double *G = g_.HostRead();
+   const double *D = d_.HostRead();
+   const auto X = Reshape(x_.HostRead(), W*ND, NB);
+   auto Y = Reshape(y_.HostReadWrite(), W*ND, NB);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int b = 0; b < NB; ++b)
+   {
+      int off[W];
+      BlockOffsets(b, NE, NQ*NC, off);
+      pa_simd_t grad[Q1D][Q1D][Q1D][3];
+      Grad3D<D1D,Q1D>(B, G, &X(0,b), grad);
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double *Dq = D + qx + Q1D*(qy + Q1D*qz);
+               const pa_simd_t O11 = Gather(Dq, off);
+               const pa_simd_t O12 = Gather(Dq + NQ, off);
+               const pa_simd_t O13 = Gather(Dq + 2*NQ, off);
+               const pa_simd_t O21 = symmetric ? O12 : Gather(Dq + 3*NQ, off);
+               const pa_simd_t O22 = Gather(Dq + (symmetric ? 3 : 4)*NQ, off);
+               const pa_simd_t O23 = Gather(Dq + (symmetric ? 4 : 5)*NQ, off);
+               const pa_simd_t O31 = symmetric ? O13 : Gather(Dq + 6*NQ, off);
+               const pa_simd_t O32 = symmetric ? O23 : Gather(Dq + 7*NQ, off);
+               const pa_simd_t O33 = Gather(Dq + (symmetric ? 5 : 8)*NQ, off);
+               const pa_simd_t gX = grad[qz][qy][qx][0];
+               const pa_simd_t gY = grad[qz][qy][qx][1];
+               const pa_simd_t gZ = grad[qz][qy][qx][2];
+               grad[qz][qy][qx][0] = O11*gX + O12*gY + O13*gZ;
+               grad[qz][qy][qx][1] = O21*gX + O22*gY + O23*gZ;
+               grad[qz][qy][qx][2] = O31*gX + O32*gY + O33*gZ;
+            }
+         }
+      }
+      GradT3D<D1D,Q1D>(B, G, grad, &Y(0,b));
+   }
+}
+
+// SIMD PA Convection Apply 2D kernel
+template <int D1D, int Q1D>
+static void SIMDPAConvectionApply2D(const int NE, const int, const int,
+                                    const Array<double> &b_,
+                                    const Array<double> &g_,
+                                    const Vector &d_, const Vector &x_,
+                                    Vector &y_)
+{
+   using namespace internal::simd;
+   constexpr int NQ = Q1D*Q1D;
+   constexpr int ND = D1D*D1D;
+   const int NB = PASIMDNumBlocks(NE);
+   const double *Bp = b_.HostRead();
+   const double *Gp = g_.HostRead();
+   const auto B = Reshape(Bp, Q1D, D1D);
+   const double *D = d_.HostRead();
+   const auto X = Reshape(x_.HostRead(), W*ND, NB);
+   auto Y = Reshape(y_.HostReadWrite(), W*ND, NB);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int b = 0; b < NB; ++b)
+   {
+      int off[W];
+      BlockOffsets(b, NE, NQ*2, off);
+      pa_simd_t grad[Q1D][Q1D][2];
+      Grad2D<D1D,Q1D>(Bp, Gp, &X(0,b), grad);
+      pa_simd_t DGu[Q1D][Q1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double *Dq = D + qx + Q1D*qy;
+            DGu[qy][qx] = Gather(Dq, off) * grad[qy][qx][0] +
+                          Gather(Dq + NQ, off) * grad[qy][qx][1];
+         }
+      }
+      pa_simd_t BDGu[Q1D][D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            BDGu[qy][dx] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BDGu[qy][dx].fma(DGu[qy][qx], B(qx,dx));
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            pa_simd_t s;
+            s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy) { s.fma(BDGu[qy][dx], B(qy,dy)); }
+            AddTo(s, &Y(W*(dx + D1D*dy), b));
+         }
+      }
+   }
+}
+
+// SIMD PA Convection Apply 3D kernel
+template <int D1D, int Q1D>
+static void SIMDPAConvectionApply3D(const int NE, const int, const int,
+                                    const Array<double> &b_,
+                                    const Array<double> &g_,
+                                    const Vector &d_, const Vector &x_,
+                                    Vector &y_)
+{
+   using namespace internal::simd;
+   constexpr int NQ = Q1D*Q1D*Q1D;
+   constexpr int ND = D1D*D1D*D1D;
+   const int NB = PASIMDNumBlocks(NE);
+   const double *Bp = b_.HostRead();
+   const double *Gp = g_.HostRead();
+   const auto B = Reshape(Bp, Q1D, D1D);
+   const double *D = d_.HostRead();
+   const auto X = Reshape(x_.HostRead(), W*ND, NB);
+   auto Y = Reshape(y_.HostReadWrite(), W*ND, NB);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int b = 0; b < NB; ++b)
+   {
+      int off[W];
+      BlockOffsets(b, NE, NQ*3, off);
+      pa_simd_t grad[Q1D][Q1D][Q1D][3];
+      Grad3D<D1D,Q1D>(Bp, Gp, &X(0,b), grad);
+      pa_simd_t DGu[Q1D][Q1D][Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double *Dq = D + qx + Q1D*(qy + Q1D*qz);
+               DGu[qz][qy][qx] = Gather(Dq, off) * grad[qz][qy][qx][0] +
+                                 Gather(Dq + NQ, off) * grad[qz][qy][qx][1] +
+                                 Gather(Dq + 2*NQ, off) * grad[qz][qy][qx][2];
+            }
+         }
+      }
+      pa_simd_t BDGu[Q1D][Q1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               BDGu[qz][qy][dx] = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  BDGu[qz][qy][dx].fma(DGu[qz][qy][qx], B(qx,dx));
+               }
+            }
+         }
+      }
+      pa_simd_t BBDGu[Q1D][D1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               BBDGu[qz][dy][dx] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  BBDGu[qz][dy][dx].fma(BDGu[qz][qy][dx], B(qy,dy));
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               pa_simd_t s;
+               s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s.fma(BBDGu[qz][dy][dx], B(qz,dz));
+               }
+               AddTo(s, &Y(W*(dx + D1D*(dy + D1D*dz)), b));
+            }
+         }
+      }
+   }
+}
+
+/// Common part of the dispatch of the SIMD kernels. There is no generic
+/// version: the integrators report that the SIMD kernels are not supported
+/// for the sizes without specialization, see SupportsPASIMD().
+struct SIMDPAKernel
+{
+   typedef void (*Signature)(const int, const int, const int,
+                             const Array<double>&, const Array<double>&,
+                             const Vector&, const Vector&, Vector&);
+
+   static Signature Fallback(const int, const int, const int)
+   {
+      MFEM_ABORT("no SIMD kernel available");
+      return nullptr;
+   }
+};
+
+struct SIMDPAMassApplyKernel : SIMDPAKernel
+{
+   static const char *Name() { return "SIMDPAMassApply"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return &SIMDPAMassApply2D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &SIMDPAMassApply3D<D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+};
+
+struct SIMDPADiffusionApplyKernel : SIMDPAKernel
+{
+   static const char *Name() { return "SIMDPADiffusionApply"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return &SIMDPADiffusionApply2D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &SIMDPADiffusionApply3D<D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+};
+
+struct SIMDPAConvectionApplyKernel : SIMDPAKernel
+{
+   static const char *Name() { return "SIMDPAConvectionApply"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return &SIMDPAConvectionApply2D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &SIMDPAConvectionApply3D<D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+};
+
+template <typename Kernel>
+static const KernelDispatchTable<Kernel> &SIMDKernels()
+{
+   static const KernelDispatchTable<Kernel> kernels{PAKernelSpecs()};
+   return kernels;
+}
+
+bool MassIntegrator::SupportsPASIMD() const
+{
+   return !DeviceCanUseCeed() && maps && ne > 0 &&
+          lowmem.storage == PAStorage::DOUBLE &&
+          SIMDKernels<SIMDPAMassApplyKernel>().Has(dim, dofs1D, quad1D);
+}
+
+void MassIntegrator::AddMultPASIMD(const Vector &x, Vector &y) const
+{
+   SIMDKernels<SIMDPAMassApplyKernel>().Get(dim, dofs1D, quad1D)
+   (ne, 1, 1, maps->B, maps->G, pa_data, x, y);
+}
+
+bool VectorMassIntegrator::SupportsPASIMD() const
+{
+   return !DeviceCanUseCeed() && maps && ne > 0 &&
+          SIMDKernels<SIMDPAMassApplyKernel>().Has(dim, dofs1D, quad1D);
+}
+
+void VectorMassIntegrator::AddMultPASIMD(const Vector &x, Vector &y) const
+{
+   SIMDKernels<SIMDPAMassApplyKernel>().Get(dim, dofs1D, quad1D)
+   (ne, dim, 1, maps->B, maps->G, pa_data, x, y);
+}
+
+bool DiffusionIntegrator::SupportsPASIMD() const
+{
+   return !DeviceCanUseCeed() && maps && ne > 0 &&
+          lowmem.storage == PAStorage::DOUBLE &&
+          SIMDKernels<SIMDPADiffusionApplyKernel>().Has(dim, dofs1D, quad1D);
+}
+
+void DiffusionIntegrator::AddMultPASIMD(const Vector &x, Vector &y) const
+{
+   const int NC = (dim == 2) ? (symmetric ? 3 : 4) : (symmetric ? 6 : 9);
+   SIMDKernels<SIMDPADiffusionApplyKernel>().Get(dim, dofs1D, quad1D)
+   (ne, 1, NC, maps->B, maps->G, pa_data, x, y);
+}
+
+bool ConvectionIntegrator::SupportsPASIMD() const
+{
+   return !DeviceCanUseCeed() && maps && ne > 0 &&
+          SIMDKernels<SIMDPAConvectionApplyKernel>().Has(dim, dofs1D, quad1D);
+}
+
+void ConvectionIntegrator::AddMultPASIMD(const Vector &x, Vector &y) const
+{
+   SIMDKernels<SIMDPAConvectionApplyKernel>().Get(dim, dofs1D, quad1D)
+   (ne, 1, dim, maps->B, maps->G, pa_data, x, y);
+}
+
+} // namespace mfem
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/kernel_dispatch.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "ceed/mass.hpp"
@@ -345,6 +346,36 @@ static void PAVectorMassApply3D(const int NE,
    });
 }
 
+// Dispatch of the PA vector mass action kernels, see KernelDispatchTable.
+struct PAVectorMassApplyKernel
+{
+   typedef void (*Signature)(const int, const Array<double>&,
+                             const Array<double>&, const Vector&,
+                             const Vector&, Vector&, const int, const int);
+
+   static const char *Name() { return "PAVectorMassApply"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return &PAVectorMassApply2D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &PAVectorMassApply3D<D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+
+   static Signature Fallback(const int dim, const int, const int)
+   {
+      if (dim == 2) { return &PAVectorMassApply2D<>; }
+      if (dim == 3) { return &PAVectorMassApply3D<>; }
+      MFEM_ABORT("Unknown kernel.");
+      return nullptr;
+   }
+};
+
 static void PAVectorMassApply(const int dim,
                               const int D1D,
                               const int Q1D,
@@ -355,15 +386,9 @@ static void PAVectorMassApply(const int dim,
                               const Vector &x,
                               Vector &y)
 {
-   if (dim == 2)
-   {
-      return PAVectorMassApply2D(NE, B, Bt, op, x, y, D1D, Q1D);
-   }
-   if (dim == 3)
-   {
-      return PAVectorMassApply3D(NE, B, Bt, op, x, y, D1D, Q1D);
-   }
-   MFEM_ABORT("Unknown kernel.");
+   static const KernelDispatchTable<PAVectorMassApplyKernel>
+   kernels{PAKernelSpecs()};
+   kernels.Get(dim, D1D, Q1D)(NE, B, Bt, op, x, y, D1D, Q1D);
 }
 
 void VectorMassIntegrator::AddMultPA(const Vector &x, Vector &y) const
@@ -506,6 +531,36 @@ static void PAVectorMassAssembleDiagonal3D(const int NE,
    });
 }
 
+// Dispatch of the PA vector mass diagonal kernels, see KernelDispatchTable.
+struct PAVectorMassDiagonalKernel
+{
+   typedef void (*Signature)(const int, const Array<double>&,
+                             const Array<double>&, const Vector&, Vector&,
+                             const int, const int);
+
+   static const char *Name() { return "PAVectorMassDiagonal"; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,2>)
+   { return &PAVectorMassAssembleDiagonal2D<D1D,Q1D>; }
+
+   template <int D1D, int Q1D>
+   static Signature Get(std::integral_constant<int,3>)
+   { return &PAVectorMassAssembleDiagonal3D<D1D,Q1D>; }
+
+   template <int DIM, int D1D, int Q1D>
+   static Signature Specialization()
+   { return Get<D1D,Q1D>(std::integral_constant<int,DIM>()); }
+
+   static Signature Fallback(const int dim, const int, const int)
+   {
+      if (dim == 2) { return &PAVectorMassAssembleDiagonal2D<>; }
+      if (dim == 3) { return &PAVectorMassAssembleDiagonal3D<>; }
+      MFEM_ABORT("Dimension not implemented.");
+      return nullptr;
+   }
+};
+
 static void PAVectorMassAssembleDiagonal(const int dim,
                                          const int D1D,
                                          const int Q1D,
@@ -515,15 +570,9 @@ static void PAVectorMassAssembleDiagonal(const int dim,
                                          const Vector &op,
                                          Vector &y)
 {
-   if (dim == 2)
-   {
-      return PAVectorMassAssembleDiagonal2D(NE, B, Bt, op, y, D1D, Q1D);
-   }
-   else if (dim == 3)
-   {
-      return PAVectorMassAssembleDiagonal3D(NE, B, Bt, op, y, D1D, Q1D);
-   }
-   MFEM_ABORT("Dimension not implemented.");
+   static const KernelDispatchTable<PAVectorMassDiagonalKernel>
+   kernels{PAKernelSpecs()};
+   kernels.Get(dim, D1D, Q1D)(NE, B, Bt, op, y, D1D, Q1D);
 }
 
 void VectorMassIntegrator::AssembleDiagonalPA(Vector &diag)
@@ -12,6 +12,7 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 #include <cmath>
 #include <limits>
@@ -21,6 +22,45 @@ namespace mfem
 
 using namespace std;
 
+// Return the number of points per element of the QuadratureFunction @a qf, or
+// -1 if its mesh has elements of different geometries or is 1D (the batched
+// QuadratureInterpolator kernels are implemented in 2D and 3D).
+static int ProjectNumPoints(const QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "QuadratureFunction's vdim must be 1");
+   const Mesh &mesh = *qf.GetSpace()->GetMesh();
+   if (mesh.GetNE() == 0) { return 0; }
+   if (mesh.Dimension() == 1 ||
+       mesh.GetNumGeometries(mesh.Dimension()) != 1) { return -1; }
+   return qf.GetElementIntRule(0).GetNPoints();
+}
+
+void Coefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "QuadratureFunction's vdim must be 1");
+   Mesh &mesh = *qf.GetSpace()->GetMesh();
+   qf.HostWrite();
+   Vector values;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      const IntegrationRule &ir = qf.GetElementIntRule(e);
+      qf.GetElementValues(e, values);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         values(q) = Eval(T, ip);
+      }
+   }
+}
+
+void ConstantCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "QuadratureFunction's vdim must be 1");
+   qf = constant;
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -28,6 +68,25 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void PWConstCoefficient::Project(QuadratureFunction &qf)
+{
+   const int nq = ProjectNumPoints(qf);
+   if (nq < 0) { Coefficient::Project(qf); return; }
+   const Mesh &mesh = *qf.GetSpace()->GetMesh();
+   const int ne = mesh.GetNE();
+   Array<int> attr(ne);
+   for (int e = 0; e < ne; e++) { attr[e] = mesh.GetAttribute(e) - 1; }
+   const int NQ = nq;
+   const auto A = attr.Read();
+   const auto C = constants.Read();
+   auto V = Reshape(qf.Write(), NQ, ne);
+   MFEM_FORALL(e, ne,
+   {
+      const double c = C[A[e]];
+      for (int q = 0; q < NQ; q++) { V(q,e) = c; }
+   });
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -46,12 +105,150 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::Project(QuadratureFunction &qf)
+{
+   const int nq = ProjectNumPoints(qf);
+   if (nq < 0) { Coefficient::Project(qf); return; }
+   Mesh &mesh = *qf.GetSpace()->GetMesh();
+   const int ne = mesh.GetNE();
+   if (ne == 0) { return; }
+   const int sdim = mesh.SpaceDimension();
+   const IntegrationRule &ir = qf.GetElementIntRule(0);
+   const int flags = GeometricFactors::COORDINATES;
+   // Meshes without nodes are not modified: their factors are not cached
+   GeometricFactors *own_geom = mesh.GetNodes() ? NULL :
+                                new GeometricFactors(&mesh, ir, flags);
+   const GeometricFactors *geom =
+      own_geom ? own_geom : mesh.GetGeometricFactors(ir, flags);
+   const auto X = Reshape(geom->X.HostRead(), nq, sdim, ne);
+   auto V = Reshape(qf.HostWrite(), nq, ne);
+   double x[3];
+   Vector transip(x, sdim);
+   for (int e = 0; e < ne; e++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         for (int d = 0; d < sdim; d++) { x[d] = X(q,d,e); }
+         V(q,e) = Function ? Function(transip) :
+                  TDFunction(transip, GetTime());
+      }
+   }
+   delete own_geom;
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T, ip, Component);
 }
 
+void GridFunctionCoefficient::Project(QuadratureFunction &qf)
+{
+   const int nq = ProjectNumPoints(qf);
+   const FiniteElementSpace &fes = *GridF->FESpace();
+   const Mesh &mesh = *qf.GetSpace()->GetMesh();
+   const int ne = mesh.GetNE();
+   const int vdim = fes.GetVDim();
+   if (nq < 0 || fes.GetMesh() != &mesh || fes.IsVariableOrder() ||
+       fes.GetNURBSext() || vdim > 3 ||
+       (ne > 0 && (fes.GetFE(0)->GetRangeType() != FiniteElement::SCALAR ||
+                   fes.GetFE(0)->GetMapType() != FiniteElement::VALUE)))
+   {
+      Coefficient::Project(qf);
+      return;
+   }
+   if (ne == 0) { return; }
+   const IntegrationRule &ir = qf.GetElementIntRule(0);
+   const bool use_tensor_products =
+      UsesTensorBasis(fes) && ir.IsTensorProduct(mesh.Dimension());
+   const ElementDofOrdering ordering = use_tensor_products ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
+   const Operator *R = fes.GetElementRestriction(ordering);
+   Vector e_vec(R->Height());
+   R->Mult(*GridF, e_vec);
+
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   const QVectorLayout layout = qi->GetOutputLayout();
+   const bool tensor = qi->UsesTensorProducts();
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->DisableTensorProducts(!use_tensor_products);
+   if (vdim == 1)
+   {
+      qi->Values(e_vec, qf);
+   }
+   else
+   {
+      Vector q_val(vdim*nq*ne);
+      qi->Values(e_vec, q_val);
+      const int VDIM = vdim, c = Component - 1;
+      const auto Q = Reshape(q_val.Read(), VDIM, nq*ne);
+      auto V = qf.Write();
+      MFEM_FORALL(i, nq*ne, V[i] = Q(c,i););
+   }
+   qi->SetOutputLayout(layout);
+   qi->DisableTensorProducts(!tensor);
+}
+
+void SumCoefficient::Project(QuadratureFunction &qf)
+{
+   b->Project(qf);
+   const double al = alpha, be = beta;
+   auto V = qf.ReadWrite();
+   if (a == NULL)
+   {
+      const double ac = aConst;
+      MFEM_FORALL(i, qf.Size(), V[i] = al*ac + be*V[i];);
+      return;
+   }
+   QuadratureFunction qa(qf.GetSpace());
+   a->Project(qa);
+   const auto A = qa.Read();
+   MFEM_FORALL(i, qf.Size(), V[i] = al*A[i] + be*V[i];);
+}
+
+void ProductCoefficient::Project(QuadratureFunction &qf)
+{
+   b->Project(qf);
+   auto V = qf.ReadWrite();
+   if (a == NULL)
+   {
+      const double ac = aConst;
+      MFEM_FORALL(i, qf.Size(), V[i] *= ac;);
+      return;
+   }
+   QuadratureFunction qa(qf.GetSpace());
+   a->Project(qa);
+   const auto A = qa.Read();
+   MFEM_FORALL(i, qf.Size(), V[i] *= A[i];);
+}
+
+void RatioCoefficient::Project(QuadratureFunction &qf)
+{
+   if (a == NULL) { qf = aConst; }
+   else { a->Project(qf); }
+   auto V = qf.ReadWrite();
+   if (b == NULL)
+   {
+      MFEM_ASSERT(bConst != 0.0, "Division by zero in RatioCoefficient");
+      const double bc = bConst;
+      MFEM_FORALL(i, qf.Size(), V[i] /= bc;);
+      return;
+   }
+   QuadratureFunction qb(qf.GetSpace());
+   b->Project(qb);
+   const auto B = qb.Read();
+   MFEM_FORALL(i, qf.Size(), V[i] /= B[i];);
+}
+
+void PowerCoefficient::Project(QuadratureFunction &qf)
+{
+   a->Project(qf);
+   const double P = p;
+   auto V = qf.ReadWrite();
+   MFEM_FORALL(i, qf.Size(), V[i] = pow(V[i], P););
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
@@ -991,4 +1188,57 @@ double QuadratureFunctionCoefficient::Eval(ElementTransformation &T,
    return temp[0];
 }
 
+void QuadratureFunctionCoefficient::Project(QuadratureFunction &qf)
+{
+   const QuadratureSpace &qs = *QuadF.GetSpace(), &qs_out = *qf.GetSpace();
+   const int nq = ProjectNumPoints(qf);
+   const bool same_rule = nq > 0 && qs.GetMesh() == qs_out.GetMesh() &&
+                          qs.GetSize() == qs_out.GetSize() &&
+                          &QuadF.GetElementIntRule(0) ==
+                          &qf.GetElementIntRule(0);
+   if (&qs == &qs_out || same_rule)
+   {
+      qf = QuadF;
+      return;
+   }
+   Coefficient::Project(qf);
+}
+
+void EvalPACoefficient(Coefficient *Q, Mesh &mesh, const IntegrationRule &ir,
+                       Vector &coeff, bool compress)
+{
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q);
+   if (compress && (Q == NULL || cQ))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ ? cQ->constant : 1.0;
+      return;
+   }
+   if (Q == NULL)
+   {
+      coeff.SetSize(nq*ne);
+      coeff = 1.0;
+      return;
+   }
+   if (QuadratureFunctionCoefficient *qfQ =
+          dynamic_cast<QuadratureFunctionCoefficient*>(Q))
+   {
+      const QuadratureFunction &qFun = qfQ->GetQuadFunction();
+      MFEM_VERIFY(qFun.Size() == nq*ne,
+                  "Incompatible QuadratureFunction dimension \n");
+      MFEM_VERIFY(ne == 0 || &ir == &qFun.GetSpace()->GetElementIntRule(0),
+                  "IntegrationRule used within integrator and in"
+                  " QuadratureFunction appear to be different");
+      qFun.Read();
+      coeff.MakeRef(const_cast<QuadratureFunction &>(qFun), 0);
+      return;
+   }
+   QuadratureSpace qs(&mesh, ir);
+   QuadratureFunction qf(&qs);
+   Q->Project(qf);
+   coeff.Swap(qf);
+}
+
 }
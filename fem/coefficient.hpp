@@ -23,6 +23,7 @@ namespace mfem
 {
 
 class Mesh;
+class QuadratureFunction;
 
 #ifdef MFEM_USE_MPI
 class ParMesh;
@@ -70,6 +71,13 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all quadrature points of the
+       QuadratureFunction @a qf, overwriting its values. */
+   /** The QuadratureFunction must have vector dimension 1. The default
+       implementation calls Eval() at every point; derived classes override it
+       with batched evaluations that can run on the device. */
+   virtual void Project(QuadratureFunction &qf);
+
    virtual ~Coefficient() { }
 };
 
@@ -87,6 +95,9 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   /// Set all values of @a qf to the constant.
+   virtual void Project(QuadratureFunction &qf);
 };
 
 /** @brief A piecewise constant coefficient with the constants keyed
@@ -123,6 +134,9 @@ public:
    /// Evaluate the coefficient.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /// Evaluate the coefficient at all points of @a qf on the device.
+   virtual void Project(QuadratureFunction &qf);
 };
 
 /// A general function coefficient
@@ -166,6 +180,10 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the function at the physical coordinates of all points
+       of @a qf, computed with the GeometricFactors of the mesh. */
+   virtual void Project(QuadratureFunction &qf);
 };
 
 class GridFunction;
@@ -193,6 +211,12 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Interpolate the GridFunction at all points of @a qf using the
+       QuadratureInterpolator of its FiniteElementSpace. */
+   /** Falls back to Coefficient::Project() for variable order, NURBS or vector
+       FE spaces and for mixed meshes. */
+   virtual void Project(QuadratureFunction &qf);
 };
 
 
@@ -943,6 +967,9 @@ public:
       return alpha * ((a == NULL ) ? aConst : a->Eval(T, ip) )
              + beta * b->Eval(T, ip);
    }
+
+   /// Project the terms and combine them element-wise on the device.
+   virtual void Project(QuadratureFunction &qf);
 };
 
 
@@ -1082,6 +1109,9 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return ((a == NULL ) ? aConst : a->Eval(T, ip) ) * b->Eval(T, ip); }
+
+   /// Project the factors and multiply them element-wise on the device.
+   virtual void Project(QuadratureFunction &qf);
 };
 
 /** @brief Scalar coefficient defined as the ratio of two scalars where one or
@@ -1136,6 +1166,9 @@ public:
       MFEM_ASSERT(den != 0.0, "Division by zero in RatioCoefficient");
       return ((a == NULL ) ? aConst : a->Eval(T, ip) ) / den;
    }
+
+   /// Project the terms and divide them element-wise on the device.
+   virtual void Project(QuadratureFunction &qf);
 };
 
 /// Scalar coefficient defined as a scalar raised to a power
@@ -1165,6 +1198,9 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return pow(a->Eval(T, ip), p); }
+
+   /// Project the base and raise it to the power element-wise on the device.
+   virtual void Project(QuadratureFunction &qf);
 };
 
 
@@ -1658,8 +1694,6 @@ public:
 };
 ///@}
 
-class QuadratureFunction;
-
 /** @brief Vector quadrature function coefficient which requires that the
     quadrature rules used for this vector coefficient be the same as those that
     live within the supplied QuadratureFunction. */
@@ -1703,9 +1737,22 @@ public:
 
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
 
+   /** @brief Copy the values of the QuadratureFunction if @a qf uses the same
+       QuadratureSpace or the same IntegrationRule in all elements. */
+   virtual void Project(QuadratureFunction &qf);
+
    virtual ~QuadratureFunctionCoefficient() { }
 };
 
+/** @brief Evaluate the coefficient @a Q of an integrator at the points of the
+    IntegrationRule @a ir in all elements of @a mesh, for partial assembly. */
+/** The result, @a coeff, has the layout NQ x NE. If @a compress is true, a
+    NULL or constant coefficient gives a single value instead. A NULL @a Q
+    represents the constant 1. This is the coefficient setup shared by the
+    AssemblePA() methods of the integrators. */
+void EvalPACoefficient(Coefficient *Q, Mesh &mesh, const IntegrationRule &ir,
+                       Vector &coeff, bool compress = true);
+
 /** @brief Compute the Lp norm of a function f.
     \f$ \| f \|_{Lp} = ( \int_\Omega | f |^p d\Omega)^{1/p} \f$ */
 double ComputeLpNorm(double p, Coefficient &coeff, Mesh &mesh,
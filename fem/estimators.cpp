@@ -132,6 +132,44 @@ void KellyErrorEstimator::ResetCoefficientFunctions()
    };
 }
 
+// Return the sum over the points of the face rule @a ir of the squared jumps of
+// the normal flux, weighted by the face quadrature weights. The flux of the two
+// elements at the face points is given by the columns of @a vals1 and @a vals2.
+static double FluxJumpSquared(FaceElementTransformations &FT,
+                              const IntegrationRule &ir,
+                              const DenseMatrix &vals1,
+                              const DenseMatrix &vals2,
+                              Vector &normal, Vector &ref_normal)
+{
+   double sum = 0.0;
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &fip = ir.IntPoint(i);
+      FT.SetAllIntPoints(&fip);
+      if (ref_normal.Size() == normal.Size())
+      {
+         CalcOrtho(FT.Face->Jacobian(), normal);
+      }
+      else
+      {
+         FT.Loc1.Transf.SetIntPoint(&fip);
+         CalcOrtho(FT.Loc1.Transf.Jacobian(), ref_normal);
+         auto &e1 = FT.GetElement1Transformation();
+         e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
+         normal /= e1.Weight();
+      }
+
+      double jump = 0.0;
+      for (int d = 0; d < normal.Size(); d++)
+      {
+         jump += (vals1(d, i) - vals2(d, i))*normal(d);
+      }
+      jump *= fip.weight * FT.Face->Weight();
+      sum += jump*jump;
+   }
+   return sum;
+}
+
 void KellyErrorEstimator::ComputeEstimates()
 {
    // Remarks:
@@ -166,8 +204,16 @@ void KellyErrorEstimator::ComputeEstimates()
       attributes.Sort();
    }
 
-   Array<int> xdofs, fdofs;
-   Vector el_x, el_f;
+   // The element fluxes are computed in batched form when the integrator
+   // supports it.
+   Vector el_flux;
+   Array<int> offsets;
+   solution->ComputeElementFluxes(*flux_integrator, *flux_space, el_flux,
+                                  offsets);
+   el_flux.HostRead();
+
+   Array<int> fdofs;
+   Vector el_f;
    for (int e = 0; e < xfes->GetNE(); e++)
    {
       auto attr = xfes->GetAttribute(e);
@@ -176,133 +222,72 @@ void KellyErrorEstimator::ComputeEstimates()
          continue;
       }
 
-      xfes->GetElementVDofs(e, xdofs);
-      solution->GetSubVector(xdofs, el_x);
-
-      ElementTransformation* Transf = xfes->GetElementTransformation(e);
-      flux_integrator->ComputeElementFlux(*xfes->GetFE(e), *Transf, el_x,
-                                          *flux_space->GetFE(e), el_f, true);
-
       flux_space->GetElementVDofs(e, fdofs);
+      el_f.MakeRef(el_flux, offsets[e], offsets[e+1] - offsets[e]);
       flux.AddElementVector(fdofs, el_f);
    }
 
+   // Start the exchange of the face-neighbor data, which is needed only for
+   // the shared faces, so that it overlaps with the local faces.
+   flux.ExchangeFaceNbrDataBegin();
+
+   const int vdim = flux_space->GetVDim();
+   Vector normal(pmesh->SpaceDimension()), ref_normal(pmesh->Dimension()), val;
+   IntegrationRule eir;
+   DenseMatrix vals1, vals2;
+
    // 2. Add error contribution from local interior faces
    for (int f = 0; f < pmesh->GetNumFaces(); f++)
    {
-      auto FT = pmesh->GetFaceElementTransformations(f);
+      if (!pmesh->FaceIsInterior(f)) { continue; }
 
-      auto &int_rule = IntRules.Get(FT->FaceGeom, 2 * xfes->GetFaceOrder(f));
-      const auto nip = int_rule.GetNPoints();
+      auto FT = pmesh->GetFaceElementTransformations(f);
 
-      if (pmesh->FaceIsInterior(f))
+      int Inf1, Inf2, NCFace;
+      pmesh->GetFaceInfos(f, &Inf1, &Inf2, &NCFace);
+
+      // Convention
+      // * Conforming face: Face side with smaller element id handles
+      // the integration
+      // * Non-conforming face: The slave handles the integration.
+      // See FaceInfo documentation for details.
+      bool isNCSlave    = FT->Elem2No >= 0 && NCFace >= 0;
+      bool isConforming = FT->Elem2No >= 0 && NCFace == -1;
+      if ((FT->Elem1No < FT->Elem2No && isConforming) || isNCSlave)
       {
-         int Inf1, Inf2, NCFace;
-         pmesh->GetFaceInfos(f, &Inf1, &Inf2, &NCFace);
-
-         // Convention
-         // * Conforming face: Face side with smaller element id handles
-         // the integration
-         // * Non-conforming face: The slave handles the integration.
-         // See FaceInfo documentation for details.
-         bool isNCSlave    = FT->Elem2No >= 0 && NCFace >= 0;
-         bool isConforming = FT->Elem2No >= 0 && NCFace == -1;
-         if ((FT->Elem1No < FT->Elem2No && isConforming) || isNCSlave)
+         if (attributes.Size() &&
+             (attributes.FindSorted(FT->Elem1->Attribute) == -1
+              || attributes.FindSorted(FT->Elem2->Attribute) == -1))
          {
-            if (attributes.Size() &&
-                (attributes.FindSorted(FT->Elem1->Attribute) == -1
-                 || attributes.FindSorted(FT->Elem2->Attribute) == -1))
-            {
-               continue;
-            }
-
-            IntegrationRule eir;
-            Vector jumps(nip);
-
-            // Integral over local half face on the side of e₁
-            // i.e. the numerical integration of ∫ flux ⋅ n dS₁
-            for (int i = 0; i < nip; i++)
-            {
-               // Evaluate flux at IP
-               auto &fip = int_rule.IntPoint(i);
-               IntegrationPoint ip;
-               FT->Loc1.Transform(fip, ip);
-
-               Vector val(flux_space->GetVDim());
-               flux.GetVectorValue(FT->Elem1No, ip, val);
-
-               // And build scalar product with normal
-               Vector normal(pmesh->SpaceDimension());
-               FT->Face->SetIntPoint(&fip);
-               if (pmesh->Dimension() == pmesh->SpaceDimension())
-               {
-                  CalcOrtho(FT->Face->Jacobian(), normal);
-               }
-               else
-               {
-                  Vector ref_normal(pmesh->Dimension());
-                  FT->Loc1.Transf.SetIntPoint(&fip);
-                  CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
-                  auto &e1 = FT->GetElement1Transformation();
-                  e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
-                  normal /= e1.Weight();
-               }
-               jumps(i) = val * normal * fip.weight * FT->Face->Weight();
-            }
-
-            // Subtract integral over half face of e₂
-            // i.e. the numerical integration of ∫ flux ⋅ n dS₂
-            for (int i = 0; i < nip; i++)
-            {
-               // Evaluate flux vector at IP
-               auto &fip = int_rule.IntPoint(i);
-               IntegrationPoint ip;
-               FT->Loc2.Transform(fip, ip);
-
-               Vector val(flux_space->GetVDim());
-               flux.GetVectorValue(FT->Elem2No, ip, val);
-
-               // And build scalar product with normal
-               Vector normal(pmesh->SpaceDimension());
-               FT->Face->SetIntPoint(&fip);
-               if (pmesh->Dimension() == pmesh->SpaceDimension())
-               {
-                  CalcOrtho(FT->Face->Jacobian(), normal);
-               }
-               else
-               {
-                  Vector ref_normal(pmesh->Dimension());
-                  FT->Loc1.Transf.SetIntPoint(&fip);
-                  CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
-                  auto &e1 = FT->GetElement1Transformation();
-                  e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
-                  normal /= e1.Weight();
-               }
-
-               jumps(i) -= val * normal * fip.weight * FT->Face->Weight();
-            }
-
-            // Finalize "local" L₂ contribution
-            for (int i = 0; i < nip; i++)
-            {
-               jumps(i) *= jumps(i);
-            }
-            auto h_k_face = compute_face_coefficient(pmesh, f, false);
-            double jump_integral = h_k_face*jumps.Sum();
-
-            // A local face is shared between two local elements, so we
-            // can get away with integrating the jump only once and add
-            // it to both elements. To minimize communication, the jump
-            // of shared faces is computed locally by each process.
-            error_estimates(FT->Elem1No) += jump_integral;
-            error_estimates(FT->Elem2No) += jump_integral;
+            continue;
          }
+
+         auto &int_rule = IntRules.Get(FT->FaceGeom, 2 * xfes->GetFaceOrder(f));
+
+         // Evaluate the flux of both elements at all face points at once
+         eir.SetSize(int_rule.GetNPoints());
+         FT->Loc1.Transform(int_rule, eir);
+         flux.GetVectorValues(*FT->Elem1, eir, vals1);
+         FT->Loc2.Transform(int_rule, eir);
+         flux.GetVectorValues(*FT->Elem2, eir, vals2);
+
+         auto h_k_face = compute_face_coefficient(pmesh, f, false);
+         double jump_integral =
+            h_k_face*FluxJumpSquared(*FT, int_rule, vals1, vals2, normal,
+                                     ref_normal);
+
+         // A local face is shared between two local elements, so we
+         // can get away with integrating the jump only once and add
+         // it to both elements. To minimize communication, the jump
+         // of shared faces is computed locally by each process.
+         error_estimates(FT->Elem1No) += jump_integral;
+         error_estimates(FT->Elem2No) += jump_integral;
       }
    }
 
    // 3. Add error contribution from shared interior faces
-   // Synchronize face data.
-   flux.ExchangeFaceNbrData();
+   // Complete the synchronization of the face data.
+   flux.ExchangeFaceNbrDataEnd();
 
    for (int sf = 0; sf < pmesh->GetNSharedFaces(); sf++)
    {
@@ -317,78 +302,24 @@ void KellyErrorEstimator::ComputeEstimates()
       auto &int_rule = IntRules.Get(FT->FaceGeom, 2 * xfes->GetFaceOrder(0));
       const auto nip = int_rule.GetNPoints();
 
-      IntegrationRule eir;
-      Vector jumps(nip);
+      eir.SetSize(nip);
+      FT->Loc1.Transform(int_rule, eir);
+      flux.GetVectorValues(*FT->Elem1, eir, vals1);
 
-      // Integral over local half face on the side of e₁
-      // i.e. the numerical integration of ∫ flux ⋅ n dS₁
+      // The second element is a face-neighbor element
+      vals2.SetSize(vdim, nip);
       for (int i = 0; i < nip; i++)
       {
-         // Evaluate flux vector at integration point
-         auto &fip = int_rule.IntPoint(i);
          IntegrationPoint ip;
-         FT->Loc1.Transform(fip, ip);
-
-         Vector val(flux_space->GetVDim());
-         flux.GetVectorValue(FT->Elem1No, ip, val);
-
-         Vector normal(pmesh->SpaceDimension());
-         FT->Face->SetIntPoint(&fip);
-         if (pmesh->Dimension() == pmesh->SpaceDimension())
-         {
-            CalcOrtho(FT->Face->Jacobian(), normal);
-         }
-         else
-         {
-            Vector ref_normal(pmesh->Dimension());
-            FT->Loc1.Transf.SetIntPoint(&fip);
-            CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
-            auto &e1 = FT->GetElement1Transformation();
-            e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
-            normal /= e1.Weight();
-         }
-
-         jumps(i) = val * normal * fip.weight * FT->Face->Weight();
-      }
-
-      // Subtract integral over non-local half face of e₂
-      // i.e. the numerical integration of ∫ flux ⋅ n dS₂
-      for (int i = 0; i < nip; i++)
-      {
-         // Evaluate flux vector at integration point
-         auto &fip = int_rule.IntPoint(i);
-         IntegrationPoint ip;
-         FT->Loc2.Transform(fip, ip);
-
-         Vector val(flux_space->GetVDim());
+         FT->Loc2.Transform(int_rule.IntPoint(i), ip);
+         vals2.GetColumnReference(i, val);
          flux.GetVectorValue(FT->Elem2No, ip, val);
-
-         // Evaluate gauss point
-         Vector normal(pmesh->SpaceDimension());
-         FT->Face->SetIntPoint(&fip);
-         if (pmesh->Dimension() == pmesh->SpaceDimension())
-         {
-            CalcOrtho(FT->Face->Jacobian(), normal);
-         }
-         else
-         {
-            Vector ref_normal(pmesh->Dimension());
-            CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
-            auto &e1 = FT->GetElement1Transformation();
-            e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
-            normal /= e1.Weight();
-         }
-
-         jumps(i) -= val * normal * fip.weight * FT->Face->Weight();
       }
 
-      // Finalize "local" L₂ contribution
-      for (int i = 0; i < nip; i++)
-      {
-         jumps(i) *= jumps(i);
-      }
       auto h_k_face = compute_face_coefficient(pmesh, sf, true);
-      double jump_integral = h_k_face*jumps.Sum();
+      double jump_integral =
+         h_k_face*FluxJumpSquared(*FT, int_rule, vals1, vals2, normal,
+                                  ref_normal);
 
       error_estimates(FT->Elem1No) += jump_integral;
       // We skip "error_estimates(FT->Elem2No) += jump_integral"
@@ -364,6 +364,23 @@ void  FiniteElement::CalcPhysHessian(ElementTransformation &Trans,
    Mult( hess, lhm, Hessian);
 }
 
+// Return the maps in 'd2q_array' for the points of 'ir' and 'mode', or NULL.
+static DofToQuad *FindDofToQuad(const Array<DofToQuad*> &d2q_array,
+                                const IntegrationRule &ir, DofToQuad::Mode mode)
+{
+   for (int i = 0; i < d2q_array.Size(); i++)
+   {
+      DofToQuad *d2q = d2q_array[i];
+      if (d2q->mode == mode && ir.SamePoints(d2q->ir_points))
+      {
+         // The previous rule with the same points may no longer exist
+         d2q->IntRule = &ir;
+         return d2q;
+      }
+   }
+   return NULL;
+}
+
 const DofToQuad &FiniteElement::GetDofToQuad(const IntegrationRule &,
                                              DofToQuad::Mode) const
 {
@@ -500,16 +517,14 @@ const DofToQuad &ScalarFiniteElement::GetDofToQuad(const IntegrationRule &ir,
 {
    MFEM_VERIFY(mode == DofToQuad::FULL, "invalid mode requested");
 
-   for (int i = 0; i < dof2quad_array.Size(); i++)
-   {
-      const DofToQuad &d2q = *dof2quad_array[i];
-      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
-   }
+   const DofToQuad *found = FindDofToQuad(dof2quad_array, ir, mode);
+   if (found) { return *found; }
 
    DofToQuad *d2q = new DofToQuad;
    const int nqpt = ir.GetNPoints();
    d2q->FE = this;
    d2q->IntRule = &ir;
+   ir.Copy(d2q->ir_points);
    d2q->mode = mode;
    d2q->ndof = dof;
    d2q->nqpt = nqpt;
@@ -549,11 +564,8 @@ const DofToQuad &ScalarFiniteElement::GetTensorDofToQuad(
 {
    MFEM_VERIFY(mode == DofToQuad::TENSOR, "invalid mode requested");
 
-   for (int i = 0; i < dof2quad_array.Size(); i++)
-   {
-      const DofToQuad &d2q = *dof2quad_array[i];
-      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
-   }
+   const DofToQuad *found = FindDofToQuad(dof2quad_array, ir, mode);
+   if (found) { return *found; }
 
    DofToQuad *d2q = new DofToQuad;
    const Poly_1D::Basis &basis_1d = tb.GetBasis1D();
@@ -561,6 +573,7 @@ const DofToQuad &ScalarFiniteElement::GetTensorDofToQuad(
    const int nqpt = (int)floor(pow(ir.GetNPoints(), 1.0/dim) + 0.5);
    d2q->FE = this;
    d2q->IntRule = &ir;
+   ir.Copy(d2q->ir_points);
    d2q->mode = mode;
    d2q->ndof = ndof;
    d2q->nqpt = nqpt;
@@ -11924,19 +11937,16 @@ const DofToQuad &VectorTensorFiniteElement::GetTensorDofToQuad(
 {
    MFEM_VERIFY(mode == DofToQuad::TENSOR, "invalid mode requested");
 
-   for (int i = 0;
-        i < (closed ? dof2quad_array.Size() : dof2quad_array_open.Size());
-        i++)
-   {
-      const DofToQuad &d2q = closed ? *dof2quad_array[i] : *dof2quad_array_open[i];
-      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
-   }
+   const DofToQuad *found =
+      FindDofToQuad(closed ? dof2quad_array : dof2quad_array_open, ir, mode);
+   if (found) { return *found; }
 
    DofToQuad *d2q = new DofToQuad;
    const int ndof = closed ? order + 1 : order;
    const int nqpt = (int)floor(pow(ir.GetNPoints(), 1.0/dim) + 0.5);
    d2q->FE = this;
    d2q->IntRule = &ir;
+   ir.Copy(d2q->ir_points);
    d2q->mode = mode;
    d2q->ndof = ndof;
    d2q->nqpt = nqpt;
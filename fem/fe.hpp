@@ -206,6 +206,12 @@ public:
        - #ndof x #nqpt, for H(div) vector elements (TODO), or
        - #ndof x #nqpt x cdim, for H(curl) vector elements (TODO). */
    Array<double> Gt;
+
+   /** @brief Copy of the points and weights of #IntRule, identifying the
+       maps. */
+   /** The FiniteElement returns the same maps for all the rules with these
+       points, and #IntRule is the last rule they were requested with. */
+   Array<IntegrationPoint> ir_points;
 };
 
 
@@ -3311,6 +3317,7 @@ public:
 
    void                 Reset      ()         const { patch = elem = -1; }
    void                 SetIJK     (const int *IJK) const { ijk = IJK; }
+   const int           *GetIJK     ()         const { return ijk; }
    int                  GetPatch   ()         const { return patch; }
    void                 SetPatch   (int p)    const { patch = p; }
    int                  GetElement ()         const { return elem; }
@@ -35,7 +35,9 @@
 #include "tmop.hpp"
 #include "tmop_tools.hpp"
 #include "gslib.hpp"
+#include "pointeval.hpp"
 #include "restriction.hpp"
+#include "pa_simd.hpp"
 #include "quadinterpolator.hpp"
 #include "quadinterpolator_face.hpp"
 #include "transfer.hpp"
@@ -49,6 +51,7 @@
 #include "plinearform.hpp"
 #include "pbilinearform.hpp"
 #include "pnonlinearform.hpp"
+#include "ppointeval.hpp"
 #endif
 
 #ifdef MFEM_USE_SIDRE
@@ -3142,6 +3142,27 @@ void QuadratureSpace::Construct()
    element_offsets[num_elem] = size = offset;
 }
 
+QuadratureSpace::QuadratureSpace(Mesh *mesh_, const IntegrationRule &ir)
+   : mesh(mesh_), order(ir.GetOrder())
+{
+   const int num_elem = mesh->GetNE();
+   const int dim = mesh->Dimension();
+   MFEM_VERIFY(num_elem == 0 || mesh->GetNumGeometries(dim) == 1,
+               "mixed meshes are not supported");
+   const int nq = ir.GetNPoints();
+   element_offsets = new int[num_elem + 1];
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      int_rule[g] = NULL;
+   }
+   if (num_elem > 0) { int_rule[mesh->GetElementBaseGeometry(0)] = &ir; }
+   for (int i = 0; i <= num_elem; i++)
+   {
+      element_offsets[i] = i*nq;
+   }
+   size = num_elem*nq;
+}
+
 QuadratureSpace::QuadratureSpace(Mesh *mesh_, std::istream &in)
    : mesh(mesh_)
 {
@@ -3167,6 +3188,13 @@ QuadratureSpace::QuadratureSpace(Mesh *mesh_, std::istream &in)
 
 void QuadratureSpace::Save(std::ostream &out) const
 {
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      MFEM_VERIFY(int_rule[g] == NULL ||
+                  int_rule[g] == &IntRules.Get(g, order),
+                  "only QuadratureSpaces based on the global rules can be "
+                  "saved");
+   }
    out << "QuadratureSpace\n"
        << "Type: default_quadrature\n"
        << "Order: " << order << '\n';
@@ -913,6 +913,13 @@ public:
    QuadratureSpace(Mesh *mesh_, int order_)
       : mesh(mesh_), order(order_) { Construct(); }
 
+   /** @brief Create a QuadratureSpace using the IntegrationRule @a ir in all
+       elements. */
+   /** All elements of the mesh must have the same geometry, matching the one
+       of @a ir. The rule is not owned and must outlive the QuadratureSpace.
+       Spaces created in this way cannot be saved with Save(). */
+   QuadratureSpace(Mesh *mesh_, const IntegrationRule &ir);
+
    /// Read a QuadratureSpace from the stream @a in.
    QuadratureSpace(Mesh *mesh_, std::istream &in);
 
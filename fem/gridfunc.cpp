@@ -12,7 +12,9 @@
 // Implementation of GridFunction
 
 #include "gridfunc.hpp"
+#include "restriction.hpp"
 #include "../mesh/nurbs.hpp"
+#include "../general/forall.hpp"
 #include "../general/text.hpp"
 
 #ifdef MFEM_USE_MPI
@@ -254,36 +256,38 @@ void GridFunction::SumFluxAndCount(BilinearFormIntegrator &blfi,
                                    bool wcoef,
                                    int subdomain)
 {
-   GridFunction &u = *this;
-
-   ElementTransformation *Transf;
+   Vector el_flux;
+   Array<int> offsets;
+   ComputeElementFluxes(blfi, *flux.FESpace(), el_flux, offsets, wcoef,
+                        subdomain);
+   SumElementFluxes(el_flux, offsets, flux, count, subdomain);
+}
 
-   FiniteElementSpace *ufes = u.FESpace();
+void GridFunction::SumElementFluxes(const Vector &el_flux,
+                                    const Array<int> &offsets,
+                                    GridFunction &flux,
+                                    Array<int> &count,
+                                    int subdomain) const
+{
    FiniteElementSpace *ffes = flux.FESpace();
 
-   int nfe = ufes->GetNE();
-   Array<int> udofs;
    Array<int> fdofs;
-   Vector ul, fl;
+   Vector fl;
 
    flux = 0.0;
    count = 0;
 
-   for (int i = 0; i < nfe; i++)
+   el_flux.HostRead();
+   for (int i = 0; i < fes->GetNE(); i++)
    {
-      if (subdomain >= 0 && ufes->GetAttribute(i) != subdomain)
+      if (subdomain >= 0 && fes->GetAttribute(i) != subdomain)
       {
          continue;
       }
 
-      ufes->GetElementVDofs(i, udofs);
       ffes->GetElementVDofs(i, fdofs);
-
-      u.GetSubVector(udofs, ul);
-
-      Transf = ufes->GetElementTransformation(i);
-      blfi.ComputeElementFlux(*ufes->GetFE(i), *Transf, ul,
-                              *ffes->GetFE(i), fl, wcoef);
+      fl.MakeRef(const_cast<Vector &>(el_flux), offsets[i],
+                 offsets[i+1] - offsets[i]);
 
       flux.AddElementVector(fdofs, fl);
 
@@ -295,13 +299,57 @@ void GridFunction::SumFluxAndCount(BilinearFormIntegrator &blfi,
    }
 }
 
-void GridFunction::ComputeFlux(BilinearFormIntegrator &blfi,
-                               GridFunction &flux, bool wcoef,
-                               int subdomain)
+void GridFunction::ComputeElementFluxes(BilinearFormIntegrator &blfi,
+                                        const FiniteElementSpace &flux_fes,
+                                        Vector &el_flux, Array<int> &offsets,
+                                        bool wcoef, int subdomain) const
+{
+   const int nfe = fes->GetNE();
+   offsets.SetSize(nfe + 1);
+
+   if (blfi.ComputeElementFluxes(*fes, *this, flux_fes, el_flux, wcoef))
+   {
+      const int nvd = el_flux.Size()/nfe;
+      for (int i = 0; i <= nfe; i++) { offsets[i] = i*nvd; }
+      return;
+   }
+
+   offsets[0] = 0;
+   for (int i = 0; i < nfe; i++)
+   {
+      const bool skip = (subdomain >= 0 && fes->GetAttribute(i) != subdomain);
+      const int nvd = flux_fes.GetFE(i)->GetDof()*flux_fes.GetVDim();
+      offsets[i+1] = offsets[i] + (skip ? 0 : nvd);
+   }
+   el_flux.SetSize(offsets[nfe]);
+
+   Array<int> udofs;
+   Vector ul, fl;
+   for (int i = 0; i < nfe; i++)
+   {
+      if (offsets[i+1] == offsets[i]) { continue; }
+
+      fes->GetElementVDofs(i, udofs);
+      GetSubVector(udofs, ul);
+
+      ElementTransformation *Transf = fes->GetElementTransformation(i);
+      blfi.ComputeElementFlux(*fes->GetFE(i), *Transf, ul,
+                              *flux_fes.GetFE(i), fl, wcoef);
+
+      MFEM_ASSERT(fl.Size() == offsets[i+1] - offsets[i],
+                  "invalid size of the element flux");
+      el_flux.SetVector(fl, offsets[i]);
+   }
+}
+
+void GridFunction::AverageElementFluxes(const Vector &el_flux,
+                                        const Array<int> &offsets,
+                                        GridFunction &flux,
+                                        int subdomain) const
 {
    Array<int> count(flux.Size());
 
-   SumFluxAndCount(blfi, flux, count, wcoef, subdomain);
+   SumElementFluxes(el_flux, offsets, flux, count, subdomain);
 
    // complete averaging
    for (int i = 0; i < count.Size(); i++)
@@ -310,6 +358,19 @@ void GridFunction::ComputeFlux(BilinearFormIntegrator &blfi,
    }
 }
 
+void GridFunction::ComputeFlux(BilinearFormIntegrator &blfi,
+                               GridFunction &flux, bool wcoef,
+                               int subdomain)
+{
+   Vector el_flux;
+   Array<int> offsets;
+
+   ComputeElementFluxes(blfi, *flux.FESpace(), el_flux, offsets, wcoef,
+                        subdomain);
+   // This calls the parallel version when this is a ParGridFunction
+   AverageElementFluxes(el_flux, offsets, flux, subdomain);
+}
+
 int GridFunction::VectorDim() const
 {
    const FiniteElement *fe;
@@ -2277,12 +2338,49 @@ void GridFunction::ProjectDeltaCoefficient(DeltaCoefficient &delta_coeff,
    }
 }
 
+// Project the Coefficient @a coeff on the GridFunction @a u by evaluating it at
+// the nodes of all elements in one call to Coefficient::Project(). Returns
+// false if @a u is not a scalar, fixed order, nodal Lagrange (VALUE) space.
+static bool ProjectNodalCoefficient(Coefficient &coeff, GridFunction &u)
+{
+   const FiniteElementSpace &fes = *u.FESpace();
+   Mesh &mesh = *fes.GetMesh();
+   const int ne = fes.GetNE();
+   if (ne == 0 || fes.GetVDim() != 1 || fes.IsVariableOrder() ||
+       fes.GetNURBSext() || mesh.GetNumGeometries(mesh.Dimension()) != 1)
+   {
+      return false;
+   }
+   const NodalFiniteElement *fe =
+      dynamic_cast<const NodalFiniteElement*>(fes.GetFE(0));
+   if (fe == NULL || fe->GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+   const Operator *R = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   const ElementRestriction *er = dynamic_cast<const ElementRestriction*>(R);
+   const L2ElementRestriction *l2r =
+      dynamic_cast<const L2ElementRestriction*>(R);
+   if (er == NULL && l2r == NULL) { return false; }
+
+   QuadratureSpace qs(&mesh, fe->GetNodes());
+   QuadratureFunction qf(&qs);
+   coeff.Project(qf);
+   // A dof shared by several elements gets the value of the last one, as in
+   // the element loop of GridFunction::ProjectCoefficient()
+   if (er) { er->MultLeftInverse(qf, u); }
+   else { l2r->MultTranspose(qf, u); }
+   return true;
+}
+
 void GridFunction::ProjectCoefficient(Coefficient &coeff)
 {
    DeltaCoefficient *delta_c = dynamic_cast<DeltaCoefficient *>(&coeff);
 
    if (delta_c == NULL)
    {
+      if (ProjectNodalCoefficient(coeff, *this)) { return; }
+
       Array<int> vdofs;
       Vector vals;
 
@@ -3155,51 +3253,137 @@ double GridFunction::ComputeW11Error(
    return error;
 }
 
+// Evaluate the pointwise terms of the Lp error of the GridFunction @a u at the
+// points of the rule used by ComputeLpError() in all elements, in batched form.
+// The Q-vector @a err (NQ x NE) contains |u - exsol|^p weight, or |u - exsol|
+// weight if p is infinity, and @a qw contains the quadrature weights times the
+// Jacobian determinants. Returns false if @a u is not a scalar, fixed order
+// space on a 2D or 3D mesh with one element geometry and no embedding.
+static bool LpErrorTerms(const GridFunction &u, const double p,
+                         Coefficient &exsol, Coefficient *weight,
+                         const IntegrationRule *irs[],
+                         Vector &err, Vector &qw)
+{
+   const FiniteElementSpace &fes = *u.FESpace();
+   Mesh &mesh = *fes.GetMesh();
+   const int ne = fes.GetNE();
+   const int dim = mesh.Dimension();
+   if (ne == 0 || dim == 1 || fes.GetVDim() != 1 || fes.IsVariableOrder() ||
+       fes.GetNURBSext() || mesh.SpaceDimension() != dim ||
+       mesh.GetNumGeometries(dim) != 1 ||
+       fes.GetFE(0)->GetRangeType() != FiniteElement::SCALAR)
+   {
+      return false;
+   }
+   const FiniteElement &fe = *fes.GetFE(0);
+   const IntegrationRule &ir = irs ? *irs[fe.GetGeomType()] :
+                               IntRules.Get(fe.GetGeomType(),
+                                            2*fe.GetOrder() + 3);
+   const int nq = ir.GetNPoints();
+
+   QuadratureSpace qs(&mesh, ir);
+   QuadratureFunction u_q(&qs), ex_q(&qs), w_q;
+   GridFunctionCoefficient u_coeff(&u);
+   u_coeff.Project(u_q);
+   exsol.Project(ex_q);
+   if (weight)
+   {
+      w_q.SetSpace(&qs, 1);
+      weight->Project(w_q);
+   }
+
+   const int flags = GeometricFactors::DETERMINANTS;
+   // Meshes without nodes are not modified: their factors are not cached
+   GeometricFactors *own_geom = mesh.GetNodes() ? NULL :
+                                new GeometricFactors(&mesh, ir, flags);
+   const GeometricFactors *geom =
+      own_geom ? own_geom : mesh.GetGeometricFactors(ir, flags);
+
+   const int NQ = nq;
+   const double P = p;
+   const bool p_inf = !(p < infinity()), use_weight = (weight != NULL);
+   err.SetSize(nq*ne);
+   qw.SetSize(nq*ne);
+   const auto U = u_q.Read();
+   const auto E = ex_q.Read();
+   const auto WT = use_weight ? w_q.Read() : NULL;
+   const auto W = ir.GetWeights().Read();
+   const auto DJ = geom->detJ.Read();
+   auto ERR = err.Write();
+   auto QW = qw.Write();
+   MFEM_FORALL(i, nq*ne,
+   {
+      double e = fabs(U[i] - E[i]);
+      if (!p_inf) { e = pow(e, P); }
+      if (use_weight) { e *= WT[i]; }
+      ERR[i] = e;
+      QW[i] = W[i % NQ]*DJ[i];
+   });
+   delete own_geom;
+   return true;
+}
+
 double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
                                     Coefficient *weight,
                                     const IntegrationRule *irs[]) const
 {
    double error = 0.0;
-   const FiniteElement *fe;
-   ElementTransformation *T;
-   Vector vals;
-
-   for (int i = 0; i < fes->GetNE(); i++)
+   Vector err_q, w_q;
+   if (LpErrorTerms(*this, p, exsol, weight, irs, err_q, w_q))
    {
-      fe = fes->GetFE(i);
-      const IntegrationRule *ir;
-      if (irs)
+      if (p < infinity())
       {
-         ir = irs[fe->GetGeomType()];
+         error = err_q*w_q;
       }
       else
       {
-         int intorder = 2*fe->GetOrder() + 3; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         err_q.HostRead();
+         error = std::max(error, err_q.Max());
       }
-      GetValues(i, *ir, vals);
-      T = fes->GetElementTransformation(i);
-      for (int j = 0; j < ir->GetNPoints(); j++)
+   }
+   else
+   {
+      const FiniteElement *fe;
+      ElementTransformation *T;
+      Vector vals;
+
+      for (int i = 0; i < fes->GetNE(); i++)
       {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         T->SetIntPoint(&ip);
-         double err = fabs(vals(j) - exsol.Eval(*T, ip));
-         if (p < infinity())
+         fe = fes->GetFE(i);
+         const IntegrationRule *ir;
+         if (irs)
          {
-            err = pow(err, p);
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error += ip.weight * T->Weight() * err;
+            ir = irs[fe->GetGeomType()];
          }
          else
          {
-            if (weight)
+            int intorder = 2*fe->GetOrder() + 3; // <----------
+            ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         }
+         GetValues(i, *ir, vals);
+         T = fes->GetElementTransformation(i);
+         for (int j = 0; j < ir->GetNPoints(); j++)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(j);
+            T->SetIntPoint(&ip);
+            double err = fabs(vals(j) - exsol.Eval(*T, ip));
+            if (p < infinity())
             {
-               err *= weight->Eval(*T, ip);
+               err = pow(err, p);
+               if (weight)
+               {
+                  err *= weight->Eval(*T, ip);
+               }
+               error += ip.weight * T->Weight() * err;
+            }
+            else
+            {
+               if (weight)
+               {
+                  err *= weight->Eval(*T, ip);
+               }
+               error = std::max(error, err);
             }
-            error = std::max(error, err);
          }
       }
    }
@@ -3228,6 +3412,32 @@ void GridFunction::ComputeElementLpErrors(const double p, Coefficient &exsol,
    MFEM_ASSERT(error.Size() == fes->GetNE(),
                "Incorrect size for result vector");
 
+   Vector err_q, w_q;
+   if (LpErrorTerms(*this, p, exsol, weight, irs, err_q, w_q))
+   {
+      const int ne = fes->GetNE(), nq = err_q.Size()/ne;
+      const double P = p;
+      const bool p_inf = !(p < infinity());
+      const auto ERR = Reshape(err_q.Read(), nq, ne);
+      const auto QW = Reshape(w_q.Read(), nq, ne);
+      auto d_error = error.Write();
+      MFEM_FORALL(e, ne,
+      {
+         double err_e = 0.0;
+         for (int q = 0; q < nq; q++)
+         {
+            err_e = p_inf ? fmax(err_e, ERR(q,e)) : err_e + QW(q,e)*ERR(q,e);
+         }
+         if (!p_inf)
+         {
+            // negative quadrature weights may cause the error to be negative
+            err_e = (err_e < 0.) ? -pow(-err_e, 1./P) : pow(err_e, 1./P);
+         }
+         d_error[e] = err_e;
+      });
+      return;
+   }
+
    error = 0.0;
    const FiniteElement *fe;
    ElementTransformation *T;
@@ -3843,20 +4053,17 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
 {
    FiniteElementSpace *ufes = u.FESpace();
    FiniteElementSpace *ffes = flux.FESpace();
-   ElementTransformation *Transf;
 
    int dim = ufes->GetMesh()->Dimension();
    int nfe = ufes->GetNE();
 
-   Array<int> udofs;
    Array<int> fdofs;
-   Vector ul, fl, fla, d_xyz;
+   Vector fla;
 
    error_estimates.SetSize(nfe);
    if (aniso_flags)
    {
       aniso_flags->SetSize(nfe);
-      d_xyz.SetSize(dim);
    }
 
    int nsd = 1;
@@ -3865,51 +4072,78 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
       nsd = ufes->GetMesh()->attributes.Max();
    }
 
-   double total_error = 0.0;
+   // The element fluxes do not depend on the subdomain, so they are computed
+   // only once, in batched form when the integrator supports it.
+   Vector el_flux, el_diff;
+   Array<int> offsets;
+   u.ComputeElementFluxes(blfi, *ffes, el_flux, offsets, with_coeff);
+   el_diff.SetSize(el_flux.Size());
+   el_flux.HostRead();
+
    for (int s = 1; s <= nsd; s++)
    {
       // This calls the parallel version when u is a ParGridFunction
-      u.ComputeFlux(blfi, flux, with_coeff, (with_subdomains ? s : -1));
+      u.AverageElementFluxes(el_flux, offsets, flux,
+                             (with_subdomains ? s : -1));
 
       for (int i = 0; i < nfe; i++)
       {
          if (with_subdomains && ufes->GetAttribute(i) != s) { continue; }
 
-         ufes->GetElementVDofs(i, udofs);
          ffes->GetElementVDofs(i, fdofs);
-
-         u.GetSubVector(udofs, ul);
          flux.GetSubVector(fdofs, fla);
+         for (int j = 0; j < fla.Size(); j++)
+         {
+            el_diff(offsets[i] + j) = el_flux(offsets[i] + j) - fla(j);
+         }
+      }
+   }
 
-         Transf = ufes->GetElementTransformation(i);
-         blfi.ComputeElementFlux(*ufes->GetFE(i), *Transf, ul,
-                                 *ffes->GetFE(i), fl, with_coeff);
+   Vector energy;
+   DenseMatrix d_energy;
+   if (!blfi.ComputeFluxEnergies(*ffes, el_diff, energy,
+                                 aniso_flags ? &d_energy : NULL))
+   {
+      energy.SetSize(nfe);
+      if (aniso_flags) { d_energy.SetSize(dim, nfe); }
 
-         fl -= fla;
+      Vector fl, d_xyz;
+      for (int i = 0; i < nfe; i++)
+      {
+         fl.MakeRef(el_diff, offsets[i], offsets[i+1] - offsets[i]);
+         if (aniso_flags) { d_energy.GetColumnReference(i, d_xyz); }
 
-         double err = blfi.ComputeFluxEnergy(*ffes->GetFE(i), *Transf, fl,
-                                             (aniso_flags ? &d_xyz : NULL));
+         ElementTransformation *Transf = ufes->GetElementTransformation(i);
+         energy(i) = blfi.ComputeFluxEnergy(*ffes->GetFE(i), *Transf, fl,
+                                            (aniso_flags ? &d_xyz : NULL));
+      }
+   }
 
-         error_estimates(i) = std::sqrt(err);
-         total_error += err;
+   double total_error = 0.0;
+   energy.HostRead();
+   d_energy.HostRead();
+   for (int i = 0; i < nfe; i++)
+   {
+      double err = energy(i);
+      error_estimates(i) = std::sqrt(err);
+      total_error += err;
 
-         if (aniso_flags)
+      if (aniso_flags)
+      {
+         double sum = 0;
+         for (int k = 0; k < dim; k++)
          {
-            double sum = 0;
-            for (int k = 0; k < dim; k++)
-            {
-               sum += d_xyz[k];
-            }
-
-            double thresh = 0.15 * 3.0/dim;
-            int flag = 0;
-            for (int k = 0; k < dim; k++)
-            {
-               if (d_xyz[k] / sum > thresh) { flag |= (1 << k); }
-            }
+            sum += d_energy(k, i);
+         }
 
-            (*aniso_flags)[i] = flag;
+         double thresh = 0.15 * 3.0/dim;
+         int flag = 0;
+         for (int k = 0; k < dim; k++)
+         {
+            if (d_energy(k, i) / sum > thresh) { flag |= (1 << k); }
          }
+
+         (*aniso_flags)[i] = flag;
       }
    }
 #ifdef MFEM_USE_MPI
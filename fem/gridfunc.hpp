@@ -62,6 +62,12 @@ protected:
                         bool wcoef,
                         int subdomain);
 
+   // Sum the element fluxes computed by ComputeElementFluxes() to the dofs of
+   // 'flux' and count element contributions
+   void SumElementFluxes(const Vector &el_flux, const Array<int> &offsets,
+                         GridFunction &flux, Array<int> &counts,
+                         int subdomain) const;
+
    /** Project a discontinuous vector coefficient in a continuous space and
        return in dof_attr the maximal attribute of the elements containing each
        degree of freedom. */
@@ -617,6 +623,27 @@ public:
                             GridFunction &flux,
                             bool wcoef = true, int subdomain = -1);
 
+   /** @brief Compute the fluxes (see BilinearFormIntegrator::
+       ComputeElementFlux()) of the GridFunction in all elements of the given
+       @a subdomain, or in all elements if @a subdomain is negative. */
+   /** The flux coefficients of element i are stored in @a el_flux between
+       @a offsets[i] and @a offsets[i+1], in the order of the vdofs of element i
+       in @a flux_fes. When BilinearFormIntegrator::ComputeElementFluxes() is
+       supported, the fluxes of all elements are computed in batched form. */
+   void ComputeElementFluxes(BilinearFormIntegrator &blfi,
+                             const FiniteElementSpace &flux_fes,
+                             Vector &el_flux, Array<int> &offsets,
+                             bool wcoef = true, int subdomain = -1) const;
+
+   /** @brief Average the element fluxes computed by ComputeElementFluxes() in
+       the elements of the given @a subdomain into @a flux. */
+   /** ComputeFlux() calls ComputeElementFluxes() and this method. The parallel
+       version also averages over the elements of other processors. */
+   virtual void AverageElementFluxes(const Vector &el_flux,
+                                     const Array<int> &offsets,
+                                     GridFunction &flux,
+                                     int subdomain = -1) const;
+
    /// Redefine '=' for GridFunction = constant.
    GridFunction &operator=(double value);
 
@@ -41,6 +41,9 @@ namespace mfem
  *
  *  FindPointsGSLIB provides interface to use these functions individually or
  *  using a single call.
+ *
+ *  PointEvaluator and ParPointEvaluator provide similar functionality without
+ *  the gslib dependency.
  */
 class FindPointsGSLIB
 {
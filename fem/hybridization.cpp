@@ -11,11 +11,14 @@
 
 #include "hybridization.hpp"
 #include "gridfunc.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
 
 #ifdef MFEM_USE_MPI
 #include "pfespace.hpp"
 #endif
 
+#include <algorithm>
 #include <map>
 
 // uncomment next line for debugging: write C and P to file
@@ -30,7 +33,8 @@ namespace mfem
 Hybridization::Hybridization(FiniteElementSpace *fespace,
                              FiniteElementSpace *c_fespace)
    : fes(fespace), c_fes(c_fespace), c_bfi(NULL), Ct(NULL), H(NULL),
-     Af_data(NULL), Af_ipiv(NULL)
+     Af_data(NULL), Af_ipiv(NULL),
+     batched(Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK))
 {
 #ifdef MFEM_USE_MPI
    pC = P_pc = NULL;
@@ -364,8 +368,7 @@ void Hybridization::Init(const Array<int> &ess_tdof_list)
 #undef MFEM_DEBUG_HERE
 #endif
 
-   Af_data = new double[Af_offsets[NE]];
-   Af_ipiv = new int[Af_f_offsets[NE]];
+   AllocateAf();
 
 #ifdef MFEM_DEBUG
    // check that Ref = 0
@@ -403,6 +406,73 @@ void Hybridization::Init(const Array<int> &ess_tdof_list)
 #endif
 }
 
+bool Hybridization::BatchedSupported() const
+{
+   const int NE = fes->GetNE();
+   if (NE == 0) { return false; }
+#ifdef MFEM_USE_MPI
+   if (pC) { return false; }
+#endif
+   const int n = hat_offsets[1] - hat_offsets[0];
+   for (int i = 1; i < NE; i++)
+   {
+      if (hat_offsets[i+1] - hat_offsets[i] != n) { return false; }
+   }
+   return true;
+}
+
+void Hybridization::AllocateAf()
+{
+   const int NE = fes->GetNE();
+   batched = batched && BatchedSupported();
+
+   delete [] Af_ipiv;
+   delete [] Af_data;
+   Af_data = NULL;
+   Af_ipiv = NULL;
+   Af_batch.Clear();
+   Af_batch_piv.DeleteAll();
+   hat_vdofs.DeleteAll();
+   hat_vdofs_first.DeleteAll();
+
+   if (!batched)
+   {
+      Af_data = new double[Af_offsets[NE]];
+      Af_ipiv = new int[Af_f_offsets[NE]];
+      return;
+   }
+
+   const int n = hat_offsets[1];
+   Af_batch.SetSize(n, n, NE);
+
+   // Define the maps from hat dofs to vdofs used by MultAfInv() and
+   // ComputeSolution(): the contribution of the r.h.s. of each vdof is
+   // assigned to its first hat dof.
+   Array<int> vdofs;
+   Array<bool> vdof_marker(fes->GetVSize());
+   vdof_marker = false;
+   hat_vdofs.SetSize(n*NE);
+   hat_vdofs_first.SetSize(n*NE);
+   for (int i = 0; i < NE; i++)
+   {
+      fes->GetElementVDofs(i, vdofs);
+      for (int j = 0; j < n; j++)
+      {
+         const int vdof = vdofs[j];
+         const int k = vdof >= 0 ? vdof : -1-vdof;
+         hat_vdofs[i*n+j] = vdof;
+         hat_vdofs_first[i*n+j] = !vdof_marker[k];
+         vdof_marker[k] = true;
+      }
+   }
+}
+
+void Hybridization::UseBatched(bool use)
+{
+   batched = use;
+   if (Ct) { AllocateAf(); }
+}
+
 void Hybridization::GetIBDofs(
    int el, Array<int> &i_dofs, Array<int> &b_dofs) const
 {
@@ -441,6 +511,15 @@ void Hybridization::GetBDofs(int el, int &num_idofs, Array<int> &b_dofs) const
 
 void Hybridization::AssembleMatrix(int el, const DenseMatrix &A)
 {
+   if (batched)
+   {
+      const int n = Af_batch.SizeI();
+      MFEM_ASSERT(A.Height() == n && A.Width() == n, "invalid element matrix");
+      const double *a = A.Data();
+      std::copy(a, a + n*n, Af_batch.HostReadWrite() + n*n*el);
+      return;
+   }
+
    Array<int> i_dofs, b_dofs;
 
    GetIBDofs(el, i_dofs, b_dofs);
@@ -521,6 +600,24 @@ void Hybridization::AssembleBdrMatrix(int bdr_el, const DenseMatrix &A)
       }
    }
 
+   if (batched)
+   {
+      const int n = Af_batch.SizeI();
+      DenseMatrix A_el(Af_batch.HostReadWrite() + n*n*el, n, n);
+      for (int j = 0; j < n; j++)
+      {
+         const int j_f = e2f[j];
+         if (j_f == -1) { continue; }
+         for (int i = 0; i < n; i++)
+         {
+            const int i_f = e2f[i];
+            if (i_f == -1) { continue; }
+            A_el(i,j) += B(i_f,j_f);
+         }
+      }
+      return;
+   }
+
    GetIBDofs(el, i_dofs, b_dofs);
 
    DenseMatrix A_ii(Af_data + Af_offsets[el], i_dofs.Size(), i_dofs.Size());
@@ -567,102 +664,295 @@ void Hybridization::AssembleBdrMatrix(int bdr_el, const DenseMatrix &A)
    }
 }
 
-void Hybridization::ComputeH()
+void Hybridization::ComputeBatchedH()
 {
-   const int skip_zeros = 1;
-   Array<int> c_dof_marker(Ct->Width());
-   Array<int> b_dofs, c_dofs;
    const int NE = fes->GetNE();
-   DenseMatrix Cb_t, Sb_inv_Cb_t, Hb;
-#ifndef MFEM_USE_MPI
-   H = new SparseMatrix(Ct->Width());
-#else
-   H = pC ? NULL : new SparseMatrix(Ct->Width());
-   // V = Sb^{-1} Cb^T, for parallel non-conforming meshes
-   SparseMatrix *V = pC ? new SparseMatrix(Ct->Height(), Ct->Width()) : NULL;
-#endif
+   const int n = Af_batch.SizeI();
 
-   c_dof_marker = -1;
-   int c_mark_start = 0;
-   for (int el = 0; el < NE; el++)
+   // Replace the rows and columns of the "essential" hat dofs by identity
+   // and factor the element matrices.
    {
-      int i_dofs_size;
-      GetBDofs(el, i_dofs_size, b_dofs);
-
-      LUFactors LU_ii(Af_data + Af_offsets[el], Af_ipiv + Af_f_offsets[el]);
-      double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
-      double *A_bi_data = A_ib_data + i_dofs_size*b_dofs.Size();
-      LUFactors LU_bb(A_bi_data + i_dofs_size*b_dofs.Size(),
-                      LU_ii.ipiv + i_dofs_size);
-
-      LU_ii.Factor(i_dofs_size);
-      LU_ii.BlockFactor(i_dofs_size, b_dofs.Size(),
-                        A_ib_data, A_bi_data, LU_bb.data);
-      LU_bb.Factor(b_dofs.Size());
+      const auto d_marker = Reshape(hat_dofs_marker.Read(), n, NE);
+      auto d_A = Reshape(Af_batch.ReadWrite(), n, n, NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int j = 0; j < n; j++)
+         {
+            if (d_marker(j,e) != 1) { continue; }
+            for (int i = 0; i < n; i++)
+            {
+               d_A(i,j,e) = 0.0;
+               d_A(j,i,e) = 0.0;
+            }
+            d_A(j,j,e) = 1.0;
+         }
+      });
+   }
+   BatchLUFactor(Af_batch, Af_batch_piv);
 
-      // Extract Cb_t from Ct, define c_dofs
-      c_dofs.SetSize(0);
-      for (int i = 0; i < b_dofs.Size(); i++)
+   // Extract the blocks Cb^T of Ct: the rows of the "boundary" hat dofs of
+   // each element and the columns of the c_dofs coupled to them, stored in
+   // the table el_cdof.
+   const int num_c_dofs = Ct->Width();
+   Array<int> c_dof_marker(num_c_dofs);
+   Array<int> el_cdof_I(NE+1), el_cdof_J;
+   c_dof_marker = -1;
+   el_cdof_I[0] = 0;
+   int max_c = 0;
+   for (int e = 0; e < NE; e++)
+   {
+      for (int k = e*n; k < (e+1)*n; k++)
       {
-         const int row = b_dofs[i];
-         const int ncols = Ct->RowSize(row);
-         const int *cols = Ct->GetRowColumns(row);
+         if (hat_dofs_marker[k] != -1) { continue; }
+         const int ncols = Ct->RowSize(k);
+         const int *cols = Ct->GetRowColumns(k);
          for (int j = 0; j < ncols; j++)
          {
             const int c_dof = cols[j];
-            if (c_dof_marker[c_dof] < c_mark_start)
+            if (c_dof_marker[c_dof] < el_cdof_I[e])
             {
-               c_dof_marker[c_dof] = c_mark_start + c_dofs.Size();
-               c_dofs.Append(c_dof);
+               c_dof_marker[c_dof] = el_cdof_J.Size();
+               el_cdof_J.Append(c_dof);
             }
          }
       }
-      Cb_t.SetSize(b_dofs.Size(), c_dofs.Size());
-      Cb_t = 0.0;
-      for (int i = 0; i < b_dofs.Size(); i++)
+      el_cdof_I[e+1] = el_cdof_J.Size();
+      max_c = std::max(max_c, el_cdof_I[e+1] - el_cdof_I[e]);
+   }
+   DenseTensor Cb_t(n, max_c, NE);
+   Cb_t = 0.0;
+   for (int e = 0; e < NE; e++)
+   {
+      for (int j = el_cdof_I[e]; j < el_cdof_I[e+1]; j++)
       {
-         const int row = b_dofs[i];
-         const int ncols = Ct->RowSize(row);
-         const int *cols = Ct->GetRowColumns(row);
-         const double *vals = Ct->GetRowEntries(row);
+         c_dof_marker[el_cdof_J[j]] = j - el_cdof_I[e];
+      }
+      for (int k = e*n; k < (e+1)*n; k++)
+      {
+         if (hat_dofs_marker[k] != -1) { continue; }
+         const int ncols = Ct->RowSize(k);
+         const int *cols = Ct->GetRowColumns(k);
+         const double *vals = Ct->GetRowEntries(k);
          for (int j = 0; j < ncols; j++)
          {
-            const int loc_j = c_dof_marker[cols[j]] - c_mark_start;
-            Cb_t(i,loc_j) = vals[j];
+            Cb_t(k - e*n, c_dof_marker[cols[j]], e) = vals[j];
          }
       }
+   }
 
-      // Compute Hb = Cb Sb^{-1} Cb^t
-      Sb_inv_Cb_t = Cb_t;
-      LU_bb.Solve(Cb_t.Height(), Cb_t.Width(), Sb_inv_Cb_t.Data());
+   // Compute the element contributions Hb = Cb Sb^{-1} Cb^T. Since Cb^T is
+   // zero outside of the "boundary" dofs, Sb^{-1} Cb^T is the "boundary"
+   // part of Af^{-1} Cb^T.
+   DenseTensor Hb(max_c, max_c, NE);
+   {
+      Vector X(n*max_c*NE);
+      const auto d_LU = Reshape(Af_batch.Read(), n, n, NE);
+      const auto d_piv = Reshape(Af_batch_piv.Read(), n, NE);
+      const auto d_I = el_cdof_I.Read();
+      const auto d_Cb_t = Reshape(Cb_t.Read(), n, max_c, NE);
+      auto d_X = Reshape(X.Write(), n, max_c, NE);
+      auto d_Hb = Reshape(Hb.Write(), max_c, max_c, NE);
+      MFEM_FORALL(e, NE,
+      {
+         const int nc = d_I[e+1] - d_I[e];
+         for (int k = 0; k < nc; k++)
+         {
+            for (int i = 0; i < n; i++) { d_X(i,k,e) = d_Cb_t(i,k,e); }
+            kernels::LUSolve(&d_LU(0,0,e), n, &d_piv(0,e), &d_X(0,k,e));
+         }
+         for (int k = 0; k < nc; k++)
+         {
+            for (int l = 0; l < nc; l++)
+            {
+               double h = 0.0;
+               for (int i = 0; i < n; i++) { h += d_Cb_t(i,l,e)*d_X(i,k,e); }
+               d_Hb(l,k,e) = h;
+            }
+         }
+      });
+   }
+
+   // Define the sparsity of H from the c_dof-to-c_dof connectivity through
+   // the elements; empty rows get a unit diagonal entry.
+   Table el_cdof, cdof_el;
+   el_cdof.MakeI(NE);
+   for (int e = 0; e < NE; e++)
+   {
+      el_cdof.AddColumnsInRow(e, el_cdof_I[e+1] - el_cdof_I[e]);
+   }
+   el_cdof.MakeJ();
+   for (int e = 0; e < NE; e++)
+   {
+      el_cdof.AddConnections(e, el_cdof_J + el_cdof_I[e],
+                             el_cdof_I[e+1] - el_cdof_I[e]);
+   }
+   el_cdof.ShiftUpI();
+   Transpose(el_cdof, cdof_el, num_c_dofs);
+   Table *cdof_cdof = Mult(cdof_el, el_cdof);
+   cdof_cdof->SortRows();
+
+   int *H_I = new int[num_c_dofs+1];
+   H_I[0] = 0;
+   for (int r = 0; r < num_c_dofs; r++)
+   {
+      H_I[r+1] = H_I[r] + std::max(cdof_cdof->RowSize(r), 1);
+   }
+   int *H_J = new int[H_I[num_c_dofs]];
+   double *H_data = new double[H_I[num_c_dofs]];
+   for (int r = 0; r < num_c_dofs; r++)
+   {
+      if (cdof_cdof->RowSize(r) == 0) { H_J[H_I[r]] = r; continue; }
+      const int *row = cdof_cdof->GetRow(r);
+      std::copy(row, row + cdof_cdof->RowSize(r), H_J + H_I[r]);
+   }
+   delete cdof_cdof;
+   H = new SparseMatrix(H_I, H_J, H_data, num_c_dofs, num_c_dofs);
+
+   // Assemble H row by row: each thread sums the contributions of the
+   // elements adjacent to its c_dof.
+   {
+      const int *d_cI = mfem::Read(cdof_el.GetIMemory(), num_c_dofs+1);
+      const int *d_cJ = mfem::Read(cdof_el.GetJMemory(),
+                                   cdof_el.Size_of_connections());
+      const auto d_eI = el_cdof_I.Read();
+      const auto d_eJ = el_cdof_J.Read();
+      const auto d_Hb = Reshape(Hb.Read(), max_c, max_c, NE);
+      const int *d_HI = H->ReadI();
+      const int *d_HJ = H->ReadJ();
+      double *d_H = H->WriteData();
+      MFEM_FORALL(r, num_c_dofs,
+      {
+         const int h_begin = d_HI[r], h_end = d_HI[r+1];
+         for (int k = h_begin; k < h_end; k++) { d_H[k] = 0.0; }
+         if (d_cI[r] == d_cI[r+1]) { d_H[h_begin] = 1.0; }
+         for (int k = d_cI[r]; k < d_cI[r+1]; k++)
+         {
+            const int e = d_cJ[k];
+            const int c_begin = d_eI[e], nc = d_eI[e+1] - c_begin;
+            int lr = 0;
+            while (d_eJ[c_begin + lr] != r) { lr++; }
+            for (int l = 0; l < nc; l++)
+            {
+               // binary search for the column of c_dof d_eJ[c_begin+l]
+               const int c = d_eJ[c_begin + l];
+               int lo = h_begin, hi = h_end - 1;
+               while (lo < hi)
+               {
+                  const int mid = (lo + hi)/2;
+                  if (d_HJ[mid] < c) { lo = mid + 1; }
+                  else { hi = mid; }
+               }
+               d_H[lo] += d_Hb(lr,l,e);
+            }
+         }
+      });
+   }
+}
+
+void Hybridization::ComputeH()
+{
+   const int skip_zeros = 1;
+   const bool fix_empty_rows = true;
 #ifdef MFEM_USE_MPI
-      if (!pC)
+   // V = Sb^{-1} Cb^T, for parallel non-conforming meshes
+   SparseMatrix *V = NULL;
+#endif
+   if (batched)
+   {
+      ComputeBatchedH();
+   }
+   else
+   {
+      Array<int> c_dof_marker(Ct->Width());
+      Array<int> b_dofs, c_dofs;
+      const int NE = fes->GetNE();
+      DenseMatrix Cb_t, Sb_inv_Cb_t, Hb;
+#ifndef MFEM_USE_MPI
+      H = new SparseMatrix(Ct->Width());
+#else
+      H = pC ? NULL : new SparseMatrix(Ct->Width());
+      V = pC ? new SparseMatrix(Ct->Height(), Ct->Width()) : NULL;
 #endif
+
+      c_dof_marker = -1;
+      int c_mark_start = 0;
+      for (int el = 0; el < NE; el++)
       {
-         Hb.SetSize(Cb_t.Width());
-         MultAtB(Cb_t, Sb_inv_Cb_t, Hb);
+         int i_dofs_size;
+         GetBDofs(el, i_dofs_size, b_dofs);
 
-         // Assemble Hb into H
-         H->AddSubMatrix(c_dofs, c_dofs, Hb, skip_zeros);
-      }
+         LUFactors LU_ii(Af_data + Af_offsets[el], Af_ipiv + Af_f_offsets[el]);
+         double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
+         double *A_bi_data = A_ib_data + i_dofs_size*b_dofs.Size();
+         LUFactors LU_bb(A_bi_data + i_dofs_size*b_dofs.Size(),
+                         LU_ii.ipiv + i_dofs_size);
+
+         LU_ii.Factor(i_dofs_size);
+         LU_ii.BlockFactor(i_dofs_size, b_dofs.Size(),
+                           A_ib_data, A_bi_data, LU_bb.data);
+         LU_bb.Factor(b_dofs.Size());
+
+         // Extract Cb_t from Ct, define c_dofs
+         c_dofs.SetSize(0);
+         for (int i = 0; i < b_dofs.Size(); i++)
+         {
+            const int row = b_dofs[i];
+            const int ncols = Ct->RowSize(row);
+            const int *cols = Ct->GetRowColumns(row);
+            for (int j = 0; j < ncols; j++)
+            {
+               const int c_dof = cols[j];
+               if (c_dof_marker[c_dof] < c_mark_start)
+               {
+                  c_dof_marker[c_dof] = c_mark_start + c_dofs.Size();
+                  c_dofs.Append(c_dof);
+               }
+            }
+         }
+         Cb_t.SetSize(b_dofs.Size(), c_dofs.Size());
+         Cb_t = 0.0;
+         for (int i = 0; i < b_dofs.Size(); i++)
+         {
+            const int row = b_dofs[i];
+            const int ncols = Ct->RowSize(row);
+            const int *cols = Ct->GetRowColumns(row);
+            const double *vals = Ct->GetRowEntries(row);
+            for (int j = 0; j < ncols; j++)
+            {
+               const int loc_j = c_dof_marker[cols[j]] - c_mark_start;
+               Cb_t(i,loc_j) = vals[j];
+            }
+         }
+
+         // Compute Hb = Cb Sb^{-1} Cb^t
+         Sb_inv_Cb_t = Cb_t;
+         LU_bb.Solve(Cb_t.Height(), Cb_t.Width(), Sb_inv_Cb_t.Data());
 #ifdef MFEM_USE_MPI
-      else
-      {
-         V->AddSubMatrix(b_dofs, c_dofs, Sb_inv_Cb_t, skip_zeros);
-      }
+         if (!pC)
+#endif
+         {
+            Hb.SetSize(Cb_t.Width());
+            MultAtB(Cb_t, Sb_inv_Cb_t, Hb);
+
+            // Assemble Hb into H
+            H->AddSubMatrix(c_dofs, c_dofs, Hb, skip_zeros);
+         }
+#ifdef MFEM_USE_MPI
+         else
+         {
+            V->AddSubMatrix(b_dofs, c_dofs, Sb_inv_Cb_t, skip_zeros);
+         }
 #endif
 
-      c_mark_start += c_dofs.Size();
-      MFEM_VERIFY(c_mark_start >= 0, "overflow"); // check for overflow
+         c_mark_start += c_dofs.Size();
+         MFEM_VERIFY(c_mark_start >= 0, "overflow"); // check for overflow
+      }
+      if (H) { H->Finalize(skip_zeros, fix_empty_rows); }
    }
-   const bool fix_empty_rows = true;
-#ifndef MFEM_USE_MPI
-   H->Finalize(skip_zeros, fix_empty_rows);
-#else
+#ifdef MFEM_USE_MPI
    ParFiniteElementSpace *c_pfes = dynamic_cast<ParFiniteElementSpace*>(c_fes);
    if (!pC)
    {
-      H->Finalize(skip_zeros, fix_empty_rows);
       if (!c_pfes) { return; }
 
       OperatorHandle pP(pH.Type()), dH(pH.Type());
@@ -731,7 +1021,7 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
    const SparseMatrix *R = fes->GetRestrictionMatrix();
    if (!R)
    {
-      b1.SetDataAndSize(b.GetData(), b.Size());
+      b1.MakeRef(const_cast<Vector&>(b), 0, b.Size());
    }
    else
    {
@@ -743,6 +1033,7 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
    Array<int> vdofs, i_dofs, b_dofs;
    Vector el_vals, bf_i, i_vals, b_vals;
    bf.SetSize(hat_offsets[NE]);
+   if (batched) { bf.UseDevice(true); }
    if (mode == 1)
    {
 #ifdef MFEM_USE_MPI
@@ -762,6 +1053,36 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
       Ct->Mult(lambda, bf);
 #endif
    }
+   if (batched)
+   {
+      // Gather the element r.h.s. in bf and apply Af^{-1} in place
+      const int N = bf.Size();
+      const bool sub = (mode == 1);
+      const auto d_marker = hat_dofs_marker.Read();
+      const auto d_vdofs = hat_vdofs.Read();
+      const auto d_first = hat_vdofs_first.Read();
+      const auto d_b = b1.Read();
+      auto d_bf = sub ? bf.ReadWrite() : bf.Write();
+      MFEM_FORALL(i, N,
+      {
+         double val = 0.0;
+         if (d_marker[i] != 1)
+         {
+            const int vdof = d_vdofs[i];
+            if (d_first[i]) { val = (vdof >= 0) ? d_b[vdof] : -d_b[-1-vdof]; }
+            if (sub) { val -= d_bf[i]; }
+         }
+         d_bf[i] = val;
+      });
+      BatchLUSolve(Af_batch, Af_batch_piv, bf);
+      if (mode == 0)
+      {
+         // zero the non-"boundary" part of bf
+         auto d_bf0 = bf.ReadWrite();
+         MFEM_FORALL(i, N, if (d_marker[i] != -1) { d_bf0[i] = 0.0; });
+      }
+      return;
+   }
    // Apply Af^{-1}
    Array<bool> vdof_marker(b1.Size());
    vdof_marker = false;
@@ -852,16 +1173,37 @@ void Hybridization::ComputeSolution(const Vector &b, const Vector &sol_r,
       R->MultTranspose(sol, s);
    }
    const int NE = fes->GetMesh()->GetNE();
-   Array<int> vdofs;
-   for (int i = 0; i < NE; i++)
+   if (batched)
    {
-      fes->GetElementVDofs(i, vdofs);
-      for (int j = hat_offsets[i]; j < hat_offsets[i+1]; j++)
+      // Scatter the first hat dof of each non-"essential" vdof
+      const auto d_marker = hat_dofs_marker.Read();
+      const auto d_vdofs = hat_vdofs.Read();
+      const auto d_first = hat_vdofs_first.Read();
+      const auto d_bf = bf.Read();
+      auto d_s = s.ReadWrite();
+      MFEM_FORALL(i, bf.Size(),
       {
-         if (hat_dofs_marker[j] == 1) { continue; } // skip essential b.c.
-         int vdof = vdofs[j-hat_offsets[i]];
-         if (vdof >= 0) { s(vdof) = bf(j); }
-         else { s(-1-vdof) = -bf(j); }
+         if (d_marker[i] != 1 && d_first[i])
+         {
+            const int vdof = d_vdofs[i];
+            if (vdof >= 0) { d_s[vdof] = d_bf[i]; }
+            else { d_s[-1-vdof] = -d_bf[i]; }
+         }
+      });
+   }
+   else
+   {
+      Array<int> vdofs;
+      for (int i = 0; i < NE; i++)
+      {
+         fes->GetElementVDofs(i, vdofs);
+         for (int j = hat_offsets[i]; j < hat_offsets[i+1]; j++)
+         {
+            if (hat_dofs_marker[j] == 1) { continue; } // skip essential b.c.
+            int vdof = vdofs[j-hat_offsets[i]];
+            if (vdof >= 0) { s(vdof) = bf(j); }
+            else { s(-1-vdof) = -bf(j); }
+         }
       }
    }
    if (R)
@@ -56,7 +56,13 @@ namespace mfem
         \f[ S_b = \hat{A}_b - \hat{A}_{bf} \hat{A}_{f}^{-1} \hat{A}_{fb}. \f]
 
     Hybridization can also be viewed as a discretization method for imposing
-    (weak) continuity constraints between neighboring elements. */
+    (weak) continuity constraints between neighboring elements.
+
+    When all elements have the same number of dofs, the element matrices can
+    be stored in a DenseTensor and factored and solved with BatchLUFactor()
+    and BatchLUSolve(), see UseBatched(). In this case, the element
+    contributions to \f$ H \f$ are computed with MFEM_FORALL and assembled
+    row-wise, and ReduceRHS() and ComputeSolution() run on the device. */
 class Hybridization
 {
 protected:
@@ -70,6 +76,17 @@ protected:
    double *Af_data;
    int *Af_ipiv;
 
+   // Batched storage of the element matrices, used instead of Af_data and
+   // Af_ipiv when 'batched' is true. In the batched element matrices, the
+   // rows and columns of the "essential" hat dofs are replaced by identity.
+   bool batched;
+   DenseTensor Af_batch;
+   Array<int> Af_batch_piv;
+   // The vdof of each hat dof, with the sign encoding of GetElementVDofs(),
+   // and a flag indicating the first hat dof (in element order) of each vdof.
+   Array<int> hat_vdofs;
+   Array<bool> hat_vdofs_first;
+
 #ifdef MFEM_USE_MPI
    HypreParMatrix *pC, *P_pc; // for parallel non-conforming meshes
    OperatorHandle pH;
@@ -83,6 +100,15 @@ protected:
 
    void ComputeH();
 
+   // Return true if the element matrices can be stored in a DenseTensor.
+   bool BatchedSupported() const;
+
+   // (Re)allocate the storage for the element matrices.
+   void AllocateAf();
+
+   // Compute the serial matrix H with the batched element matrices.
+   void ComputeBatchedH();
+
    // Compute depending on mode:
    // - mode 0: bf = Af^{-1} Rf^t b, where
    //           the non-"boundary" part of bf is set to 0;
@@ -108,6 +134,19 @@ public:
    /// Prepare the Hybridization object for assembly.
    void Init(const Array<int> &ess_tdof_list);
 
+   /** @brief Store the element matrices in a DenseTensor and use the batched
+       (device) kernels for the local solves.
+
+       The batched path is only used if all elements have the same number of
+       dofs and, in parallel, the mesh has no shared non-conforming faces;
+       otherwise this call is ignored. It is enabled by default when a device
+       or OpenMP backend is configured. This method must be called before the
+       assembly of the element matrices. */
+   void UseBatched(bool use = true);
+
+   /// Return true if the batched element storage and kernels are used.
+   bool UsesBatched() const { return batched; }
+
    /// Assemble the element matrix A into the hybridized system matrix.
    void AssembleMatrix(int el, const DenseMatrix &A);
 
@@ -95,6 +95,41 @@ const Array<double> &IntegrationRule::GetWeights() const
    return weights;
 }
 
+bool IntegrationRule::IsTensorProduct(int dim) const
+{
+   const int np = GetNPoints();
+   const int n1 = (int)floor(pow(np, 1.0/dim) + 0.5);
+   int npt = 1;
+   for (int d = 0; d < dim; d++) { npt *= n1; }
+   if (npt != np) { return false; }
+   for (int i = 0; i < np; i++)
+   {
+      const IntegrationPoint &ip = IntPoint(i);
+      const int ix = i%n1, iy = (i/n1)%n1, iz = i/(n1*n1);
+      if (ip.x != IntPoint(ix).x ||
+          (dim > 1 && ip.y != IntPoint(iy).x) ||
+          (dim > 2 && ip.z != IntPoint(iz).x))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+bool IntegrationRule::SamePoints(const Array<IntegrationPoint> &pts) const
+{
+   if (pts.Size() != GetNPoints()) { return false; }
+   for (int i = 0; i < pts.Size(); i++)
+   {
+      const IntegrationPoint &a = pts[i], &b = IntPoint(i);
+      if (a.x != b.x || a.y != b.y || a.z != b.z || a.weight != b.weight)
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
 void IntegrationRule::SetPointIndices()
 {
    for (int i = 0; i < Size(); i++)
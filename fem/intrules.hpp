@@ -255,6 +255,17 @@ public:
        a call like this: `IntPoint(i).weight`. */
    const Array<double> &GetWeights() const;
 
+   /** @brief Return true if the rule is the tensor product of a 1D rule in
+       @a dim dimensions, with the points in lexicographic order. */
+   /** The 1D points are the x-coordinates of the first points of the rule.
+       This is the layout of the rules of IntRules on squares and cubes, which
+       is assumed by the tensor-product evaluations, see DofToQuad::TENSOR. */
+   bool IsTensorProduct(int dim) const;
+
+   /** @brief Return true if the rule has the same points and weights, in the
+       same order, as @a pts, e.g. a copy of another rule. */
+   bool SamePoints(const Array<IntegrationPoint> &pts) const;
+
    /// Destroys an IntegrationRule object
    ~IntegrationRule() { }
 };
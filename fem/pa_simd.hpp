@@ -0,0 +1,65 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PA_SIMD_HPP
+#define MFEM_PA_SIMD_HPP
+
+#include "../config/config.hpp"
+#include "../linalg/simd.hpp"
+#include "../linalg/vector.hpp"
+
+namespace mfem
+{
+
+/** @brief SIMD type used by the CPU partial assembly kernels vectorized across
+    elements, see BilinearFormIntegrator::AddMultPASIMD().
+
+    With MFEM_USE_SIMD this is the intrinsics-based AutoSIMD type of width
+    MFEM_SIMD_BYTES. Otherwise, the generic AutoSIMD with 4 lanes is used and
+    the vectorization of its operations is left to the compiler. */
+#ifdef MFEM_USE_SIMD
+typedef AutoSIMDTraits<double,double>::vreal_t pa_simd_t;
+#else
+typedef AutoSIMD<double,4,32> pa_simd_t;
+#endif
+
+/// Number of elements processed together by the SIMD partial assembly kernels.
+const int PA_SIMD_WIDTH = pa_simd_t::size;
+
+/** @brief Number of element blocks in the interleaved E-vector layout used by
+    the SIMD partial assembly kernels.
+
+    The standard E-vector of @a ne elements with @a nd dofs and @a vdim
+    components is ordered as [ne][vdim][nd] (the last index is the fastest).
+    The interleaved layout groups the elements in blocks of PA_SIMD_WIDTH and
+    stores the values of the elements of a block next to each other, i.e. it is
+    ordered as [nb][vdim][nd][PA_SIMD_WIDTH] where nb = PASIMDNumBlocks(ne).
+    The entries of the last block beyond @a ne are padding. */
+inline int PASIMDNumBlocks(const int ne)
+{ return (ne + PA_SIMD_WIDTH - 1) / PA_SIMD_WIDTH; }
+
+/// Size of an E-vector in the interleaved layout, see PASIMDNumBlocks().
+inline int PASIMDSize(const int ne, const int nd, const int vdim)
+{ return PASIMDNumBlocks(ne) * vdim * nd * PA_SIMD_WIDTH; }
+
+/** @brief Convert the standard E-vector @a x to the interleaved layout @a xi,
+    see PASIMDNumBlocks(). The padding entries of @a xi are set to zero. */
+void PASIMDInterleave(const int ne, const int nd, const int vdim,
+                      const Vector &x, Vector &xi);
+
+/** @brief Convert the E-vector @a xi in the interleaved layout to the standard
+    layout @a x, see PASIMDNumBlocks(). The padding entries are ignored. */
+void PASIMDDeinterleave(const int ne, const int nd, const int vdim,
+                        const Vector &xi, Vector &x);
+
+} // namespace mfem
+
+#endif // MFEM_PA_SIMD_HPP
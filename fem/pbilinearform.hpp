@@ -38,6 +38,9 @@ protected:
 
    bool keep_nbr_block;
 
+   /// Overlap communication and computation in the fused PA operator.
+   bool pa_overlap;
+
    // Allocate mat - called when (mat == NULL && fbfi.Size() > 0)
    void pAllocMat();
 
@@ -56,7 +59,7 @@ public:
    ParBilinearForm(ParFiniteElementSpace *pf)
       : BilinearForm(pf), pfes(pf),
         p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR)
-   { keep_nbr_block = false; }
+   { keep_nbr_block = false; pa_overlap = false; }
 
    /** @brief Create a ParBilinearForm on the ParFiniteElementSpace @a *pf,
        using the same integrators as the ParBilinearForm @a *bf.
@@ -68,7 +71,7 @@ public:
    ParBilinearForm(ParFiniteElementSpace *pf, ParBilinearForm *bf)
       : BilinearForm(pf, bf), pfes(pf),
         p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR)
-   { keep_nbr_block = false; }
+   { keep_nbr_block = false; pa_overlap = false; }
 
    /** When set to true and the ParBilinearForm has interior face integrators,
        the local SparseMatrix will include the rows (in addition to the columns)
@@ -76,6 +79,22 @@ public:
        those rows. Must be called before the first Assemble call. */
    void KeepNbrBlock(bool knb = true) { keep_nbr_block = knb; }
 
+   /** @brief Overlap the MPI exchange of the conforming prolongation with the
+       local computation in the operator returned by FormSystemMatrix() and
+       FormLinearSystem() with AssemblyLevel::PARTIAL. Disabled by default.
+
+       The action on the elements without external dofs is computed while the
+       halo exchanges of P and P^T are in progress, see PAOverlapOperator. The
+       overlap is used when all the domain integrators support subsets of the
+       elements, see BilinearFormIntegrator::SupportsPAElements(), there are no
+       face integrators and the SIMD and fused kernels are not used. The result
+       is bitwise identical with or without overlap. Must be called before
+       FormSystemMatrix() or FormLinearSystem(). */
+   void UsePAOverlap(bool use = true) { pa_overlap = use; }
+
+   /// Return true if the overlap is enabled, see UsePAOverlap().
+   bool UsesPAOverlap() const { return pa_overlap; }
+
    /** @brief Set the operator type id for the parallel matrix/operator when
        using AssemblyLevel::LEGACY. */
    /** If using static condensation or hybridization, call this method *after*
@@ -3132,6 +3132,13 @@ ConformingProlongationOperator::ConformingProlongationOperator(
 }
 
 void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
+{
+   MultBegin(x, y);
+   MultEnd(y);
+}
+
+void ConformingProlongationOperator::MultBegin(const Vector &x,
+                                               Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Width(), "");
    MFEM_ASSERT(y.Size() == Height(), "");
@@ -3158,16 +3165,36 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
       j = end+1;
    }
    std::copy(xdata+j-m, xdata+Width(), ydata+j);
+}
 
+void ConformingProlongationOperator::MultEnd(Vector &y) const
+{
    const int out_layout = 0; // 0 - output is ldofs array
    if (!local)
    {
-      gc.BcastEnd(ydata, out_layout);
+      gc.BcastEnd(y.HostReadWrite(), out_layout);
    }
 }
 
 void ConformingProlongationOperator::MultTranspose(
    const Vector &x, Vector &y) const
+{
+   MultTransposeBegin(x);
+   MultTransposeEnd(x, y);
+}
+
+void ConformingProlongationOperator::MultTransposeBegin(const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+
+   if (!local)
+   {
+      gc.ReduceBegin(x.HostRead());
+   }
+}
+
+void ConformingProlongationOperator::MultTransposeEnd(const Vector &x,
+                                                      Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Height(), "");
    MFEM_ASSERT(y.Size() == Width(), "");
@@ -3176,11 +3203,6 @@ void ConformingProlongationOperator::MultTranspose(
    double *ydata = y.HostWrite();
    const int m = external_ldofs.Size();
 
-   if (!local)
-   {
-      gc.ReduceBegin(xdata);
-   }
-
    int j = 0;
    for (int i = 0; i < m; i++)
    {
@@ -3200,7 +3222,8 @@ void ConformingProlongationOperator::MultTranspose(
 DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
    const GroupCommunicator &gc_, const SparseMatrix *R, bool local_)
    : ConformingProlongationOperator(R->Width(), gc_, local_),
-     mpi_gpu_aware(Device::GetGPUAwareMPI())
+     mpi_gpu_aware(Device::GetGPUAwareMPI()),
+     num_requests(0)
 {
    MFEM_ASSERT(R->Finalized(), "");
    const int tdofs = R->Height();
@@ -3324,6 +3347,13 @@ void DeviceConformingProlongationOperator::BcastEndCopy(
 
 void DeviceConformingProlongationOperator::Mult(const Vector &x,
                                                 Vector &y) const
+{
+   MultBegin(x, y);
+   MultEnd(y);
+}
+
+void DeviceConformingProlongationOperator::MultBegin(const Vector &x,
+                                                     Vector &y) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    int req_counter = 0;
@@ -3363,9 +3393,14 @@ void DeviceConformingProlongationOperator::Mult(const Vector &x,
       }
    }
    BcastLocalCopy(x, y);
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::MultEnd(Vector &y) const
+{
    if (!local)
    {
-      MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+      MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
       BcastEndCopy(y); // copy from 'ext_buf'
    }
 }
@@ -3426,6 +3461,13 @@ void DeviceConformingProlongationOperator::ReduceEndAssemble(Vector &y) const
 
 void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
                                                          Vector &y) const
+{
+   MultTransposeBegin(x);
+   MultTransposeEnd(x, y);
+}
+
+void DeviceConformingProlongationOperator::MultTransposeBegin(
+   const Vector &x) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    int req_counter = 0;
@@ -3454,10 +3496,16 @@ void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
          }
       }
    }
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::MultTransposeEnd(const Vector &x,
+                                                            Vector &y) const
+{
    ReduceLocalCopy(x, y);
    if (!local)
    {
-      MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+      MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
       ReduceEndAssemble(y); // assemble from 'shr_buf'
    }
 }
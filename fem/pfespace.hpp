@@ -427,9 +427,28 @@ public:
 
    const GroupCommunicator &GetGroupCommunicator() const;
 
+   /// Return the sorted list of ldofs owned by other ranks.
+   const Array<int> &GetExternalLDofs() const { return external_ldofs; }
+
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** @brief Start the computation of Mult(): post the exchange of the shared
+       dofs and set the entries of @a y that are not external ldofs, see
+       GetExternalLDofs(). The external ldofs are set by MultEnd(). */
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   /// Finish the computation started by MultBegin().
+   virtual void MultEnd(Vector &y) const;
+
+   /** @brief Start the computation of MultTranspose(): post the exchange of
+       the external ldofs of @a x. Only these entries of @a x must be final;
+       the other entries can be modified until MultTransposeEnd(). */
+   virtual void MultTransposeBegin(const Vector &x) const;
+
+   /// Finish the computation started by MultTransposeBegin().
+   virtual void MultTransposeEnd(const Vector &x, Vector &y) const;
 };
 
 /// Auxiliary device class used by ParFiniteElementSpace.
@@ -444,6 +463,7 @@ protected:
    Array<int> ltdof_ldof, unq_ltdof;
    Array<int> unq_shr_i, unq_shr_j;
    MPI_Request *requests;
+   mutable int num_requests; // requests posted by MultBegin, MultTransposeBegin
 
    // Kernel: copy ltdofs from 'src' to 'shr_buf' - prepare for send.
    //         shr_buf[i] = src[shr_ltdof[i]]
@@ -481,6 +501,14 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   virtual void MultEnd(Vector &y) const;
+
+   virtual void MultTransposeBegin(const Vector &x) const;
+
+   virtual void MultTransposeEnd(const Vector &x, Vector &y) const;
 };
 
 }
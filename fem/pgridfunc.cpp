@@ -203,9 +203,17 @@ HypreParVector *ParGridFunction::ParallelAssemble() const
 }
 
 void ParGridFunction::ExchangeFaceNbrData()
+{
+   ExchangeFaceNbrDataBegin();
+   ExchangeFaceNbrDataEnd();
+}
+
+void ParGridFunction::ExchangeFaceNbrDataBegin()
 {
    pfes->ExchangeFaceNbrData();
 
+   MFEM_VERIFY(face_nbr_requests.Size() == 0,
+               "ExchangeFaceNbrDataEnd() was not called");
    if (pfes->GetFaceNbrVSize() <= 0)
    {
       return;
@@ -223,10 +231,9 @@ void ParGridFunction::ExchangeFaceNbrData()
    MPI_Comm MyComm = pfes->GetComm();
 
    int num_face_nbrs = pmesh->GetNFaceNeighbors();
-   MPI_Request *requests = new MPI_Request[2*num_face_nbrs];
-   MPI_Request *send_requests = requests;
-   MPI_Request *recv_requests = requests + num_face_nbrs;
-   MPI_Status  *statuses = new MPI_Status[num_face_nbrs];
+   face_nbr_requests.SetSize(2*num_face_nbrs);
+   MPI_Request *send_requests = face_nbr_requests.GetData();
+   MPI_Request *recv_requests = send_requests + num_face_nbrs;
 
    auto d_data = this->Read();
    auto d_send_data = send_data.Write();
@@ -253,12 +260,18 @@ void ParGridFunction::ExchangeFaceNbrData()
                 recv_offset[fn+1] - recv_offset[fn],
                 MPI_DOUBLE, nbr_rank, tag, MyComm, &recv_requests[fn]);
    }
+}
 
-   MPI_Waitall(num_face_nbrs, send_requests, statuses);
-   MPI_Waitall(num_face_nbrs, recv_requests, statuses);
+void ParGridFunction::ExchangeFaceNbrDataEnd()
+{
+   if (face_nbr_requests.Size() == 0)
+   {
+      return;
+   }
 
-   delete [] statuses;
-   delete [] requests;
+   MPI_Waitall(face_nbr_requests.Size(), face_nbr_requests.GetData(),
+               MPI_STATUSES_IGNORE);
+   face_nbr_requests.SetSize(0);
 }
 
 double ParGridFunction::GetValue(int i, const IntegrationPoint &ip, int vdim)
@@ -1065,16 +1078,17 @@ double GlobalLpNorm(const double p, double loc_norm, MPI_Comm comm)
    return glob_norm;
 }
 
-void ParGridFunction::ComputeFlux(
-   BilinearFormIntegrator &blfi,
-   GridFunction &flux, bool wcoef, int subdomain)
+void ParGridFunction::AverageElementFluxes(const Vector &el_flux,
+                                           const Array<int> &offsets,
+                                           GridFunction &flux,
+                                           int subdomain) const
 {
    ParFiniteElementSpace *ffes =
       dynamic_cast<ParFiniteElementSpace*>(flux.FESpace());
    MFEM_VERIFY(ffes, "the flux FE space must be ParFiniteElementSpace");
 
    Array<int> count(flux.Size());
-   SumFluxAndCount(blfi, flux, count, wcoef, subdomain);
+   SumElementFluxes(el_flux, offsets, flux, count, subdomain);
 
    // Accumulate flux and counts in parallel
    ffes->GroupComm().Reduce<double>(flux, GroupCommunicator::Sum);
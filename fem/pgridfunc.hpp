@@ -43,6 +43,9 @@ protected:
    //TODO: Use temporary memory to avoid CUDA malloc allocation cost.
    Vector send_data;
 
+   /// Pending requests of ExchangeFaceNbrDataBegin().
+   Array<MPI_Request> face_nbr_requests;
+
    void ProjectBdrCoefficient(Coefficient *coeff[], VectorCoefficient *vcoeff,
                               Array<int> &attr);
 
@@ -200,6 +203,16 @@ public:
    HypreParVector *ParallelAssemble() const;
 
    void ExchangeFaceNbrData();
+
+   /** @brief Start the exchange of the face-neighbor data; the communication
+       is completed by ExchangeFaceNbrDataEnd(). */
+   /** The ParGridFunction must not be modified, and FaceNbrData() must not be
+       used, before ExchangeFaceNbrDataEnd() is called, so that the exchange
+       can overlap with local computations. */
+   void ExchangeFaceNbrDataBegin();
+
+   /// Wait for the exchange started by ExchangeFaceNbrDataBegin() to complete.
+   void ExchangeFaceNbrDataEnd();
    Vector &FaceNbrData() { return face_nbr_data; }
    const Vector &FaceNbrData() const { return face_nbr_data; }
 
@@ -400,9 +413,10 @@ public:
                              p, exsol, weight, v_weight, irs), pfes->GetComm());
    }
 
-   virtual void ComputeFlux(BilinearFormIntegrator &blfi,
-                            GridFunction &flux,
-                            bool wcoef = true, int subdomain = -1);
+   virtual void AverageElementFluxes(const Vector &el_flux,
+                                     const Array<int> &offsets,
+                                     GridFunction &flux,
+                                     int subdomain = -1) const;
 
    /** Save the local portion of the ParGridFunction. This differs from the
        serial GridFunction::Save in that it takes into account the signs of
@@ -0,0 +1,497 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "pointeval.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace mfem
+{
+
+BoxBuckets::BoxBuckets() : sdim(0)
+{
+   for (int d = 0; d < 3; d++)
+   {
+      grid_min[d] = 0.0;
+      grid_h[d] = 1.0;
+      grid_n[d] = 1;
+   }
+   boxes.MakeI(1);
+   boxes.MakeJ();
+   boxes.ShiftUpI();
+}
+
+void BoxBuckets::Build(const Vector &bbox, int nbox, int sdim_)
+{
+   sdim = sdim_;
+   const int bb_size = 2*sdim;
+   auto empty = [&](int i)
+   {
+      const double *bb = bbox.GetData() + bb_size*i;
+      for (int d = 0; d < sdim; d++)
+      {
+         if (!(bb[2*d] <= bb[2*d+1])) { return true; }
+      }
+      return false;
+   };
+
+   double gmax[3];
+   int nb = 0;
+   for (int d = 0; d < 3; d++)
+   {
+      grid_min[d] = std::numeric_limits<double>::infinity();
+      gmax[d] = -std::numeric_limits<double>::infinity();
+   }
+   for (int i = 0; i < nbox; i++)
+   {
+      if (empty(i)) { continue; }
+      const double *bb = bbox.GetData() + bb_size*i;
+      for (int d = 0; d < sdim; d++)
+      {
+         grid_min[d] = std::min(grid_min[d], bb[2*d]);
+         gmax[d] = std::max(gmax[d], bb[2*d+1]);
+      }
+      nb++;
+   }
+
+   // Choose the bucket size so that there is about one box per bucket
+   double vol = 1.0;
+   int nd = 0;
+   for (int d = 0; d < sdim; d++)
+   {
+      if (nb > 0 && gmax[d] > grid_min[d])
+      {
+         vol *= gmax[d] - grid_min[d];
+         nd++;
+      }
+   }
+   const double h = nd ? std::pow(vol/nb, 1.0/nd) : 1.0;
+   for (int d = 0; d < 3; d++)
+   {
+      const double len = (d < sdim && nb > 0) ? gmax[d] - grid_min[d] : 0.0;
+      if (len > 0.0)
+      {
+         grid_n[d] = std::max(1, std::min((int)std::ceil(len/h), nb));
+         grid_h[d] = len/grid_n[d];
+      }
+      else
+      {
+         if (d >= sdim || nb == 0) { grid_min[d] = 0.0; }
+         grid_n[d] = 1;
+         grid_h[d] = 1.0;
+      }
+   }
+
+   // List the boxes intersecting each bucket
+   int lo[3], hi[3];
+   auto bucket_range = [&](int i)
+   {
+      const double *bb = bbox.GetData() + bb_size*i;
+      for (int d = 0; d < 3; d++)
+      {
+         lo[d] = hi[d] = 0;
+         if (d >= sdim) { continue; }
+         lo[d] = (int)std::floor((bb[2*d] - grid_min[d])/grid_h[d]);
+         hi[d] = (int)std::floor((bb[2*d+1] - grid_min[d])/grid_h[d]);
+         lo[d] = std::max(0, std::min(lo[d], grid_n[d]-1));
+         hi[d] = std::max(0, std::min(hi[d], grid_n[d]-1));
+      }
+   };
+
+   boxes.Clear();
+   boxes.MakeI(grid_n[0]*grid_n[1]*grid_n[2]);
+   for (int i = 0; i < nbox; i++)
+   {
+      if (empty(i)) { continue; }
+      bucket_range(i);
+      for (int k = lo[2]; k <= hi[2]; k++)
+         for (int j = lo[1]; j <= hi[1]; j++)
+            for (int l = lo[0]; l <= hi[0]; l++)
+            {
+               boxes.AddAColumnInRow((k*grid_n[1] + j)*grid_n[0] + l);
+            }
+   }
+   boxes.MakeJ();
+   for (int i = 0; i < nbox; i++)
+   {
+      if (empty(i)) { continue; }
+      bucket_range(i);
+      for (int k = lo[2]; k <= hi[2]; k++)
+         for (int j = lo[1]; j <= hi[1]; j++)
+            for (int l = lo[0]; l <= hi[0]; l++)
+            {
+               boxes.AddConnection((k*grid_n[1] + j)*grid_n[0] + l, i);
+            }
+   }
+   boxes.ShiftUpI();
+}
+
+int BoxBuckets::FindBucket(const double *x) const
+{
+   int idx[3] = { 0, 0, 0 };
+   for (int d = 0; d < sdim; d++)
+   {
+      const double t = (x[d] - grid_min[d])/grid_h[d];
+      if (!(t >= 0.0 && t <= grid_n[d])) { return -1; }
+      idx[d] = std::min((int)t, grid_n[d]-1);
+   }
+   return (idx[2]*grid_n[1] + idx[1])*grid_n[0] + idx[0];
+}
+
+void PointEvaluator::GetPoint(const Vector &pos, int n, int ordering, int i,
+                              Vector &x)
+{
+   const int sdim = x.Size();
+   for (int d = 0; d < sdim; d++)
+   {
+      x(d) = (ordering == Ordering::byNODES) ? pos(d*n + i) : pos(i*sdim + d);
+   }
+}
+
+PointEvaluator::PointEvaluator()
+   : mesh(NULL), dim(0), sdim(0), npts(0), bb_tol(0.1), border_tol(1e-12),
+     default_interp_value(0.0),
+     init_guess_type(InverseElementTransformation::Center)
+{
+   // The default tolerances are close to the machine precision and Newton's
+   // method may not detect the convergence for points in curved elements
+   inv_tr.SetReferenceTol(1e-12);
+   inv_tr.SetPhysicalRelTol(1e-13);
+}
+
+PointEvaluator::PointEvaluator(Mesh &m, const double bb_t)
+   : PointEvaluator()
+{
+   Setup(m, bb_t);
+}
+
+void PointEvaluator::Setup(Mesh &m, const double bb_t)
+{
+   mesh = &m;
+   dim = mesh->Dimension();
+   sdim = mesh->SpaceDimension();
+   bb_tol = bb_t;
+   npts = 0;
+   elem.SetSize(0);
+   code.SetSize(0);
+   ips.SetSize(0);
+
+   // The center of a curved element is a poor initial guess for Newton's
+   // method, use the closest of a few nodes instead.
+   const GridFunction *nodes = mesh->GetNodes();
+   const bool curved = nodes && nodes->FESpace()->GetMaxElementOrder() > 1;
+   init_guess_type = curved ? InverseElementTransformation::ClosestPhysNode :
+                     InverseElementTransformation::Center;
+
+   // Build the face-neighbor table once, for MovePoints()
+   if (mesh->GetNE() > 0 && dim > 1) { mesh->ElementToElementTable(); }
+
+   BuildBuckets();
+}
+
+void PointEvaluator::BuildBuckets()
+{
+   const int NE = mesh->GetNE();
+   const int bb_size = 2*sdim;
+   elem_bbox.SetSize(bb_size*NE);
+
+   // Bounding boxes of the element nodes, enlarged by bb_tol times their
+   // largest side to cover curved faces
+   for (int e = 0; e < NE; e++)
+   {
+      mesh->GetElementTransformation(e, &T);
+      const DenseMatrix &pm = T.GetPointMat();
+      double *bb = elem_bbox.GetData() + bb_size*e;
+      double size = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         double lo = pm(d,0), hi = pm(d,0);
+         for (int j = 1; j < pm.Width(); j++)
+         {
+            lo = std::min(lo, pm(d,j));
+            hi = std::max(hi, pm(d,j));
+         }
+         bb[2*d] = lo;
+         bb[2*d+1] = hi;
+         size = std::max(size, hi - lo);
+      }
+      for (int d = 0; d < sdim; d++)
+      {
+         bb[2*d] -= bb_tol*size;
+         bb[2*d+1] += bb_tol*size;
+      }
+   }
+
+   grid.Build(elem_bbox, NE, sdim);
+}
+
+bool PointEvaluator::LocateInElement(const Vector &x, int e,
+                                     const IntegrationPoint *guess,
+                                     IntegrationPoint &ip, unsigned int &c)
+{
+   const double *bb = elem_bbox.GetData() + 2*sdim*e;
+   for (int d = 0; d < sdim; d++)
+   {
+      if (x(d) < bb[2*d] || x(d) > bb[2*d+1]) { return false; }
+   }
+
+   mesh->GetElementTransformation(e, &T);
+   inv_tr.SetTransformation(T);
+   IntegrationPoint ip0;
+   if (guess)
+   {
+      ip0 = *guess;
+      inv_tr.SetInitialGuess(ip0);
+   }
+   else
+   {
+      inv_tr.SetInitialGuessType(
+         (InverseElementTransformation::InitGuessType)init_guess_type);
+   }
+   if (inv_tr.Transform(x, ip) != InverseElementTransformation::Inside)
+   {
+      return false;
+   }
+   c = Geometry::CheckPoint(T.GetGeometryType(), ip, -border_tol) ?
+       Inside : Border;
+   return true;
+}
+
+int PointEvaluator::LocatePoint(const Vector &x, IntegrationPoint &ip,
+                                unsigned int &c)
+{
+   const int b = grid.FindBucket(x.GetData());
+   if (b < 0) { return -1; }
+   const int *els = grid.GetBoxes(b);
+   for (int k = 0; k < grid.NumBoxes(b); k++)
+   {
+      if (LocateInElement(x, els[k], NULL, ip, c)) { return els[k]; }
+   }
+   return -1;
+}
+
+int PointEvaluator::RelocatePoint(const Vector &x, int e0,
+                                  IntegrationPoint &ip, unsigned int &c)
+{
+   if (e0 >= 0)
+   {
+      if (LocateInElement(x, e0, &ip, ip, c)) { return e0; }
+      if (dim > 1)
+      {
+         const Table &el_to_el = mesh->ElementToElementTable();
+         const int *nbrs = el_to_el.GetRow(e0);
+         for (int k = 0; k < el_to_el.RowSize(e0); k++)
+         {
+            // Neighbors beyond the local elements are ghosts (ParNCMesh)
+            if (nbrs[k] >= mesh->GetNE()) { continue; }
+            if (LocateInElement(x, nbrs[k], NULL, ip, c)) { return nbrs[k]; }
+         }
+      }
+   }
+   return LocatePoint(x, ip, c);
+}
+
+void PointEvaluator::FindPoints(const Vector &point_pos, int point_ordering)
+{
+   MFEM_VERIFY(mesh, "Setup() must be called first");
+   MFEM_VERIFY(point_pos.Size() % sdim == 0, "invalid size of point_pos");
+   npts = point_pos.Size()/sdim;
+   elem.SetSize(npts);
+   code.SetSize(npts);
+   ips.SetSize(npts);
+
+   point_pos.HostRead();
+   Vector x(sdim);
+   for (int i = 0; i < npts; i++)
+   {
+      GetPoint(point_pos, npts, point_ordering, i, x);
+      elem[i] = LocatePoint(x, ips[i], code[i]);
+      if (elem[i] < 0)
+      {
+         code[i] = NotFound;
+         ips[i].Init(0);
+      }
+   }
+   GroupPoints(elem, elem_pts_offsets, elem_pts, elems_with_pts);
+}
+
+void PointEvaluator::MovePoints(const Vector &point_pos, int point_ordering)
+{
+   MFEM_VERIFY(mesh, "Setup() must be called first");
+   MFEM_VERIFY(point_pos.Size() == npts*sdim,
+               "the number of points has changed, use FindPoints()");
+
+   point_pos.HostRead();
+   Vector x(sdim);
+   for (int i = 0; i < npts; i++)
+   {
+      GetPoint(point_pos, npts, point_ordering, i, x);
+      elem[i] = RelocatePoint(x, elem[i], ips[i], code[i]);
+      if (elem[i] < 0)
+      {
+         code[i] = NotFound;
+         ips[i].Init(0);
+      }
+   }
+   GroupPoints(elem, elem_pts_offsets, elem_pts, elems_with_pts);
+}
+
+void PointEvaluator::GroupPoints(const Array<int> &elem_, Array<int> &offsets,
+                                 Array<int> &pts, Array<int> &elems) const
+{
+   const int NE = mesh->GetNE();
+   offsets.SetSize(NE+1);
+   offsets = 0;
+   for (int i = 0; i < elem_.Size(); i++)
+   {
+      if (elem_[i] >= 0) { offsets[elem_[i]+1]++; }
+   }
+   offsets.PartialSum();
+
+   pts.SetSize(offsets[NE]);
+   Array<int> next(NE);
+   for (int e = 0; e < NE; e++) { next[e] = offsets[e]; }
+   for (int i = 0; i < elem_.Size(); i++)
+   {
+      if (elem_[i] >= 0) { pts[next[elem_[i]]++] = i; }
+   }
+
+   // Order the elements by geometry, so that the same FiniteElement is used
+   // for consecutive elements
+   Array<Geometry::Type> geoms;
+   mesh->GetGeometries(dim, geoms);
+   elems.SetSize(0);
+   for (int g = 0; g < geoms.Size(); g++)
+   {
+      for (int e = 0; e < NE; e++)
+      {
+         if (offsets[e+1] > offsets[e] &&
+             (geoms.Size() == 1 || mesh->GetElementBaseGeometry(e) == geoms[g]))
+         {
+            elems.Append(e);
+         }
+      }
+   }
+}
+
+void PointEvaluator::InterpolateGrouped(const GridFunction &field_in,
+                                        const Array<int> &offsets,
+                                        const Array<int> &pts,
+                                        const Array<int> &elems,
+                                        const Array<IntegrationPoint> &ips_,
+                                        DenseMatrix &vals)
+{
+   const FiniteElementSpace *fes = field_in.FESpace();
+   MFEM_VERIFY(fes->GetMesh() == mesh,
+               "the GridFunction is not defined on the Setup() mesh");
+   const int vdim = fes->GetVDim();
+
+   field_in.HostRead();
+   Array<int> vdofs;
+   Vector el_dofs, col;
+   DenseMatrix shape, vshape, pt_vals;
+   for (int k = 0; k < elems.Size(); k++)
+   {
+      const int e = elems[k];
+      const int np = offsets[e+1] - offsets[e];
+      const int *p = pts.GetData() + offsets[e];
+      const FiniteElement *fe = fes->GetFE(e);
+      const int dof = fe->GetDof();
+      fes->GetElementVDofs(e, vdofs);
+      field_in.GetSubVector(vdofs, el_dofs);
+
+      const bool vector_fe = fe->GetRangeType() == FiniteElement::VECTOR;
+      const bool need_T = vector_fe || fe->GetMapType() != FiniteElement::VALUE;
+      if (need_T) { mesh->GetElementTransformation(e, &T); }
+
+      if (!vector_fe)
+      {
+         // Evaluate the basis at all points of the element, then all the
+         // components at once: pt_vals = shape^t el_dofs
+         shape.SetSize(dof, np);
+         for (int j = 0; j < np; j++)
+         {
+            const IntegrationPoint &ip = ips_[p[j]];
+            shape.GetColumnReference(j, col);
+            if (need_T)
+            {
+               T.SetIntPoint(&ip);
+               fe->CalcPhysShape(T, col);
+            }
+            else
+            {
+               fe->CalcShape(ip, col);
+            }
+         }
+         DenseMatrix el_mat(el_dofs.GetData(), dof, vdim);
+         pt_vals.SetSize(np, vdim);
+         MultAtB(shape, el_mat, pt_vals);
+         for (int j = 0; j < np; j++)
+         {
+            for (int c = 0; c < vdim; c++) { vals(c, p[j]) = pt_vals(j, c); }
+         }
+      }
+      else
+      {
+         vshape.SetSize(dof, sdim);
+         for (int j = 0; j < np; j++)
+         {
+            T.SetIntPoint(&ips_[p[j]]);
+            fe->CalcVShape(T, vshape);
+            vals.GetColumnReference(p[j], col);
+            vshape.MultTranspose(el_dofs, col);
+         }
+      }
+   }
+}
+
+void PointEvaluator::Interpolate(const GridFunction &field_in,
+                                 Vector &field_out)
+{
+   const int vd = field_in.VectorDim();
+   DenseMatrix vals(vd, npts);
+   vals = default_interp_value;
+   InterpolateGrouped(field_in, elem_pts_offsets, elem_pts, elems_with_pts,
+                      ips, vals);
+
+   field_out.SetSize(vd*npts);
+   double *out = field_out.HostWrite();
+   const bool by_nodes =
+      field_in.FESpace()->GetOrdering() == Ordering::byNODES;
+   for (int i = 0; i < npts; i++)
+   {
+      for (int c = 0; c < vd; c++)
+      {
+         out[by_nodes ? c*npts + i : i*vd + c] = vals(c, i);
+      }
+   }
+}
+
+void PointEvaluator::Interpolate(const Vector &point_pos,
+                                 const GridFunction &field_in,
+                                 Vector &field_out)
+{
+   FindPoints(point_pos);
+   Interpolate(field_in, field_out);
+}
+
+const Vector &PointEvaluator::GetReferencePosition() const
+{
+   ref_pos.SetSize(npts*dim);
+   for (int i = 0; i < npts; i++)
+   {
+      ips[i].Get(ref_pos.GetData() + i*dim, dim);
+   }
+   return ref_pos;
+}
+
+} // namespace mfem
@@ -0,0 +1,226 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_POINTEVAL
+#define MFEM_POINTEVAL
+
+#include "../config/config.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+/** @brief Uniform grid of buckets over a set of axis-aligned boxes, each bucket
+    listing the boxes that intersect it.
+
+    The bucket size is chosen so that there is about one box per bucket. Used
+    by PointEvaluator for the bounding boxes of the elements and by
+    ParPointEvaluator for those of the partitions. */
+class BoxBuckets
+{
+protected:
+   double grid_min[3], grid_h[3];
+   int grid_n[3], sdim;
+   Table boxes;
+
+public:
+   BoxBuckets();
+
+   /** @brief Build the grid over the @a nbox boxes in @a bbox, [min, max] per
+       each of the @a sdim_ space directions. Empty boxes, with min > max in
+       some direction, are not listed. */
+   void Build(const Vector &bbox, int nbox, int sdim_);
+
+   /// Return the bucket containing the point @a x, or -1 if @a x is outside
+   /// of the grid.
+   int FindBucket(const double *x) const;
+
+   /// Return the number of boxes intersecting the bucket @a b.
+   int NumBoxes(int b) const { return boxes.RowSize(b); }
+
+   /// Return the boxes intersecting the bucket @a b, in increasing order.
+   const int *GetBoxes(int b) const { return boxes.GetRow(b); }
+};
+
+/** @brief PointEvaluator evaluates GridFunction%s at an arbitrary collection of
+    points in physical space, without external libraries.
+
+    The evaluator works in three steps:
+
+    1. Setup - builds a uniform grid of buckets over the bounding box of the
+       Mesh, each bucket listing the elements whose (slightly enlarged)
+       bounding boxes intersect it.
+
+    2. FindPoints - locates the points: the candidate elements are taken from
+       the bucket containing each point and the reference coordinates are
+       computed with InverseElementTransformation. The resulting map from the
+       points to (element, reference coordinates) is cached. Points that have
+       moved can be relocated with MovePoints(), which first searches the
+       previous element of each point and its face neighbors, using the
+       previous reference coordinates as the initial guess.
+
+    3. Interpolate - evaluates a GridFunction at the located points. The points
+       are grouped by element, and the elements by geometry, so that the
+       element degrees of freedom are read once per element and the basis
+       functions are evaluated for all points of the element at once.
+
+    The map is reused by any number of calls to Interpolate(), with any
+    GridFunction defined on the Mesh given to Setup(). If the Mesh changes,
+    e.g. after refinement, Setup() must be called again. */
+class PointEvaluator
+{
+public:
+   /// Location codes returned by GetCode(), compatible with FindPointsGSLIB.
+   enum Code
+   {
+      Inside   = 0, ///< The point is inside an element
+      Border   = 1, ///< The point is on the boundary of an element
+      NotFound = 2  ///< The point was not found in the mesh
+   };
+
+protected:
+   Mesh *mesh;
+   int dim, sdim, npts;
+   double bb_tol, border_tol, default_interp_value;
+
+   // Bounding boxes of the elements, [min, max] per space direction.
+   Vector elem_bbox;
+   // Bucket grid listing the elements intersecting each bucket.
+   BoxBuckets grid;
+
+   // Location of the points.
+   Array<int> elem;
+   Array<unsigned int> code;
+   Array<IntegrationPoint> ips;
+   mutable Vector ref_pos;
+   // Points grouped by element (CSR), and the elements containing points,
+   // ordered by geometry.
+   Array<int> elem_pts_offsets, elem_pts, elems_with_pts;
+
+   IsoparametricTransformation T;
+   InverseElementTransformation inv_tr;
+   int init_guess_type;
+
+   /// Build the element bounding boxes and the bucket grid.
+   void BuildBuckets();
+
+   /// Try to locate the point @a x in element @a e. If @a guess is not NULL, it
+   /// is used as the initial guess of the inversion. On success, return true
+   /// and set @a ip and the code @a c.
+   bool LocateInElement(const Vector &x, int e, const IntegrationPoint *guess,
+                        IntegrationPoint &ip, unsigned int &c);
+
+   /// Locate the point @a x using the buckets; return the element or -1.
+   int LocatePoint(const Vector &x, IntegrationPoint &ip, unsigned int &c);
+
+   /// Locate the point @a x starting from the element @a e0 and its face
+   /// neighbors, with the reference point @a ip as the initial guess; fall
+   /// back to LocatePoint() if this fails. Return the element or -1.
+   int RelocatePoint(const Vector &x, int e0, IntegrationPoint &ip,
+                     unsigned int &c);
+
+   /// Copy the point @a i of the @a n points in @a pos, ordered by nodes or by
+   /// vdim according to @a ordering, to @a x.
+   static void GetPoint(const Vector &pos, int n, int ordering, int i,
+                        Vector &x);
+
+   /** @brief Group the points located in the elements @a elem_ by element:
+       the points in element e are pts[offsets[e]], ..., pts[offsets[e+1]-1].
+       The elements containing points are returned in @a elems, ordered by
+       geometry. Points with negative elements are skipped. */
+   void GroupPoints(const Array<int> &elem_, Array<int> &offsets,
+                    Array<int> &pts, Array<int> &elems) const;
+
+   /** @brief Evaluate @a field_in at the points with reference coordinates
+       @a ips_, grouped as returned by GroupPoints(). The values are written
+       to the columns of @a vals, which must have VectorDim() rows and one
+       column per point; columns of points not in @a pts are not changed. */
+   void InterpolateGrouped(const GridFunction &field_in,
+                           const Array<int> &offsets, const Array<int> &pts,
+                           const Array<int> &elems,
+                           const Array<IntegrationPoint> &ips_,
+                           DenseMatrix &vals);
+
+public:
+   PointEvaluator();
+
+   /// Construct the evaluator and call Setup().
+   PointEvaluator(Mesh &m, const double bb_t = 0.1);
+
+   virtual ~PointEvaluator() { }
+
+   /** @brief Build the search structures for the Mesh @a m.
+
+       @param[in] m     Input mesh. It may be curved, nonconforming, or have
+                        mixed element geometries.
+       @param[in] bb_t  (Optional) Relative size by which the bounding box of
+                        each element is enlarged. */
+   virtual void Setup(Mesh &m, const double bb_t = 0.1);
+
+   /** @brief Locate the positions given in physical space by @a point_pos and
+       cache the point-to-element map.
+
+       The positions are ordered by nodes (XXX...,YYY...,ZZZ...) by default,
+       or by vdim (XYZ,XYZ,...) if @a point_ordering is Ordering::byVDIM. */
+   virtual void FindPoints(const Vector &point_pos,
+                           int point_ordering = Ordering::byNODES);
+
+   /** @brief Relocate the points after they have moved to @a point_pos.
+
+       The number of points must be the same as in the last call to
+       FindPoints(). Each point is searched first in its previous element and
+       then in the face neighbors of that element, which is much faster than
+       FindPoints() when the displacements are small compared to the mesh
+       size. */
+   virtual void MovePoints(const Vector &point_pos,
+                           int point_ordering = Ordering::byNODES);
+
+   /** @brief Interpolate @a field_in at the located points.
+
+       @param[in] field_in    GridFunction on the Mesh given to Setup(). Scalar,
+                              vector (vdim > 1) and vector finite element
+                              spaces are supported.
+       @param[out] field_out  Interpolated values, ordered like the degrees of
+                              freedom of @a field_in: (XXX...,YYY...) for
+                              Ordering::byNODES and (XY,XY,...) for
+                              Ordering::byVDIM. For points that were not found
+                              the value is set to the default interpolation
+                              value. */
+   virtual void Interpolate(const GridFunction &field_in, Vector &field_out);
+
+   /// Locate the points given by @a point_pos and interpolate @a field_in.
+   void Interpolate(const Vector &point_pos, const GridFunction &field_in,
+                    Vector &field_out);
+
+   /// Set the value used for points that were not found in the mesh.
+   void SetDefaultInterpolationValue(double interp_value)
+   { default_interp_value = interp_value; }
+
+   /// Return the number of points given to the last FindPoints().
+   int GetNPoints() const { return npts; }
+
+   /// Return the code of each point: Inside, Border or NotFound.
+   virtual const Array<unsigned int> &GetCode() const { return code; }
+
+   /// Return the element containing each point, or -1 if it was not found.
+   virtual const Array<int> &GetElem() const { return elem; }
+
+   /// Return the reference coordinates of each point, ordered by vdim
+   /// (XYZ,XYZ,...). The coordinates of points that were not found are 0.
+   virtual const Vector &GetReferencePosition() const;
+
+   /// Return the reference coordinates of each point as IntegrationPoint%s.
+   const Array<IntegrationPoint> &GetIntegrationPoints() const { return ips; }
+};
+
+} // namespace mfem
+
+#endif
@@ -0,0 +1,434 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "ppointeval.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace mfem
+{
+
+ParPointEvaluator::ParPointEvaluator()
+   : PointEvaluator(), pmesh(NULL), comm(MPI_COMM_NULL), myid(0), nranks(1),
+     num_nbx(0)
+{ }
+
+ParPointEvaluator::ParPointEvaluator(ParMesh &m, const double bb_t)
+   : ParPointEvaluator()
+{
+   Setup(m, bb_t);
+}
+
+ParPointEvaluator::~ParPointEvaluator()
+{
+   int finalized;
+   MPI_Finalized(&finalized);
+   if (comm != MPI_COMM_NULL && !finalized) { MPI_Comm_free(&comm); }
+}
+
+void ParPointEvaluator::ExchangeItems(int unit, const Array<int> &send_offsets,
+                                      const Vector &send,
+                                      Array<int> &recv_offsets, Vector &recv,
+                                      bool recv_known)
+{
+   const int tag = 2479;
+   double *send_data = const_cast<double*>(send.HostRead());
+   std::vector<MPI_Request> requests;
+   if (!recv_known)
+   {
+      // A rank leaving the loop below may already send the messages of the
+      // next exchange, which must not be taken by the ranks still receiving
+      // the messages of this one
+      const int nbx_tag = tag + 1 + (num_nbx++ % 2);
+      for (int r = 0; r < nranks; r++)
+      {
+         const int cnt = send_offsets[r+1] - send_offsets[r];
+         if (cnt == 0) { continue; }
+         requests.push_back(MPI_REQUEST_NULL);
+         MPI_Issend(send_data + unit*send_offsets[r], unit*cnt, MPI_DOUBLE, r,
+                    nbx_tag, comm, &requests.back());
+      }
+
+      // Receive until all the synchronous sends have completed on all ranks,
+      // i.e. all the messages have been received
+      std::vector<int> msg_rank;
+      std::vector<std::vector<double>> msg;
+      MPI_Request barrier = MPI_REQUEST_NULL;
+      bool barrier_active = false;
+      while (true)
+      {
+         int flag;
+         MPI_Status status;
+         MPI_Iprobe(MPI_ANY_SOURCE, nbx_tag, comm, &flag, &status);
+         if (flag)
+         {
+            int cnt;
+            MPI_Get_count(&status, MPI_DOUBLE, &cnt);
+            msg_rank.push_back(status.MPI_SOURCE);
+            msg.emplace_back(cnt);
+            MPI_Recv(msg.back().data(), cnt, MPI_DOUBLE, status.MPI_SOURCE,
+                     nbx_tag, comm, MPI_STATUS_IGNORE);
+         }
+         if (barrier_active)
+         {
+            int done;
+            MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+            if (done) { break; }
+         }
+         else
+         {
+            int sent;
+            MPI_Testall((int)requests.size(), requests.data(), &sent,
+                        MPI_STATUSES_IGNORE);
+            if (sent)
+            {
+               MPI_Ibarrier(comm, &barrier);
+               barrier_active = true;
+            }
+         }
+      }
+
+      // Order the received items by source rank
+      recv_offsets.SetSize(nranks+1);
+      recv_offsets = 0;
+      for (size_t m = 0; m < msg.size(); m++)
+      {
+         recv_offsets[msg_rank[m]+1] = (int)msg[m].size()/unit;
+      }
+      recv_offsets.PartialSum();
+      recv.SetSize(unit*recv_offsets[nranks]);
+      double *recv_data = recv.HostWrite();
+      for (size_t m = 0; m < msg.size(); m++)
+      {
+         std::copy(msg[m].begin(), msg[m].end(),
+                   recv_data + unit*recv_offsets[msg_rank[m]]);
+      }
+      return;
+   }
+
+   recv.SetSize(unit*recv_offsets[nranks]);
+   double *recv_data = recv.HostWrite();
+   for (int r = 0; r < nranks; r++)
+   {
+      const int cnt = recv_offsets[r+1] - recv_offsets[r];
+      if (cnt == 0) { continue; }
+      requests.push_back(MPI_REQUEST_NULL);
+      MPI_Irecv(recv_data + unit*recv_offsets[r], unit*cnt, MPI_DOUBLE, r, tag,
+                comm, &requests.back());
+   }
+   for (int r = 0; r < nranks; r++)
+   {
+      const int cnt = send_offsets[r+1] - send_offsets[r];
+      if (cnt == 0) { continue; }
+      requests.push_back(MPI_REQUEST_NULL);
+      MPI_Isend(send_data + unit*send_offsets[r], unit*cnt, MPI_DOUBLE, r, tag,
+                comm, &requests.back());
+   }
+   MPI_Waitall((int)requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+void ParPointEvaluator::Setup(Mesh &m, const double bb_t)
+{
+   pmesh = dynamic_cast<ParMesh*>(&m);
+   MFEM_VERIFY(pmesh, "ParPointEvaluator requires a ParMesh");
+   if (comm != MPI_COMM_NULL) { MPI_Comm_free(&comm); }
+   MPI_Comm_dup(pmesh->GetComm(), &comm);
+   num_nbx = 0;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &nranks);
+
+   PointEvaluator::Setup(m, bb_t);
+   proc.SetSize(0);
+   eval_offsets.SetSize(nranks+1);
+   eval_offsets = 0;
+   eval_pts.SetSize(0);
+   req_offsets = eval_offsets;
+   req_elem.SetSize(0);
+   req_ips.SetSize(0);
+   GroupPoints(req_elem, req_grp_offsets, req_grp_pts, req_grp_elems);
+
+   // The bounding box of the partition is that of the local elements; empty
+   // partitions have an empty box
+   const int bb_size = 2*sdim;
+   Vector my_bbox(bb_size);
+   for (int d = 0; d < sdim; d++)
+   {
+      my_bbox(2*d) = std::numeric_limits<double>::infinity();
+      my_bbox(2*d+1) = -std::numeric_limits<double>::infinity();
+   }
+   for (int e = 0; e < mesh->GetNE(); e++)
+   {
+      const double *bb = elem_bbox.GetData() + bb_size*e;
+      for (int d = 0; d < sdim; d++)
+      {
+         my_bbox(2*d) = std::min(my_bbox(2*d), bb[2*d]);
+         my_bbox(2*d+1) = std::max(my_bbox(2*d+1), bb[2*d+1]);
+      }
+   }
+   rank_bbox.SetSize(bb_size*nranks);
+   MPI_Allgather(my_bbox.GetData(), bb_size, MPI_DOUBLE,
+                 rank_bbox.GetData(), bb_size, MPI_DOUBLE, comm);
+   rank_grid.Build(rank_bbox, nranks, sdim);
+}
+
+void ParPointEvaluator::LocateGlobal(const Vector &point_pos,
+                                     int point_ordering, const Array<int> &pts)
+{
+   const int bb_size = 2*sdim;
+   Vector x(sdim);
+   auto in_rank_bbox = [&](int r)
+   {
+      const double *bb = rank_bbox.GetData() + bb_size*r;
+      for (int d = 0; d < sdim; d++)
+      {
+         if (x(d) < bb[2*d] || x(d) > bb[2*d+1]) { return false; }
+      }
+      return true;
+   };
+
+   // 1. Send each point to the ranks whose partition bounding box contains
+   // it, among those listed in its bucket
+   Array<int> send_offsets(nranks+1);
+   send_offsets = 0;
+   for (int k = 0; k < pts.Size(); k++)
+   {
+      GetPoint(point_pos, npts, point_ordering, pts[k], x);
+      const int b = rank_grid.FindBucket(x.GetData());
+      if (b < 0) { continue; }
+      const int *ranks = rank_grid.GetBoxes(b);
+      for (int j = 0; j < rank_grid.NumBoxes(b); j++)
+      {
+         if (in_rank_bbox(ranks[j])) { send_offsets[ranks[j]+1]++; }
+      }
+   }
+   send_offsets.PartialSum();
+   Array<int> send_pt(send_offsets[nranks]), next(nranks);
+   Vector send(sdim*send_offsets[nranks]);
+   for (int r = 0; r < nranks; r++) { next[r] = send_offsets[r]; }
+   for (int k = 0; k < pts.Size(); k++)
+   {
+      GetPoint(point_pos, npts, point_ordering, pts[k], x);
+      const int b = rank_grid.FindBucket(x.GetData());
+      if (b < 0) { continue; }
+      const int *ranks = rank_grid.GetBoxes(b);
+      for (int j = 0; j < rank_grid.NumBoxes(b); j++)
+      {
+         const int r = ranks[j];
+         if (!in_rank_bbox(r)) { continue; }
+         const int s = next[r]++;
+         send_pt[s] = pts[k];
+         for (int d = 0; d < sdim; d++) { send(sdim*s + d) = x(d); }
+      }
+   }
+   Array<int> recv_offsets;
+   Vector recv;
+   ExchangeItems(sdim, send_offsets, send, recv_offsets, recv, false);
+
+   // 2. Locate the received points in the local elements and reply with the
+   // code, the element and the reference coordinates of each point
+   const int nrecv = recv_offsets[nranks], ru = 2 + dim;
+   Vector reply(ru*nrecv);
+   for (int j = 0; j < nrecv; j++)
+   {
+      for (int d = 0; d < sdim; d++) { x(d) = recv(sdim*j + d); }
+      IntegrationPoint ip;
+      ip.Init(0);
+      unsigned int c;
+      const int e = LocatePoint(x, ip, c);
+      reply(ru*j) = (e >= 0) ? c : NotFound;
+      reply(ru*j + 1) = e;
+      ip.Get(reply.GetData() + ru*j + 2, dim);
+   }
+   Vector answers;
+   ExchangeItems(ru, recv_offsets, reply, send_offsets, answers, true);
+
+   // 3. Select the owner of each point: the rank with the lowest code, and
+   // then with the lowest rank
+   for (int k = 0; k < pts.Size(); k++)
+   {
+      const int i = pts[k];
+      code[i] = NotFound;
+      elem[i] = -1;
+      proc[i] = myid;
+      ips[i].Init(0);
+   }
+   for (int r = 0; r < nranks; r++)
+   {
+      for (int s = send_offsets[r]; s < send_offsets[r+1]; s++)
+      {
+         const int i = send_pt[s];
+         const unsigned int c = (unsigned int)answers(ru*s);
+         if (c >= code[i]) { continue; }
+         code[i] = c;
+         elem[i] = (int)answers(ru*s + 1);
+         proc[i] = r;
+         ips[i].Set(answers.GetData() + ru*s + 2, dim);
+      }
+   }
+}
+
+void ParPointEvaluator::SetupEvaluation()
+{
+   eval_offsets.SetSize(nranks+1);
+   eval_offsets = 0;
+   for (int i = 0; i < npts; i++)
+   {
+      if (code[i] != NotFound) { eval_offsets[proc[i]+1]++; }
+   }
+   eval_offsets.PartialSum();
+   eval_pts.SetSize(eval_offsets[nranks]);
+   Array<int> next(nranks);
+   for (int r = 0; r < nranks; r++) { next[r] = eval_offsets[r]; }
+   for (int i = 0; i < npts; i++)
+   {
+      if (code[i] != NotFound) { eval_pts[next[proc[i]]++] = i; }
+   }
+
+   // Send the elements and reference coordinates to the owners
+   const int ru = 1 + dim;
+   Vector send(ru*eval_pts.Size()), recv;
+   for (int s = 0; s < eval_pts.Size(); s++)
+   {
+      const int i = eval_pts[s];
+      send(ru*s) = elem[i];
+      ips[i].Get(send.GetData() + ru*s + 1, dim);
+   }
+   ExchangeItems(ru, eval_offsets, send, req_offsets, recv, false);
+
+   const int nreq = req_offsets[nranks];
+   req_elem.SetSize(nreq);
+   req_ips.SetSize(nreq);
+   for (int j = 0; j < nreq; j++)
+   {
+      req_elem[j] = (int)recv(ru*j);
+      req_ips[j].Init(0);
+      req_ips[j].Set(recv.GetData() + ru*j + 1, dim);
+   }
+   GroupPoints(req_elem, req_grp_offsets, req_grp_pts, req_grp_elems);
+}
+
+void ParPointEvaluator::FindPoints(const Vector &point_pos, int point_ordering)
+{
+   MFEM_VERIFY(pmesh, "Setup() must be called first");
+   MFEM_VERIFY(point_pos.Size() % sdim == 0, "invalid size of point_pos");
+   npts = point_pos.Size()/sdim;
+   elem.SetSize(npts);
+   code.SetSize(npts);
+   ips.SetSize(npts);
+   proc.SetSize(npts);
+
+   point_pos.HostRead();
+   Array<int> all(npts);
+   for (int i = 0; i < npts; i++) { all[i] = i; }
+   LocateGlobal(point_pos, point_ordering, all);
+   SetupEvaluation();
+}
+
+void ParPointEvaluator::MovePoints(const Vector &point_pos, int point_ordering)
+{
+   MFEM_VERIFY(pmesh, "Setup() must be called first");
+   MFEM_VERIFY(point_pos.Size() == npts*sdim,
+               "the number of points has changed, use FindPoints()");
+   point_pos.HostRead();
+
+   // 1. Send the new positions to the previous owners
+   Vector x(sdim), send(sdim*eval_pts.Size()), recv;
+   for (int s = 0; s < eval_pts.Size(); s++)
+   {
+      GetPoint(point_pos, npts, point_ordering, eval_pts[s], x);
+      for (int d = 0; d < sdim; d++) { send(sdim*s + d) = x(d); }
+   }
+   ExchangeItems(sdim, eval_offsets, send, req_offsets, recv, true);
+
+   // 2. The owners search the previous elements and their neighbors, and keep
+   // the new locations of the points that remain in their partition
+   const int nreq = req_offsets[nranks], ru = 2 + dim;
+   Vector reply(ru*nreq);
+   for (int j = 0; j < nreq; j++)
+   {
+      for (int d = 0; d < sdim; d++) { x(d) = recv(sdim*j + d); }
+      unsigned int c;
+      req_elem[j] = RelocatePoint(x, req_elem[j], req_ips[j], c);
+      if (req_elem[j] < 0) { c = NotFound; }
+      reply(ru*j) = c;
+      reply(ru*j + 1) = req_elem[j];
+      req_ips[j].Get(reply.GetData() + ru*j + 2, dim);
+   }
+   Vector answers;
+   ExchangeItems(ru, req_offsets, reply, eval_offsets, answers, true);
+
+   Array<bool> found(npts);
+   found = false;
+   for (int s = 0; s < eval_pts.Size(); s++)
+   {
+      const int i = eval_pts[s];
+      code[i] = (unsigned int)answers(ru*s);
+      if (code[i] == NotFound) { continue; }
+      found[i] = true;
+      elem[i] = (int)answers(ru*s + 1);
+      ips[i].Set(answers.GetData() + ru*s + 2, dim);
+   }
+
+   // 3. Route the points that have left the partition of their owner, and
+   // the points that were not found before, if there are any on any rank
+   Array<int> lost;
+   for (int i = 0; i < npts; i++)
+   {
+      if (!found[i]) { lost.Append(i); }
+   }
+   int loc_lost = lost.Size(), glob_lost;
+   MPI_Allreduce(&loc_lost, &glob_lost, 1, MPI_INT, MPI_SUM, comm);
+   if (glob_lost == 0)
+   {
+      GroupPoints(req_elem, req_grp_offsets, req_grp_pts, req_grp_elems);
+      return;
+   }
+   LocateGlobal(point_pos, point_ordering, lost);
+   SetupEvaluation();
+}
+
+void ParPointEvaluator::Interpolate(const GridFunction &field_in,
+                                    Vector &field_out)
+{
+   // The owners evaluate the requested points and send back the values
+   const int vd = field_in.VectorDim();
+   const int nreq = req_offsets[nranks];
+   DenseMatrix req_vals(vd, nreq);
+   req_vals = default_interp_value;
+   InterpolateGrouped(field_in, req_grp_offsets, req_grp_pts, req_grp_elems,
+                      req_ips, req_vals);
+   Vector send(req_vals.GetData(), vd*nreq), recv;
+   ExchangeItems(vd, req_offsets, send, eval_offsets, recv, true);
+
+   field_out.SetSize(vd*npts);
+   field_out = default_interp_value;
+   double *out = field_out.HostReadWrite();
+   const bool by_nodes =
+      field_in.FESpace()->GetOrdering() == Ordering::byNODES;
+   for (int s = 0; s < eval_pts.Size(); s++)
+   {
+      const int i = eval_pts[s];
+      for (int c = 0; c < vd; c++)
+      {
+         out[by_nodes ? c*npts + i : i*vd + c] = recv(vd*s + c);
+      }
+   }
+}
+
+} // namespace mfem
+
+#endif // MFEM_USE_MPI
@@ -0,0 +1,144 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PPOINTEVAL
+#define MFEM_PPOINTEVAL
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "../mesh/pmesh.hpp"
+#include "pointeval.hpp"
+
+namespace mfem
+{
+
+/** @brief Parallel version of PointEvaluator: evaluates GridFunction%s on a
+    ParMesh at points given on any rank.
+
+    Each rank gives its own points, which may lie in the partition of any
+    rank. Setup() gathers the bounding boxes of the partitions of all ranks
+    and builds a bucket grid over them, as PointEvaluator does for the
+    elements. FindPoints() sends each point to the ranks whose bounding box
+    contains it, locates it there with the local search of PointEvaluator, and
+    returns the result to the requesting rank, which selects the owner of the
+    point. The messages are exchanged only between ranks that have points to
+    send: when the receivers do not know the message sizes, they are sent with
+    synchronous sends and received as they arrive, until a nonblocking barrier
+    shows that all of them have been received (NBX, nonblocking consensus).
+
+    The owners keep the reference coordinates of the points they evaluate, so
+    Interpolate() only sends back the interpolated values. MovePoints() first
+    sends the new positions to the previous owners, which search the previous
+    elements and their neighbors; only the points that have left the partition
+    of their owner are routed again.
+
+    Since the points are located independently on each rank, the evaluator
+    can also be used to interpolate between independently partitioned meshes
+    on the same communicator. */
+class ParPointEvaluator : public PointEvaluator
+{
+protected:
+   ParMesh *pmesh;
+   // Duplicate of the communicator of the mesh, so that the messages of
+   // different evaluators cannot be mixed.
+   MPI_Comm comm;
+   int myid, nranks;
+   // Number of exchanges with unknown message sizes, their tag alternates.
+   int num_nbx;
+
+   // Bounding boxes of the partitions of all ranks, [min, max] per space
+   // direction, and the bucket grid listing the ranks intersecting each
+   // bucket.
+   Vector rank_bbox;
+   BoxBuckets rank_grid;
+
+   // Rank owning each local point.
+   Array<unsigned int> proc;
+
+   // Requester side: the local points evaluated by each rank, ordered by
+   // owner rank (CSR).
+   Array<int> eval_offsets, eval_pts;
+
+   // Owner side: the elements and reference coordinates of the points
+   // evaluated for other ranks, ordered by requesting rank (CSR), and their
+   // grouping by element.
+   Array<int> req_offsets, req_elem;
+   Array<IntegrationPoint> req_ips;
+   Array<int> req_grp_offsets, req_grp_pts, req_grp_elems;
+
+   /** @brief Send the items of @a send, @a unit doubles each, partitioned by
+       destination rank with @a send_offsets. On return, @a recv contains the
+       received items, partitioned by source rank with @a recv_offsets.
+
+       If @a recv_known is true, @a recv_offsets is an input, e.g. the
+       @a send_offsets of a previous exchange in the opposite direction.
+       Otherwise the messages are received as they arrive (NBX). */
+   void ExchangeItems(int unit, const Array<int> &send_offsets,
+                      const Vector &send, Array<int> &recv_offsets,
+                      Vector &recv, bool recv_known);
+
+   /// Locate the local points @a pts in the partitions of all ranks, setting
+   /// their owner, element, reference coordinates and code.
+   void LocateGlobal(const Vector &point_pos, int point_ordering,
+                     const Array<int> &pts);
+
+   /// Send the elements and reference coordinates of the located points to
+   /// their owners, and set up the communication of Interpolate().
+   void SetupEvaluation();
+
+public:
+   ParPointEvaluator();
+
+   /// Construct the evaluator and call Setup().
+   ParPointEvaluator(ParMesh &m, const double bb_t = 0.1);
+
+   ParPointEvaluator(const ParPointEvaluator &) = delete;
+   ParPointEvaluator &operator=(const ParPointEvaluator &) = delete;
+
+   virtual ~ParPointEvaluator();
+
+   /** @brief Build the local search structures and gather the bounding boxes
+       of the partitions. This is a collective call on the communicator of
+       @a m, which must be a ParMesh. */
+   virtual void Setup(Mesh &m, const double bb_t = 0.1);
+
+   /** @brief Locate the local points @a point_pos on all ranks. Collective.
+
+       See PointEvaluator::FindPoints(). After the call, GetProc() returns the
+       rank owning each point and GetElem() the local element number on that
+       rank. */
+   virtual void FindPoints(const Vector &point_pos,
+                           int point_ordering = Ordering::byNODES);
+
+   /// Relocate the local points after they have moved. Collective.
+   virtual void MovePoints(const Vector &point_pos,
+                           int point_ordering = Ordering::byNODES);
+
+   /** @brief Interpolate @a field_in at the local points. Collective.
+
+       @a field_in must be defined on the ParMesh given to Setup(), e.g. a
+       ParGridFunction. The output is as in PointEvaluator::Interpolate(). */
+   virtual void Interpolate(const GridFunction &field_in, Vector &field_out);
+
+   using PointEvaluator::Interpolate;
+
+   /// Return the rank on which each point was found. Points that were not
+   /// found have the rank of the caller.
+   virtual const Array<unsigned int> &GetProc() const { return proc; }
+};
+
+} // namespace mfem
+
+#endif // MFEM_USE_MPI
+
+#endif
@@ -12,6 +12,7 @@
 #include "restriction.hpp"
 #include "gridfunc.hpp"
 #include "fespace.hpp"
+#include "pa_simd.hpp"
 #include "../general/forall.hpp"
 
 namespace mfem
@@ -168,6 +169,63 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultElements(const Array<int> &elems,
+                                      const Vector& x, Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.ReadWrite(), nd, vd, ne);
+   auto d_gatherMap = gatherMap.Read();
+   auto d_elems = elems.Read();
+   MFEM_FORALL(i, nd*elems.Size(),
+   {
+      const int e = d_elems[i / nd];
+      const int gid = d_gatherMap[e*nd + i % nd];
+      const bool plus = gid >= 0;
+      const int j = plus ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:j, t?j:c);
+         d_y(i % nd, c, e) = plus ? dofValue : -dofValue;
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeDofs(const Array<int> &dofs,
+                                           const Vector& x, Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_dofs = dofs.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, ne);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(k, dofs.Size(),
+   {
+      const int i = d_dofs[k];
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const bool plus = d_indices[j] >= 0;
+            const int idx_j = plus ? d_indices[j] : -1 - d_indices[j];
+            const double value = d_x(idx_j % nd, c, idx_j / nd);
+            dofValue += plus ? value : -value;
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
 void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -195,6 +253,76 @@ void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultInterleaved(const Vector& x, Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int NE = ne;
+   const int W = PA_SIMD_WIDTH;
+   const int nb = PASIMDNumBlocks(ne);
+   MFEM_VERIFY(y.Size() == PASIMDSize(ne, nd, vd), "invalid E-vector size");
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.Write(), W, nd, vd, nb);
+   auto d_gatherMap = gatherMap.Read();
+   MFEM_FORALL(i, W*nd*nb,
+   {
+      const int l = i % W;
+      const int d = (i / W) % nd;
+      const int b = i / (W*nd);
+      const int e = b*W + l;
+      if (e < NE)
+      {
+         const int gid = d_gatherMap[e*nd + d];
+         const bool plus = gid >= 0;
+         const int j = plus ? gid : -1-gid;
+         for (int c = 0; c < vd; ++c)
+         {
+            const double dofValue = d_x(t?c:j, t?j:c);
+            d_y(l, d, c, b) = plus ? dofValue : -dofValue;
+         }
+      }
+      else
+      {
+         for (int c = 0; c < vd; ++c) { d_y(l, d, c, b) = 0.0; }
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeInterleaved(const Vector& x,
+                                                  Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int W = PA_SIMD_WIDTH;
+   const int nb = PASIMDNumBlocks(ne);
+   MFEM_VERIFY(x.Size() == PASIMDSize(ne, nd, vd), "invalid E-vector size");
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_x = Reshape(x.Read(), W, nd, vd, nb);
+   auto d_y = Reshape(y.Write(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            const int e = idx_j / nd;
+            const double value = d_x(e % W, idx_j % nd, c, e / W);
+            dofValue += (d_indices[j] >= 0) ? value : -value;
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
 void ElementRestriction::MultLeftInverse(const Vector& x, Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -220,6 +348,54 @@ void ElementRestriction::MultLeftInverse(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::GetElementColoring(const Array<int> &elems,
+                                            Table &colors) const
+{
+   const int *d_offsets = offsets.HostRead();
+   const int *d_indices = indices.HostRead();
+   const int *d_gatherMap = gatherMap.HostRead();
+   const int n = elems.Size();
+   Array<int> color(ne), elem_color(n), mark;
+   color = -1;
+   int num_colors = 0;
+   for (int k = 0; k < n; ++k)
+   {
+      const int e = elems[k];
+      // Mark the colors of the elements already colored sharing a dof with e
+      for (int d = 0; d < dof; ++d)
+      {
+         const int sgid = d_gatherMap[dof*e + d];
+         const int gid = (sgid >= 0) ? sgid : -1-sgid;
+         for (int j = d_offsets[gid]; j < d_offsets[gid + 1]; ++j)
+         {
+            const int lid = (d_indices[j] >= 0) ? d_indices[j] : -1-d_indices[j];
+            const int nbr_color = color[lid / dof];
+            if (nbr_color >= 0) { mark[nbr_color] = k; }
+         }
+      }
+      int c = 0;
+      while (c < num_colors && mark[c] == k) { c++; }
+      if (c == num_colors) { mark.Append(-1); num_colors++; }
+      color[e] = elem_color[k] = c;
+   }
+
+   colors.Clear();
+   colors.MakeI(num_colors);
+   for (int k = 0; k < n; ++k) { colors.AddAColumnInRow(elem_color[k]); }
+   colors.MakeJ();
+   for (int k = 0; k < n; ++k) { colors.AddConnection(elem_color[k], elems[k]); }
+   colors.ShiftUpI();
+}
+
+const Table &ElementRestriction::GetElementColoring() const
+{
+   if (el_coloring.Size() > 0 || ne == 0) { return el_coloring; }
+   Array<int> elems(ne);
+   for (int e = 0; e < ne; ++e) { elems[e] = e; }
+   GetElementColoring(elems, el_coloring);
+   return el_coloring;
+}
+
 void ElementRestriction::BooleanMask(Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -520,6 +696,54 @@ void L2ElementRestriction::MultTranspose(const Vector &x, Vector &y) const
    });
 }
 
+void L2ElementRestriction::MultInterleaved(const Vector &x, Vector &y) const
+{
+   const int nd = ndof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int NE = ne;
+   const int W = PA_SIMD_WIDTH;
+   const int nb = PASIMDNumBlocks(ne);
+   MFEM_VERIFY(y.Size() == PASIMDSize(ne, nd, vd), "invalid E-vector size");
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.Write(), W, nd, vd, nb);
+   MFEM_FORALL(i, W*nd*nb,
+   {
+      const int l = i % W;
+      const int dof = (i / W) % nd;
+      const int b = i / (W*nd);
+      const int e = b*W + l;
+      const int idx = e*nd + dof;
+      for (int c = 0; c < vd; ++c)
+      {
+         d_y(l, dof, c, b) = (e < NE) ? d_x(t?c:idx, t?idx:c) : 0.0;
+      }
+   });
+}
+
+void L2ElementRestriction::MultTransposeInterleaved(const Vector &x,
+                                                    Vector &y) const
+{
+   const int nd = ndof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int W = PA_SIMD_WIDTH;
+   const int nb = PASIMDNumBlocks(ne);
+   MFEM_VERIFY(x.Size() == PASIMDSize(ne, nd, vd), "invalid E-vector size");
+   auto d_x = Reshape(x.Read(), W, nd, vd, nb);
+   auto d_y = Reshape(y.Write(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int idx = i;
+      const int dof = idx % nd;
+      const int e = idx / nd;
+      for (int c = 0; c < vd; ++c)
+      {
+         d_y(t?c:idx,t?idx:c) = d_x(e % W, dof, c, e / W);
+      }
+   });
+}
+
 void L2ElementRestriction::FillI(SparseMatrix &mat) const
 {
    const int elem_dofs = ndof;
@@ -46,6 +46,7 @@ protected:
    Array<int> offsets;
    Array<int> indices;
    Array<int> gatherMap;
+   mutable Table el_coloring; // built on demand, see GetElementColoring()
 
 public:
    ElementRestriction(const FiniteElementSpace&, ElementDofOrdering);
@@ -57,10 +58,51 @@ public:
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
 
+   /** @brief Compute Mult only for the elements listed in @a elems: the
+       entries of the other elements of the E-vector @a y are not modified. */
+   void MultElements(const Array<int> &elems, const Vector &x,
+                     Vector &y) const;
+   /** @brief Compute MultTranspose only for the (scalar) dofs listed in
+       @a dofs: the other entries of the L-vector @a y are not modified. The
+       entries are computed in the same way as in MultTranspose(). */
+   void MultTransposeDofs(const Array<int> &dofs, const Vector &x,
+                          Vector &y) const;
+
    /// Compute MultTranspose by setting (rather than adding) element
    /// contributions; this is a left inverse of the Mult() operation
    void MultLeftInverse(const Vector &x, Vector &y) const;
 
+   /** @brief Compute Mult writing the E-vector @a y in the interleaved layout
+       used by the SIMD partial assembly kernels, see PASIMDNumBlocks().
+
+       The size of @a y must be PASIMDSize(ne, dof, vdim); its padding entries
+       are set to zero. */
+   void MultInterleaved(const Vector &x, Vector &y) const;
+   /// Compute MultTranspose reading the E-vector @a x in the interleaved
+   /// layout, see MultInterleaved(). The padding entries of @a x are ignored.
+   void MultTransposeInterleaved(const Vector &x, Vector &y) const;
+
+   /** @brief Return the signed map from E-vector to L-vector (scalar) dofs:
+       entry i = e*dof + d is the index j of the L-vector dof of the local dof d
+       of element e, encoded as -1-j if the dof has a negative orientation. */
+   const Array<int> &GatherMap() const { return gatherMap; }
+
+   /** @brief Return a coloring of the elements such that no two elements of
+       the same color share a dof: row c of the Table lists the elements of
+       color c, in increasing order.
+
+       The coloring is computed on the host with a greedy algorithm in element
+       order on the first call, so it is deterministic. It allows to scatter-add
+       element contributions to an L-vector without atomics and with a result
+       independent of the number of threads. */
+   const Table &GetElementColoring() const;
+
+   /** @brief Compute a coloring of the elements listed in @a elems, in the
+       same way as GetElementColoring(): the elements are colored greedily in
+       the order of @a elems, and row c of @a colors lists the elements of
+       color c in that order. */
+   void GetElementColoring(const Array<int> &elems, Table &colors) const;
+
    /// @brief Fills the E-vector y with `boolean` values 0.0 and 1.0 such that each
    /// each entry of the L-vector is uniquely represented in `y`.
    /** This means, the sum of the E-vector `y` is equal to the sum of the
@@ -96,6 +138,12 @@ public:
    L2ElementRestriction(const FiniteElementSpace&);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+   /// Compute Mult writing the E-vector @a y in the interleaved layout used by
+   /// the SIMD PA kernels, see ElementRestriction::MultInterleaved().
+   void MultInterleaved(const Vector &x, Vector &y) const;
+   /// Compute MultTranspose reading the E-vector @a x in the interleaved
+   /// layout, see ElementRestriction::MultTransposeInterleaved().
+   void MultTransposeInterleaved(const Vector &x, Vector &y) const;
    /** Fill the I array of SparseMatrix corresponding to the sparsity pattern
        given by this ElementRestriction. */
    void FillI(SparseMatrix &mat) const;
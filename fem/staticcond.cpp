@@ -10,6 +10,8 @@
 // CONTRIBUTING.md for details.
 
 #include "staticcond.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
 
 namespace mfem
 {
@@ -40,6 +42,8 @@ StaticCondensation::StaticCondensation(FiniteElementSpace *fespace)
 #endif
    S = S_e = NULL;
    symm = false;
+   batched = Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK);
+   batched_pending = false;
    A_data.Reset();
    A_ipiv.Reset();
 
@@ -147,8 +151,7 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
       A_offsets[i+1] = A_offsets[i] + npd*(npd + (symm ? 1 : 2)*ned);
       A_ipiv_offsets[i+1] = A_ipiv_offsets[i] + npd;
    }
-   A_data = Memory<double>(A_offsets[NE]);
-   A_ipiv = Memory<int>(A_ipiv_offsets[NE]);
+   AllocateA();
    const int nedofs = tr_fes->GetVSize();
    if (fes->GetVDim() == 1)
    {
@@ -186,6 +189,181 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
    }
 }
 
+bool StaticCondensation::BatchedSupported() const
+{
+   const int NE = fes->GetNE();
+   if (NE == 0) { return false; }
+   Array<int> rvdofs;
+   tr_fes->GetElementVDofs(0, rvdofs);
+   const int npd = elem_pdof.RowSize(0), ned = rvdofs.Size();
+   for (int i = 1; i < NE; i++)
+   {
+      tr_fes->GetElementVDofs(i, rvdofs);
+      if (elem_pdof.RowSize(i) != npd || rvdofs.Size() != ned) { return false; }
+   }
+   return true;
+}
+
+void StaticCondensation::AllocateA()
+{
+   const int NE = fes->GetNE();
+   batched = batched && BatchedSupported();
+   batched_pending = false;
+
+   A_data.Delete();
+   A_ipiv.Delete();
+   A_data.Reset();
+   A_ipiv.Reset();
+   A_pp_b.Clear();
+   A_pe_b.Clear();
+   A_ep_b.Clear();
+   A_ee_b.Clear();
+   A_pp_piv.DeleteAll();
+   elem_rdofs.DeleteAll();
+   rdof_eoffsets.DeleteAll();
+   rdof_eindices.DeleteAll();
+
+   if (!batched)
+   {
+      A_data = Memory<double>(A_offsets[NE]);
+      A_ipiv = Memory<int>(A_ipiv_offsets[NE]);
+      return;
+   }
+
+   Array<int> rvdofs;
+   tr_fes->GetElementVDofs(0, rvdofs);
+   const int npd = elem_pdof.RowSize(0), ned = rvdofs.Size();
+   A_pp_b.SetSize(npd, npd, NE);
+   A_pe_b.SetSize(npd, ned, NE);
+   A_ep_b.SetSize(ned, npd, NE);
+   A_ee_b.SetSize(ned, ned, NE);
+
+   // Define elem_rdofs and its transpose, used to gather the element vectors
+   // and matrices without race conditions.
+   const int nedofs = tr_fes->GetVSize();
+   elem_rdofs.SetSize(ned*NE);
+   rdof_eoffsets.SetSize(nedofs+1);
+   rdof_eoffsets = 0;
+   for (int i = 0; i < NE; i++)
+   {
+      tr_fes->GetElementVDofs(i, rvdofs);
+      for (int j = 0; j < ned; j++)
+      {
+         const int rd = rvdofs[j];
+         elem_rdofs[i*ned+j] = rd;
+         rdof_eoffsets[(rd >= 0 ? rd : -1-rd) + 1]++;
+      }
+   }
+   rdof_eoffsets.PartialSum();
+   Array<int> pos(nedofs);
+   for (int i = 0; i < nedofs; i++) { pos[i] = rdof_eoffsets[i]; }
+   rdof_eindices.SetSize(ned*NE);
+   for (int k = 0; k < ned*NE; k++)
+   {
+      const int rd = elem_rdofs[k];
+      rdof_eindices[pos[rd >= 0 ? rd : -1-rd]++] = (rd >= 0) ? k : -1-k;
+   }
+}
+
+void StaticCondensation::UseBatched(bool use)
+{
+   batched = use;
+   if (A_offsets.Size()) { AllocateA(); }
+}
+
+void StaticCondensation::AssembleBatchedS()
+{
+   if (!batched_pending) { return; }
+   batched_pending = false;
+
+   const int NE = fes->GetNE();
+   const int npd = A_pp_b.SizeI(), ned = A_ee_b.SizeI();
+
+   // Factor A_pp and compute the element Schur complements in A_ee:
+   // A_ee <- A_ee - A_ep A_pp^{-1} A_pe
+   BatchLUFactor(A_pp_b, A_pp_piv);
+   {
+      Vector X(npd*ned*NE);
+      const auto d_LU = Reshape(A_pp_b.Read(), npd, npd, NE);
+      const auto d_piv = Reshape(A_pp_piv.Read(), npd, NE);
+      const auto d_A_pe = Reshape(A_pe_b.Read(), npd, ned, NE);
+      const auto d_A_ep = Reshape(A_ep_b.Read(), ned, npd, NE);
+      auto d_X = Reshape(X.Write(), npd, ned, NE);
+      auto d_A_ee = Reshape(A_ee_b.ReadWrite(), ned, ned, NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int j = 0; j < ned; j++)
+         {
+            for (int i = 0; i < npd; i++) { d_X(i,j,e) = d_A_pe(i,j,e); }
+            kernels::LUSolve(&d_LU(0,0,e), npd, &d_piv(0,e), &d_X(0,j,e));
+         }
+         for (int j = 0; j < ned; j++)
+         {
+            for (int i = 0; i < ned; i++)
+            {
+               double a = 0.0;
+               for (int k = 0; k < npd; k++) { a += d_A_ep(i,k,e)*d_X(k,j,e); }
+               d_A_ee(i,j,e) -= a;
+            }
+         }
+      });
+   }
+
+   if (!S->Finalized())
+   {
+      // Dynamic sparsity pattern (vector forms): assemble on the host
+      const int skip_zeros = 0;
+      double *S_data = A_ee_b.HostReadWrite();
+      Array<int> rvdofs;
+      DenseMatrix S_el;
+      for (int i = 0; i < NE; i++)
+      {
+         tr_fes->GetElementVDofs(i, rvdofs);
+         S_el.UseExternalData(S_data + ned*ned*i, ned, ned);
+         S->AddSubMatrix(rvdofs, rvdofs, S_el, skip_zeros);
+      }
+      return;
+   }
+
+   // Assemble S row by row in the sparsity pattern computed in Init(): each
+   // thread sums the contributions of the elements adjacent to its row.
+   if (!S->ColumnsAreSorted()) { S->SortColumnIndices(); }
+   const int nedofs = S->Height();
+   const auto d_offsets = rdof_eoffsets.Read();
+   const auto d_indices = rdof_eindices.Read();
+   const auto d_rdofs = elem_rdofs.Read();
+   const auto d_S_el = Reshape(A_ee_b.Read(), ned, ned, NE);
+   const int *d_I = S->ReadI();
+   const int *d_J = S->ReadJ();
+   double *d_S = S->ReadWriteData();
+   MFEM_FORALL(r, nedofs,
+   {
+      const int s_begin = d_I[r], s_end = d_I[r+1];
+      for (int k = d_offsets[r]; k < d_offsets[r+1]; k++)
+      {
+         const int idx = d_indices[k];
+         const bool neg_r = (idx < 0);
+         const int e = (neg_r ? -1-idx : idx)/ned;
+         const int lr = (neg_r ? -1-idx : idx)%ned;
+         for (int l = 0; l < ned; l++)
+         {
+            const int rd = d_rdofs[e*ned+l];
+            const int c = (rd >= 0) ? rd : -1-rd;
+            const double a = d_S_el(lr,l,e);
+            // binary search for column c
+            int lo = s_begin, hi = s_end - 1;
+            while (lo < hi)
+            {
+               const int mid = (lo + hi)/2;
+               if (d_J[mid] < c) { lo = mid + 1; }
+               else { hi = mid; }
+            }
+            d_S[lo] += (neg_r != (rd < 0)) ? -a : a;
+         }
+      }
+   });
+}
+
 void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
 {
    Array<int> rvdofs;
@@ -193,12 +371,22 @@ void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
    const int vdim = fes->GetVDim();
    const int nvpd = elem_pdof.RowSize(el);
    const int nved = rvdofs.Size();
-   DenseMatrix A_pp(A_data + A_offsets[el], nvpd, nvpd);
-   DenseMatrix A_pe(A_pp.Data() + nvpd*nvpd, nvpd, nved);
-   DenseMatrix A_ep;
-   if (symm) { A_ep.SetSize(nved, nvpd); }
-   else      { A_ep.UseExternalData(A_pe.Data() + nvpd*nved, nved, nvpd); }
-   DenseMatrix A_ee(nved, nved);
+   DenseMatrix A_pp, A_pe, A_ep, A_ee;
+   if (batched)
+   {
+      A_pp.UseExternalData(A_pp_b.HostReadWrite() + nvpd*nvpd*el, nvpd, nvpd);
+      A_pe.UseExternalData(A_pe_b.HostReadWrite() + nvpd*nved*el, nvpd, nved);
+      A_ep.UseExternalData(A_ep_b.HostReadWrite() + nved*nvpd*el, nved, nvpd);
+      A_ee.UseExternalData(A_ee_b.HostReadWrite() + nved*nved*el, nved, nved);
+   }
+   else
+   {
+      A_pp.UseExternalData(A_data + A_offsets[el], nvpd, nvpd);
+      A_pe.UseExternalData(A_pp.Data() + nvpd*nvpd, nvpd, nved);
+      if (symm) { A_ep.SetSize(nved, nvpd); }
+      else      { A_ep.UseExternalData(A_pe.Data() + nvpd*nved, nved, nvpd); }
+      A_ee.SetSize(nved, nved);
+   }
 
    const int npd = nvpd/vdim;
    const int ned = nved/vdim;
@@ -214,6 +402,13 @@ void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
          A_ee.CopyMN(elmat, ned, ned, i*nd,     j*nd,     i*ned, j*ned);
       }
    }
+   if (batched)
+   {
+      // The Schur complements are computed for all elements in Finalize()
+      batched_pending = true;
+      return;
+   }
+
    // Compute the Schur complement
    LUFactors lu(A_pp.Data(), A_ipiv + A_ipiv_offsets[el]);
    lu.Factor(nvpd);
@@ -235,6 +430,7 @@ void StaticCondensation::AssembleBdrMatrix(int el, const DenseMatrix &elmat)
 void StaticCondensation::Finalize()
 {
    const int skip_zeros = 0;
+   if (batched && S) { AssembleBatchedS(); }
    if (!Parallel())
    {
       S->Finalize(skip_zeros);
@@ -321,53 +517,103 @@ void StaticCondensation::ReduceRHS(const Vector &b, Vector &sc_b) const
    if (!Parallel() && !(tr_cP = tr_fes->GetConformingProlongation()))
    {
       sc_b.SetSize(nedofs);
-      b_r.SetDataAndSize(sc_b.GetData(), sc_b.Size());
+      b_r.MakeRef(sc_b, 0, sc_b.Size());
    }
    else
    {
       b_r.SetSize(nedofs);
    }
-   for (int i = 0; i < nedofs; i++)
+   if (batched)
    {
-      b_r(i) = b(rdof_edof[i]);
-   }
+      const int npd = A_pp_b.SizeI(), ned = A_ee_b.SizeI();
+      const auto d_b = b.Read();
+      const auto d_rdof_edof = rdof_edof.Read();
+      auto d_b_r = b_r.Write();
+      MFEM_FORALL(i, nedofs, d_b_r[i] = d_b[d_rdof_edof[i]];);
 
-   DenseMatrix U_pe, L_ep;
-   Vector b_p, b_ep;
-   Array<int> rvdofs;
-   for (int i = 0; i < NE; i++)
-   {
-      tr_fes->GetElementVDofs(i, rvdofs);
-      const int ned = rvdofs.Size();
-      const int *rd = rvdofs.GetData();
-      const int npd = elem_pdof.RowSize(i);
-      const int *pd = elem_pdof.GetRow(i);
-      b_p.SetSize(npd);
-      b_ep.SetSize(ned);
-      for (int j = 0; j < npd; j++)
+      // b_ep = A_ep A_pp^{-1} b_p
+      Vector b_p(npd*NE), b_ep(ned*NE);
+      const auto d_pdofs = Reshape(mfem::Read(elem_pdof.GetJMemory(), npd*NE),
+                                   npd, NE);
+      auto d_b_p = Reshape(b_p.Write(), npd, NE);
+      MFEM_FORALL(e, NE,
       {
-         b_p(j) = b(pd[j]);
-      }
-
-      LUFactors lu(const_cast<double*>((const double*)A_data) + A_offsets[i],
-                   const_cast<int*>((const int*)A_ipiv) + A_ipiv_offsets[i]);
-      lu.LSolve(npd, 1, b_p);
+         for (int j = 0; j < npd; j++) { d_b_p(j,e) = d_b[d_pdofs(j,e)]; }
+      });
+      BatchLUSolve(A_pp_b, A_pp_piv, b_p);
+      const auto d_A_ep = Reshape(A_ep_b.Read(), ned, npd, NE);
+      const auto d_x_p = Reshape(b_p.Read(), npd, NE);
+      auto d_b_ep = b_ep.Write();
+      MFEM_FORALL(e, NE,
+      {
+         for (int i = 0; i < ned; i++)
+         {
+            double a = 0.0;
+            for (int k = 0; k < npd; k++) { a += d_A_ep(i,k,e)*d_x_p(k,e); }
+            d_b_ep[e*ned+i] = a;
+         }
+      });
 
-      if (symm)
+      // b_r -= b_ep, gathered through the transposed element-to-rdof map
+      const auto d_offsets = rdof_eoffsets.Read();
+      const auto d_indices = rdof_eindices.Read();
+      d_b_r = b_r.ReadWrite();
+      MFEM_FORALL(i, nedofs,
       {
-         // TODO: handle the symmetric case correctly.
-         U_pe.UseExternalData(lu.data + npd*npd, npd, ned);
-         U_pe.MultTranspose(b_p, b_ep);
-      }
-      else
+         double a = 0.0;
+         for (int k = d_offsets[i]; k < d_offsets[i+1]; k++)
+         {
+            const int idx = d_indices[k];
+            a += (idx >= 0) ? d_b_ep[idx] : -d_b_ep[-1-idx];
+         }
+         d_b_r[i] -= a;
+      });
+   }
+   else
+   {
+      for (int i = 0; i < nedofs; i++)
       {
-         L_ep.UseExternalData(lu.data + npd*(npd+ned), ned, npd);
-         L_ep.Mult(b_p, b_ep);
+         b_r(i) = b(rdof_edof[i]);
       }
-      for (int j = 0; j < ned; j++)
+
+      DenseMatrix U_pe, L_ep;
+      Vector b_p, b_ep;
+      Array<int> rvdofs;
+      for (int i = 0; i < NE; i++)
       {
-         if (rd[j] >= 0) { b_r(rd[j]) -= b_ep(j); }
-         else            { b_r(-1-rd[j]) += b_ep(j); }
+         tr_fes->GetElementVDofs(i, rvdofs);
+         const int ned = rvdofs.Size();
+         const int *rd = rvdofs.GetData();
+         const int npd = elem_pdof.RowSize(i);
+         const int *pd = elem_pdof.GetRow(i);
+         b_p.SetSize(npd);
+         b_ep.SetSize(ned);
+         for (int j = 0; j < npd; j++)
+         {
+            b_p(j) = b(pd[j]);
+         }
+
+         LUFactors lu(
+            const_cast<double*>((const double*)A_data) + A_offsets[i],
+            const_cast<int*>((const int*)A_ipiv) + A_ipiv_offsets[i]);
+         lu.LSolve(npd, 1, b_p);
+
+         if (symm)
+         {
+            // TODO: handle the symmetric case correctly.
+            U_pe.UseExternalData(lu.data + npd*npd, npd, ned);
+            U_pe.MultTranspose(b_p, b_ep);
+         }
+         else
+         {
+            L_ep.UseExternalData(lu.data + npd*(npd+ned), ned, npd);
+            L_ep.Mult(b_p, b_ep);
+         }
+         for (int j = 0; j < ned; j++)
+         {
+            if (rd[j] >= 0) { b_r(rd[j]) -= b_ep(j); }
+            else            { b_r(-1-rd[j]) += b_ep(j); }
+         }
       }
    }
    if (!Parallel())
@@ -490,7 +736,7 @@ void StaticCondensation::ComputeSolution(
       const SparseMatrix *tr_cP = tr_fes->GetConformingProlongation();
       if (!tr_cP)
       {
-         sol_r.SetDataAndSize(sc_sol.GetData(), sc_sol.Size());
+         sol_r.MakeRef(const_cast<Vector&>(sc_sol), 0, sc_sol.Size());
       }
       else
       {
@@ -506,11 +752,45 @@ void StaticCondensation::ComputeSolution(
 #endif
    }
    sol.SetSize(nedofs+npdofs);
+   const int NE = fes->GetNE();
+   if (batched)
+   {
+      const int npd = A_pp_b.SizeI(), ned = A_ee_b.SizeI();
+      const auto d_sol_r = sol_r.Read();
+      const auto d_rdof_edof = rdof_edof.Read();
+      auto d_sol = sol.Write();
+      MFEM_FORALL(i, nedofs, d_sol[d_rdof_edof[i]] = d_sol_r[i];);
+
+      // sol_p = A_pp^{-1} (b_p - A_pe sol_e)
+      Vector b_p(npd*NE);
+      const auto d_b = b.Read();
+      const auto d_pdofs = Reshape(mfem::Read(elem_pdof.GetJMemory(), npd*NE),
+                                   npd, NE);
+      const auto d_rdofs = Reshape(elem_rdofs.Read(), ned, NE);
+      const auto d_A_pe = Reshape(A_pe_b.Read(), npd, ned, NE);
+      auto d_b_p = Reshape(b_p.Write(), npd, NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int i = 0; i < npd; i++) { d_b_p(i,e) = d_b[d_pdofs(i,e)]; }
+         for (int j = 0; j < ned; j++)
+         {
+            const int rd = d_rdofs(j,e);
+            const double s_j = (rd >= 0) ? d_sol_r[rd] : -d_sol_r[-1-rd];
+            for (int i = 0; i < npd; i++) { d_b_p(i,e) -= d_A_pe(i,j,e)*s_j; }
+         }
+      });
+      BatchLUSolve(A_pp_b, A_pp_piv, b_p);
+      const auto d_x_p = Reshape(b_p.Read(), npd, NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int i = 0; i < npd; i++) { d_sol[d_pdofs(i,e)] = d_x_p(i,e); }
+      });
+      return;
+   }
    for (int i = 0; i < nedofs; i++)
    {
       sol(rdof_edof[i]) = sol_r(i);
    }
-   const int NE = fes->GetNE();
    Vector b_p, s_e;
    Array<int> rvdofs;
    for (int i = 0; i < NE; i++)
@@ -61,7 +61,13 @@ namespace mfem
         \f[ S_{22} = A_{22} - A_{21} A_{11}^{-1} A_{12}. \f]
     After solving the Schur complement system, the \f$ X_1 \f$ part of the
     solution can be recovered using the formula
-        \f[ X_1 = A_{11}^{-1} ( B_1 - A_{12} X_2 ). \f] */
+        \f[ X_1 = A_{11}^{-1} ( B_1 - A_{12} X_2 ). \f]
+
+    When all elements have the same numbers of private and exposed dofs, the
+    element blocks can be stored in DenseTensor%s, see UseBatched(). Then the
+    factorization of the \f$ A_{11} \f$ blocks and the element Schur
+    complements are computed for all elements at once in Finalize(), and
+    ReduceRHS() and ComputeSolution() are MFEM_FORALL kernels. */
 class StaticCondensation
 {
    FiniteElementSpace *fes, *tr_fes;
@@ -87,6 +93,28 @@ class StaticCondensation
 
    Array<int> ess_rtdof_list;
 
+   // Batched storage of the element blocks, used instead of A_data and A_ipiv
+   // when 'batched' is true. The factors of A_pp are stored in A_pp_b and
+   // A_pp_piv; A_pe_b and A_ep_b are not modified by the factorization.
+   bool batched;
+   bool batched_pending; // element Schur complements not yet added to S
+   DenseTensor A_pp_b, A_pe_b, A_ep_b, A_ee_b;
+   Array<int> A_pp_piv;
+   // The reduced vdofs of the elements (ned x NE, with the sign encoding of
+   // GetElementVDofs()) and the transposed map from reduced vdofs to the
+   // entries of the element vectors, with the same sign encoding.
+   Array<int> elem_rdofs, rdof_eoffsets, rdof_eindices;
+
+   // Return true if the element blocks can be stored in DenseTensor%s.
+   bool BatchedSupported() const;
+
+   // (Re)allocate the storage for the element blocks.
+   void AllocateA();
+
+   // Factor the batched A_pp blocks, compute the element Schur complements
+   // and add them to S.
+   void AssembleBatchedS();
+
 public:
    /// Construct a StaticCondensation object.
    StaticCondensation(FiniteElementSpace *fespace);
@@ -105,6 +133,18 @@ public:
        complement matrix and the other element-wise blocks. */
    void Init(bool symmetric, bool block_diagonal);
 
+   /** @brief Store the element blocks in DenseTensor%s and use the batched
+       (device) kernels for the elimination of the private dofs.
+
+       The batched path is only used if all elements have the same numbers of
+       private and exposed dofs; otherwise this call is ignored. It is enabled
+       by default when a device or OpenMP backend is configured. This method
+       must be called before the assembly of the element matrices. */
+   void UseBatched(bool use = true);
+
+   /// Return true if the batched element storage and kernels are used.
+   bool UsesBatched() const { return batched; }
+
    /// Return a pointer to the reduced/trace FE space.
    FiniteElementSpace *GetTraceFESpace() { return tr_fes; }
 
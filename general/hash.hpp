@@ -38,6 +38,22 @@ struct Hashed4
    int next;
 };
 
+/** Items of OpenHashTable, accessible by hashing two IDs. Unlike Hashed2,
+ *  they have no chaining link.
+ */
+struct OpenHashed2
+{
+   int p1, p2;
+};
+
+/** Items of OpenHashTable, accessible by hashing four IDs. Unlike Hashed4,
+ *  they have no chaining link.
+ */
+struct OpenHashed4
+{
+   int p1, p2, p3; // NOTE: p4 is neither hashed nor stored
+};
+
 
 /** HashTable is a container for items that require associative access through
  *  pairs (or quadruples) of indices:
@@ -187,12 +203,13 @@ protected:
    int mask;
    Array<int> unused;
 
-   // hash functions (NOTE: the constants are arbitrary)
+   // hash functions (NOTE: the constants are arbitrary; the products are
+   // unsigned since a signed overflow would be undefined behavior)
    inline int Hash(int p1, int p2) const
-   { return (984120265*p1 + 125965121*p2) & mask; }
+   { return (984120265u*p1 + 125965121u*p2) & mask; }
 
    inline int Hash(int p1, int p2, int p3) const
-   { return (984120265*p1 + 125965121*p2 + 495698413*p3) & mask; }
+   { return (984120265u*p1 + 125965121u*p2 + 495698413u*p3) & mask; }
 
    // Delete() and Reparent() use one of these:
    inline int Hash(const Hashed2& item) const
@@ -213,6 +230,184 @@ protected:
 };
 
 
+/** OpenHashTable is an alternative to HashTable with the same interface, in
+ *  which the items are indexed by an open addressing hash table with linear
+ *  probing instead of separate chaining.
+ *
+ *  Besides the item ID, each slot of the table holds 8 bits of the hash of
+ *  the item, so that a lookup rarely needs to access items other than the one
+ *  it is looking for. The table is kept between 3/16 and 3/4 full of the
+ *  items currently stored and deleted items are removed by shifting the
+ *  following items back (no tombstones). The items do not need a chaining
+ *  link, so the item type (T) follows the OpenHashed2 or OpenHashed4 concept;
+ *  unused items are marked with p1 == -1.
+ *
+ *  The lookups and insertions are faster than with HashTable, in particular
+ *  for the NCMesh refinement, but the table takes 5 bytes per slot, i.e.
+ *  6.7 to 13.3 bytes per item once grown, while the chained HashTable takes
+ *  6 to 8 bytes per item, including the 4-byte link stored in the item.
+ *  OpenHashTable is not the default container of NCMesh, see
+ *  MFEM_NCMESH_OPEN_HASH in ncmesh.hpp.
+ */
+template<typename T>
+class OpenHashTable : public BlockArray<T>
+{
+protected:
+   typedef BlockArray<T> Base;
+
+public:
+   OpenHashTable(int block_size = 16*1024, int init_hash_size = 32*1024);
+   OpenHashTable(const OpenHashTable& other); // deep copy
+   ~OpenHashTable();
+
+   /// Get item whose parents are 'p1', 'p2'... Create it if it doesn't exist.
+   T* Get(int p1, int p2);
+   T* Get(int p1, int p2, int p3, int p4 = -1 /* p4 optional */);
+
+   /// Get id of item whose parents are p1, p2... Create it if it doesn't exist.
+   int GetId(int p1, int p2);
+   int GetId(int p1, int p2, int p3, int p4 = -1);
+
+   /// Find item whose parents are p1, p2... Return NULL if it doesn't exist.
+   T* Find(int p1, int p2);
+   T* Find(int p1, int p2, int p3, int p4 = -1);
+
+   const T* Find(int p1, int p2) const;
+   const T* Find(int p1, int p2, int p3, int p4 = -1) const;
+
+   /// Find id of item whose parents are p1, p2... Return -1 if it doesn't exist.
+   int FindId(int p1, int p2) const;
+   int FindId(int p1, int p2, int p3, int p4 = -1) const;
+
+   /// Return the number of elements currently stored in the OpenHashTable.
+   int Size() const { return Base::Size() - unused.Size(); }
+
+   /// Return the total number of ids (used and unused) in the OpenHashTable.
+   int NumIds() const { return Base::Size(); }
+
+   /// Return the number of free/unused ids in the OpenHashTable.
+   int NumFreeIds() const { return unused.Size(); }
+
+   /// Return true if item 'id' exists in (is used by) the container.
+   /** It is assumed that 0 <= id < NumIds(). */
+   bool IdExists(int id) const { return (Base::At(id).p1 >= 0); }
+
+   /// Remove an item from the hash table.
+   /** Its id will be reused by newly added items. */
+   void Delete(int id);
+
+   /// Remove all items.
+   void DeleteAll();
+
+   /// Allocate an item at 'id'. Enlarge the underlying BlockArray if necessary.
+   /** This is a special purpose method used when loading data from a file.
+       Does nothing if the slot 'id' has already been allocated. */
+   void Alloc(int id, int p1, int p2);
+
+   /// Reinitialize the internal list of unallocated items.
+   /** This is a special purpose method used when loading data from a file. */
+   void UpdateUnused();
+
+   /// Make an item hashed under different parent IDs.
+   void Reparent(int id, int new_p1, int new_p2);
+   void Reparent(int id, int new_p1, int new_p2, int new_p3, int new_p4 = -1);
+
+   /// Return total size of allocated memory (tables plus items), in bytes.
+   long MemoryUsage() const;
+
+   /// Write details of the memory usage to the mfem output stream.
+   void PrintMemoryDetail() const;
+
+   class iterator : public Base::iterator
+   {
+   protected:
+      friend class OpenHashTable;
+      typedef typename Base::iterator base;
+
+      iterator() { }
+      iterator(const base &it) : base(it)
+      {
+         while (base::good() && (*this)->p1 < 0) { base::next(); }
+      }
+
+   public:
+      iterator &operator++()
+      {
+         while (base::next(), base::good() && (*this)->p1 < 0) { }
+         return *this;
+      }
+   };
+
+   class const_iterator : public Base::const_iterator
+   {
+   protected:
+      friend class OpenHashTable;
+      typedef typename Base::const_iterator base;
+
+      const_iterator() { }
+      const_iterator(const base &it) : base(it)
+      {
+         while (base::good() && (*this)->p1 < 0) { base::next(); }
+      }
+
+   public:
+      const_iterator &operator++()
+      {
+         while (base::next(), base::good() && (*this)->p1 < 0) { }
+         return *this;
+      }
+   };
+
+   iterator begin() { return iterator(Base::begin()); }
+   iterator end() { return iterator(); }
+
+   const_iterator cbegin() const { return const_iterator(Base::cbegin()); }
+   const_iterator cend() const { return const_iterator(); }
+
+protected:
+   int* table;          ///< item ids, -1 for an empty slot
+   unsigned char* tags; ///< high 8 bits of the hash of the item in each slot
+   int mask;
+   int min_size;        ///< initial (and smallest) size of the table
+   Array<int> unused;
+
+   // hash functions (NOTE: the constants are arbitrary)
+   static inline unsigned Mix(unsigned h)
+   { h ^= h >> 15; h *= 0x2c1b3c6du; return h ^ (h >> 12); }
+
+   inline unsigned Hash(int p1, int p2) const
+   { return Mix(984120265u*p1 + 125965121u*p2); }
+
+   inline unsigned Hash(int p1, int p2, int p3) const
+   { return Mix(984120265u*p1 + 125965121u*p2 + 495698413u*p3); }
+
+   // Delete() and Reparent() use one of these:
+   inline unsigned Hash(const OpenHashed2& item) const
+   { return Hash(item.p1, item.p2); }
+
+   inline unsigned Hash(const OpenHashed4& item) const
+   { return Hash(item.p1, item.p2, item.p3); }
+
+   static inline unsigned char Tag(unsigned hash)
+   { return (unsigned char) (hash >> 24); }
+
+   /** Return the slot of the item with the given parents, or the empty slot
+       where it would be inserted. */
+   int FindSlot(unsigned hash, int p1, int p2) const;
+   int FindSlot(unsigned hash, int p1, int p2, int p3) const;
+
+   /// Return the first empty slot on the probe sequence of @a hash.
+   inline int EmptySlot(unsigned hash) const;
+
+   inline void Insert(int idx, int id, unsigned hash);
+   void Unlink(unsigned hash, int id);
+
+   /// Check table load factor and resize if necessary
+   inline void CheckRehash();
+   void DoRehash();
+};
+
+
 /// Hash function for data sequences.
 /** Depends on GnuTLS for SHA-256 hashing. */
 class HashFunction
@@ -650,6 +845,374 @@ void HashTable<T>::PrintMemoryDetail() const
 }
 
 
+template<typename T>
+OpenHashTable<T>::OpenHashTable(int block_size, int init_hash_size)
+   : Base(block_size), min_size(init_hash_size)
+{
+   mask = init_hash_size-1;
+   MFEM_VERIFY(!(init_hash_size & mask), "init_size must be a power of two.");
+
+   table = new int[init_hash_size];
+   tags = new unsigned char[init_hash_size];
+   for (int i = 0; i < init_hash_size; i++)
+   {
+      table[i] = -1;
+   }
+}
+
+template<typename T>
+OpenHashTable<T>::OpenHashTable(const OpenHashTable& other)
+   : Base(other), mask(other.mask), min_size(other.min_size)
+{
+   int size = mask+1;
+   table = new int[size];
+   tags = new unsigned char[size];
+   memcpy(table, other.table, size*sizeof(int));
+   memcpy(tags, other.tags, size*sizeof(unsigned char));
+   other.unused.Copy(unused);
+}
+
+template<typename T>
+OpenHashTable<T>::~OpenHashTable()
+{
+   delete [] tags;
+   delete [] table;
+}
+
+
+template<typename T>
+inline T* OpenHashTable<T>::Get(int p1, int p2)
+{
+   return &(Base::At(GetId(p1, p2)));
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Get(int p1, int p2, int p3, int p4)
+{
+   return &(Base::At(GetId(p1, p2, p3, p4)));
+}
+
+template<typename T>
+int OpenHashTable<T>::GetId(int p1, int p2)
+{
+   // search for the item in the hashtable
+   if (p1 > p2) { std::swap(p1, p2); }
+   const unsigned hash = Hash(p1, p2);
+   const int idx = FindSlot(hash, p1, p2);
+   if (table[idx] >= 0) { return table[idx]; }
+
+   // not found - use an unused item or create a new one
+   int new_id;
+   if (unused.Size())
+   {
+      new_id = unused.Last();
+      unused.DeleteLast();
+   }
+   else
+   {
+      new_id = Base::Append();
+   }
+   T& item = Base::At(new_id);
+   item.p1 = p1;
+   item.p2 = p2;
+
+   // insert into hashtable
+   Insert(idx, new_id, hash);
+   CheckRehash();
+
+   return new_id;
+}
+
+template<typename T>
+int OpenHashTable<T>::GetId(int p1, int p2, int p3, int p4)
+{
+   // search for the item in the hashtable
+   internal::sort4_ext(p1, p2, p3, p4);
+   const unsigned hash = Hash(p1, p2, p3);
+   const int idx = FindSlot(hash, p1, p2, p3);
+   if (table[idx] >= 0) { return table[idx]; }
+
+   // not found - use an unused item or create a new one
+   int new_id;
+   if (unused.Size())
+   {
+      new_id = unused.Last();
+      unused.DeleteLast();
+   }
+   else
+   {
+      new_id = Base::Append();
+   }
+   T& item = Base::At(new_id);
+   item.p1 = p1;
+   item.p2 = p2;
+   item.p3 = p3;
+
+   // insert into hashtable
+   Insert(idx, new_id, hash);
+   CheckRehash();
+
+   return new_id;
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Find(int p1, int p2)
+{
+   int id = FindId(p1, p2);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Find(int p1, int p2, int p3, int p4)
+{
+   int id = FindId(p1, p2, p3, p4);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline const T* OpenHashTable<T>::Find(int p1, int p2) const
+{
+   int id = FindId(p1, p2);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline const T* OpenHashTable<T>::Find(int p1, int p2, int p3, int p4) const
+{
+   int id = FindId(p1, p2, p3, p4);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+int OpenHashTable<T>::FindId(int p1, int p2) const
+{
+   if (p1 > p2) { std::swap(p1, p2); }
+   return table[FindSlot(Hash(p1, p2), p1, p2)];
+}
+
+template<typename T>
+int OpenHashTable<T>::FindId(int p1, int p2, int p3, int p4) const
+{
+   internal::sort4_ext(p1, p2, p3, p4);
+   return table[FindSlot(Hash(p1, p2, p3), p1, p2, p3)];
+}
+
+template<typename T>
+int OpenHashTable<T>::FindSlot(unsigned hash, int p1, int p2) const
+{
+   const unsigned char tag = Tag(hash);
+   for (int idx = hash & mask; ; idx = (idx + 1) & mask)
+   {
+      const int id = table[idx];
+      if (id < 0) { return idx; }
+      if (tags[idx] == tag)
+      {
+         const T& item = Base::At(id);
+         if (item.p1 == p1 && item.p2 == p2) { return idx; }
+      }
+   }
+}
+
+template<typename T>
+int OpenHashTable<T>::FindSlot(unsigned hash, int p1, int p2, int p3) const
+{
+   const unsigned char tag = Tag(hash);
+   for (int idx = hash & mask; ; idx = (idx + 1) & mask)
+   {
+      const int id = table[idx];
+      if (id < 0) { return idx; }
+      if (tags[idx] == tag)
+      {
+         const T& item = Base::At(id);
+         if (item.p1 == p1 && item.p2 == p2 && item.p3 == p3) { return idx; }
+      }
+   }
+}
+
+template<typename T>
+inline int OpenHashTable<T>::EmptySlot(unsigned hash) const
+{
+   int idx = hash & mask;
+   while (table[idx] >= 0) { idx = (idx + 1) & mask; }
+   return idx;
+}
+
+template<typename T>
+inline void OpenHashTable<T>::CheckRehash()
+{
+   // is the table more than 3/4 full, or less than 3/16 full? (the unused ids
+   // are not counted, so that the table shrinks after a derefinement)
+   const long n = Size(), slots = mask+1;
+   if (4*n > 3*slots || (16*n < 3*slots && slots > min_size))
+   {
+      DoRehash();
+   }
+}
+
+template<typename T>
+void OpenHashTable<T>::DoRehash()
+{
+   delete [] tags;
+   delete [] table;
+
+   // the smallest table that is at most 3/8 full
+   int new_table_size = min_size;
+   while (8*(long) Size() > 3*(long) new_table_size)
+   {
+      new_table_size *= 2;
+   }
+   table = new int[new_table_size];
+   tags = new unsigned char[new_table_size];
+   for (int i = 0; i < new_table_size; i++) { table[i] = -1; }
+   mask = new_table_size-1;
+
+#if defined(MFEM_DEBUG) && !defined(MFEM_USE_MPI)
+   mfem::out << _MFEM_FUNC_NAME << ": rehashing to size " << new_table_size
+             << std::endl;
+#endif
+
+   // reinsert all items
+   for (iterator it = begin(); it != end(); ++it)
+   {
+      const unsigned hash = Hash(*it);
+      Insert(EmptySlot(hash), it.index(), hash);
+   }
+}
+
+template<typename T>
+inline void OpenHashTable<T>::Insert(int idx, int id, unsigned hash)
+{
+   // occupy the empty slot 'idx'
+   table[idx] = id;
+   tags[idx] = Tag(hash);
+}
+
+template<typename T>
+void OpenHashTable<T>::Unlink(unsigned hash, int id)
+{
+   // find the slot of the item
+   int idx = hash & mask;
+   while (table[idx] != id)
+   {
+      if (table[idx] < 0)
+      {
+         MFEM_ABORT("OpenHashTable<>::Unlink: item not found!");
+      }
+      idx = (idx + 1) & mask;
+   }
+
+   // shift back the following items whose probe sequence passes through the
+   // freed slot, so that no lookup stops early at an empty slot
+   for (int j = (idx + 1) & mask; table[j] >= 0; j = (j + 1) & mask)
+   {
+      const int home = Hash(Base::At(table[j])) & mask;
+      if (((j - idx) & mask) <= ((j - home) & mask))
+      {
+         table[idx] = table[j];
+         tags[idx] = tags[j];
+         idx = j;
+      }
+   }
+   table[idx] = -1;
+}
+
+template<typename T>
+void OpenHashTable<T>::Delete(int id)
+{
+   T& item = Base::At(id);
+   Unlink(Hash(item), id);
+   item.p1 = -1;      // mark item as unused
+   unused.Append(id); // add its id to the unused ids
+   CheckRehash();
+}
+
+template<typename T>
+void OpenHashTable<T>::DeleteAll()
+{
+   Base::DeleteAll();
+   for (int i = 0; i <= mask; i++) { table[i] = -1; }
+   unused.DeleteAll();
+}
+
+template<typename T>
+void OpenHashTable<T>::Alloc(int id, int p1, int p2)
+{
+   // enlarge the BlockArray to hold 'id'
+   while (id >= Base::Size())
+   {
+      Base::At(Base::Append()).p1 = -1; // append "unused" items
+   }
+
+   T& item = Base::At(id);
+   if (item.p1 < 0)
+   {
+      item.p1 = p1;
+      item.p2 = p2;
+
+      const unsigned hash = Hash(p1, p2);
+      Insert(EmptySlot(hash), id, hash);
+      CheckRehash();
+   }
+}
+
+template<typename T>
+void OpenHashTable<T>::UpdateUnused()
+{
+   unused.DeleteAll();
+   for (int i = 0; i < Base::Size(); i++)
+   {
+      if (Base::At(i).p1 < 0) { unused.Append(i); }
+   }
+}
+
+template<typename T>
+void OpenHashTable<T>::Reparent(int id, int new_p1, int new_p2)
+{
+   T& item = Base::At(id);
+   Unlink(Hash(item), id);
+
+   if (new_p1 > new_p2) { std::swap(new_p1, new_p2); }
+   item.p1 = new_p1;
+   item.p2 = new_p2;
+
+   // reinsert under new parent IDs
+   const unsigned hash = Hash(new_p1, new_p2);
+   Insert(EmptySlot(hash), id, hash);
+}
+
+template<typename T>
+void OpenHashTable<T>::Reparent(int id,
+                            int new_p1, int new_p2, int new_p3, int new_p4)
+{
+   T& item = Base::At(id);
+   Unlink(Hash(item), id);
+
+   internal::sort4_ext(new_p1, new_p2, new_p3, new_p4);
+   item.p1 = new_p1;
+   item.p2 = new_p2;
+   item.p3 = new_p3;
+
+   // reinsert under new parent IDs
+   const unsigned hash = Hash(new_p1, new_p2, new_p3);
+   Insert(EmptySlot(hash), id, hash);
+}
+
+template<typename T>
+long OpenHashTable<T>::MemoryUsage() const
+{
+   return (mask+1) * (sizeof(int) + sizeof(unsigned char)) +
+          Base::MemoryUsage() + unused.MemoryUsage();
+}
+
+template<typename T>
+void OpenHashTable<T>::PrintMemoryDetail() const
+{
+   mfem::out << Base::MemoryUsage() << " + "
+             << (mask+1) * (sizeof(int) + sizeof(unsigned char))
+             << " + " << unused.MemoryUsage();
+}
+
+
 template <typename int_type_const_iter>
 HashFunction &HashFunction::EncodeAndHashInts(int_type_const_iter begin,
                                               int_type_const_iter end)
@@ -0,0 +1,122 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "kernel_dispatch.hpp"
+#include "error.hpp"
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+typedef std::tuple<std::string, int, int, int> FallbackKey;
+
+static KernelFallback::Action fallback_action = KernelFallback::COUNT;
+
+static std::map<FallbackKey, long> &FallbackCounts()
+{
+   static std::map<FallbackKey, long> counts;
+   return counts;
+}
+
+// Guards FallbackCounts(), which Report() may update from several threads.
+static std::mutex &FallbackMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+} // namespace internal
+
+void KernelFallback::SetAction(Action action)
+{
+   internal::fallback_action = action;
+}
+
+KernelFallback::Action KernelFallback::GetAction()
+{
+   return internal::fallback_action;
+}
+
+long KernelFallback::GetCount()
+{
+   std::lock_guard<std::mutex> lock(internal::FallbackMutex());
+   long count = 0;
+   for (const auto &kv : internal::FallbackCounts()) { count += kv.second; }
+   return count;
+}
+
+long KernelFallback::GetCount(const char *kernel)
+{
+   std::lock_guard<std::mutex> lock(internal::FallbackMutex());
+   long count = 0;
+   for (const auto &kv : internal::FallbackCounts())
+   {
+      if (std::get<0>(kv.first) == kernel) { count += kv.second; }
+   }
+   return count;
+}
+
+void KernelFallback::Reset()
+{
+   std::lock_guard<std::mutex> lock(internal::FallbackMutex());
+   internal::FallbackCounts().clear();
+}
+
+void KernelFallback::Print(std::ostream &out)
+{
+   out << "Generic (non-specialized) kernel calls: " << GetCount() << '\n';
+   std::lock_guard<std::mutex> lock(internal::FallbackMutex());
+   for (const auto &kv : internal::FallbackCounts())
+   {
+      out << "   " << std::get<0>(kv.first)
+          << " (dim = " << std::get<1>(kv.first)
+          << ", D1D = " << std::get<2>(kv.first)
+          << ", Q1D = " << std::get<3>(kv.first) << "): "
+          << kv.second << '\n';
+   }
+   out << std::flush;
+}
+
+void KernelFallback::Report(const char *kernel, int dim, int d1d, int q1d)
+{
+   const internal::FallbackKey key(kernel, dim, d1d, q1d);
+   long count;
+   {
+      std::lock_guard<std::mutex> lock(internal::FallbackMutex());
+      count = ++internal::FallbackCounts()[key];
+   }
+   switch (internal::fallback_action)
+   {
+      case COUNT: break;
+      case WARN:
+         if (count == 1)
+         {
+            MFEM_WARNING("using the generic version of kernel " << kernel
+                         << " for dim = " << dim << ", D1D = " << d1d
+                         << ", Q1D = " << q1d << "; add a specialization "
+                         "with MFEM_PA_KERNEL_SPECS_EXTRA for better "
+                         "performance.");
+         }
+         break;
+      case ABORT:
+         MFEM_ABORT("no specialization of kernel " << kernel
+                    << " for dim = " << dim << ", D1D = " << d1d
+                    << ", Q1D = " << q1d);
+   }
+}
+
+} // namespace mfem
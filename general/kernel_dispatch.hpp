@@ -0,0 +1,178 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_KERNEL_DISPATCH_HPP
+#define MFEM_KERNEL_DISPATCH_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp"
+#include <type_traits>
+#include <unordered_map>
+
+namespace mfem
+{
+
+/// Compile-time (dimension, 1D dofs, 1D quadrature points) triple identifying
+/// a specialization of a tensor-product kernel.
+template <int T_DIM, int T_D1D, int T_Q1D>
+struct KernelSpec
+{
+   static constexpr int DIM = T_DIM;
+   static constexpr int D1D = T_D1D;
+   static constexpr int Q1D = T_Q1D;
+};
+
+/// Compile-time list of KernelSpec%s.
+template <typename... Specs> struct KernelSpecList { };
+
+/** @brief The (dim, D1D, Q1D) specializations registered by default for the
+    partial assembly kernels of the integrators.
+
+    The list can be extended at build time by defining the macro
+    MFEM_PA_KERNEL_SPECS_EXTRA as a comma-separated list of KernelSpec%s, e.g.
+    -DMFEM_PA_KERNEL_SPECS_EXTRA="KernelSpec<3,8,12>,KernelSpec<3,9,12>". */
+#define MFEM_PA_KERNEL_SPECS_DEFAULT                                        \
+   /* 2D: Q1D = D1D, D1D+1, D1D+2, plus a few over-integrated rules */     \
+   KernelSpec<2,2,2>, KernelSpec<2,2,3>, KernelSpec<2,2,4>,                 \
+   KernelSpec<2,3,3>, KernelSpec<2,3,4>, KernelSpec<2,3,5>,                 \
+   KernelSpec<2,3,6>, KernelSpec<2,4,4>, KernelSpec<2,4,5>,                 \
+   KernelSpec<2,4,6>, KernelSpec<2,4,8>, KernelSpec<2,5,5>,                 \
+   KernelSpec<2,5,6>, KernelSpec<2,5,7>, KernelSpec<2,5,8>,                 \
+   KernelSpec<2,6,6>, KernelSpec<2,6,7>, KernelSpec<2,6,8>,                 \
+   KernelSpec<2,7,7>, KernelSpec<2,7,8>, KernelSpec<2,7,9>,                 \
+   KernelSpec<2,8,8>, KernelSpec<2,8,9>, KernelSpec<2,8,10>,                \
+   KernelSpec<2,9,9>, KernelSpec<2,9,10>, KernelSpec<2,9,11>,               \
+   /* 3D: Q1D = D1D, D1D+1, D1D+2, plus a few over-integrated rules */     \
+   KernelSpec<3,2,2>, KernelSpec<3,2,3>, KernelSpec<3,2,4>,                 \
+   KernelSpec<3,2,6>, KernelSpec<3,3,3>, KernelSpec<3,3,4>,                 \
+   KernelSpec<3,3,5>, KernelSpec<3,3,6>, KernelSpec<3,3,7>,                 \
+   KernelSpec<3,4,4>, KernelSpec<3,4,5>, KernelSpec<3,4,6>,                 \
+   KernelSpec<3,4,8>, KernelSpec<3,5,5>, KernelSpec<3,5,6>,                 \
+   KernelSpec<3,5,7>, KernelSpec<3,5,8>, KernelSpec<3,6,6>,                 \
+   KernelSpec<3,6,7>, KernelSpec<3,6,8>, KernelSpec<3,7,7>,                 \
+   KernelSpec<3,7,8>, KernelSpec<3,7,9>, KernelSpec<3,8,8>,                 \
+   KernelSpec<3,8,9>, KernelSpec<3,8,10>, KernelSpec<3,9,9>,                \
+   KernelSpec<3,9,10>, KernelSpec<3,9,11>
+
+#ifdef MFEM_PA_KERNEL_SPECS_EXTRA
+typedef KernelSpecList<MFEM_PA_KERNEL_SPECS_DEFAULT,
+        MFEM_PA_KERNEL_SPECS_EXTRA> PAKernelSpecs;
+#else
+typedef KernelSpecList<MFEM_PA_KERNEL_SPECS_DEFAULT> PAKernelSpecs;
+#endif
+
+/** @brief Global control and statistics of the generic kernels used by
+    KernelDispatchTable when no specialization is registered for the requested
+    (dim, D1D, Q1D).
+
+    The generic kernels use MAX_D1D/MAX_Q1D runtime bounds and are typically
+    several times slower than the specialized ones, so their use is always
+    counted. A warning or an abort can be requested with SetAction(). The
+    counters are protected by a lock, so kernels can be dispatched from
+    several host threads. */
+class KernelFallback
+{
+public:
+   /// What to do when a generic kernel is used.
+   enum Action
+   {
+      COUNT, ///< Only count the calls, see GetCount() (default).
+      WARN,  ///< Count and warn once per kernel and (dim, D1D, Q1D).
+      ABORT  ///< Abort, useful to check that a run only uses specializations.
+   };
+
+   /// Set the action performed when a generic kernel is used.
+   static void SetAction(Action action);
+
+   /// Get the action performed when a generic kernel is used.
+   static Action GetAction();
+
+   /// Return the total number of calls to generic kernels.
+   static long GetCount();
+
+   /// Return the number of calls to the generic version of @a kernel.
+   static long GetCount(const char *kernel);
+
+   /// Reset all the counters (and the record of the issued warnings).
+   static void Reset();
+
+   /// Print the number of calls to generic kernels for each kernel and size.
+   static void Print(std::ostream &out = mfem::out);
+
+   /// Record the use of the generic version of @a kernel, used internally by
+   /// KernelDispatchTable.
+   static void Report(const char *kernel, int dim, int d1d, int q1d);
+};
+
+/** @brief Table of compile-time specializations of a tensor-product kernel,
+    keyed by (dim, D1D, Q1D), with a generic fallback.
+
+    The template parameter Kernel is a class with:
+    - a typedef Signature, the function pointer type of the kernel; the
+      specialized and generic versions share this signature,
+    - a static method template Specialization<DIM,D1D,Q1D>() returning the
+      specialized kernel,
+    - a static method Fallback(int dim, int d1d, int q1d) returning the generic
+      kernel (with runtime sizes) for the given dimension,
+    - a static method Name() returning the name of the kernel, used for the
+      fallback statistics, see KernelFallback. */
+template <typename Kernel>
+class KernelDispatchTable
+{
+public:
+   typedef typename Kernel::Signature Signature;
+
+private:
+   std::unordered_map<int, Signature> table;
+
+   static int Key(int dim, int d1d, int q1d)
+   { return (dim << 16) | (d1d << 8) | q1d; }
+
+public:
+   /// Create a table with all the specializations in @a SpecList.
+   template <typename... Specs>
+   explicit KernelDispatchTable(KernelSpecList<Specs...>)
+   {
+      int unused[] = { 0, (AddSpecialization<Specs::DIM, Specs::D1D,
+                           Specs::Q1D>(), 0)... };
+      (void) unused;
+   }
+
+   /// Instantiate and register the (DIM, D1D, Q1D) specialization.
+   template <int DIM, int D1D, int Q1D>
+   void AddSpecialization()
+   {
+      table[Key(DIM, D1D, Q1D)] =
+         Kernel::template Specialization<DIM, D1D, Q1D>();
+   }
+
+   /// Return true if a specialization is registered for (dim, d1d, q1d).
+   bool Has(int dim, int d1d, int q1d) const
+   { return table.find(Key(dim, d1d, q1d)) != table.end(); }
+
+   /// Return the number of registered specializations.
+   int Size() const { return (int) table.size(); }
+
+   /** @brief Return the specialized kernel for (dim, d1d, q1d) if registered,
+       otherwise the generic one; the use of the latter is recorded by
+       KernelFallback. */
+   Signature Get(int dim, int d1d, int q1d) const
+   {
+      auto it = table.find(Key(dim, d1d, q1d));
+      if (it != table.end()) { return it->second; }
+      KernelFallback::Report(Kernel::Name(), dim, d1d, q1d);
+      return Kernel::Fallback(dim, d1d, q1d);
+   }
+};
+
+} // namespace mfem
+
+#endif // MFEM_KERNEL_DISPATCH_HPP
@@ -0,0 +1,660 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the batched dense linear algebra functions
+
+#include "batched.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+namespace internal
+{
+
+namespace batched
+{
+
+// The kernels below process, in each MFEM_FORALL iteration, a block of W
+// matrices stored in the interleaved layout, with W = 1 for the standard
+// layout, see BatchLayout. All the operations on the W matrices of a block are
+// performed in innermost loops over the lanes l = 0,...,W-1. The size T_N is
+// the compile-time value of the size n, or 0 for the generic kernels.
+
+// C = alpha op(A) B + beta C, where op(A) is m x n and B is n x p. The loops
+// are ordered for unit stride in the columns of A, or op(A) = A^t.
+struct MultKernel
+{
+   template <int T_N, int W>
+   static void Run(const int n, const int m, const int p, const int nb,
+                   const bool transA, const double alpha, const double beta,
+                   const double *a, const double *b, double *c)
+   {
+      const int N = T_N ? T_N : n;
+      const auto A = transA ? Reshape(a, W, N, m, nb) : Reshape(a, W, m, N, nb);
+      const auto B = Reshape(b, W, N, p, nb);
+      auto C = Reshape(c, W, m, p, nb);
+      MFEM_FORALL(e, nb,
+      {
+         for (int j = 0; j < p; j++)
+         {
+            if (transA)
+            {
+               // C(i,j) = alpha sum_k A(k,i) B(k,j) + beta C(i,j)
+               for (int i = 0; i < m; i++)
+               {
+                  double s[W];
+                  for (int l = 0; l < W; l++) { s[l] = 0.0; }
+                  for (int k = 0; k < N; k++)
+                  {
+                     for (int l = 0; l < W; l++)
+                     {
+                        s[l] += A(l,k,i,e)*B(l,k,j,e);
+                     }
+                  }
+                  for (int l = 0; l < W; l++)
+                  {
+                     C(l,i,j,e) = (beta == 0.0) ? alpha*s[l] :
+                                  alpha*s[l] + beta*C(l,i,j,e);
+                  }
+               }
+               continue;
+            }
+            // C(:,j) = beta C(:,j) + sum_k A(:,k) alpha B(k,j)
+            for (int i = 0; i < m; i++)
+            {
+               for (int l = 0; l < W; l++)
+               {
+                  C(l,i,j,e) = (beta == 0.0) ? 0.0 : beta*C(l,i,j,e);
+               }
+            }
+            for (int k = 0; k < N; k++)
+            {
+               double b_kj[W];
+               for (int l = 0; l < W; l++) { b_kj[l] = alpha*B(l,k,j,e); }
+               for (int i = 0; i < m; i++)
+               {
+                  for (int l = 0; l < W; l++)
+                  {
+                     C(l,i,j,e) += A(l,i,k,e)*b_kj[l];
+                  }
+               }
+            }
+         }
+      });
+   }
+};
+
+// In-place Cholesky factorization A = L L^t, column by column
+struct CholeskyKernel
+{
+   template <int T_N, int W>
+   static void Run(const int n, const int nb, double *a, bool *d_spd_flag)
+   {
+      const int N = T_N ? T_N : n;
+      auto A = Reshape(a, W, N, N, nb);
+      MFEM_FORALL(e, nb,
+      {
+         for (int j = 0; j < N; j++)
+         {
+            // A(j:,j) -= L(j:,k) L(j,k) for k < j
+            for (int k = 0; k < j; k++)
+            {
+               double l_jk[W];
+               for (int l = 0; l < W; l++) { l_jk[l] = A(l,j,k,e); }
+               for (int i = j; i < N; i++)
+               {
+                  for (int l = 0; l < W; l++)
+                  {
+                     A(l,i,j,e) -= A(l,i,k,e)*l_jk[l];
+                  }
+               }
+            }
+            double d[W];
+            for (int l = 0; l < W; l++)
+            {
+               d[l] = A(l,j,j,e);
+               if (!(d[l] > 0.0))
+               {
+                  d_spd_flag[0] = false;
+                  d[l] = 1.0;
+               }
+               d[l] = sqrt(d[l]);
+               A(l,j,j,e) = d[l];
+               d[l] = 1.0/d[l];
+            }
+            for (int i = j+1; i < N; i++)
+            {
+               for (int l = 0; l < W; l++)
+               {
+                  A(l,i,j,e) *= d[l];
+                  A(l,j,i,e) = 0.0;
+               }
+            }
+         }
+      });
+   }
+};
+
+// Solve T x = b or T^t x = b with T triangular: column oriented substitution
+// for T, dot products for T^t
+struct TriangularSolveKernel
+{
+   template <int T_N, int W>
+   static void Run(const int n, const int nb, const bool lower,
+                   const bool transpose, const double *t, double *x)
+   {
+      const int N = T_N ? T_N : n;
+      const auto T = Reshape(t, W, N, N, nb);
+      auto X = Reshape(x, W, N, nb);
+      // Forward substitution for lower triangular op(T)
+      const bool forward = (lower != transpose);
+      MFEM_FORALL(e, nb,
+      {
+         for (int kk = 0; kk < N; kk++)
+         {
+            const int k = forward ? kk : N-1-kk;
+            if (transpose)
+            {
+               const int i_begin = forward ? 0 : k+1;
+               const int i_end = forward ? k : N;
+               double s[W];
+               for (int l = 0; l < W; l++) { s[l] = X(l,k,e); }
+               for (int i = i_begin; i < i_end; i++)
+               {
+                  for (int l = 0; l < W; l++) { s[l] -= T(l,i,k,e)*X(l,i,e); }
+               }
+               for (int l = 0; l < W; l++) { X(l,k,e) = s[l] / T(l,k,k,e); }
+            }
+            else
+            {
+               const int i_begin = forward ? k+1 : 0;
+               const int i_end = forward ? N : k;
+               double x_k[W];
+               for (int l = 0; l < W; l++)
+               {
+                  x_k[l] = X(l,k,e) / T(l,k,k,e);
+                  X(l,k,e) = x_k[l];
+               }
+               for (int i = i_begin; i < i_end; i++)
+               {
+                  for (int l = 0; l < W; l++) { X(l,i,e) -= T(l,i,k,e)*x_k[l]; }
+               }
+            }
+         }
+      });
+   }
+};
+
+// In-place Gauss-Jordan inversion with partial pivoting
+struct InverseKernel
+{
+   template <int T_N, int W>
+   static void Run(const int n, const int nb, double *a, int *piv,
+                   bool *d_pivot_flag)
+   {
+      const int N = T_N ? T_N : n;
+      auto A = Reshape(a, W, N, N, nb);
+      auto P = Reshape(piv, W, N, nb);
+      MFEM_FORALL(e, nb,
+      {
+         for (int k = 0; k < N; k++)
+         {
+            double d[W];
+            for (int l = 0; l < W; l++)
+            {
+               int p = k;
+               double a_max = fabs(A(l,k,k,e));
+               for (int i = k+1; i < N; i++)
+               {
+                  const double a_ik = fabs(A(l,i,k,e));
+                  if (a_ik > a_max)
+                  {
+                     a_max = a_ik;
+                     p = i;
+                  }
+               }
+               P(l,k,e) = p;
+               if (p != k)
+               {
+                  for (int j = 0; j < N; j++)
+                  {
+                     const double tmp = A(l,k,j,e);
+                     A(l,k,j,e) = A(l,p,j,e);
+                     A(l,p,j,e) = tmp;
+                  }
+               }
+               if (a_max == 0.0)
+               {
+                  d_pivot_flag[0] = false;
+                  A(l,k,k,e) = 1.0;
+               }
+               d[l] = 1.0/A(l,k,k,e);
+               A(l,k,k,e) = 1.0;
+            }
+            for (int j = 0; j < N; j++)
+            {
+               for (int l = 0; l < W; l++) { A(l,k,j,e) *= d[l]; }
+            }
+            // Eliminate column k from the other rows, column by column: the
+            // factors A(i,k) are updated last and A(k,k) is set to zero
+            // meanwhile, to leave row k unchanged
+            for (int l = 0; l < W; l++) { A(l,k,k,e) = 0.0; }
+            for (int j = 0; j < N; j++)
+            {
+               if (j == k) { continue; }
+               double a_kj[W];
+               for (int l = 0; l < W; l++) { a_kj[l] = A(l,k,j,e); }
+               for (int i = 0; i < N; i++)
+               {
+                  for (int l = 0; l < W; l++)
+                  {
+                     A(l,i,j,e) -= A(l,i,k,e)*a_kj[l];
+                  }
+               }
+            }
+            for (int i = 0; i < N; i++)
+            {
+               for (int l = 0; l < W; l++) { A(l,i,k,e) *= -d[l]; }
+            }
+            for (int l = 0; l < W; l++) { A(l,k,k,e) = d[l]; }
+         }
+         // Undo the row permutations, on the columns of the inverse
+         for (int k = N-1; k >= 0; k--)
+         {
+            for (int l = 0; l < W; l++)
+            {
+               const int p = P(l,k,e);
+               if (p == k) { continue; }
+               for (int i = 0; i < N; i++)
+               {
+                  const double tmp = A(l,i,k,e);
+                  A(l,i,k,e) = A(l,i,p,e);
+                  A(l,i,p,e) = tmp;
+               }
+            }
+         }
+      });
+   }
+};
+
+// Cyclic Jacobi eigensolver: D is overwritten with the diagonal matrix of the
+// eigenvalues, in ascending order
+struct EigensystemKernel
+{
+   template <int T_N, int W>
+   static void Run(const int n, const int nb, double *d, double *v,
+                   double *ev)
+   {
+      const int N = T_N ? T_N : n;
+      const int max_sweeps = 50;
+      auto D = Reshape(d, W, N, N, nb);
+      auto V = Reshape(v, W, N, N, nb);
+      auto EV = Reshape(ev, W, N, nb);
+      MFEM_FORALL(e, nb,
+      {
+         for (int j = 0; j < N; j++)
+         {
+            for (int i = 0; i < N; i++)
+            {
+               for (int l = 0; l < W; l++) { V(l,i,j,e) = (i == j); }
+            }
+         }
+         for (int sweep = 0; sweep < max_sweeps; sweep++)
+         {
+            double off = 0.0, diag = 0.0;
+            for (int j = 0; j < N; j++)
+            {
+               for (int i = 0; i < j; i++)
+               {
+                  for (int l = 0; l < W; l++) { off += D(l,i,j,e)*D(l,i,j,e); }
+               }
+               for (int l = 0; l < W; l++) { diag += D(l,j,j,e)*D(l,j,j,e); }
+            }
+            if (off <= 1e-32*diag) { break; }
+
+            for (int p = 0; p < N; p++)
+            {
+               for (int q = p+1; q < N; q++)
+               {
+                  // Rotation in the (p,q) plane annihilating D(p,q)
+                  double c[W] = {}, s[W] = {};
+                  for (int l = 0; l < W; l++)
+                  {
+                     const double d_pq = D(l,p,q,e);
+                     if (d_pq == 0.0)
+                     {
+                        c[l] = 1.0;
+                        s[l] = 0.0;
+                        continue;
+                     }
+                     const double theta = (D(l,q,q,e) - D(l,p,p,e))/(2.0*d_pq);
+                     const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                                      (fabs(theta) + sqrt(theta*theta + 1.0));
+                     c[l] = 1.0/sqrt(t*t + 1.0);
+                     s[l] = t*c[l];
+                  }
+                  // D <- D J, V <- V J
+                  for (int k = 0; k < N; k++)
+                  {
+                     for (int l = 0; l < W; l++)
+                     {
+                        const double d_kp = D(l,k,p,e), d_kq = D(l,k,q,e);
+                        D(l,k,p,e) = c[l]*d_kp - s[l]*d_kq;
+                        D(l,k,q,e) = s[l]*d_kp + c[l]*d_kq;
+                        const double v_kp = V(l,k,p,e), v_kq = V(l,k,q,e);
+                        V(l,k,p,e) = c[l]*v_kp - s[l]*v_kq;
+                        V(l,k,q,e) = s[l]*v_kp + c[l]*v_kq;
+                     }
+                  }
+                  // D <- J^t D
+                  for (int k = 0; k < N; k++)
+                  {
+                     for (int l = 0; l < W; l++)
+                     {
+                        const double d_pk = D(l,p,k,e), d_qk = D(l,q,k,e);
+                        D(l,p,k,e) = c[l]*d_pk - s[l]*d_qk;
+                        D(l,q,k,e) = s[l]*d_pk + c[l]*d_qk;
+                     }
+                  }
+               }
+            }
+         }
+         // Sort the eigenvalues and the eigenvectors
+         for (int l = 0; l < W; l++)
+         {
+            for (int i = 0; i < N; i++)
+            {
+               int k = i;
+               for (int j = i+1; j < N; j++)
+               {
+                  if (D(l,j,j,e) < D(l,k,k,e)) { k = j; }
+               }
+               if (k != i)
+               {
+                  const double tmp = D(l,i,i,e);
+                  D(l,i,i,e) = D(l,k,k,e);
+                  D(l,k,k,e) = tmp;
+                  for (int j = 0; j < N; j++)
+                  {
+                     const double v_ji = V(l,j,i,e);
+                     V(l,j,i,e) = V(l,j,k,e);
+                     V(l,j,k,e) = v_ji;
+                  }
+               }
+               EV(l,i,e) = D(l,i,i,e);
+            }
+         }
+      });
+   }
+};
+
+// Call the specialization of Kernel for the size n, if any
+template <typename Kernel, int W, typename... Args>
+static void DispatchSize(const int n, Args... args)
+{
+   switch (n)
+   {
+      case 1: return Kernel::template Run<1,W>(n, args...);
+      case 2: return Kernel::template Run<2,W>(n, args...);
+      case 3: return Kernel::template Run<3,W>(n, args...);
+      case 4: return Kernel::template Run<4,W>(n, args...);
+      case 5: return Kernel::template Run<5,W>(n, args...);
+      case 6: return Kernel::template Run<6,W>(n, args...);
+      case 7: return Kernel::template Run<7,W>(n, args...);
+      case 8: return Kernel::template Run<8,W>(n, args...);
+      case 9: return Kernel::template Run<9,W>(n, args...);
+      case 10: return Kernel::template Run<10,W>(n, args...);
+      case 12: return Kernel::template Run<12,W>(n, args...);
+      case 16: return Kernel::template Run<16,W>(n, args...);
+      case 20: return Kernel::template Run<20,W>(n, args...);
+      case 25: return Kernel::template Run<25,W>(n, args...);
+      case 27: return Kernel::template Run<27,W>(n, args...);
+      case 32: return Kernel::template Run<32,W>(n, args...);
+      case 36: return Kernel::template Run<36,W>(n, args...);
+      case 49: return Kernel::template Run<49,W>(n, args...);
+      case 64: return Kernel::template Run<64,W>(n, args...);
+      default: return Kernel::template Run<0,W>(n, args...);
+   }
+}
+
+template <typename Kernel, typename... Args>
+static void Dispatch(const BatchLayout layout, const int n, Args... args)
+{
+   if (layout == BatchLayout::INTERLEAVED)
+   {
+      DispatchSize<Kernel,BATCH_SIMD_WIDTH>(n, args...);
+   }
+   else
+   {
+      DispatchSize<Kernel,1>(n, args...);
+   }
+}
+
+// Number of kernel iterations for a batch of nk matrices
+static int NumBlocks(const int nk, const BatchLayout layout)
+{
+   if (layout == BatchLayout::STANDARD) { return nk; }
+   MFEM_VERIFY(nk % BATCH_SIMD_WIDTH == 0,
+               "the number of matrices must be a multiple of BATCH_SIMD_WIDTH");
+   return nk / BATCH_SIMD_WIDTH;
+}
+
+static void SetSize(DenseTensor &A, const int i, const int j, const int k)
+{
+   if (A.SizeI() != i || A.SizeJ() != j || A.SizeK() != k)
+   {
+      A.SetSize(i, j, k);
+   }
+}
+
+static void Mult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C,
+                 const bool transA, const double alpha, const double beta,
+                 const BatchLayout layout)
+{
+   const int nk = A.SizeK();
+   const int m = transA ? A.SizeJ() : A.SizeI();
+   const int n = transA ? A.SizeI() : A.SizeJ();
+   const int p = B.SizeJ();
+   MFEM_VERIFY(B.SizeI() == n && B.SizeK() == nk, "incompatible dimensions");
+   if (beta == 0.0) { SetSize(C, m, p, nk); }
+   MFEM_VERIFY(C.SizeI() == m && C.SizeJ() == p && C.SizeK() == nk,
+               "incompatible dimensions");
+   const int nb = NumBlocks(nk, layout);
+   Dispatch<MultKernel>(layout, n, m, p, nb, transA, alpha, beta, A.Read(),
+                        B.Read(), beta == 0.0 ? C.Write() : C.ReadWrite());
+}
+
+static void Mult(const DenseTensor &A, const Vector &x, Vector &y,
+                 const bool transA, const double alpha, const double beta,
+                 const BatchLayout layout)
+{
+   const int nk = A.SizeK();
+   const int m = transA ? A.SizeJ() : A.SizeI();
+   const int n = transA ? A.SizeI() : A.SizeJ();
+   MFEM_VERIFY(x.Size() == n*nk, "incompatible dimensions");
+   if (beta == 0.0) { y.SetSize(m*nk); }
+   MFEM_VERIFY(y.Size() == m*nk, "incompatible dimensions");
+   const int nb = NumBlocks(nk, layout);
+   Dispatch<MultKernel>(layout, n, m, 1, nb, transA, alpha, beta, A.Read(),
+                        x.Read(), beta == 0.0 ? y.Write() : y.ReadWrite());
+}
+
+} // namespace batched
+
+} // namespace internal
+
+void BatchInterleave(const DenseTensor &A, DenseTensor &Ai)
+{
+   constexpr int W = BATCH_SIMD_WIDTH;
+   const int m = A.SizeI(), n = A.SizeJ(), ne = A.SizeK();
+   const int nb = (ne + W - 1) / W;
+   internal::batched::SetSize(Ai, m, n, nb*W);
+   const auto d_A = Reshape(A.Read(), m, n, ne);
+   auto d_Ai = Reshape(Ai.Write(), W, m, n, nb);
+   MFEM_FORALL(idx, W*m*n*nb,
+   {
+      const int l = idx % W;
+      const int i = (idx / W) % m;
+      const int j = (idx / (W*m)) % n;
+      const int b = idx / (W*m*n);
+      const int e = b*W + l;
+      d_Ai(l,i,j,b) = (e < ne) ? d_A(i,j,e) : (i == j ? 1.0 : 0.0);
+   });
+}
+
+void BatchDeinterleave(const DenseTensor &Ai, const int ne, DenseTensor &A)
+{
+   constexpr int W = BATCH_SIMD_WIDTH;
+   const int m = Ai.SizeI(), n = Ai.SizeJ();
+   const int nb = internal::batched::NumBlocks(Ai.SizeK(),
+                                               BatchLayout::INTERLEAVED);
+   MFEM_VERIFY(ne <= nb*W, "invalid number of matrices");
+   internal::batched::SetSize(A, m, n, ne);
+   const auto d_Ai = Reshape(Ai.Read(), W, m, n, nb);
+   auto d_A = Reshape(A.Write(), m, n, ne);
+   MFEM_FORALL(idx, m*n*ne,
+   {
+      const int i = idx % m;
+      const int j = (idx / m) % n;
+      const int e = idx / (m*n);
+      d_A(i,j,e) = d_Ai(e % W, i, j, e / W);
+   });
+}
+
+void BatchInterleave(const Vector &x, const int m, Vector &xi)
+{
+   constexpr int W = BATCH_SIMD_WIDTH;
+   MFEM_VERIFY(m > 0 && x.Size() % m == 0, "invalid vector size");
+   const int ne = x.Size() / m;
+   const int nb = (ne + W - 1) / W;
+   xi.SetSize(W*m*nb);
+   const auto X = Reshape(x.Read(), m, ne);
+   auto XI = Reshape(xi.Write(), W, m, nb);
+   MFEM_FORALL(idx, W*m*nb,
+   {
+      const int l = idx % W;
+      const int i = (idx / W) % m;
+      const int b = idx / (W*m);
+      const int e = b*W + l;
+      XI(l,i,b) = (e < ne) ? X(i,e) : 0.0;
+   });
+}
+
+void BatchDeinterleave(const Vector &xi, const int m, const int ne, Vector &x)
+{
+   constexpr int W = BATCH_SIMD_WIDTH;
+   MFEM_VERIFY(m > 0 && xi.Size() % (W*m) == 0, "invalid vector size");
+   const int nb = xi.Size() / (W*m);
+   MFEM_VERIFY(ne <= nb*W, "invalid number of vectors");
+   x.SetSize(m*ne);
+   const auto XI = Reshape(xi.Read(), W, m, nb);
+   auto X = Reshape(x.Write(), m, ne);
+   MFEM_FORALL(idx, m*ne,
+   {
+      const int i = idx % m;
+      const int e = idx / m;
+      X(i,e) = XI(e % W, i, e / W);
+   });
+}
+
+void BatchMult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C,
+               const double alpha, const double beta, const BatchLayout layout)
+{
+   internal::batched::Mult(A, B, C, false, alpha, beta, layout);
+}
+
+void BatchMultAtB(const DenseTensor &A, const DenseTensor &B, DenseTensor &C,
+                  const double alpha, const double beta,
+                  const BatchLayout layout)
+{
+   internal::batched::Mult(A, B, C, true, alpha, beta, layout);
+}
+
+void BatchMult(const DenseTensor &A, const Vector &x, Vector &y,
+               const double alpha, const double beta, const BatchLayout layout)
+{
+   internal::batched::Mult(A, x, y, false, alpha, beta, layout);
+}
+
+void BatchMultTranspose(const DenseTensor &A, const Vector &x, Vector &y,
+                        const double alpha, const double beta,
+                        const BatchLayout layout)
+{
+   internal::batched::Mult(A, x, y, true, alpha, beta, layout);
+}
+
+void BatchCholeskyFactor(DenseTensor &A, const BatchLayout layout)
+{
+   using namespace internal::batched;
+   const int m = A.SizeI();
+   MFEM_VERIFY(A.SizeJ() == m, "the matrices must be square");
+   const int nb = NumBlocks(A.SizeK(), layout);
+   Array<bool> spd_flag(1);
+   spd_flag[0] = true;
+   Dispatch<CholeskyKernel>(layout, m, nb, A.ReadWrite(),
+                            spd_flag.ReadWrite());
+   MFEM_VERIFY(spd_flag.HostRead()[0],
+               "Batch Cholesky factorization failed: the matrices must be SPD");
+}
+
+void BatchCholeskySolve(const DenseTensor &L, Vector &X,
+                        const BatchLayout layout)
+{
+   BatchTriangularSolve(L, X, true, false, layout);
+   BatchTriangularSolve(L, X, true, true, layout);
+}
+
+void BatchTriangularSolve(const DenseTensor &T, Vector &X, const bool lower,
+                          const bool transpose, const BatchLayout layout)
+{
+   using namespace internal::batched;
+   const int m = T.SizeI();
+   MFEM_VERIFY(T.SizeJ() == m, "the matrices must be square");
+   MFEM_VERIFY(X.Size() == m*T.SizeK(), "incompatible dimensions");
+   const int nb = NumBlocks(T.SizeK(), layout);
+   Dispatch<TriangularSolveKernel>(layout, m, nb, lower, transpose, T.Read(),
+                                   X.ReadWrite());
+}
+
+void BatchInverse(const DenseTensor &A, DenseTensor &Ainv,
+                  const BatchLayout layout)
+{
+   using namespace internal::batched;
+   const int m = A.SizeI(), nk = A.SizeK();
+   MFEM_VERIFY(A.SizeJ() == m, "the matrices must be square");
+   const int nb = NumBlocks(nk, layout);
+   SetSize(Ainv, m, m, nk);
+   Ainv.GetMemory().CopyFrom(A.GetMemory(), m*m*nk);
+   Array<int> piv(m*nk);
+   Array<bool> pivot_flag(1);
+   pivot_flag[0] = true;
+   Dispatch<InverseKernel>(layout, m, nb, Ainv.ReadWrite(), piv.Write(),
+                           pivot_flag.ReadWrite());
+   MFEM_VERIFY(pivot_flag.HostRead()[0],
+               "Batch inversion failed: singular matrix");
+}
+
+void BatchSymmetricEigensystem(const DenseTensor &A, Vector &ev,
+                               DenseTensor &evect, const BatchLayout layout)
+{
+   using namespace internal::batched;
+   const int m = A.SizeI(), nk = A.SizeK();
+   MFEM_VERIFY(A.SizeJ() == m, "the matrices must be square");
+   const int nb = NumBlocks(nk, layout);
+   DenseTensor D(A);
+   SetSize(evect, m, m, nk);
+   ev.SetSize(m*nk);
+   Dispatch<EigensystemKernel>(layout, m, nb, D.ReadWrite(), evect.Write(),
+                               ev.Write());
+}
+
+} // namespace mfem
@@ -0,0 +1,182 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BATCHED
+#define MFEM_BATCHED
+
+#include "../config/config.hpp"
+#include "simd.hpp"
+#include "densemat.hpp"
+
+namespace mfem
+{
+
+/** @name Batched dense linear algebra
+
+    The following functions apply the same operation to all the matrices of a
+    DenseTensor, e.g. the element matrices of a mesh, with one MFEM_FORALL
+    kernel, so they run on all the mfem::Device backends. The kernels are
+    specialized at compile time for the matrix sizes 1-10, 12, 16, 20, 25, 27,
+    32, 36, 49 and 64 (for the inner dimension of the products); other sizes use
+    a generic kernel.
+
+    The matrices and the vectors are stored either in the layout of DenseTensor
+    (BatchLayout::STANDARD) or interleaved in blocks of BATCH_SIMD_WIDTH
+    matrices (BatchLayout::INTERLEAVED), see BatchInterleave(). In the latter
+    case, each kernel iteration processes the matrices of a block together, in
+    innermost loops with unit stride which the compiler vectorizes. */
+///@{
+
+#ifdef MFEM_USE_SIMD
+/// Number of matrices in a block of the interleaved layout, see BatchLayout.
+const int BATCH_SIMD_WIDTH = MFEM_SIMD_BYTES/sizeof(double);
+#else
+const int BATCH_SIMD_WIDTH = 4;
+#endif
+
+/// Memory layout of the matrices and vectors of the batched functions.
+enum class BatchLayout
+{
+   /** The layout of DenseTensor: the m x n matrices are stored one after the
+       other, column-major, and the vectors of size m one after the other. */
+   STANDARD,
+   /** The matrices are grouped in blocks of BATCH_SIMD_WIDTH and the entries of
+       the matrices of a block are stored next to each other, i.e. the layout is
+       [nb][n][m][BATCH_SIMD_WIDTH] (the last index is the fastest), and
+       [nb][m][BATCH_SIMD_WIDTH] for the vectors. The number of matrices,
+       DenseTensor::SizeK(), must be a multiple of BATCH_SIMD_WIDTH. */
+   INTERLEAVED
+};
+
+/** @brief Convert the batch of matrices @a A to the interleaved layout @a Ai,
+    see BatchLayout. The number of matrices of @a Ai is rounded up to a multiple
+    of BATCH_SIMD_WIDTH, the additional matrices are set to the identity. */
+void BatchInterleave(const DenseTensor &A, DenseTensor &Ai);
+
+/** @brief Convert the batch of matrices @a Ai in the interleaved layout to the
+    standard layout @a A, keeping the first @a ne matrices. */
+void BatchDeinterleave(const DenseTensor &Ai, const int ne, DenseTensor &A);
+
+/** @brief Convert the batch of vectors of size @a m in @a x to the interleaved
+    layout @a xi, see BatchLayout. The padding entries are set to zero. */
+void BatchInterleave(const Vector &x, const int m, Vector &xi);
+
+/** @brief Convert the batch of vectors of size @a m in the interleaved layout
+    @a xi to the standard layout @a x, keeping the first @a ne vectors. */
+void BatchDeinterleave(const Vector &xi, const int m, const int ne, Vector &x);
+
+/** @brief Batched matrix-matrix product (GEMM): C = alpha A B + beta C for
+    each matrix of the batch.
+
+    @param [in] A batch of matrices - dimension m x k x ne.
+    @param [in] B batch of matrices - dimension k x n x ne.
+    @param [in,out] C batch of matrices - dimension m x n x ne, resized when
+    @a beta is 0.
+    @param [in] alpha scaling of the product.
+    @param [in] beta scaling of @a C; when 0, the input @a C is not read.
+    @param [in] layout the layout of the matrices. */
+void BatchMult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C,
+               const double alpha = 1.0, const double beta = 0.0,
+               const BatchLayout layout = BatchLayout::STANDARD);
+
+/** @brief Batched matrix-matrix product with the transpose of @a A:
+    C = alpha A^t B + beta C, where @a A has dimension k x m x ne, see
+    BatchMult(const DenseTensor&, const DenseTensor&, DenseTensor&,
+    const double, const double, const BatchLayout). */
+void BatchMultAtB(const DenseTensor &A, const DenseTensor &B, DenseTensor &C,
+                  const double alpha = 1.0, const double beta = 0.0,
+                  const BatchLayout layout = BatchLayout::STANDARD);
+
+/** @brief Batched matrix-vector product (GEMV): y = alpha A x + beta y for
+    each matrix of the batch.
+
+    @param [in] A batch of matrices - dimension m x n x ne.
+    @param [in] x batch of vectors - dimension n x ne.
+    @param [in,out] y batch of vectors - dimension m x ne, resized when @a beta
+    is 0.
+    @param [in] alpha scaling of the product.
+    @param [in] beta scaling of @a y; when 0, the input @a y is not read.
+    @param [in] layout the layout of the matrices and vectors. */
+void BatchMult(const DenseTensor &A, const Vector &x, Vector &y,
+               const double alpha = 1.0, const double beta = 0.0,
+               const BatchLayout layout = BatchLayout::STANDARD);
+
+/** @brief Batched transposed matrix-vector product: y = alpha A^t x + beta y,
+    see BatchMult(const DenseTensor&, const Vector&, Vector&, const double,
+    const double, const BatchLayout). */
+void BatchMultTranspose(const DenseTensor &A, const Vector &x, Vector &y,
+                        const double alpha = 1.0, const double beta = 0.0,
+                        const BatchLayout layout = BatchLayout::STANDARD);
+
+/** @brief Compute the Cholesky factorization A = L L^t of a batch of symmetric
+    positive definite matrices.
+
+    @param [in,out] A batch of matrices - dimension m x m x ne; overwritten with
+    the lower triangular factors L, the strictly upper triangular parts are set
+    to zero. Only the lower triangular parts of the input are used.
+    @param [in] layout the layout of the matrices.
+
+    The function aborts if one of the matrices is not positive definite. */
+void BatchCholeskyFactor(DenseTensor &A,
+                         const BatchLayout layout = BatchLayout::STANDARD);
+
+/** @brief Solve the batch linear systems A x = b with the Cholesky factors
+    computed by BatchCholeskyFactor().
+
+    @param [in] L batch of Cholesky factors - dimension m x m x ne.
+    @param [in,out] X vector storing the right-hand sides and then the
+    solutions - dimension m x ne.
+    @param [in] layout the layout of the matrices and vectors. */
+void BatchCholeskySolve(const DenseTensor &L, Vector &X,
+                        const BatchLayout layout = BatchLayout::STANDARD);
+
+/** @brief Solve the batch triangular systems T x = b, or T^t x = b.
+
+    @param [in] T batch of triangular matrices - dimension m x m x ne. Only the
+    lower (or upper) triangular parts are used.
+    @param [in,out] X vector storing the right-hand sides and then the
+    solutions - dimension m x ne.
+    @param [in] lower if true T is lower triangular, otherwise upper triangular.
+    @param [in] transpose if true solve T^t x = b.
+    @param [in] layout the layout of the matrices and vectors. */
+void BatchTriangularSolve(const DenseTensor &T, Vector &X,
+                          const bool lower = true, const bool transpose = false,
+                          const BatchLayout layout = BatchLayout::STANDARD);
+
+/** @brief Compute the inverses of a batch of matrices, by Gauss-Jordan
+    elimination with partial pivoting.
+
+    @param [in] A batch of matrices - dimension m x m x ne.
+    @param [out] Ainv batch of inverses - dimension m x m x ne, resized.
+    @param [in] layout the layout of the matrices.
+
+    The function aborts if one of the matrices is singular. */
+void BatchInverse(const DenseTensor &A, DenseTensor &Ainv,
+                  const BatchLayout layout = BatchLayout::STANDARD);
+
+/** @brief Compute the eigenvalues and the eigenvectors of a batch of symmetric
+    matrices, with the cyclic Jacobi method.
+
+    @param [in] A batch of symmetric matrices - dimension m x m x ne.
+    @param [out] ev batch of eigenvalues in ascending order - dimension m x ne,
+    resized.
+    @param [out] evect batch of orthonormal eigenvectors, stored in the columns
+    in the order of @a ev - dimension m x m x ne, resized.
+    @param [in] layout the layout of the matrices and vectors. */
+void BatchSymmetricEigensystem(
+   const DenseTensor &A, Vector &ev, DenseTensor &evect,
+   const BatchLayout layout = BatchLayout::STANDARD);
+
+///@}
+
+} // namespace mfem
+
+#endif
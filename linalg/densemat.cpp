@@ -2877,55 +2877,8 @@ bool LUFactors::Factor(int m, double TOL)
    return info == 0;
 #else
    // compiling without LAPACK
-   double *data = this->data;
-   for (int i = 0; i < m; i++)
-   {
-      // pivoting
-      {
-         int piv = i;
-         double a = std::abs(data[piv+i*m]);
-         for (int j = i+1; j < m; j++)
-         {
-            const double b = std::abs(data[j+i*m]);
-            if (b > a)
-            {
-               a = b;
-               piv = j;
-            }
-         }
-         ipiv[i] = piv;
-         if (piv != i)
-         {
-            // swap rows i and piv in both L and U parts
-            for (int j = 0; j < m; j++)
-            {
-               mfem::Swap<double>(data[i+j*m], data[piv+j*m]);
-            }
-         }
-      }
-
-      if (abs(data[i + i*m]) <= TOL)
-      {
-         return false; // failed
-      }
-
-      const double a_ii_inv = 1.0 / data[i+i*m];
-      for (int j = i+1; j < m; j++)
-      {
-         data[j+i*m] *= a_ii_inv;
-      }
-      for (int k = i+1; k < m; k++)
-      {
-         const double a_ik = data[i+k*m];
-         for (int j = i+1; j < m; j++)
-         {
-            data[j+k*m] -= a_ik * data[j+i*m];
-         }
-      }
-   }
+   return kernels::LUFactor(data, m, ipiv, TOL);
 #endif
-
-   return true; // success
 }
 
 double LUFactors::Det(int m) const
@@ -3532,57 +3485,42 @@ void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL)
 
    MFEM_FORALL(e, NE,
    {
-      for (int i = 0; i < m; i++)
+      if (!kernels::LUFactor(&data_all(0,0,e), m, &ipiv_all(0,e), TOL))
       {
-         // pivoting
-         {
-            int piv = i;
-            double a = fabs(data_all(piv,i,e));
-            for (int j = i+1; j < m; j++)
-            {
-               const double b = fabs(data_all(j,i,e));
-               if (b > a)
-               {
-                  a = b;
-                  piv = j;
-               }
-            }
-            ipiv_all(i,e) = piv;
-            if (piv != i)
-            {
-               // swap rows i and piv in both L and U parts
-               for (int j = 0; j < m; j++)
-               {
-                  mfem::kernels::internal::Swap<double>(data_all(i,j,e), data_all(piv,j,e));
-               }
-            }
-         } // pivot end
+         d_pivot_flag[0] = false;
+      }
+   });
 
-         if (abs(data_all(i,i,e)) <= TOL)
-         {
-            d_pivot_flag[0] = false;
-         }
+   MFEM_ASSERT(pivot_flag.HostRead()[0], "Batch LU factorization failed \n");
+}
 
-         const double a_ii_inv = 1.0 / data_all(i,i,e);
-         for (int j = i+1; j < m; j++)
-         {
-            data_all(j,i,e) *= a_ii_inv;
-         }
+void BatchLUFactor(const DenseTensor &M, Array<float> &Mlu, Array<int> &P,
+                   const double TOL)
+{
+   const int m = M.SizeI();
+   const int NE = M.SizeK();
+   Mlu.SetSize(m*m*NE);
+   P.SetSize(m*NE);
 
-         for (int k = i+1; k < m; k++)
-         {
-            const double a_ik = data_all(i,k,e);
-            for (int j = i+1; j < m; j++)
-            {
-               data_all(j,k,e) -= a_ik * data_all(j,i,e);
-            }
-         }
+   const auto d_M = M.Read();
+   auto d_Mlu = Mlu.Write();
+   MFEM_FORALL(i, m*m*NE, d_Mlu[i] = (float) d_M[i]; );
 
-      } // m loop
+   auto data_all = mfem::Reshape(d_Mlu, m, m, NE);
+   auto ipiv_all = mfem::Reshape(P.Write(), m, NE);
+   Array<bool> pivot_flag(1);
+   pivot_flag[0] = true;
+   bool *d_pivot_flag = pivot_flag.ReadWrite();
 
+   MFEM_FORALL(e, NE,
+   {
+      if (!kernels::LUFactor(&data_all(0,0,e), m, &ipiv_all(0,e), TOL))
+      {
+         d_pivot_flag[0] = false;
+      }
    });
 
-   MFEM_ASSERT(pivot_flag.HostRead()[0], "Batch LU factorization failed \n");
+   MFEM_VERIFY(pivot_flag.HostRead()[0], "Batch LU factorization failed");
 }
 
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
@@ -3602,4 +3540,21 @@ void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
 
 }
 
+void BatchLUSolve(const Array<float> &Mlu, const Array<int> &P, Vector &X)
+{
+   const int mNE = P.Size();
+   const int m = mNE ? Mlu.Size() / mNE : 0;
+   const int NE = m ? mNE / m : 0;
+   MFEM_VERIFY(X.Size() == mNE, "incompatible vector size");
+
+   auto data_all = mfem::Reshape(Mlu.Read(), m, m, NE);
+   auto piv_all = mfem::Reshape(P.Read(), m, NE);
+   auto x_all = mfem::Reshape(X.ReadWrite(), m, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      kernels::LUSolve(&data_all(0,0,e), m, &piv_all(0,e), &x_all(0,e));
+   });
+}
+
 } // namespace mfem
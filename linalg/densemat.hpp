@@ -915,6 +915,33 @@ void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL = 0.0);
     dimension m x n. */
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X);
 
+/** @brief Compute the single precision LU factorization of a batch of
+    matrices
+
+    Same as BatchLUFactor(DenseTensor&, Array<int>&, const double), where the
+    matrices are rounded to single precision and the factors are stored in the
+    array @a Mlu, e.g. for the low precision solver of a mixed precision method,
+    see FloatBatchLUSolver.
+
+    @param [in] M batch of square matrices - dimension m x m x n.
+    @param [out] Mlu batch of LU factors - dimension m x m x n.
+    @param [out] P array storing pivot information - dimension m x n.
+    @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0. */
+void BatchLUFactor(const DenseTensor &M, Array<float> &Mlu, Array<int> &P,
+                   const double TOL = 0.0);
+
+/** @brief Solve batch linear systems with single precision LU factors
+
+    Same as BatchLUSolve(const DenseTensor&, const Array<int>&, Vector&) with
+    the factors computed by BatchLUFactor(const DenseTensor&, Array<float>&,
+    Array<int>&, const double). The solves are performed in double precision.
+
+    @param [in] Mlu batch of LU factors - dimension m x m x n.
+    @param [in] P array storing pivot information - dimension m x n.
+    @param [in, out] X vector storing right-hand side and then solution -
+    dimension m x n. */
+void BatchLUSolve(const Array<float> &Mlu, const Array<int> &P, Vector &X);
+
 
 // Inline methods
 
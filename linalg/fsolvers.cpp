@@ -0,0 +1,283 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the single precision operators, smoothers and solvers
+
+#include "fsolvers.hpp"
+#include "solvers.hpp"
+#include "kernels.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+FloatSparseMatrix::FloatSparseMatrix(const SparseMatrix &m)
+   : FloatOperator(m.Height(), m.Width())
+{
+   MFEM_VERIFY(m.Finalized(), "the SparseMatrix must be finalized");
+   const int nnz = m.NumNonZeroElems();
+   I.SetSize(height + 1);
+   J.SetSize(nnz);
+   A.SetSize(nnz);
+   const auto mI = m.ReadI(), mJ = m.ReadJ();
+   const auto mA = m.ReadData();
+   auto d_I = I.Write(), d_J = J.Write();
+   auto d_A = A.Write();
+   MFEM_FORALL(i, height + 1, d_I[i] = mI[i]; );
+   MFEM_FORALL(k, nnz,
+   {
+      d_J[k] = mJ[k];
+      d_A[k] = (float) mA[k];
+   });
+}
+
+void FloatSparseMatrix::Mult(const FloatVector &x, FloatVector &y) const
+{
+   y = 0.0f;
+   AddMult(x, y);
+}
+
+void FloatSparseMatrix::AddMult(const FloatVector &x, FloatVector &y,
+                                const double a) const
+{
+   MFEM_ASSERT(x.Size() == width, "invalid input vector");
+   MFEM_ASSERT(y.Size() == height, "invalid output vector");
+   const auto d_I = I.Read(), d_J = J.Read();
+   const auto d_A = A.Read();
+   const auto X = x.Read();
+   auto Y = y.ReadWrite();
+   MFEM_FORALL(i, height,
+   {
+      double s = 0.0;
+      const int end = d_I[i+1];
+      for (int k = d_I[i]; k < end; k++)
+      {
+         s += (double) d_A[k] * X[d_J[k]];
+      }
+      Y[i] += (float) (a * s);
+   });
+}
+
+void FloatSparseMatrix::GetDiag(FloatVector &d) const
+{
+   MFEM_VERIFY(height == width, "the matrix must be square");
+   d.SetSize(height);
+   const auto d_I = I.Read(), d_J = J.Read();
+   const auto d_A = A.Read();
+   auto D = d.Write();
+   MFEM_FORALL(i, height,
+   {
+      float v = 0.0f;
+      const int end = d_I[i+1];
+      for (int k = d_I[i]; k < end; k++)
+      {
+         if (d_J[k] == i) { v = d_A[k]; break; }
+      }
+      D[i] = v;
+   });
+}
+
+FloatOperatorJacobiSmoother::FloatOperatorJacobiSmoother(
+   const FloatVector &d, const Array<int> &ess_tdofs, const double dmpng)
+   : FloatSolver(d.Size()),
+     dinv(height),
+     damping(dmpng),
+     ess_tdof_list(&ess_tdofs),
+     residual(height),
+     oper(NULL)
+{
+   Setup(d);
+}
+
+void FloatOperatorJacobiSmoother::Setup(const FloatVector &diag)
+{
+   const double delta = damping;
+   const auto D = diag.Read();
+   auto DI = dinv.Write();
+   MFEM_FORALL(i, height, DI[i] = (float) (delta / D[i]); );
+   if (ess_tdof_list && ess_tdof_list->Size() > 0)
+   {
+      dinv.SetSubVector(*ess_tdof_list, (float) delta);
+   }
+}
+
+void FloatOperatorJacobiSmoother::Mult(const FloatVector &x,
+                                       FloatVector &y) const
+{
+   MFEM_ASSERT(x.Size() == Width(), "invalid input vector");
+   MFEM_ASSERT(y.Size() == Height(), "invalid output vector");
+
+   if (iterative_mode)
+   {
+      MFEM_VERIFY(oper, "iterative_mode == true requires the forward operator");
+      oper->Mult(y, residual);  // r = A y
+      const auto X = x.Read();
+      auto R = residual.ReadWrite();
+      MFEM_FORALL(i, height, R[i] = X[i] - R[i]; ); // r = x - A y
+   }
+   else
+   {
+      residual = x;
+      y = 0.0f;
+   }
+   const auto DI = dinv.Read();
+   const auto R = residual.Read();
+   auto Y = y.ReadWrite();
+   MFEM_FORALL(i, height, Y[i] += DI[i] * R[i]; );
+}
+
+FloatOperatorChebyshevSmoother::FloatOperatorChebyshevSmoother(
+   const FloatOperator *oper_, const FloatVector &d,
+   const Array<int> &ess_tdofs, int order_, double max_eig_estimate)
+   : FloatSolver(d.Size()),
+     order(order_),
+     N(d.Size()),
+     dinv(N),
+     residual(N),
+     oper(oper_)
+{
+   const auto D = d.Read();
+   auto X = dinv.Write();
+   MFEM_FORALL(i, N, X[i] = 1.0f / D[i]; );
+   dinv.SetSubVector(ess_tdofs, 1.0f);
+   OperatorChebyshevSmoother::ComputeCoefficients(order, max_eig_estimate,
+                                                  coeffs);
+}
+
+void FloatOperatorChebyshevSmoother::Mult(const FloatVector &x,
+                                          FloatVector &y) const
+{
+   if (iterative_mode)
+   {
+      MFEM_ABORT("Chebyshev smoother not implemented for iterative mode");
+   }
+   if (!oper)
+   {
+      MFEM_ABORT("Chebyshev smoother requires operator");
+   }
+
+   residual = x;
+   helperVector.SetSize(N);
+   y = 0.0f;
+
+   for (int k = 0; k < order; ++k)
+   {
+      // Apply
+      if (k > 0)
+      {
+         oper->Mult(residual, helperVector);
+         residual = helperVector;
+      }
+
+      // Scale residual by inverse diagonal and add weighted contribution to y
+      const float c = (float) coeffs[k];
+      const auto Dinv = dinv.Read();
+      auto R = residual.ReadWrite();
+      auto Y = y.ReadWrite();
+      MFEM_FORALL(i, N,
+      {
+         R[i] *= Dinv[i];
+         Y[i] += c * R[i];
+      });
+   }
+}
+
+FloatSolverAdaptor::FloatSolverAdaptor(const FloatOperator &op_)
+   : Solver(op_.Height(), op_.Width()), op(op_),
+     xf(op_.Width()), yf(op_.Height()) { }
+
+void FloatSolverAdaptor::Mult(const Vector &x, Vector &y) const
+{
+   xf.SetFromDouble(x);
+   if (iterative_mode) { yf.SetFromDouble(y); }
+   op.Mult(xf, yf);
+   yf.GetDouble(y);
+}
+
+void FloatLUSolver::SetOperator(const Operator &op)
+{
+   const DenseMatrix *D = dynamic_cast<const DenseMatrix*>(&op);
+   MFEM_VERIFY(!dynamic_cast<const SparseMatrix*>(&op),
+               "FloatLUSolver does not densify a SparseMatrix, convert it "
+               "explicitly with SparseMatrix::ToDenseMatrix()");
+   MFEM_VERIFY(D, "the operator must be a DenseMatrix");
+   MFEM_VERIFY(op.Height() == op.Width(), "the matrix must be square");
+   const int m = height = width = op.Height();
+
+   lu.SetSize(m*m);
+   ipiv.SetSize(m);
+   float *LU = lu.HostWrite();
+   const double *data = D->Data();
+   for (int i = 0; i < m*m; i++) { LU[i] = (float) data[i]; }
+   const bool ok = kernels::LUFactor(LU, m, ipiv.HostWrite());
+   MFEM_VERIFY(ok, "single precision LU factorization failed");
+}
+
+void FloatLUSolver::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == width, "invalid input vector");
+   y = x;
+   kernels::LUSolve(lu.HostRead(), height, ipiv.HostRead(),
+                    y.HostReadWrite());
+}
+
+FloatBatchLUSolver::FloatBatchLUSolver(const DenseTensor &blocks)
+   : Solver(blocks.SizeI()*blocks.SizeK())
+{
+   MFEM_VERIFY(blocks.SizeI() == blocks.SizeJ(), "the blocks must be square");
+   BatchLUFactor(blocks, lu, ipiv);
+}
+
+void FloatBatchLUSolver::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == width, "invalid input vector");
+   y = x;
+   BatchLUSolve(lu, ipiv, y);
+}
+
+void MixedPrecisionLUSolver::Init()
+{
+   iterative_mode = false;
+   rel_tol = 1e-12;
+   max_iter = 20;
+   SetPreconditioner(lu);
+}
+
+MixedPrecisionLUSolver::MixedPrecisionLUSolver(Method method_)
+   : IterativeRefinementSolver(method_)
+{
+   Init();
+}
+
+MixedPrecisionLUSolver::MixedPrecisionLUSolver(const Operator &op,
+                                               Method method_)
+   : IterativeRefinementSolver(method_)
+{
+   Init();
+   SetOperator(op);
+}
+
+void MixedPrecisionLUSolver::SetOperator(const Operator &op)
+{
+   const DenseMatrix *D = dynamic_cast<const DenseMatrix*>(&op);
+   if (D) { lu.SetOperator(*D); }
+   MFEM_VERIFY(lu.Height() > 0 || op.Height() == 0,
+               "the factors are not set, see SetFactorOperator()");
+   MFEM_VERIFY(lu.Height() == op.Height() && op.Height() == op.Width(),
+               "the factors do not match the operator");
+   // Same as IterativeSolver::SetOperator(), without a second factorization
+   oper = &op;
+   height = op.Height();
+   width = op.Width();
+   SetupRefinement();
+}
+
+} // namespace mfem
@@ -0,0 +1,260 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_FSOLVERS
+#define MFEM_FSOLVERS
+
+#include "fvector.hpp"
+#include "operator.hpp"
+#include "sparsemat.hpp"
+#include "densemat.hpp"
+#include "solvers.hpp"
+
+namespace mfem
+{
+
+/** @brief Abstract single precision operator, acting on FloatVector%s.
+
+    The single precision operators and smoothers are meant to be used as
+    preconditioners inside of double precision solvers, through
+    FloatSolverAdaptor. */
+class FloatOperator
+{
+protected:
+   int height, width;
+
+public:
+   /// Construct a square operator of size @a s.
+   explicit FloatOperator(int s = 0) : height(s), width(s) { }
+
+   /// Construct an operator with height @a h and width @a w.
+   FloatOperator(int h, int w) : height(h), width(w) { }
+
+   int Height() const { return height; }
+   int Width() const { return width; }
+
+   /// Operator application: y = A(x).
+   virtual void Mult(const FloatVector &x, FloatVector &y) const = 0;
+
+   virtual ~FloatOperator() { }
+};
+
+/// Base class for single precision solvers, the counterpart of Solver.
+class FloatSolver : public FloatOperator
+{
+public:
+   /// If true, use the second argument of Mult() as an initial guess.
+   bool iterative_mode;
+
+   explicit FloatSolver(int s = 0, bool iter_mode = false)
+      : FloatOperator(s) { iterative_mode = iter_mode; }
+
+   /// Set/update the solver for the given operator.
+   virtual void SetOperator(const FloatOperator &op) = 0;
+};
+
+/** @brief Single precision copy of a finalized SparseMatrix.
+
+    The values are stored in single precision and the row sums are accumulated
+    in double precision. */
+class FloatSparseMatrix : public FloatOperator
+{
+protected:
+   Array<int> I, J;
+   Array<float> A;
+
+public:
+   /// Create the single precision copy of the finalized matrix @a m.
+   explicit FloatSparseMatrix(const SparseMatrix &m);
+
+   virtual void Mult(const FloatVector &x, FloatVector &y) const;
+
+   /// y += a * A.x
+   void AddMult(const FloatVector &x, FloatVector &y,
+                const double a = 1.0) const;
+
+   /// Return the diagonal of the matrix in @a d.
+   void GetDiag(FloatVector &d) const;
+
+   int NumNonZeroElems() const { return A.Size(); }
+};
+
+/** @brief Single precision version of OperatorJacobiSmoother.
+
+    The application is by the *inverse* of the given diagonal. It is assumed
+    that the underlying operator acts as the identity on the entries in
+    @a ess_tdof_list, see OperatorJacobiSmoother. In iterative mode, the
+    operator must be set with SetOperator(). */
+class FloatOperatorJacobiSmoother : public FloatSolver
+{
+public:
+   FloatOperatorJacobiSmoother(const FloatVector &d,
+                               const Array<int> &ess_tdof_list,
+                               const double damping = 1.0);
+
+   virtual void Mult(const FloatVector &x, FloatVector &y) const;
+
+   virtual void SetOperator(const FloatOperator &op) { oper = &op; }
+
+   /// Recompute the inverse of the diagonal from @a diag.
+   void Setup(const FloatVector &diag);
+
+private:
+   FloatVector dinv;
+   const double damping;
+   const Array<int> *ess_tdof_list; // not owned
+   mutable FloatVector residual;
+   const FloatOperator *oper; // not owned
+};
+
+/** @brief Single precision version of OperatorChebyshevSmoother.
+
+    The application is by the *inverse* of the given diagonal @a d. It is
+    assumed that the underlying operator acts as the identity on the entries
+    in @a ess_tdof_list, see OperatorChebyshevSmoother. The estimated largest
+    eigenvalue of the diagonally preconditioned operator must be provided via
+    @a max_eig_estimate, e.g. by applying PowerMethod to the double precision
+    operator. The polynomial coefficients are computed in double precision. */
+class FloatOperatorChebyshevSmoother : public FloatSolver
+{
+public:
+   FloatOperatorChebyshevSmoother(const FloatOperator *oper,
+                                  const FloatVector &d,
+                                  const Array<int> &ess_tdof_list,
+                                  int order, double max_eig_estimate);
+
+   virtual void Mult(const FloatVector &x, FloatVector &y) const;
+
+   virtual void SetOperator(const FloatOperator &op) { oper = &op; }
+
+private:
+   const int order;
+   const int N;
+   FloatVector dinv;
+   Array<double> coeffs;
+   mutable FloatVector residual;
+   mutable FloatVector helperVector;
+   const FloatOperator *oper; // not owned
+};
+
+/** @brief Double precision Solver applying a single precision FloatOperator,
+    e.g. a FloatSolver used as a preconditioner in CGSolver or FGMRESSolver.
+
+    The input is rounded to single precision and the output is converted back
+    to double precision. SetOperator() has no effect: the operator of the
+    single precision solver is set independently. In iterative mode, the
+    initial guess is passed to the FloatSolver, which must support it. */
+class FloatSolverAdaptor : public Solver
+{
+protected:
+   const FloatOperator &op;
+   mutable FloatVector xf, yf;
+
+public:
+   explicit FloatSolverAdaptor(const FloatOperator &op_);
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   virtual void SetOperator(const Operator &) { }
+};
+
+/** @brief Single precision LU factorization of a DenseMatrix, used e.g. as
+    the low precision solver of IterativeRefinementSolver.
+
+    SetOperator() rounds the matrix to single precision and factors it with
+    partial pivoting, see kernels::LUFactor(). Mult() applies the single
+    precision factors to the double precision input. Only DenseMatrix is
+    accepted: the factors of a SparseMatrix are dense, so a small SparseMatrix
+    must be converted explicitly with SparseMatrix::ToDenseMatrix(). For the
+    block diagonal matrices of a DenseTensor, see FloatBatchLUSolver. */
+class FloatLUSolver : public Solver
+{
+protected:
+   Array<float> lu;
+   Array<int> ipiv;
+
+public:
+   FloatLUSolver() { }
+
+   /// Factor the matrix @a op, see SetOperator().
+   explicit FloatLUSolver(const Operator &op) { SetOperator(op); }
+
+   /// Factor the matrix @a op, which must be a DenseMatrix.
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// Return the memory used by the factors, in bytes.
+   long MemoryUsage() const
+   { return lu.Size()*sizeof(float) + ipiv.Size()*sizeof(int); }
+};
+
+/** @brief Single precision LU factorization of the block diagonal matrix
+    with the blocks of a DenseTensor, see BatchLUFactor(const DenseTensor&,
+    Array<float>&, Array<int>&, const double). Mult() solves the block systems
+    with the factors. */
+class FloatBatchLUSolver : public Solver
+{
+protected:
+   Array<float> lu;
+   Array<int> ipiv;
+
+public:
+   /// Factor the blocks of @a blocks.
+   explicit FloatBatchLUSolver(const DenseTensor &blocks);
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// The factors are computed by the constructor.
+   virtual void SetOperator(const Operator &op) { }
+};
+
+/** @brief Mixed precision direct solver: the factors of a FloatLUSolver,
+    refined to double precision accuracy by IterativeRefinementSolver.
+
+    This is a drop-in replacement of a double precision direct solver of small
+    and medium systems, e.g. DenseMatrixInverse, which computes and stores the
+    factors in single precision. The residuals are computed with the operator
+    given to SetOperator(), which can be e.g. a SparseMatrix, and the factors
+    are those of the DenseMatrix given to SetFactorOperator(). A DenseMatrix
+    given to SetOperator() is also factored. By default, the relative tolerance
+    is 1e-12, at most 20 iterations are performed and iterative_mode is false.
+    Use Method::GMRES_IR for ill-conditioned systems. */
+class MixedPrecisionLUSolver : public IterativeRefinementSolver
+{
+protected:
+   FloatLUSolver lu;
+
+   void Init();
+
+public:
+   MixedPrecisionLUSolver(Method method_ = IR);
+
+   /// Set the operator @a op, see SetOperator().
+   explicit MixedPrecisionLUSolver(const Operator &op, Method method_ = IR);
+
+   /** @brief Factor the matrix @a A in single precision, e.g. the dense copy
+       of a SparseMatrix, see SparseMatrix::ToDenseMatrix(). The copy may be
+       destroyed after this call. */
+   void SetFactorOperator(const DenseMatrix &A) { lu.SetOperator(A); }
+
+   /** @brief Set the operator used for the double precision residuals. If
+       @a op is a DenseMatrix, it is also factored, otherwise the factors must
+       have been set with SetFactorOperator(). */
+   virtual void SetOperator(const Operator &op);
+
+   /// Return the single precision factorization.
+   const FloatLUSolver &GetLUSolver() const { return lu; }
+};
+
+} // namespace mfem
+
+#endif
@@ -0,0 +1,153 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of data type FloatVector
+
+#include "fvector.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+FloatVector::FloatVector(int s) : size(0)
+{
+   data.Reset();
+   data.UseDevice(true);
+   SetSize(s);
+}
+
+FloatVector::FloatVector(const FloatVector &v) : size(0)
+{
+   data.Reset();
+   data.UseDevice(true);
+   *this = v;
+}
+
+FloatVector::FloatVector(const Vector &v) : size(0)
+{
+   data.Reset();
+   data.UseDevice(true);
+   SetFromDouble(v);
+}
+
+void FloatVector::SetSize(int s)
+{
+   if (s == size) { return; }
+   if (s <= data.Capacity())
+   {
+      size = s;
+      return;
+   }
+   const bool use_dev = data.UseDevice();
+   data.Delete();
+   data.New(s, Device::GetDeviceMemoryType());
+   data.UseDevice(use_dev);
+   size = s;
+}
+
+void FloatVector::Destroy()
+{
+   const bool use_dev = data.UseDevice();
+   data.Delete();
+   data.Reset();
+   data.UseDevice(use_dev);
+   size = 0;
+}
+
+void FloatVector::SetFromDouble(const Vector &v)
+{
+   SetSize(v.Size());
+   const bool use_dev = UseDevice() || v.UseDevice();
+   const auto V = v.Read(use_dev);
+   auto F = Write(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size, F[i] = (float) V[i]; );
+}
+
+void FloatVector::GetDouble(Vector &v) const
+{
+   v.SetSize(size);
+   const bool use_dev = UseDevice() || v.UseDevice();
+   const auto F = Read(use_dev);
+   auto V = v.Write(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size, V[i] = F[i]; );
+}
+
+FloatVector &FloatVector::operator=(const FloatVector &v)
+{
+   if (&v == this) { return *this; }
+   SetSize(v.Size());
+   const bool use_dev = UseDevice() || v.UseDevice();
+   const auto V = v.Read(use_dev);
+   auto F = Write(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size, F[i] = V[i]; );
+   return *this;
+}
+
+FloatVector &FloatVector::operator=(float value)
+{
+   const bool use_dev = UseDevice();
+   auto F = Write(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size, F[i] = value; );
+   return *this;
+}
+
+FloatVector &FloatVector::operator*=(const double c)
+{
+   const bool use_dev = UseDevice();
+   const float fc = (float) c;
+   auto F = ReadWrite(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size, F[i] *= fc; );
+   return *this;
+}
+
+FloatVector &FloatVector::Add(const double a, const FloatVector &x)
+{
+   MFEM_ASSERT(size == x.size, "incompatible FloatVectors!");
+   if (a == 0.0) { return *this; }
+   const bool use_dev = UseDevice() || x.UseDevice();
+   const float fa = (float) a;
+   const auto X = x.Read(use_dev);
+   auto F = ReadWrite(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size, F[i] += fa * X[i]; );
+   return *this;
+}
+
+double FloatVector::operator*(const FloatVector &v) const
+{
+   MFEM_ASSERT(size == v.size, "incompatible FloatVectors!");
+   const bool use_dev = (UseDevice() || v.UseDevice()) &&
+                        Device::Allows(Backend::DEVICE_MASK);
+   if (use_dev)
+   {
+      // Use the device reductions of Vector
+      Vector x, y;
+      x.UseDevice(true);
+      y.UseDevice(true);
+      GetDouble(x);
+      v.GetDouble(y);
+      return x * y;
+   }
+   const float *x = HostRead(), *y = v.HostRead();
+   double dot = 0.0;
+   for (int i = 0; i < size; i++) { dot += (double) x[i] * y[i]; }
+   return dot;
+}
+
+void FloatVector::SetSubVector(const Array<int> &list, const float value)
+{
+   const bool use_dev = UseDevice() || list.UseDevice();
+   const int n = list.Size();
+   const auto L = list.Read(use_dev);
+   auto F = ReadWrite(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, n, F[L[i]] = value; );
+}
+
+} // namespace mfem
@@ -0,0 +1,122 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_FVECTOR
+#define MFEM_FVECTOR
+
+#include "vector.hpp"
+
+namespace mfem
+{
+
+/** @brief Single precision vector, used by the single precision operators and
+    smoothers, see FloatOperator.
+
+    Bandwidth bound operations, e.g. matrix-free operators and smoothers used
+    as preconditioners, read and write half of the data of the double precision
+    versions. The reductions, Dot() and Norml2(), are accumulated in double
+    precision.
+
+    As with Vector, the operations use the mfem::Device when UseDevice() is
+    true, which is the default for FloatVector. */
+class FloatVector
+{
+protected:
+   Memory<float> data;
+   int size;
+
+public:
+   /// Create an empty vector.
+   FloatVector() : size(0) { data.Reset(); data.UseDevice(true); }
+
+   /// Create a vector of size @a s, the entries are not initialized.
+   explicit FloatVector(int s);
+
+   /// Copy constructor.
+   FloatVector(const FloatVector &v);
+
+   /// Create the single precision copy of the double precision vector @a v.
+   explicit FloatVector(const Vector &v);
+
+   /// Resize the vector to size @a s, the entries are not initialized.
+   void SetSize(int s);
+
+   /// Return the size of the vector.
+   int Size() const { return size; }
+
+   /// Delete the data of the vector and set its size to zero.
+   void Destroy();
+
+   /// Enable or disable the use of the mfem::Device, see Vector::UseDevice().
+   void UseDevice(bool use_dev) const { data.UseDevice(use_dev); }
+
+   /// Return the device flag of the Memory object.
+   bool UseDevice() const { return data.UseDevice(); }
+
+   Memory<float> &GetMemory() { return data; }
+   const Memory<float> &GetMemory() const { return data; }
+
+   /// Round the entries of the double precision vector @a v to this vector,
+   /// which is resized to the size of @a v.
+   void SetFromDouble(const Vector &v);
+
+   /// Copy the entries of this vector to the double precision vector @a v,
+   /// which is resized to the size of this vector.
+   void GetDouble(Vector &v) const;
+
+   FloatVector &operator=(const FloatVector &v);
+
+   /// Set all entries of the vector to @a value.
+   FloatVector &operator=(float value);
+
+   /// Host access to the entry @a i, see Vector::operator()().
+   float &operator()(int i) { return HostReadWrite()[i]; }
+   float operator()(int i) const { return HostRead()[i]; }
+
+   /// this += a * x
+   FloatVector &Add(const double a, const FloatVector &x);
+
+   /// Multiply all entries of the vector by @a c.
+   FloatVector &operator*=(const double c);
+
+   /// Dot product with @a v, accumulated in double precision.
+   double operator*(const FloatVector &v) const;
+
+   /// Euclidean norm, accumulated in double precision.
+   double Norml2() const { return std::sqrt((*this)*(*this)); }
+
+   /// Set the entries listed in @a list to @a value.
+   void SetSubVector(const Array<int> &list, const float value);
+
+   const float *Read(bool on_dev = true) const
+   { return mfem::Read(data, size, on_dev && UseDevice()); }
+
+   const float *HostRead() const
+   { return mfem::Read(data, size, false); }
+
+   float *Write(bool on_dev = true)
+   { return mfem::Write(data, size, on_dev && UseDevice()); }
+
+   float *HostWrite()
+   { return mfem::Write(data, size, false); }
+
+   float *ReadWrite(bool on_dev = true)
+   { return mfem::ReadWrite(data, size, on_dev && UseDevice()); }
+
+   float *HostReadWrite()
+   { return mfem::ReadWrite(data, size, false); }
+
+   ~FloatVector() { data.Delete(); }
+};
+
+} // namespace mfem
+
+#endif
@@ -1372,27 +1372,93 @@ have_aa:
 }
 
 
+/// Compute the LU factorization with partial pivoting, L.U = P.A, of the
+//  matrix A (m x m), overwriting it with the factors. The scalar type T is
+//  double or float, e.g. for the low precision factors of a mixed precision
+//  solver.
+//
+// @param [in, out] data matrix A and then its LU factors, column-major
+// @param [in] m square matrix height
+// @param [out] ipiv array storing pivot information (0-based)
+// @param [in] tol the factorization fails if the modulus of a pivot is less
+//             than or equal to tol
+// @return false if the factorization failed
+template <typename T> MFEM_HOST_DEVICE
+inline bool LUFactor(T *data, const int m, int *ipiv, const double tol = 0.0)
+{
+   bool pivot_flag = true;
+   for (int i = 0; i < m; i++)
+   {
+      // pivoting
+      {
+         int piv = i;
+         T a = fabs(data[piv+i*m]);
+         for (int j = i+1; j < m; j++)
+         {
+            const T b = fabs(data[j+i*m]);
+            if (b > a)
+            {
+               a = b;
+               piv = j;
+            }
+         }
+         ipiv[i] = piv;
+         if (piv != i)
+         {
+            // swap rows i and piv in both L and U parts
+            for (int j = 0; j < m; j++)
+            {
+               internal::Swap<T>(data[i+j*m], data[piv+j*m]);
+            }
+         }
+      } // pivot end
+
+      if (fabs(data[i+i*m]) <= tol)
+      {
+         pivot_flag = false;
+      }
+
+      const T a_ii_inv = T(1) / data[i+i*m];
+      for (int j = i+1; j < m; j++)
+      {
+         data[j+i*m] *= a_ii_inv;
+      }
+
+      for (int k = i+1; k < m; k++)
+      {
+         const T a_ik = data[i+k*m];
+         for (int j = i+1; j < m; j++)
+         {
+            data[j+k*m] -= a_ik * data[j+i*m];
+         }
+      }
+   }
+   return pivot_flag;
+}
+
 /// Assuming L.U = P.A for a factored matrix (m x m),
 //  compute x <- A x
 //
+// The factors may be stored in a lower precision type T than the vector x,
+// in which case the solve is performed in the precision of x.
+//
 // @param [in] data LU factorization of A
 // @param [in] m square matrix height
 // @param [in] ipiv array storing pivot information
 // @param [in, out] x vector storing right-hand side and then solution
-MFEM_HOST_DEVICE
-inline void LUSolve(const double *data, const int m, const int *ipiv,
-                    double *x)
+template <typename T, typename U> MFEM_HOST_DEVICE
+inline void LUSolve(const T *data, const int m, const int *ipiv, U *x)
 {
    // X <- P X
    for (int i = 0; i < m; i++)
    {
-      internal::Swap<double>(x[i], x[ipiv[i]]);
+      internal::Swap<U>(x[i], x[ipiv[i]]);
    }
 
    // X <- L^{-1} X
    for (int j = 0; j < m; j++)
    {
-      const double x_j = x[j];
+      const U x_j = x[j];
       for (int i = j + 1; i < m; i++)
       {
          x[i] -= data[i + j * m] * x_j;
@@ -1402,7 +1468,7 @@ inline void LUSolve(const double *data, const int m, const int *ipiv,
    // X <- U^{-1} X
    for (int j = m - 1; j >= 0; j--)
    {
-      const double x_j = (x[j] /= data[j + j * m]);
+      const U x_j = (x[j] /= data[j + j * m]);
       for (int i = 0; i < j; i++)
       {
          x[i] -= data[i + j * m] * x_j;
@@ -24,9 +24,13 @@
 #include "blockoperator.hpp"
 #include "sparsesmoothers.hpp"
 #include "densemat.hpp"
+#include "batched.hpp"
 #include "symmat.hpp"
 #include "ode.hpp"
 #include "solvers.hpp"
+#include "fvector.hpp"
+#include "fsolvers.hpp"
+#include "parareal.hpp"
 #include "handle.hpp"
 #include "invariants.hpp"
 #include "constraints.hpp"
@@ -11,6 +11,10 @@
 
 #include "operator.hpp"
 #include "ode.hpp"
+#ifdef MFEM_USE_MPI
+#include "hypre.hpp"
+#endif
+#include <algorithm>
 
 namespace mfem
 {
@@ -781,6 +785,573 @@ void ESDIRK33Solver::Step(Vector &x, double &t, double &dt)
    t += dt;
 }
 
+AdaptiveODESolver::AdaptiveODESolver(int err_order_)
+   : err_order(err_order_), rtol(1e-4), atol(1e-8), err_norm_p(2.0),
+     dt_min(0.0), dt_max(infinity()), safety(0.9), k_I(0.7), k_P(0.4),
+     fac_min(0.2), fac_max(5.0), err_prev(1.0), last_dt(0.0),
+     global_size(0.0), num_steps(0), num_rejected(0)
+{
+#ifdef MFEM_USE_MPI
+   parallel = false;
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+AdaptiveODESolver::AdaptiveODESolver(MPI_Comm comm_, int err_order_)
+   : AdaptiveODESolver(err_order_)
+{
+   parallel = true;
+   comm = comm_;
+}
+#endif
+
+void AdaptiveODESolver::SetErrorNorm(double p)
+{
+   MFEM_VERIFY(p == 2.0 || p == infinity(),
+               "the error norm must be the RMS norm (p = 2) or the max norm");
+   err_norm_p = p;
+}
+
+void AdaptiveODESolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   const int n = f->Width();
+   x_new.SetSize(n, mem_type);
+   err.SetSize(n, mem_type);
+   w.SetSize(n);
+   global_size = n;
+#ifdef MFEM_USE_MPI
+   if (parallel)
+   {
+      double loc_size = n;
+      MPI_Allreduce(&loc_size, &global_size, 1, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   err_prev = 1.0;
+   last_dt = 0.0;
+   num_steps = num_rejected = 0;
+}
+
+double AdaptiveODESolver::ErrorNorm(const Vector &x, const Vector &x_new,
+                                    const Vector &err) const
+{
+   const double *xd = x.HostRead(), *xnd = x_new.HostRead();
+   const double *ed = err.HostRead();
+   double *wd = w.HostWrite();
+   for (int i = 0; i < w.Size(); i++)
+   {
+      const double sc = atol + rtol*std::max(std::abs(xd[i]), std::abs(xnd[i]));
+      wd[i] = ed[i]/sc;
+   }
+   double norm;
+#ifdef MFEM_USE_MPI
+   if (parallel) { norm = ParNormlp(w, err_norm_p, comm); }
+   else
+#endif
+   {
+      norm = (err_norm_p == 2.0) ? w.Norml2() : w.Normlinf();
+   }
+   if (err_norm_p == 2.0 && global_size > 0.0) { norm /= sqrt(global_size); }
+   return norm;
+}
+
+void AdaptiveODESolver::Step(Vector &x, double &t, double &dt)
+{
+   const double q = err_order;
+   double h = std::min(dt, dt_max);
+   bool rejected = false;
+   while (true)
+   {
+      MFEM_VERIFY(t + h > t, "time step size underflow: dt = " << h);
+      TryStep(x, t, h, x_new, err);
+      const double err_norm = ErrorNorm(x, x_new, err);
+      if (err_norm <= 1.0 || h <= dt_min)
+      {
+         // PI controller; no step size increase right after a rejection
+         double fac = fac_max;
+         if (err_norm > 0.0)
+         {
+            fac = safety*pow(err_norm, -k_I/q)*pow(err_prev, k_P/q);
+         }
+         fac = std::min(std::max(fac, fac_min), rejected ? 1.0 : fac_max);
+         AcceptStep();
+         x = x_new;
+         t += h;
+         last_dt = h;
+         err_prev = std::max(err_norm, 1e-4);
+         num_steps++;
+         dt = std::min(std::max(fac*h, dt_min), dt_max);
+         return;
+      }
+      // Rejected step: elementary controller
+      num_rejected++;
+      rejected = true;
+      const double fac = std::max(safety*pow(err_norm, -1.0/q), fac_min);
+      h = std::max(fac*h, dt_min);
+   }
+}
+
+void AdaptiveODESolver::Run(Vector &x, double &t, double &dt, double tf)
+{
+   while (t < tf)
+   {
+      const double t0 = t, h = std::min(dt, tf - t);
+      dt = h;
+      Step(x, t, dt);
+      // A step accepted with the full remaining length ends exactly at tf
+      if (last_dt == h && h == tf - t0) { t = tf; }
+   }
+}
+
+
+EmbeddedRKSolver::EmbeddedRKSolver(int s_, const double *a_, const double *b_,
+                                   const double *e_, const double *c_,
+                                   int err_order, bool fsal_)
+   : AdaptiveODESolver(err_order), s(s_), a(a_), b(b_), e(e_), c(c_),
+     fsal(fsal_), k0_valid(false)
+{
+   k = new Vector[s];
+}
+
+#ifdef MFEM_USE_MPI
+EmbeddedRKSolver::EmbeddedRKSolver(MPI_Comm comm, int s_, const double *a_,
+                                   const double *b_, const double *e_,
+                                   const double *c_, int err_order,
+                                   bool fsal_)
+   : AdaptiveODESolver(comm, err_order), s(s_), a(a_), b(b_), e(e_), c(c_),
+     fsal(fsal_), k0_valid(false)
+{
+   k = new Vector[s];
+}
+#endif
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &f_)
+{
+   AdaptiveODESolver::Init(f_);
+   const int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   k0_valid = false;
+}
+
+void EmbeddedRKSolver::TryStep(const Vector &x, double t, double dt,
+                               Vector &x_new, Vector &err)
+{
+   // Same stages as ExplicitRKSolver::Step(); k[0] is kept from the last stage
+   // of the previous step (FSAL) or from a rejected attempt.
+   if (!k0_valid)
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+      k0_valid = true;
+   }
+   for (int l = 0, i = 1; i < s; i++)
+   {
+      add(x, a[l++]*dt, k[0], y);
+      for (int j = 1; j < i; j++)
+      {
+         y.Add(a[l++]*dt, k[j]);
+      }
+
+      f->SetTime(t + c[i-1]*dt);
+      f->Mult(y, k[i]);
+   }
+   add(x, b[0]*dt, k[0], x_new);
+   err.Set(e[0]*dt, k[0]);
+   for (int i = 1; i < s; i++)
+   {
+      x_new.Add(b[i]*dt, k[i]);
+      err.Add(e[i]*dt, k[i]);
+   }
+}
+
+void EmbeddedRKSolver::AcceptStep()
+{
+   if (fsal) { k[0].Swap(k[s-1]); }
+   else { k0_valid = false; }
+}
+
+EmbeddedRKSolver::~EmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const double BogackiShampine32Solver::a[] =
+{
+   1./2.,
+   0., 3./4.,
+   2./9., 1./3., 4./9.
+};
+const double BogackiShampine32Solver::b[] = { 2./9., 1./3., 4./9., 0. };
+const double BogackiShampine32Solver::e[] = { -5./72., 1./12., 1./9., -1./8. };
+const double BogackiShampine32Solver::c[] = { 1./2., 3./4., 1. };
+
+const double DormandPrince54Solver::a[] =
+{
+   1./5.,
+   3./40., 9./40.,
+   44./45., -56./15., 32./9.,
+   19372./6561., -25360./2187., 64448./6561., -212./729.,
+   9017./3168., -355./33., 46732./5247., 49./176., -5103./18656.,
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84.
+};
+const double DormandPrince54Solver::b[] =
+{
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84., 0.
+};
+const double DormandPrince54Solver::e[] =
+{
+   71./57600., 0., -71./16695., 71./1920., -17253./339200., 22./525., -1./40.
+};
+const double DormandPrince54Solver::c[] =
+{
+   1./5., 3./10., 4./5., 8./9., 1., 1.
+};
+
+
+EmbeddedSDIRKSolver::EmbeddedSDIRKSolver(int s_, const double *a_,
+                                         const double *b_, const double *e_,
+                                         const double *c_, int err_order)
+   : AdaptiveODESolver(err_order), s(s_), a(a_), b(b_), e(e_), c(c_)
+{
+   k = new Vector[s];
+}
+
+#ifdef MFEM_USE_MPI
+EmbeddedSDIRKSolver::EmbeddedSDIRKSolver(MPI_Comm comm, int s_,
+                                         const double *a_, const double *b_,
+                                         const double *e_, const double *c_,
+                                         int err_order)
+   : AdaptiveODESolver(comm, err_order), s(s_), a(a_), b(b_), e(e_), c(c_)
+{
+   k = new Vector[s];
+}
+#endif
+
+void EmbeddedSDIRKSolver::Init(TimeDependentOperator &f_)
+{
+   AdaptiveODESolver::Init(f_);
+   const int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+}
+
+void EmbeddedSDIRKSolver::TryStep(const Vector &x, double t, double dt,
+                                  Vector &x_new, Vector &err)
+{
+   //  c[0]   | a[0]
+   //  c[1]   | a[1] a[2]
+   //  ...    |    ...
+   //  c[s-1] | ...   a[s(s+1)/2-1]
+   // --------+---------------------
+   //         | b[0] b[1] ... b[s-1]
+   for (int l = 0, i = 0; i < s; i++)
+   {
+      y = x;
+      for (int j = 0; j < i; j++)
+      {
+         y.Add(a[l++]*dt, k[j]);
+      }
+      f->SetTime(t + c[i]*dt);
+      f->ImplicitSolve(a[l++]*dt, y, k[i]);
+   }
+   add(x, b[0]*dt, k[0], x_new);
+   err.Set(e[0]*dt, k[0]);
+   for (int i = 1; i < s; i++)
+   {
+      x_new.Add(b[i]*dt, k[i]);
+      err.Add(e[i]*dt, k[i]);
+   }
+}
+
+EmbeddedSDIRKSolver::~EmbeddedSDIRKSolver()
+{
+   delete [] k;
+}
+
+// gamma = 1 - 1/sqrt(2); the embedded method is x + dt*k[0]
+const double SDIRK21EmbeddedSolver::a[] =
+{
+   0.29289321881345247559915563789515,
+   0.70710678118654752440084436210485, 0.29289321881345247559915563789515
+};
+const double SDIRK21EmbeddedSolver::b[] =
+{
+   0.70710678118654752440084436210485, 0.29289321881345247559915563789515
+};
+const double SDIRK21EmbeddedSolver::e[] =
+{
+   -0.29289321881345247559915563789515, 0.29289321881345247559915563789515
+};
+const double SDIRK21EmbeddedSolver::c[] =
+{
+   0.29289321881345247559915563789515, 1.
+};
+
+const double SDIRK43EmbeddedSolver::a[] =
+{
+   1./4.,
+   1./2., 1./4.,
+   17./50., -1./25., 1./4.,
+   371./1360., -137./2720., 15./544., 1./4.,
+   25./24., -49./48., 125./16., -85./12., 1./4.
+};
+const double SDIRK43EmbeddedSolver::b[] =
+{
+   25./24., -49./48., 125./16., -85./12., 1./4.
+};
+// e = b - b-hat with b-hat = (59/48, -17/96, 225/32, -85/12, 0)
+const double SDIRK43EmbeddedSolver::e[] =
+{
+   -3./16., -27./32., 25./32., 0., 1./4.
+};
+const double SDIRK43EmbeddedSolver::c[] =
+{
+   1./4., 3./4., 11./20., 1./2., 1.
+};
+
+IMEXRKSolver::IMEXRKSolver(int s_, const double *aE_, const double *bE_,
+                           const double *aI_, const double *bI_,
+                           const double *c_)
+   : s(s_), aE(aE_), bE(bE_), aI(aI_), bI(bI_), c(c_), needE(s_), needI(s_)
+{
+   // A stage derivative is needed if it enters the solution or a later stage
+   for (int j = 0; j < s; j++)
+   {
+      needE[j] = (bE[j] != 0.0);
+      needI[j] = (bI[j] != 0.0);
+      for (int i = j+1; i < s; i++)
+      {
+         needE[j] = needE[j] || (aE[i*s+j] != 0.0);
+         needI[j] = needI[j] || (aI[i*s+j] != 0.0);
+      }
+   }
+   kE = new Vector[s];
+   kI = new Vector[s];
+}
+
+void IMEXRKSolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   const int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      kE[i].SetSize(n, mem_type);
+      kI[i].SetSize(n, mem_type);
+   }
+}
+
+void IMEXRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   //  c[i] | aE[i*s+j]     c[i] | aI[i*s+j]
+   // ------+-----------   ------+-----------
+   //       | bE[j]              | bI[j]
+   for (int i = 0; i < s; i++)
+   {
+      y = x;
+      for (int j = 0; j < i; j++)
+      {
+         if (needE[j] && aE[i*s+j] != 0.0) { y.Add(aE[i*s+j]*dt, kE[j]); }
+         if (needI[j] && aI[i*s+j] != 0.0) { y.Add(aI[i*s+j]*dt, kI[j]); }
+      }
+      f->SetTime(t + c[i]*dt);
+      const double gdt = aI[i*s+i]*dt;
+      if (gdt != 0.0)
+      {
+         f->ImplicitSolve(gdt, y, kI[i]);
+         y.Add(gdt, kI[i]);
+      }
+      else if (needI[i])
+      {
+         f->ImplicitSolve(0.0, y, kI[i]);
+      }
+      if (needE[i]) { f->ExplicitMult(y, kE[i]); }
+   }
+   for (int i = 0; i < s; i++)
+   {
+      if (bE[i] != 0.0) { x.Add(bE[i]*dt, kE[i]); }
+      if (bI[i] != 0.0) { x.Add(bI[i]*dt, kI[i]); }
+   }
+   t += dt;
+}
+
+IMEXRKSolver::~IMEXRKSolver()
+{
+   delete [] kE;
+   delete [] kI;
+}
+
+// gamma = 1 - 1/sqrt(2), delta = 1 - 1/(2 gamma) = -1/sqrt(2)
+const double ARS222Solver::aE[] =
+{
+   0., 0., 0.,
+   0.29289321881345247559915563789515, 0., 0.,
+   -0.70710678118654752440084436210485, 1.70710678118654752440084436210485, 0.
+};
+const double ARS222Solver::bE[] =
+{
+   -0.70710678118654752440084436210485, 1.70710678118654752440084436210485, 0.
+};
+const double ARS222Solver::aI[] =
+{
+   0., 0., 0.,
+   0., 0.29289321881345247559915563789515, 0.,
+   0., 0.70710678118654752440084436210485, 0.29289321881345247559915563789515
+};
+const double ARS222Solver::bI[] =
+{
+   0., 0.70710678118654752440084436210485, 0.29289321881345247559915563789515
+};
+const double ARS222Solver::c[] =
+{
+   0., 0.29289321881345247559915563789515, 1.
+};
+
+const double ARS443Solver::aE[] =
+{
+   0., 0., 0., 0., 0.,
+   1./2., 0., 0., 0., 0.,
+   11./18., 1./18., 0., 0., 0.,
+   5./6., -5./6., 1./2., 0., 0.,
+   1./4., 7./4., 3./4., -7./4., 0.
+};
+const double ARS443Solver::bE[] = { 1./4., 7./4., 3./4., -7./4., 0. };
+const double ARS443Solver::aI[] =
+{
+   0., 0., 0., 0., 0.,
+   0., 1./2., 0., 0., 0.,
+   0., 1./6., 1./2., 0., 0.,
+   0., -1./2., 1./2., 1./2., 0.,
+   0., 3./2., -3./2., 1./2., 1./2.
+};
+const double ARS443Solver::bI[] = { 0., 3./2., -3./2., 1./2., 1./2. };
+const double ARS443Solver::c[] = { 0., 1./2., 2./3., 1./2., 1. };
+
+const double ARK3Solver::aE[] =
+{
+   0., 0., 0., 0.,
+   1767732205903./2027836641118., 0., 0., 0.,
+   5535828885825./10492691773637., 788022342437./10882634858940., 0., 0.,
+   6485989280629./16251701735622., -4246266847089./9704473918619.,
+   10755448449292./10357097424841., 0.
+};
+const double ARK3Solver::aI[] =
+{
+   0., 0., 0., 0.,
+   1767732205903./4055673282236., 1767732205903./4055673282236., 0., 0.,
+   2746238789719./10658868560708., -640167445237./6845629431997.,
+   1767732205903./4055673282236., 0.,
+   1471266399579./7840856788654., -4482444167858./7529755066697.,
+   11266239266428./11593286722821., 1767732205903./4055673282236.
+};
+const double ARK3Solver::b[] =
+{
+   1471266399579./7840856788654., -4482444167858./7529755066697.,
+   11266239266428./11593286722821., 1767732205903./4055673282236.
+};
+const double ARK3Solver::c[] =
+{
+   0., 1767732205903./2027836641118., 3./5., 1.
+};
+
+const double ARK4Solver::aE[] =
+{
+   0., 0., 0., 0., 0., 0.,
+   1./2., 0., 0., 0., 0., 0.,
+   13861./62500., 6889./62500., 0., 0., 0., 0.,
+   -116923316275./2393684061468., -2731218467317./15368042101831.,
+   9408046702089./11113171139209., 0., 0., 0.,
+   -451086348788./2902428689909., -2682348792572./7519795681897.,
+   12662868775082./11960479115383., 3355817975965./11060851509271., 0., 0.,
+   647845179188./3216320057751., 73281519250./8382639484533.,
+   552539513391./3454668386233., 3354512671639./8306763924573.,
+   4040./17871., 0.
+};
+const double ARK4Solver::aI[] =
+{
+   0., 0., 0., 0., 0., 0.,
+   1./4., 1./4., 0., 0., 0., 0.,
+   8611./62500., -1743./31250., 1./4., 0., 0., 0.,
+   5012029./34652500., -654441./2922500., 174375./388108., 1./4., 0., 0.,
+   15267082809./155376265600., -71443401./120774400.,
+   730878875./902184768., 2285395./8070912., 1./4., 0.,
+   82889./524892., 0., 15625./83664., 69875./102672., -2260./8211., 1./4.
+};
+const double ARK4Solver::b[] =
+{
+   82889./524892., 0., 15625./83664., 69875./102672., -2260./8211., 1./4.
+};
+const double ARK4Solver::c[] =
+{
+   0., 1./2., 83./250., 31./50., 17./20., 1.
+};
+
+
+void SplittingSolver::PartOperator::SetOperator(TimeDependentOperator &f_)
+{
+   f = &f_;
+   height = f->Height();
+   width = f->Width();
+}
+
+void SplittingSolver::PartOperator::SetTime(const double t_)
+{
+   TimeDependentOperator::SetTime(t_);
+   f->SetTime(t_);
+}
+
+void SplittingSolver::PartOperator::Mult(const Vector &x, Vector &y) const
+{
+   if (expl) { f->ExplicitMult(x, y); }
+   else { f->ImplicitSolve(0.0, x, y); }
+}
+
+void SplittingSolver::PartOperator::ImplicitSolve(const double dt,
+                                                  const Vector &x, Vector &k)
+{
+   MFEM_VERIFY(!expl, "the explicit part can not be solved implicitly");
+   f->ImplicitSolve(dt, x, k);
+}
+
+SplittingSolver::SplittingSolver(ODESolver &solverE_, ODESolver &solverI_,
+                                 Type split_)
+   : solverE(solverE_), solverI(solverI_), split(split_), partE(true),
+     partI(false) { }
+
+void SplittingSolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   partE.SetOperator(f_);
+   partI.SetOperator(f_);
+   solverE.Init(partE);
+   solverI.Init(partI);
+}
+
+void SplittingSolver::Step(Vector &x, double &t, double &dt)
+{
+   // The sub-steps use copies of t and dt since the sub-solvers may modify
+   // them; the sub-solvers must take the requested steps
+   double tE = t, tI = t;
+   double h = (split == STRANG) ? dt/2 : dt;
+   solverE.Step(x, tE, h);
+   h = dt;
+   solverI.Step(x, tI, h);
+   if (split == STRANG)
+   {
+      h = dt/2;
+      solverE.Step(x, tE, h);
+   }
+   t += dt;
+}
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &_f)
 {
    ODESolver::Init(_f);
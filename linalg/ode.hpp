@@ -15,6 +15,10 @@
 #include "../config/config.hpp"
 #include "operator.hpp"
 
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
 namespace mfem
 {
 
@@ -502,6 +506,380 @@ public:
 };
 
 
+/** @brief Abstract base class for one-step methods with an embedded error
+    estimator and adaptive time step control.
+
+    Each call to Step() performs one accepted time step. The step starts with
+    the input @a dt, which is reduced after each rejected attempt; on output,
+    @a t is advanced by the accepted step size, see GetLastTimeStep(), and
+    @a dt is set to the step size proposed by the controller for the next
+    step. A step is accepted if the norm of the weighted error estimate,
+    @f[ w_i = \frac{e_i}{atol + rtol \max(|x_i|, |\hat{x}_i|)}, @f]
+    is at most 1, where x and x-hat are the solutions at the beginning and at
+    the end of the step. The norm is either the root-mean-square norm (default)
+    or the max norm, see SetErrorNorm(); in parallel it is computed over the
+    communicator given to the constructor with ParNormlp().
+
+    The next step size is computed with the PI controller
+    @f[ dt_{n+1} = dt_n \, \sigma \, err_n^{-k_I/q} \, err_{n-1}^{k_P/q}, @f]
+    where q is the order of the error estimate (the lowest order of the pair
+    plus one), limited by the factors set with SetStepFactorLimits() and by the
+    step limits set with SetStepLimits(). A step of size dt_min is always
+    accepted, so setting dt_min = dt_max gives fixed time steps. */
+class AdaptiveODESolver : public ODESolver
+{
+protected:
+   const int err_order;
+   double rtol, atol, err_norm_p;
+   double dt_min, dt_max;
+   double safety, k_I, k_P, fac_min, fac_max;
+   double err_prev, last_dt, global_size;
+   int num_steps, num_rejected;
+#ifdef MFEM_USE_MPI
+   bool parallel;
+   MPI_Comm comm;
+#endif
+   Vector x_new, err;
+   mutable Vector w;
+
+   /** @brief Compute the solution @a x_new at time @a t + @a dt, starting from
+       @a x at time @a t, and an estimate @a err of its local error. */
+   virtual void TryStep(const Vector &x, double t, double dt, Vector &x_new,
+                        Vector &err) = 0;
+
+   /// Called after the last call to TryStep() when the step is accepted.
+   virtual void AcceptStep() { }
+
+   /// Return the norm of the weighted error estimate.
+   double ErrorNorm(const Vector &x, const Vector &x_new,
+                    const Vector &err) const;
+
+public:
+   /// @a err_order is the order q of the error estimate of the method.
+   AdaptiveODESolver(int err_order);
+
+#ifdef MFEM_USE_MPI
+   /// Compute the error norms over the MPI communicator @a comm.
+   AdaptiveODESolver(MPI_Comm comm, int err_order);
+#endif
+
+   /// Set the relative and absolute tolerances. Default: 1e-4 and 1e-8.
+   void SetTolerances(double rtol_, double atol_)
+   { rtol = rtol_; atol = atol_; }
+
+   /// Set the minimum and maximum step sizes. Default: 0 and infinity().
+   void SetStepLimits(double dt_min_, double dt_max_)
+   { dt_min = dt_min_; dt_max = dt_max_; }
+
+   /** @brief Set the gains and the safety factor of the PI controller.
+       Default: 0.7, 0.4 and 0.9. With @a kP = 0, this is the elementary (I)
+       controller. */
+   void SetPIController(double kI, double kP, double safety_ = 0.9)
+   { k_I = kI; k_P = kP; safety = safety_; }
+
+   /** @brief Set the minimum and maximum ratios between two consecutive step
+       sizes. Default: 0.2 and 5. */
+   void SetStepFactorLimits(double fac_min_, double fac_max_)
+   { fac_min = fac_min_; fac_max = fac_max_; }
+
+   /// Use the root-mean-square norm (p = 2, default) or the max norm (p =
+   /// infinity()) for the weighted error estimate.
+   void SetErrorNorm(double p);
+
+   /// Return the size of the last accepted step.
+   double GetLastTimeStep() const { return last_dt; }
+
+   /// Return the number of accepted steps since the last call to Init().
+   int GetNumSteps() const { return num_steps; }
+
+   /// Return the number of rejected steps since the last call to Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+
+   /** @brief Perform time integration from time @a t [in] to time @a tf [in]
+       with adaptive steps, reaching exactly @a tf. On output, @a dt is the
+       step size proposed for the next step. */
+   void Run(Vector &x, double &t, double &dt, double tf) override;
+};
+
+
+/** An explicit embedded Runge-Kutta pair corresponding to a general Butcher
+    tableau, with the same layout of @a a, @a b and @a c as ExplicitRKSolver.
+    The error weights are e = b - b-hat, where b-hat defines the embedded
+    method. If @a fsal is true, the last stage is evaluated at the new
+    solution (first same as last) and is reused as the first stage of the
+    next step. */
+class EmbeddedRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   const double *a, *b, *e, *c;
+   const bool fsal;
+   bool k0_valid;
+   Vector y, *k;
+
+protected:
+   void TryStep(const Vector &x, double t, double dt, Vector &x_new,
+                Vector &err) override;
+
+   void AcceptStep() override;
+
+public:
+   EmbeddedRKSolver(int s_, const double *a_, const double *b_,
+                    const double *e_, const double *c_, int err_order,
+                    bool fsal_ = false);
+
+#ifdef MFEM_USE_MPI
+   EmbeddedRKSolver(MPI_Comm comm, int s_, const double *a_, const double *b_,
+                    const double *e_, const double *c_, int err_order,
+                    bool fsal_ = false);
+#endif
+
+   void Init(TimeDependentOperator &f_) override;
+
+   virtual ~EmbeddedRKSolver();
+};
+
+
+/** The Bogacki-Shampine 3(2) pair: a 4-stage, 3rd order FSAL method with an
+    embedded 2nd order error estimate. */
+class BogackiShampine32Solver : public EmbeddedRKSolver
+{
+private:
+   static const double a[6], b[4], e[4], c[3];
+
+public:
+   BogackiShampine32Solver() : EmbeddedRKSolver(4, a, b, e, c, 3, true) { }
+
+#ifdef MFEM_USE_MPI
+   BogackiShampine32Solver(MPI_Comm comm)
+      : EmbeddedRKSolver(comm, 4, a, b, e, c, 3, true) { }
+#endif
+};
+
+
+/** The Dormand-Prince 5(4) pair: a 7-stage, 5th order FSAL method with an
+    embedded 4th order error estimate. */
+class DormandPrince54Solver : public EmbeddedRKSolver
+{
+private:
+   static const double a[21], b[7], e[7], c[6];
+
+public:
+   DormandPrince54Solver() : EmbeddedRKSolver(7, a, b, e, c, 5, true) { }
+
+#ifdef MFEM_USE_MPI
+   DormandPrince54Solver(MPI_Comm comm)
+      : EmbeddedRKSolver(comm, 7, a, b, e, c, 5, true) { }
+#endif
+};
+
+
+/** An embedded singly diagonal implicit Runge-Kutta (SDIRK) pair
+    corresponding to a general Butcher tableau
+    +--------+----------------------------------+
+    | c[0]   | a[0]                             |
+    | c[1]   | a[1] a[2]                        |
+    | ...    |    ...                           |
+    | c[s-1] | ...            a[s(s+1)/2-1]     |
+    +--------+----------------------------------+
+    |        | b[0] b[1] ... b[s-1]             |
+    +--------+----------------------------------+
+    with equal diagonal entries, and error weights e = b - b-hat. Each stage
+    calls TimeDependentOperator::ImplicitSolve() once. */
+class EmbeddedSDIRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   const double *a, *b, *e, *c;
+   Vector y, *k;
+
+protected:
+   void TryStep(const Vector &x, double t, double dt, Vector &x_new,
+                Vector &err) override;
+
+public:
+   EmbeddedSDIRKSolver(int s_, const double *a_, const double *b_,
+                       const double *e_, const double *c_, int err_order);
+
+#ifdef MFEM_USE_MPI
+   EmbeddedSDIRKSolver(MPI_Comm comm, int s_, const double *a_,
+                       const double *b_, const double *e_, const double *c_,
+                       int err_order);
+#endif
+
+   void Init(TimeDependentOperator &f_) override;
+
+   virtual ~EmbeddedSDIRKSolver();
+};
+
+
+/** Two stage SDIRK method of order 2, L-stable and stiffly accurate, with an
+    embedded 1st order error estimate. */
+class SDIRK21EmbeddedSolver : public EmbeddedSDIRKSolver
+{
+private:
+   static const double a[3], b[2], e[2], c[2];
+
+public:
+   SDIRK21EmbeddedSolver() : EmbeddedSDIRKSolver(2, a, b, e, c, 2) { }
+
+#ifdef MFEM_USE_MPI
+   SDIRK21EmbeddedSolver(MPI_Comm comm)
+      : EmbeddedSDIRKSolver(comm, 2, a, b, e, c, 2) { }
+#endif
+};
+
+
+/** Five stage SDIRK method of order 4, L-stable and stiffly accurate, with an
+    embedded 3rd order error estimate. From Hairer and Wanner, "Solving
+    Ordinary Differential Equations II", Table IV.6.5. */
+class SDIRK43EmbeddedSolver : public EmbeddedSDIRKSolver
+{
+private:
+   static const double a[15], b[5], e[5], c[5];
+
+public:
+   SDIRK43EmbeddedSolver() : EmbeddedSDIRKSolver(5, a, b, e, c, 4) { }
+
+#ifdef MFEM_USE_MPI
+   SDIRK43EmbeddedSolver(MPI_Comm comm)
+      : EmbeddedSDIRKSolver(comm, 5, a, b, e, c, 4) { }
+#endif
+};
+
+
+/** @brief An additive implicit-explicit (IMEX) Runge-Kutta method for
+    dx/dt = f_E(x,t) + f_I(x,t), where f_E is non-stiff and f_I is stiff.
+
+    The explicit part is evaluated with TimeDependentOperator::ExplicitMult(),
+    @a y = f_E(@a x, t), and the implicit part is treated with
+    TimeDependentOperator::ImplicitSolve(), which must solve
+    @a k = f_I(@a x + @a dt @a k, t) for the implicit part only; with @a dt = 0
+    it is also used to evaluate f_I when a stage is explicit in f_I.
+
+    The method is defined by a pair of Butcher tableaux sharing the nodes c,
+    given as s x s row-major arrays: @a aE is strictly lower triangular and
+    @a aI is lower triangular. Stages with a zero diagonal entry of @a aI,
+    and stage derivatives that do not contribute to the solution, are not
+    computed. */
+class IMEXRKSolver : public ODESolver
+{
+private:
+   int s;
+   const double *aE, *bE, *aI, *bI, *c;
+   Array<bool> needE, needI;
+   Vector y, *kE, *kI;
+
+public:
+   IMEXRKSolver(int s_, const double *aE_, const double *bE_,
+                const double *aI_, const double *bI_, const double *c_);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+
+   virtual ~IMEXRKSolver();
+};
+
+
+/** The ARS(2,2,2) IMEX method of Ascher, Ruuth and Spiteri: 2nd order,
+    L-stable implicit part. */
+class ARS222Solver : public IMEXRKSolver
+{
+private:
+   static const double aE[9], bE[3], aI[9], bI[3], c[3];
+
+public:
+   ARS222Solver() : IMEXRKSolver(3, aE, bE, aI, bI, c) { }
+};
+
+
+/** The ARS(4,4,3) IMEX method of Ascher, Ruuth and Spiteri: 3rd order,
+    L-stable implicit part. */
+class ARS443Solver : public IMEXRKSolver
+{
+private:
+   static const double aE[25], bE[5], aI[25], bI[5], c[5];
+
+public:
+   ARS443Solver() : IMEXRKSolver(5, aE, bE, aI, bI, c) { }
+};
+
+
+/** The ARK3(2)4L[2]SA IMEX method of Kennedy and Carpenter: 3rd order, 4
+    stages, ESDIRK implicit part (L-stable, stiffly accurate). */
+class ARK3Solver : public IMEXRKSolver
+{
+private:
+   static const double aE[16], aI[16], b[4], c[4];
+
+public:
+   ARK3Solver() : IMEXRKSolver(4, aE, b, aI, b, c) { }
+};
+
+
+/** The ARK4(3)6L[2]SA IMEX method of Kennedy and Carpenter: 4th order, 6
+    stages, ESDIRK implicit part (L-stable, stiffly accurate). */
+class ARK4Solver : public IMEXRKSolver
+{
+private:
+   static const double aE[36], aI[36], b[6], c[6];
+
+public:
+   ARK4Solver() : IMEXRKSolver(6, aE, b, aI, b, c) { }
+};
+
+
+/** @brief Operator splitting for dx/dt = f_E(x,t) + f_I(x,t): each step
+    composes the flows of the explicit part, integrated with @a solverE, and of
+    the implicit part, integrated with @a solverI.
+
+    The parts are defined as in IMEXRKSolver: @a solverE sees an operator whose
+    Mult() calls TimeDependentOperator::ExplicitMult(), and @a solverI sees an
+    operator whose ImplicitSolve() calls TimeDependentOperator::ImplicitSolve()
+    and whose Mult() evaluates f_I with ImplicitSolve() with dt = 0. The Lie
+    splitting (1st order) advances E over dt and then I over dt; the Strang
+    splitting (2nd order) advances E over dt/2, I over dt, E over dt/2. The
+    sub-solvers must be one-step methods. */
+class SplittingSolver : public ODESolver
+{
+public:
+   enum Type { LIE, STRANG };
+
+protected:
+   /// Adapter exposing one part of the operator.
+   class PartOperator : public TimeDependentOperator
+   {
+   private:
+      TimeDependentOperator *f;
+      const bool expl;
+
+   public:
+      PartOperator(bool expl_) : f(NULL), expl(expl_) { }
+      void SetOperator(TimeDependentOperator &f_);
+      void SetTime(const double t_) override;
+      void Mult(const Vector &x, Vector &y) const override;
+      void ImplicitSolve(const double dt, const Vector &x, Vector &k) override;
+   };
+
+   ODESolver &solverE, &solverI;
+   const Type split;
+   PartOperator partE, partI;
+
+public:
+   SplittingSolver(ODESolver &solverE_, ODESolver &solverI_,
+                   Type split_ = STRANG);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier-Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
@@ -0,0 +1,259 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "parareal.hpp"
+#ifdef MFEM_USE_MPI
+#include "hypre.hpp"
+#endif
+#include <algorithm>
+#include <iomanip>
+
+namespace mfem
+{
+
+#ifdef MFEM_USE_MPI
+SpaceTimeCommunicator::SpaceTimeCommunicator(MPI_Comm comm,
+                                             int num_time_procs)
+{
+   int size, rank;
+   MPI_Comm_size(comm, &size);
+   MPI_Comm_rank(comm, &rank);
+   MFEM_VERIFY(num_time_procs > 0 && size % num_time_procs == 0,
+               "the number of ranks, " << size << ", is not a multiple of the "
+               "number of time ranks, " << num_time_procs);
+   const int space_size = size/num_time_procs;
+   MPI_Comm_split(comm, rank/space_size, rank%space_size, &space_comm);
+   MPI_Comm_split(comm, rank%space_size, rank/space_size, &time_comm);
+}
+
+SpaceTimeCommunicator::~SpaceTimeCommunicator()
+{
+   MPI_Comm_free(&space_comm);
+   MPI_Comm_free(&time_comm);
+}
+#endif
+
+PararealSolver::PararealSolver(ODESolver &fine_, ODESolver &coarse_)
+   : fine(fine_), coarse(coarse_), f(NULL), t_start(0.0), t_end(0.0),
+     fine_steps(1), coarse_steps(1), max_iter(10), print_level(0),
+     final_iter(0), rel_tol(1e-8), abs_tol(0.0), final_norm(0.0),
+     converged(false), monitor(NULL), time_rank(0), time_size(1),
+     print_rank(true)
+{
+#ifdef MFEM_USE_MPI
+   space_comm = time_comm = MPI_COMM_NULL;
+#endif
+   SetNumSlices(1);
+}
+
+#ifdef MFEM_USE_MPI
+PararealSolver::PararealSolver(const SpaceTimeCommunicator &st,
+                               ODESolver &fine_, ODESolver &coarse_)
+   : PararealSolver(fine_, coarse_)
+{
+   space_comm = st.GetSpaceComm();
+   time_comm = st.GetTimeComm();
+   MPI_Comm_rank(time_comm, &time_rank);
+   MPI_Comm_size(time_comm, &time_size);
+   int space_rank;
+   MPI_Comm_rank(space_comm, &space_rank);
+   print_rank = (time_rank == 0 && space_rank == 0);
+   SetNumSlices(time_size);
+}
+#endif
+
+void PararealSolver::SetNumSlices(int n)
+{
+   MFEM_VERIFY(n >= time_size, "the number of time slices, " << n
+               << ", is less than the number of time ranks, " << time_size);
+   num_slices = n;
+   first_slice = (time_rank*n)/time_size;
+   last_slice = ((time_rank + 1)*n)/time_size;
+}
+
+void PararealSolver::Propagate(ODESolver &solver, int steps, double t0,
+                               double t1, Vector &x) const
+{
+   // Restart the solver: multistep methods must not use the history of
+   // another slice
+   solver.Init(*f);
+   const double h = (t1 - t0)/steps;
+   double t = t0;
+   for (int i = 0; i < steps; i++)
+   {
+      double dt = h;
+      solver.Step(x, t, dt);
+   }
+}
+
+void PararealSolver::RecvStart()
+{
+   if (first_slice == 0) { return; }
+#ifdef MFEM_USE_MPI
+   MPI_Recv(U[0].HostWrite(), U[0].Size(), MPI_DOUBLE, time_rank - 1, 0,
+            time_comm, MPI_STATUS_IGNORE);
+#endif
+}
+
+void PararealSolver::SendEnd()
+{
+   if (last_slice == num_slices) { return; }
+#ifdef MFEM_USE_MPI
+   const Vector &end = U[last_slice - first_slice];
+   MPI_Send(end.HostRead(), end.Size(), MPI_DOUBLE, time_rank + 1, 0,
+            time_comm);
+#endif
+}
+
+double PararealSolver::Norm(const Vector &x) const
+{
+#ifdef MFEM_USE_MPI
+   if (space_comm != MPI_COMM_NULL) { return ParNormlp(x, 2.0, space_comm); }
+#endif
+   return x.Norml2();
+}
+
+double PararealSolver::MaxOverTime(double a) const
+{
+#ifdef MFEM_USE_MPI
+   if (time_comm != MPI_COMM_NULL)
+   {
+      double b;
+      MPI_Allreduce(&a, &b, 1, MPI_DOUBLE, MPI_MAX, time_comm);
+      return b;
+   }
+#endif
+   return a;
+}
+
+void PararealSolver::FinePropagation()
+{
+   for (int i = 0; i < last_slice - first_slice; i++)
+   {
+      const int n = first_slice + i;
+      FU[i] = U[i];
+      Propagate(fine, fine_steps, SliceTime(n), SliceTime(n+1), FU[i]);
+   }
+}
+
+double PararealSolver::CoarseCorrection()
+{
+   // U[0] is final for the first slice; otherwise it is received
+   RecvStart();
+   double change = 0.0;
+   for (int i = 0; i < last_slice - first_slice; i++)
+   {
+      const int n = first_slice + i;
+      gU = U[i];
+      Propagate(coarse, coarse_steps, SliceTime(n), SliceTime(n+1), gU);
+      // U[i+1] <- G(U[i]) + F(U_old[i]) - G(U_old[i])
+      add(gU, FU[i], dU);
+      dU -= GU[i];
+      GU[i] = gU;
+      U[i+1].Swap(dU);
+      dU -= U[i+1];
+      change = std::max(change, Norm(dU));
+   }
+   SendEnd();
+   return change;
+}
+
+void PararealSolver::Solve(TimeDependentOperator &f_, Vector &x, double t0,
+                           double tf)
+{
+   f = &f_;
+   t_start = t0;
+   t_end = tf;
+   const int nl = last_slice - first_slice;
+   const int size = f->Width();
+   MFEM_VERIFY(x.Size() == size, "invalid size of the initial value");
+   U.resize(nl + 1);
+   FU.resize(nl);
+   GU.resize(nl);
+   for (int i = 0; i <= nl; i++) { U[i].SetSize(size); }
+   for (int i = 0; i < nl; i++)
+   {
+      FU[i].SetSize(size);
+      GU[i].SetSize(size);
+   }
+   dU.SetSize(size);
+   gU.SetSize(size);
+
+   // Initial sequential coarse propagation
+   if (first_slice == 0) { U[0] = x; }
+   RecvStart();
+   for (int i = 0; i < nl; i++)
+   {
+      const int n = first_slice + i;
+      GU[i] = U[i];
+      Propagate(coarse, coarse_steps, SliceTime(n), SliceTime(n+1), GU[i]);
+      U[i+1] = GU[i];
+   }
+   SendEnd();
+
+   const double tol = std::max(rel_tol*Norm(x), abs_tol);
+   converged = false;
+   final_iter = 0;
+   final_norm = 0.0;
+   for (int k = 1; k <= max_iter; k++)
+   {
+      Relax();
+      FinePropagation();
+      final_norm = MaxOverTime(CoarseCorrection());
+      final_iter = k;
+      // After num_slices iterations, all slices are exact
+      converged = (final_norm <= tol || k == num_slices);
+      if (print_level > 0 && print_rank)
+      {
+         mfem::out << "   Parareal iteration : " << std::setw(3) << k
+                   << "  max ||U^{k} - U^{k-1}|| = " << final_norm << '\n';
+      }
+      if (monitor)
+      {
+         monitor->MonitorResidual(k, final_norm, dU, converged);
+      }
+      if (converged) { break; }
+   }
+   if (print_level >= 0 && !converged && print_rank)
+   {
+      mfem::out << "Parareal: No convergence!\n";
+   }
+
+   // The solution at tf is the end value of the last slice
+   x = U[nl];
+#ifdef MFEM_USE_MPI
+   if (time_comm != MPI_COMM_NULL)
+   {
+      MPI_Bcast(x.HostReadWrite(), size, MPI_DOUBLE, time_size - 1, time_comm);
+   }
+#endif
+}
+
+void MGRITSolver::Relax()
+{
+   if (!fcf) { return; }
+   // F- and C-relaxation: U[i+1] <- F(U[i]), using the old values
+   FinePropagation();
+   const int nl = last_slice - first_slice;
+   for (int i = nl - 1; i >= 0; i--) { U[i+1] = FU[i]; }
+   SendEnd();
+   RecvStart();
+   // The coarse propagation of the relaxed values enters the coarse-grid
+   // correction
+   for (int i = 0; i < nl; i++)
+   {
+      const int n = first_slice + i;
+      GU[i] = U[i];
+      Propagate(coarse, coarse_steps, SliceTime(n), SliceTime(n+1), GU[i]);
+   }
+}
+
+} // namespace mfem
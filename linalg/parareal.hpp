@@ -0,0 +1,210 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PARAREAL
+#define MFEM_PARAREAL
+
+#include "../config/config.hpp"
+#include "ode.hpp"
+#include "solvers.hpp"
+#include <vector>
+
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace mfem
+{
+
+#ifdef MFEM_USE_MPI
+/** @brief Split of an MPI communicator into space and time communicators.
+
+    The ranks of @a comm are split into @a num_time_procs groups of consecutive
+    ranks: rank r has space rank r % P_s and time rank r / P_s, where P_s is the
+    number of ranks divided by @a num_time_procs. The spatial problem (mesh,
+    spaces, operators) is distributed over the space communicator, which is
+    the same on every time rank, so the ranks with the same space rank hold
+    compatible vectors. */
+class SpaceTimeCommunicator
+{
+private:
+   MPI_Comm space_comm, time_comm;
+
+public:
+   SpaceTimeCommunicator(MPI_Comm comm, int num_time_procs);
+
+   /// Communicator over which the spatial problem is distributed.
+   MPI_Comm GetSpaceComm() const { return space_comm; }
+
+   /// Communicator connecting the time slices.
+   MPI_Comm GetTimeComm() const { return time_comm; }
+
+   ~SpaceTimeCommunicator();
+};
+#endif
+
+
+/** @brief The Parareal algorithm: parallel-in-time integration of an ODE with
+    a fine and a coarse propagator.
+
+    The time interval [t0, tf] is split into N time slices of equal length
+    with start values U_n. The fine propagator F applies SetFineSteps() steps
+    of the fine ODESolver over a slice and the coarse propagator G applies
+    SetCoarseSteps() steps of the coarse ODESolver. Each iteration computes
+    F(U_n^k) for all slices in parallel and then performs the sequential
+    coarse correction
+    @f[ U_{n+1}^{k+1} = G(U_n^{k+1}) + F(U_n^k) - G(U_n^k). @f]
+    After k iterations, the first k slices are exact, i.e. they agree with the
+    sequential fine integration, so at most N iterations are performed.
+
+    In parallel, the slices are distributed in contiguous blocks over the time
+    communicator of a SpaceTimeCommunicator. Without a time communicator, all
+    slices are processed sequentially, which is useful to study the convergence
+    of the method.
+
+    The iteration stops when the largest change of the slice values,
+    max_n ||U_n^{k+1} - U_n^k||, is below max(rel_tol ||x0||, abs_tol). The
+    monitor, see SetMonitor(), receives this norm and the change of the last
+    local slice value through IterativeSolverMonitor::MonitorResidual(). */
+class PararealSolver
+{
+protected:
+   ODESolver &fine, &coarse;
+   TimeDependentOperator *f;
+   double t_start, t_end;
+   int fine_steps, coarse_steps, num_slices;
+   int max_iter, print_level, final_iter;
+   double rel_tol, abs_tol, final_norm;
+   bool converged;
+   IterativeSolverMonitor *monitor;
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm space_comm, time_comm;
+#endif
+   int time_rank, time_size;
+   /// Locally owned slices: first_slice <= n < last_slice.
+   int first_slice, last_slice;
+
+   /** Start values U_n and fine and coarse propagations of the local slices;
+       U[last_slice - first_slice] is the end value of the last local slice. */
+   std::vector<Vector> U, FU, GU;
+   Vector dU, gU;
+   bool print_rank;
+
+   /// Apply @a steps steps of @a solver to @a x from time @a t0 to @a t1.
+   void Propagate(ODESolver &solver, int steps, double t0, double t1,
+                  Vector &x) const;
+
+   /// Start time of slice @a n.
+   double SliceTime(int n) const
+   { return t_start + n*(t_end - t_start)/num_slices; }
+
+   /// Receive U[0] from the previous time rank, if any.
+   void RecvStart();
+   /// Send the end value U[last] to the next time rank, if any.
+   void SendEnd();
+
+   /// Compute FU[i] = F(U[i]) for all local slices.
+   void FinePropagation();
+
+   /// Sequential coarse correction; return the largest local change of U.
+   double CoarseCorrection();
+
+   /// Relaxation applied before the fine propagation of each iteration.
+   virtual void Relax() { }
+
+   double Norm(const Vector &x) const;
+   double MaxOverTime(double a) const;
+
+public:
+   /** @brief Create a serial Parareal solver with fine propagator @a fine_
+       and coarse propagator @a coarse_. */
+   PararealSolver(ODESolver &fine_, ODESolver &coarse_);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Create a Parareal solver whose slices are distributed over the
+       time communicator of @a st; the vectors are distributed over its space
+       communicator. */
+   PararealSolver(const SpaceTimeCommunicator &st, ODESolver &fine_,
+                  ODESolver &coarse_);
+#endif
+
+   /** @brief Set the number of time slices; in parallel, it must be at least
+       the number of time ranks. Default: 1 per time rank. */
+   void SetNumSlices(int n);
+
+   /// Set the number of steps of the fine propagator per slice. Default: 1.
+   void SetFineSteps(int steps) { fine_steps = steps; }
+
+   /// Set the number of steps of the coarse propagator per slice. Default: 1.
+   void SetCoarseSteps(int steps) { coarse_steps = steps; }
+
+   void SetRelTol(double rtol) { rel_tol = rtol; }
+   void SetAbsTol(double atol) { abs_tol = atol; }
+   void SetMaxIter(int max_it) { max_iter = max_it; }
+   void SetPrintLevel(int print_lvl) { print_level = print_lvl; }
+   void SetMonitor(IterativeSolverMonitor &m) { monitor = &m; }
+
+   /** @brief Integrate the ODE defined by @a f_ from time @a t0 to time @a tf,
+       starting from the initial value @a x. On output, @a x is the solution
+       at time @a tf on all ranks. */
+   void Solve(TimeDependentOperator &f_, Vector &x, double t0, double tf);
+
+   /// Return the range [first, last) of the slices owned by this rank.
+   void GetLocalSlices(int &first, int &last) const
+   { first = first_slice; last = last_slice; }
+
+   /** @brief Return the value at the start time of the local slice @a n, or
+       at the final time for @a n = last, see GetLocalSlices(). */
+   const Vector &GetSliceValue(int n) const { return U[n - first_slice]; }
+
+   int GetNumIterations() const { return final_iter; }
+   bool GetConverged() const { return converged; }
+   double GetFinalNorm() const { return final_norm; }
+
+   virtual ~PararealSolver() { }
+};
+
+
+/** @brief Two-level multigrid reduction in time (MGRIT) with FCF-relaxation.
+
+    The C-points are the slice boundaries and the F-points are the
+    intermediate fine steps. With FCF-relaxation, each iteration first
+    propagates the C-point values with the fine propagator, U_{n+1} <- F(U_n),
+    in parallel (F- and C-relaxation) and then performs the Parareal iteration
+    (F-relaxation and coarse-grid correction with the coarse propagator as
+    the coarse-grid operator). This doubles the fine work per iteration and
+    usually reduces the number of iterations. With F-relaxation only, see
+    SetFCFRelaxation(), the method is equivalent to Parareal. */
+class MGRITSolver : public PararealSolver
+{
+protected:
+   bool fcf;
+
+   void Relax() override;
+
+public:
+   MGRITSolver(ODESolver &fine_, ODESolver &coarse_)
+      : PararealSolver(fine_, coarse_), fcf(true) { }
+
+#ifdef MFEM_USE_MPI
+   MGRITSolver(const SpaceTimeCommunicator &st, ODESolver &fine_,
+               ODESolver &coarse_)
+      : PararealSolver(st, fine_, coarse_), fcf(true) { }
+#endif
+
+   /// Use FCF-relaxation (default) or F-relaxation only.
+   void SetFCFRelaxation(bool use_fcf = true) { fcf = use_fcf; }
+};
+
+} // namespace mfem
+
+#endif
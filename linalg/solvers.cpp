@@ -294,7 +294,15 @@ void OperatorChebyshevSmoother::Setup()
    auto I = ess_tdof_list.Read();
    MFEM_FORALL(i, ess_tdof_list.Size(), X[I[i]] = 1.0; );
 
-   // Set up Chebyshev coefficients
+   ComputeCoefficients(order, max_eig_estimate, coeffs);
+}
+
+void OperatorChebyshevSmoother::ComputeCoefficients(
+   const int order, const double max_eig_estimate, Array<double> &coeffs)
+{
+   coeffs.SetSize(order);
+
+   // Chebyshev coefficients
    // For reference, see e.g., Parallel multigrid smoothing: polynomial versus
    // Gauss-Seidel by Adams et al.
    double upper_bound = 1.2 * max_eig_estimate;
@@ -1240,6 +1248,132 @@ void GMRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+IterativeRefinementSolver::IterativeRefinementSolver(Method method_)
+   : method(method_), gmres_prec(*this), inner_iter(0)
+{
+   gmres.iterative_mode = false;
+   gmres.SetPreconditioner(gmres_prec);
+   SetCorrectionTolerance(1e-6);
+}
+
+#ifdef MFEM_USE_MPI
+IterativeRefinementSolver::IterativeRefinementSolver(MPI_Comm _comm,
+                                                     Method method_)
+   : IterativeSolver(_comm), method(method_), gmres(_comm), gmres_prec(*this),
+     inner_iter(0)
+{
+   gmres.iterative_mode = false;
+   gmres.SetPreconditioner(gmres_prec);
+   SetCorrectionTolerance(1e-6);
+}
+#endif
+
+void IterativeRefinementSolver::SetOperator(const Operator &op)
+{
+   // Sets up the low precision solver
+   IterativeSolver::SetOperator(op);
+   SetupRefinement();
+}
+
+void IterativeRefinementSolver::SetupRefinement()
+{
+   r.SetSize(width);
+   c.SetSize(width);
+   if (method == GMRES_IR)
+   {
+      // The preconditioner of GMRES applies the low precision solver without
+      // setting it up again
+      MFEM_VERIFY(prec, "the low precision solver is not set");
+      gmres.SetOperator(*oper);
+   }
+}
+
+void IterativeRefinementSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(oper && prec,
+               "the operator and the low precision solver must be set");
+
+   inner_iter = 0;
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   double nom = Norm(r), nomold;
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  ||r|| = "
+                << nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+   Monitor(0, nom, r, x);
+
+   const double r0 = std::max(nom*rel_tol, abs_tol);
+   converged = (nom <= r0);
+   final_iter = 0;
+   for (int i = 1; !converged && i <= max_iter; i++)
+   {
+      // Correction in low precision: c = M r, or GMRES solve of A c = r
+      // preconditioned with M
+      if (method == IR)
+      {
+         prec->Mult(r, c);
+      }
+      else
+      {
+         gmres.Mult(r, c);
+         inner_iter += gmres.GetNumIterations();
+      }
+      x += c;
+
+      // Residual in double precision
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+      nomold = nom;
+      nom = Norm(r);
+      final_iter = i;
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  ||r|| = "
+                   << nom << '\n';
+      }
+      Monitor(i, nom, r, x);
+
+      if (nom <= r0)
+      {
+         converged = 1;
+      }
+      else if (nom >= nomold)
+      {
+         // The low precision solver is not accurate enough
+         break;
+      }
+   }
+
+   if (print_level == 2)
+   {
+      mfem::out << "Number of IR iterations: " << final_iter << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  ||r|| = "
+                << nom << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "IR: No convergence!" << '\n';
+   }
+   final_norm = nom;
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+
 void BiCGSTABSolver::UpdateVectors()
 {
    p.SetSize(width);
@@ -245,6 +245,13 @@ public:
 
    void Setup();
 
+   /** @brief Compute the coefficients @a coeffs of the Chebyshev polynomial of
+       order @a order for the given estimate of the largest eigenvalue of the
+       diagonally preconditioned operator. */
+   static void ComputeCoefficients(const int order,
+                                   const double max_eig_estimate,
+                                   Array<double> &coeffs);
+
 private:
    const int order;
    double max_eig_estimate;
@@ -370,6 +377,85 @@ void GMRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
            double rtol = 1e-12, double atol = 1e-24);
 
 
+/** @brief Iterative refinement of the solution of A x = b, with corrections
+    computed by a low precision solver.
+
+    The low precision solver M, e.g. FloatLUSolver, is set with
+    SetPreconditioner() and the double precision operator A with
+    SetOperator(). With Method::IR, each iteration computes the residual
+    r = b - A x in double precision and updates x += M r. With Method::GMRES_IR,
+    the correction equation A c = r is solved by GMRES preconditioned with M,
+    to the relative tolerance set with SetCorrectionTolerance(). GMRES-IR
+    converges for less accurate M than the plain refinement, e.g. for
+    ill-conditioned systems factored in single precision.
+
+    The convergence is checked on the norm of the double precision residual,
+    relative to the initial one. As for the other IterativeSolver%s, see
+    SetPrintLevel(), SetMonitor(), GetNumIterations() and GetConverged(). The
+    iterations also stop when the residual does not decrease, i.e. when M is not
+    accurate enough for the refinement to converge. */
+class IterativeRefinementSolver : public IterativeSolver
+{
+public:
+   enum Method
+   {
+      IR,      ///< Stationary iterative refinement.
+      GMRES_IR ///< Corrections computed by GMRES, preconditioned by M.
+   };
+
+protected:
+   /** Preconditioner of the GMRES solves of Method::GMRES_IR, which applies
+       the low precision solver. Its SetOperator() only sets the size, so that
+       GMRESSolver::SetOperator() does not set up the low precision solver a
+       second time. */
+   class CorrectionPreconditioner : public Solver
+   {
+   protected:
+      const IterativeRefinementSolver &ir;
+
+   public:
+      CorrectionPreconditioner(const IterativeRefinementSolver &ir_)
+         : ir(ir_) { }
+
+      virtual void Mult(const Vector &x, Vector &y) const
+      { ir.prec->Mult(x, y); }
+
+      virtual void SetOperator(const Operator &op)
+      { height = op.Height(); width = op.Width(); }
+   };
+
+   Method method;
+   GMRESSolver gmres;
+   CorrectionPreconditioner gmres_prec;
+   mutable int inner_iter;
+   mutable Vector r, c;
+
+   /// Set up the work vectors and GMRES for the operator, already set in oper.
+   void SetupRefinement();
+
+public:
+   IterativeRefinementSolver(Method method_ = IR);
+
+#ifdef MFEM_USE_MPI
+   IterativeRefinementSolver(MPI_Comm _comm, Method method_ = IR);
+#endif
+
+   /** @brief Set the relative tolerance and the maximum number of iterations
+       of the GMRES correction solves of Method::GMRES_IR. The defaults are
+       1e-6 and 100. */
+   void SetCorrectionTolerance(double rtol, int max_it = 100)
+   { gmres.SetRelTol(rtol); gmres.SetMaxIter(max_it); }
+
+   /// Return the total number of GMRES iterations of the last Mult().
+   int GetNumInnerIterations() const { return inner_iter; }
+
+   /// Also calls SetOperator for the preconditioner, which is set before.
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+
 /// BiCGSTAB method
 class BiCGSTABSolver : public IterativeSolver
 {
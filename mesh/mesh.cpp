@@ -781,18 +781,30 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
                                                   const int flags,
                                                   MemoryType d_mt)
 {
+   this->EnsureNodes();
+
    for (int i = 0; i < geom_factors.Size(); i++)
    {
       GeometricFactors *gf = geom_factors[i];
-      if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags)
+      if (!ir.SamePoints(gf->ir_points)) { continue; }
+      // The previous rule with the same points may no longer exist
+      gf->IntRule = &ir;
+      if ((gf->computed_factors & flags) != flags || gf->sequence != sequence)
       {
-         return gf;
+         // Update the shared object in place, since its previous users may
+         // still hold a pointer to it
+         gf->computed_factors |= flags;
+         gf->Compute(*Nodes, d_mt);
+         gf->sequence = sequence;
       }
+      gf->ref_count++;
+      return gf;
    }
 
-   this->EnsureNodes();
-
    GeometricFactors *gf = new GeometricFactors(this, ir, flags, d_mt);
+   ir.Copy(gf->ir_points);
+   gf->sequence = sequence;
+   gf->ref_count = 1;
    geom_factors.Append(gf);
    return gf;
 }
@@ -801,23 +813,54 @@ const FaceGeometricFactors* Mesh::GetFaceGeometricFactors(
    const IntegrationRule& ir,
    const int flags, FaceType type)
 {
+   this->EnsureNodes();
+
    for (int i = 0; i < face_geom_factors.Size(); i++)
    {
       FaceGeometricFactors *gf = face_geom_factors[i];
-      if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags &&
-          gf->type==type)
+      if (gf->type != type || !ir.SamePoints(gf->ir_points))
       {
-         return gf;
+         continue;
       }
+      gf->IntRule = &ir;
+      if ((gf->computed_factors & flags) != flags || gf->sequence != sequence)
+      {
+         gf->computed_factors |= flags;
+         gf->Compute();
+         gf->sequence = sequence;
+      }
+      gf->ref_count++;
+      return gf;
    }
 
-   this->EnsureNodes();
-
    FaceGeometricFactors *gf = new FaceGeometricFactors(this, ir, flags, type);
+   ir.Copy(gf->ir_points);
+   gf->sequence = sequence;
+   gf->ref_count = 1;
    face_geom_factors.Append(gf);
    return gf;
 }
 
+void Mesh::ReleaseGeometricFactors(const GeometricFactors *geom)
+{
+   GeometricFactors *gf = const_cast<GeometricFactors*>(geom);
+   MFEM_VERIFY(geom_factors.Find(gf) >= 0,
+               "the GeometricFactors are not stored by the Mesh");
+   if (--gf->ref_count > 0) { return; }
+   geom_factors.DeleteFirst(gf);
+   delete gf;
+}
+
+void Mesh::ReleaseGeometricFactors(const FaceGeometricFactors *geom)
+{
+   FaceGeometricFactors *gf = const_cast<FaceGeometricFactors*>(geom);
+   MFEM_VERIFY(face_geom_factors.Find(gf) >= 0,
+               "the FaceGeometricFactors are not stored by the Mesh");
+   if (--gf->ref_count > 0) { return; }
+   face_geom_factors.DeleteFirst(gf);
+   delete gf;
+}
+
 void Mesh::DeleteGeometricFactors()
 {
    for (int i = 0; i < geom_factors.Size(); i++)
@@ -832,6 +875,32 @@ void Mesh::DeleteGeometricFactors()
    face_geom_factors.SetSize(0);
 }
 
+void Mesh::NodesUpdated()
+{
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      geom_factors[i]->sequence = -1;
+   }
+   for (int i = 0; i < face_geom_factors.Size(); i++)
+   {
+      face_geom_factors[i]->sequence = -1;
+   }
+}
+
+long Mesh::GeometricFactorsMemoryUsage() const
+{
+   long mem = 0;
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      mem += geom_factors[i]->MemoryUsage();
+   }
+   for (int i = 0; i < face_geom_factors.Size(); i++)
+   {
+      mem += face_geom_factors[i]->MemoryUsage();
+   }
+   return mem;
+}
+
 void Mesh::GetLocalFaceTransformation(
    int face_type, int elem_type, IsoparametricTransformation &Transf, int info)
 {
@@ -7092,6 +7161,7 @@ void Mesh::MoveVertices(const Vector &displacements)
       {
          vertices[i](j) += displacements(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetVertices(Vector &vert_coord) const
@@ -7112,6 +7182,7 @@ void Mesh::SetVertices(const Vector &vert_coord)
       {
          vertices[i](j) = vert_coord(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetNode(int i, double *coord) const
@@ -7151,6 +7222,7 @@ void Mesh::SetNode(int i, const double *coord)
       }
 
    }
+   NodesUpdated();
 }
 
 void Mesh::MoveNodes(const Vector &displacements)
@@ -7158,6 +7230,7 @@ void Mesh::MoveNodes(const Vector &displacements)
    if (Nodes)
    {
       (*Nodes) += displacements;
+      NodesUpdated();
    }
    else
    {
@@ -7182,6 +7255,7 @@ void Mesh::SetNodes(const Vector &node_coord)
    if (Nodes)
    {
       (*Nodes) = node_coord;
+      NodesUpdated();
    }
    else
    {
@@ -7206,12 +7280,14 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
    {
       ncmesh->MakeTopologyOnly();
    }
+   NodesUpdated();
 }
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
+   NodesUpdated();
    // TODO:
    // if (nodes)
    //    nodes->FESpace()->MakeNURBSextOwner();
@@ -10853,6 +10929,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
       xnew.ProjectCoefficient(f_pert);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::Transform(VectorCoefficient &deformation)
@@ -10877,6 +10954,7 @@ void Mesh::Transform(VectorCoefficient &deformation)
       xnew.ProjectCoefficient(deformation);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::RemoveUnusedVertices()
@@ -11216,6 +11294,7 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
 
 GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
                                    int flags, MemoryType d_mt)
+   : sequence(-1), ref_count(0)
 {
    this->mesh = mesh;
    IntRule = &ir;
@@ -11223,14 +11302,27 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
 
    MFEM_ASSERT(mesh->GetNumGeometries(mesh->Dimension()) <= 1,
                "mixed meshes are not supported!");
-   MFEM_ASSERT(mesh->GetNodes(), "meshes without nodes are not supported!");
 
-   Compute(*mesh->GetNodes(), d_mt);
+   if (mesh->GetNodes())
+   {
+      Compute(*mesh->GetNodes(), d_mt);
+      return;
+   }
+
+   // Use temporary linear nodes, without modifying the mesh
+   const int dim = mesh->Dimension(), sdim = mesh->SpaceDimension();
+   H1_FECollection fec(1, dim);
+   FiniteElementSpace fes(const_cast<Mesh*>(mesh), &fec, sdim,
+                          Ordering::byVDIM);
+   GridFunction nodes(&fes);
+   mesh->GetNodes(nodes);
+   Compute(nodes, d_mt);
 }
 
 GeometricFactors::GeometricFactors(const GridFunction &nodes,
                                    const IntegrationRule &ir,
                                    int flags, MemoryType d_mt)
+   : sequence(-1), ref_count(0)
 {
    this->mesh = nodes.FESpace()->GetMesh();
    IntRule = &ir;
@@ -11274,7 +11366,8 @@ void GeometricFactors::Compute(const GridFunction &nodes,
    // All X, J, and detJ use this layout:
    qi->SetOutputLayout(QVectorLayout::byNODES);
 
-   const bool use_tensor_products = UsesTensorBasis(*fespace);
+   const bool use_tensor_products = UsesTensorBasis(*fespace) &&
+                                    IntRule->IsTensorProduct(dim);
 
    qi->DisableTensorProducts(!use_tensor_products);
    const ElementDofOrdering e_ordering = use_tensor_products ?
@@ -11294,20 +11387,32 @@ void GeometricFactors::Compute(const GridFunction &nodes,
    }
 }
 
+long GeometricFactors::MemoryUsage() const
+{
+   return (X.Size() + J.Size() + detJ.Size())*sizeof(double) +
+          ir_points.MemoryUsage();
+}
+
 FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
                                            const IntegrationRule &ir,
                                            int flags, FaceType type)
-   : type(type)
+   : sequence(-1), ref_count(0), type(type)
 {
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
 
+   Compute();
+}
+
+void FaceGeometricFactors::Compute()
+{
+   const int flags = computed_factors;
    const GridFunction *nodes = mesh->GetNodes();
    const FiniteElementSpace *fespace = nodes->FESpace();
    const int vdim = fespace->GetVDim();
    const int NF   = fespace->GetNFbyType(type);
-   const int NQ   = ir.GetNPoints();
+   const int NQ   = IntRule->GetNPoints();
 
    const Operator *face_restr = fespace->GetFaceRestriction(
                                    ElementDofOrdering::LEXICOGRAPHIC,
@@ -11339,10 +11444,16 @@ FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
    }
 
    const FaceQuadratureInterpolator *qi = fespace->GetFaceQuadratureInterpolator(
-                                             ir, type);
+                                             *IntRule, type);
    qi->Mult(Fnodes, eval_flags, X, J, detJ, normal);
 }
 
+long FaceGeometricFactors::MemoryUsage() const
+{
+   return (X.Size() + J.Size() + detJ.Size() + normal.Size())*sizeof(double) +
+          ir_points.MemoryUsage();
+}
+
 NodeExtrudeCoefficient::NodeExtrudeCoefficient(const int dim, const int _n,
                                                const double _s)
    : VectorCoefficient(dim), n(_n), s(_s), tip(p, dim-1)
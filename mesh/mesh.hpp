@@ -858,7 +858,19 @@ public:
        integration rule. */
    /** If the device MemoryType parameter @a d_mt is specified, then the
        returned object will use that type unless it was previously allocated
-       with a different type. */
+       with a different type.
+
+       The Mesh keeps one GeometricFactors object per integration rule, shared
+       by all callers: rules with the same points and weights share the object
+       even if they are different IntegrationRule objects, and factors that
+       were not computed yet are added to the existing object. The factors are
+       recomputed, in the same object, when they are requested after the mesh
+       or its nodes have changed, see NodesUpdated().
+
+       Each call adds a reference to the returned object, which a caller that
+       no longer needs the factors can drop with ReleaseGeometricFactors().
+       The objects are deleted when their last reference is released, and
+       otherwise with the Mesh. */
    const GeometricFactors* GetGeometricFactors(
       const IntegrationRule& ir,
       const int flags,
@@ -866,15 +878,37 @@ public:
 
    /** @brief Return the mesh geometric factors for the faces corresponding
         to the given integration rule. */
+   /** The objects are shared and updated as in GetGeometricFactors(). */
    const FaceGeometricFactors* GetFaceGeometricFactors(const IntegrationRule& ir,
                                                        const int flags,
                                                        FaceType type);
 
+   /** @brief Release a reference to @a geom, returned by
+       GetGeometricFactors(), deleting it if it was the last one. */
+   void ReleaseGeometricFactors(const GeometricFactors *geom);
+
+   /** @brief Release a reference to @a geom, returned by
+       GetFaceGeometricFactors(), deleting it if it was the last one. */
+   void ReleaseGeometricFactors(const FaceGeometricFactors *geom);
+
    /// Destroy all GeometricFactors stored by the Mesh.
-   /** This method can be used to force recomputation of the GeometricFactors,
-       for example, after the mesh nodes are modified externally. */
+   /** The pointers returned by GetGeometricFactors() and
+       GetFaceGeometricFactors() become invalid. To only force recomputation of
+       the factors, use NodesUpdated(). */
    void DeleteGeometricFactors();
 
+   /** @brief Notify the Mesh that its nodes or vertices have changed, so that
+       the stored GeometricFactors and FaceGeometricFactors are recomputed the
+       next time they are requested. */
+   /** This is done automatically by the Mesh methods that modify the nodes,
+       e.g. MoveNodes(), SetNodes() and Transform(). It must be called after
+       the nodes are modified externally, e.g. through GetNodes(). */
+   void NodesUpdated();
+
+   /** @brief Return the memory, in bytes, used by the GeometricFactors and
+       FaceGeometricFactors stored by the Mesh. */
+   long GeometricFactorsMemoryUsage() const;
+
    /// Equals 1 + num_holes - num_loops
    inline int EulerNumber() const
    { return NumOfVertices - NumOfEdges + NumOfFaces - NumOfElements; }
@@ -1522,8 +1556,16 @@ std::ostream &operator<<(std::ostream &out, const Mesh &mesh);
     Mesh. See Mesh::GetGeometricFactors(). */
 class GeometricFactors
 {
+   friend class Mesh;
 
 private:
+   /// Copy of the points and weights of #IntRule, identifying the factors.
+   Array<IntegrationPoint> ir_points;
+   /// Mesh sequence at the time of the computation, -1 when out of date.
+   long sequence;
+   /// Number of the GetGeometricFactors() calls not yet released.
+   int ref_count;
+
    void Compute(const GridFunction &nodes,
                 MemoryType d_mt = MemoryType::DEFAULT);
 
@@ -1568,6 +1610,9 @@ public:
        - NQ = number of quadrature points per element, and
        - NE = number of elements in the mesh. */
    Vector detJ;
+
+   /// Return the memory, in bytes, used by the factors.
+   long MemoryUsage() const;
 };
 
 /** @brief Structure for storing face geometric factors: coordinates, Jacobians,
@@ -1576,6 +1621,18 @@ public:
     Mesh. See Mesh::GetFaceGeometricFactors(). */
 class FaceGeometricFactors
 {
+   friend class Mesh;
+
+private:
+   /// Copy of the points and weights of #IntRule, identifying the factors.
+   Array<IntegrationPoint> ir_points;
+   /// Mesh sequence at the time of the computation, -1 when out of date.
+   long sequence;
+   /// Number of the GetGeometricFactors() calls not yet released.
+   int ref_count;
+
+   void Compute();
+
 public:
    const Mesh *mesh;
    const IntegrationRule *IntRule;
@@ -1622,6 +1679,9 @@ public:
        - SDIM = space dimension of the mesh = mesh.SpaceDimension(), and
        - NF = number of faces in the mesh. */
    Vector normal;
+
+   /// Return the memory, in bytes, used by the factors.
+   long MemoryUsage() const;
 };
 
 /// Class used to extrude the nodes of a mesh
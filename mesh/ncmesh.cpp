@@ -16,6 +16,7 @@
 #include <string>
 #include <cmath>
 #include <map>
+#include <vector>
 
 #include "ncmesh_tables.hpp"
 
@@ -1557,6 +1558,14 @@ void NCMesh::Refine(const Array<Refinement>& refinements)
 
       Update: what about a FIFO instead of ref_stack? */
 
+   /* NOTE: unlike the face and edge lists, the refinement is not threaded.
+      RefineElement creates the new nodes, faces and elements in the shared
+      hash tables and block arrays, and the order of these insertions defines
+      their ids and hence the numbering of the refined mesh. Refining batches
+      of independent elements concurrently would need the insertions to be
+      replayed in the sequential order (or a renumbering pass) to keep the
+      numbering deterministic, which is not implemented yet. */
+
 #if defined(MFEM_DEBUG) && !defined(MFEM_USE_MPI)
    mfem::out << "Refined " << refinements.Size() << " + " << nforced
              << " elements" << std::endl;
@@ -2673,6 +2682,16 @@ struct MatrixMap
       }
    }
 
+   /// Return pointers to the matrices, in the order of their indices.
+   void GetMatrices(Array<const NCMesh::PointMatrix*> &matrices) const
+   {
+      matrices.SetSize(map.size());
+      for (const auto &pair : map)
+      {
+         matrices[pair.second - 1] = &pair.first;
+      }
+   }
+
    void DumpBucketSizes() const
    {
       for (unsigned i = 0; i < map.bucket_count(); i++)
@@ -2685,6 +2704,42 @@ private:
    std::unordered_map<NCMesh::PointMatrix, int, PointMatrixHash> map;
 };
 
+/** The slaves found by traversing a contiguous range of the faces (edges) of
+    BuildFaceList (BuildEdgeList). The chunks are traversed in parallel and
+    then merged in order, so the result does not depend on the threads. */
+struct TraversalChunk
+{
+   Array<NCMesh::Slave> slaves;
+   Array<int> ends; ///< end of the slaves of each traversed face/edge
+   MatrixMap matrix_maps[Geometry::NumGeom]; ///< chunk-local point matrices
+
+   /** Renumber the point matrices of the slaves to indices in the global
+       'maps', in the same order as a sequential traversal would. */
+   void RenumberMatrices(MatrixMap maps[])
+   {
+      // the local indices are in the order of first appearance, so mapping
+      // them in increasing order preserves the global order
+      Array<int> remap[Geometry::NumGeom];
+      Array<const NCMesh::PointMatrix*> matrices;
+      for (int i = 0; i < Geometry::NumGeom; i++)
+      {
+         matrix_maps[i].GetMatrices(matrices);
+         remap[i].SetSize(matrices.Size());
+         for (int j = 0; j < matrices.Size(); j++)
+         {
+            remap[i][j] = maps[i].GetIndex(*matrices[j]);
+         }
+      }
+      for (int i = 0; i < slaves.Size(); i++)
+      {
+         NCMesh::Slave &sl = slaves[i];
+         sl.matrix = remap[sl.Geom()][sl.matrix];
+      }
+   }
+};
+
+static const int traversal_chunk_size = 256;
+
 
 int NCMesh::ReorderFacePointMat(int v0, int v1, int v2, int v3,
                                 int elem, const PointMatrix &pm,
@@ -2719,19 +2774,19 @@ int NCMesh::ReorderFacePointMat(int v0, int v1, int v2, int v3,
 
 void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
                               const PointMatrix& pm, int level,
-                              Face* eface[4], MatrixMap &matrix_map)
+                              const Face* eface[4], Array<Slave> &slaves,
+                              MatrixMap &matrix_map) const
 {
    if (level > 0)
    {
       // check if we made it to a face that is not split further
-      Face* fa = faces.Find(vn0, vn1, vn2, vn3);
+      const Face* fa = faces.Find(vn0, vn1, vn2, vn3);
       if (fa)
       {
          // we have a slave face, add it to the list
          int elem = fa->GetSingleElement();
-         face_list.slaves.Append(
-            Slave(fa->index, elem, -1, Geometry::SQUARE));
-         Slave &sl = face_list.slaves.Last();
+         slaves.Append(Slave(fa->index, elem, -1, Geometry::SQUARE));
+         Slave &sl = slaves.Last();
 
          // reorder the point matrix according to slave face orientation
          PointMatrix pm_r;
@@ -2749,18 +2804,18 @@ void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
    int mid[5];
    int split = QuadFaceSplitType(vn0, vn1, vn2, vn3, mid);
 
-   Face *ef[2][4];
+   const Face *ef[2][4];
    if (split == 1) // "X" split face
    {
       Point pmid0(pm(0), pm(1)), pmid2(pm(2), pm(3));
 
       TraverseQuadFace(vn0, mid[0], mid[2], vn3,
                        PointMatrix(pm(0), pmid0, pmid2, pm(3)),
-                       level+1, ef[0], matrix_map);
+                       level+1, ef[0], slaves, matrix_map);
 
       TraverseQuadFace(mid[0], vn1, vn2, mid[2],
                        PointMatrix(pmid0, pm(1), pm(2), pmid2),
-                       level+1, ef[1], matrix_map);
+                       level+1, ef[1], slaves, matrix_map);
 
       eface[1] = ef[1][1];
       eface[3] = ef[0][3];
@@ -2772,11 +2827,11 @@ void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
 
       TraverseQuadFace(vn0, vn1, mid[1], mid[3],
                        PointMatrix(pm(0), pm(1), pmid1, pmid3),
-                       level+1, ef[0], matrix_map);
+                       level+1, ef[0], slaves, matrix_map);
 
       TraverseQuadFace(mid[3], mid[1], vn2, vn3,
                        PointMatrix(pmid3, pmid1, pm(2), pm(3)),
-                       level+1, ef[1], matrix_map);
+                       level+1, ef[1], slaves, matrix_map);
 
       eface[0] = ef[0][0];
       eface[2] = ef[1][2];
@@ -2786,7 +2841,7 @@ void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
    // check for a prism edge constrained by the master face
    if (HavePrisms() && mid[4] >= 0)
    {
-      Node& enode = nodes[mid[4]];
+      const Node& enode = nodes[mid[4]];
       if (enode.HasEdge())
       {
          // process the edge only if it's not shared by slave faces
@@ -2806,10 +2861,10 @@ void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
             MFEM_ASSERT(eid.Size() < 2, "non-unique edge prism");
 
             // create a slave face record with a degenerate point matrix
-            face_list.slaves.Append(
+            slaves.Append(
                Slave(-1 - enode.edge_index,
                      eid[0].element, eid[0].local, Geometry::SQUARE));
-            Slave &sl = face_list.slaves.Last();
+            Slave &sl = slaves.Last();
 
             if (split == 1)
             {
@@ -2837,7 +2892,7 @@ void NCMesh::TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
 }
 
 void NCMesh::TraverseTetEdge(int vn0, int vn1, const Point &p0, const Point &p1,
-                             MatrixMap &matrix_map)
+                             Array<Slave> &slaves, MatrixMap &matrix_map) const
 {
    int mid = nodes.FindId(vn0, vn1);
    if (mid < 0) { return; }
@@ -2853,13 +2908,13 @@ void NCMesh::TraverseTetEdge(int vn0, int vn1, const Point &p0, const Point &p1,
          // in this case we need to add an edge-face constraint, because the
          // master edge is really a (face-)slave itself
 
-         face_list.slaves.Append(
+         slaves.Append(
             Slave(-1 - eid.index, eid.element, eid.local, Geometry::TRIANGLE));
 
          int v0index = nodes[vn0].vert_index;
          int v1index = nodes[vn1].vert_index;
 
-         face_list.slaves.Last().matrix =
+         slaves.Last().matrix =
             matrix_map.GetIndex((v0index < v1index) ? PointMatrix(p0, p1, p0)
                                 /*               */ : PointMatrix(p1, p0, p1));
 
@@ -2869,25 +2924,24 @@ void NCMesh::TraverseTetEdge(int vn0, int vn1, const Point &p0, const Point &p1,
 
    // recurse deeper
    Point pmid(p0, p1);
-   TraverseTetEdge(vn0, mid, p0, pmid, matrix_map);
-   TraverseTetEdge(mid, vn1, pmid, p1, matrix_map);
+   TraverseTetEdge(vn0, mid, p0, pmid, slaves, matrix_map);
+   TraverseTetEdge(mid, vn1, pmid, p1, slaves, matrix_map);
 }
 
 bool NCMesh::TraverseTriFace(int vn0, int vn1, int vn2,
                              const PointMatrix& pm, int level,
-                             MatrixMap &matrix_map)
+                             Array<Slave> &slaves, MatrixMap &matrix_map) const
 {
    if (level > 0)
    {
       // check if we made it to a face that is not split further
-      Face* fa = faces.Find(vn0, vn1, vn2);
+      const Face* fa = faces.Find(vn0, vn1, vn2);
       if (fa)
       {
          // we have a slave face, add it to the list
          int elem = fa->GetSingleElement();
-         face_list.slaves.Append(
-            Slave(fa->index, elem, -1, Geometry::TRIANGLE));
-         Slave &sl = face_list.slaves.Last();
+         slaves.Append(Slave(fa->index, elem, -1, Geometry::TRIANGLE));
+         Slave &sl = slaves.Last();
 
          // reorder the point matrix according to slave face orientation
          PointMatrix pm_r;
@@ -2906,26 +2960,35 @@ bool NCMesh::TraverseTriFace(int vn0, int vn1, int vn2,
 
       b[0] = TraverseTriFace(vn0, mid[0], mid[2],
                              PointMatrix(pm(0), pmid0, pmid2),
-                             level+1, matrix_map);
+                             level+1, slaves, matrix_map);
 
       b[1] = TraverseTriFace(mid[0], vn1, mid[1],
                              PointMatrix(pmid0, pm(1), pmid1),
-                             level+1, matrix_map);
+                             level+1, slaves, matrix_map);
 
       b[2] = TraverseTriFace(mid[2], mid[1], vn2,
                              PointMatrix(pmid2, pmid1, pm(2)),
-                             level+1, matrix_map);
+                             level+1, slaves, matrix_map);
 
       b[3] = TraverseTriFace(mid[1], mid[2], mid[0],
                              PointMatrix(pmid1, pmid2, pmid0),
-                             level+1, matrix_map);
+                             level+1, slaves, matrix_map);
 
       // traverse possible tet edges constrained by the master face
       if (HaveTets() && !b[3])
       {
-         if (!b[1]) { TraverseTetEdge(mid[0],mid[1], pmid0,pmid1, matrix_map); }
-         if (!b[2]) { TraverseTetEdge(mid[1],mid[2], pmid1,pmid2, matrix_map); }
-         if (!b[0]) { TraverseTetEdge(mid[2],mid[0], pmid2,pmid0, matrix_map); }
+         if (!b[1])
+         {
+            TraverseTetEdge(mid[0], mid[1], pmid0, pmid1, slaves, matrix_map);
+         }
+         if (!b[2])
+         {
+            TraverseTetEdge(mid[1], mid[2], pmid1, pmid2, slaves, matrix_map);
+         }
+         if (!b[0])
+         {
+            TraverseTetEdge(mid[2], mid[0], pmid2, pmid0, slaves, matrix_map);
+         }
       }
    }
 
@@ -2937,34 +3000,48 @@ void NCMesh::BuildFaceList()
    face_list.Clear();
    if (Dim < 3) { return; }
 
-   if (HaveTets()) { GetEdgeList(); } // needed by TraverseTetEdge()
+   if (HaveTets())
+   {
+      GetEdgeList(); // needed by TraverseTetEdge()
+      edge_list.BuildIndex(); // LookUp() must not modify the list in threads
+   }
 
    boundary_faces.SetSize(0);
 
+   // find the faces of the leaf elements (in parallel)
+   const int nleaves = leaf_elements.Size();
+   Array<int> leaf_faces(6*nleaves);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nleaves; i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      MFEM_ASSERT(!el.ref_type, "not a leaf element.");
+
+      const GeomInfo& gi = GI[el.Geom()];
+      for (int j = 0; j < gi.nf; j++)
+      {
+         const int* fv = gi.faces[j];
+         leaf_faces[6*i + j] = faces.FindId(el.node[fv[0]], el.node[fv[1]],
+                                            el.node[fv[2]], el.node[fv[3]]);
+         MFEM_ASSERT(leaf_faces[6*i + j] >= 0, "face not found!");
+      }
+   }
+
    Array<char> processed_faces(faces.NumIds());
    processed_faces = 0;
 
-   MatrixMap matrix_maps[Geometry::NumGeom];
-
-   // visit faces of leaf elements
-   for (int i = 0; i < leaf_elements.Size(); i++)
+   // visit faces of leaf elements, list the conforming faces and collect the
+   // faces that need to be traversed
+   Array<MeshId> nc_faces;
+   for (int i = 0; i < nleaves; i++)
    {
       int elem = leaf_elements[i];
-      Element &el = elements[elem];
-      MFEM_ASSERT(!el.ref_type, "not a leaf element.");
-
-      GeomInfo& gi = GI[el.Geom()];
+      GeomInfo& gi = GI[elements[elem].Geom()];
       for (int j = 0; j < gi.nf; j++)
       {
-         // get nodes for this face
-         int node[4];
-         for (int k = 0; k < 4; k++)
-         {
-            node[k] = el.node[gi.faces[j][k]];
-         }
-
-         int face = faces.FindId(node[0], node[1], node[2], node[3]);
-         MFEM_ASSERT(face >= 0, "face not found!");
+         int face = leaf_faces[6*i + j];
 
          // tell ParNCMesh about the face
          ElementSharesFace(elem, j, face);
@@ -2973,7 +3050,7 @@ void NCMesh::BuildFaceList()
          if (processed_faces[face]) { continue; }
          processed_faces[face] = 1;
 
-         int fgeom = (node[3] >= 0) ? Geometry::SQUARE : Geometry::TRIANGLE;
+         int fgeom = (gi.nfv[j] == 4) ? Geometry::SQUARE : Geometry::TRIANGLE;
 
          Face &fa = faces[face];
          if (fa.elem[0] >= 0 && fa.elem[1] >= 0)
@@ -2985,35 +3062,82 @@ void NCMesh::BuildFaceList()
          {
             // this is either a master face or a slave face, but we can't
             // tell until we traverse the face refinement 'tree'...
-            int sb = face_list.slaves.Size();
-            if (fgeom == Geometry::SQUARE)
-            {
-               Face* dummy[4];
-               TraverseQuadFace(node[0], node[1], node[2], node[3],
-                                pm_quad_identity, 0, dummy, matrix_maps[fgeom]);
-            }
-            else
-            {
-               TraverseTriFace(node[0], node[1], node[2],
-                               pm_tri_identity, 0, matrix_maps[fgeom]);
-            }
+            nc_faces.Append(MeshId(face, elem, j, fgeom));
+         }
 
-            int se = face_list.slaves.Size();
-            if (sb < se)
-            {
-               // found slaves, so this is a master face; add it to the list
-               face_list.masters.Append(
-                  Master(fa.index, elem, j, fgeom, sb, se));
+         if (fa.Boundary()) { boundary_faces.Append(face); }
+      }
+   }
 
-               // also, set the master index for the slaves
-               for (int i = sb; i < se; i++)
-               {
-                  face_list.slaves[i].master = fa.index;
-               }
-            }
+   // traverse the faces in chunks (in parallel) to find their slaves
+   const int nchunks = (nc_faces.Size() + traversal_chunk_size - 1) /
+                       traversal_chunk_size;
+   std::vector<TraversalChunk> chunks(nchunks);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for schedule(dynamic)
+#endif
+   for (int c = 0; c < nchunks; c++)
+   {
+      TraversalChunk &chunk = chunks[c];
+      const int begin = c*traversal_chunk_size;
+      const int end = std::min(begin + traversal_chunk_size, nc_faces.Size());
+      chunk.ends.SetSize(end - begin);
+      for (int k = begin; k < end; k++)
+      {
+         const MeshId &id = nc_faces[k];
+         const Element &el = elements[id.element];
+         const int* fv = GI[el.Geom()].faces[id.local];
+         const int node[4] =
+         {
+            el.node[fv[0]], el.node[fv[1]], el.node[fv[2]], el.node[fv[3]]
+         };
+
+         if (id.Geom() == Geometry::SQUARE)
+         {
+            const Face* dummy[4];
+            TraverseQuadFace(node[0], node[1], node[2], node[3],
+                             pm_quad_identity, 0, dummy, chunk.slaves,
+                             chunk.matrix_maps[Geometry::SQUARE]);
+         }
+         else
+         {
+            TraverseTriFace(node[0], node[1], node[2], pm_tri_identity, 0,
+                            chunk.slaves,
+                            chunk.matrix_maps[Geometry::TRIANGLE]);
          }
+         chunk.ends[k - begin] = chunk.slaves.Size();
+      }
+   }
 
-         if (fa.Boundary()) { boundary_faces.Append(face); }
+   // merge the chunks in order, so the lists do not depend on the threads
+   MatrixMap matrix_maps[Geometry::NumGeom];
+   for (int c = 0; c < nchunks; c++)
+   {
+      TraversalChunk &chunk = chunks[c];
+      chunk.RenumberMatrices(matrix_maps);
+
+      int sb = 0;
+      for (int k = 0; k < chunk.ends.Size(); k++)
+      {
+         const MeshId &id = nc_faces[c*traversal_chunk_size + k];
+         const int se = chunk.ends[k];
+         if (sb < se)
+         {
+            // found slaves, so this is a master face; add it to the list
+            const int index = faces[id.index].index;
+            const int offset = face_list.slaves.Size() - sb;
+            face_list.masters.Append(
+               Master(index, id.element, id.local, id.geom,
+                      offset + sb, offset + se));
+
+            // also, set the master index for the slaves
+            for (int i = sb; i < se; i++)
+            {
+               face_list.slaves.Append(chunk.slaves[i]);
+               face_list.slaves.Last().master = index;
+            }
+         }
+         sb = se;
       }
    }
 
@@ -3025,18 +3149,19 @@ void NCMesh::BuildFaceList()
 }
 
 void NCMesh::TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
-                          int level, MatrixMap &matrix_map)
+                          int level, Array<Slave> &slaves,
+                          MatrixMap &matrix_map) const
 {
    int mid = nodes.FindId(vn0, vn1);
    if (mid < 0) { return; }
 
-   Node &nd = nodes[mid];
+   const Node &nd = nodes[mid];
    if (nd.HasEdge() && level > 0)
    {
       // we have a slave edge, add it to the list
-      edge_list.slaves.Append(Slave(nd.edge_index, -1, -1, Geometry::SEGMENT));
+      slaves.Append(Slave(nd.edge_index, -1, -1, Geometry::SEGMENT));
 
-      Slave &sl = edge_list.slaves.Last();
+      Slave &sl = slaves.Last();
       sl.matrix = matrix_map.GetIndex(PointMatrix(Point(t0), Point(t1)));
 
       // handle slave edge orientation
@@ -3048,8 +3173,8 @@ void NCMesh::TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
 
    // recurse deeper
    double tmid = (t0 + t1) / 2;
-   TraverseEdge(vn0, mid, t0, tmid, flags, level+1, matrix_map);
-   TraverseEdge(mid, vn1, tmid, t1, flags, level+1, matrix_map);
+   TraverseEdge(vn0, mid, t0, tmid, flags, level+1, slaves, matrix_map);
+   TraverseEdge(mid, vn1, tmid, t1, flags, level+1, slaves, matrix_map);
 }
 
 void NCMesh::BuildEdgeList()
@@ -3057,6 +3182,26 @@ void NCMesh::BuildEdgeList()
    edge_list.Clear();
    if (Dim < 3) { boundary_faces.SetSize(0); }
 
+   // find the edges of the leaf elements (in parallel)
+   const int nleaves = leaf_elements.Size();
+   Array<int> leaf_edges(12*nleaves);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nleaves; i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      MFEM_ASSERT(!el.ref_type, "not a leaf element.");
+
+      const GeomInfo& gi = GI[el.Geom()];
+      for (int j = 0; j < gi.ne; j++)
+      {
+         const int* ev = gi.edges[j];
+         leaf_edges[12*i + j] = nodes.FindId(el.node[ev[0]], el.node[ev[1]]);
+         MFEM_ASSERT(leaf_edges[12*i + j] >= 0, "edge node not found!");
+      }
+   }
+
    Array<char> processed_edges(nodes.NumIds());
    processed_edges = 0;
 
@@ -3064,24 +3209,17 @@ void NCMesh::BuildEdgeList()
    Array<signed char> edge_local(nodes.NumIds());
    edge_local = -1;
 
-   MatrixMap matrix_map;
-
-   // visit edges of leaf elements
-   for (int i = 0; i < leaf_elements.Size(); i++)
+   // visit edges of leaf elements, collect the edges that need to be traversed
+   Array<MeshId> nc_edges;
+   for (int i = 0; i < nleaves; i++)
    {
       int elem = leaf_elements[i];
       Element &el = elements[elem];
-      MFEM_ASSERT(!el.ref_type, "not a leaf element.");
 
       GeomInfo& gi = GI[el.Geom()];
       for (int j = 0; j < gi.ne; j++)
       {
-         // get nodes for this edge
-         const int* ev = gi.edges[j];
-         int node[2] = { el.node[ev[0]], el.node[ev[1]] };
-
-         int enode = nodes.FindId(node[0], node[1]);
-         MFEM_ASSERT(enode >= 0, "edge node not found!");
+         int enode = leaf_edges[12*i + j];
 
          Node &nd = nodes[enode];
          MFEM_ASSERT(nd.HasEdge(), "edge not found!");
@@ -3092,6 +3230,8 @@ void NCMesh::BuildEdgeList()
          // (2D only, store boundary faces)
          if (Dim <= 2)
          {
+            const int* ev = gi.edges[j];
+            int node[2] = { el.node[ev[0]], el.node[ev[1]] };
             int face = faces.FindId(node[0], node[0], node[1], node[1]);
             MFEM_ASSERT(face >= 0, "face not found!");
             if (faces[face].Boundary()) { boundary_faces.Append(face); }
@@ -3101,13 +3241,37 @@ void NCMesh::BuildEdgeList()
          edge_element[nd.edge_index] = elem;
          edge_local[nd.edge_index] = j;
 
-         // skip slave edges here, they will be reached from their masters
-         if (GetEdgeMaster(enode) >= 0) { continue; }
-
          // have we already processed this edge? skip if yes
          if (processed_edges[enode]) { continue; }
          processed_edges[enode] = 1;
 
+         // skip slave edges here, they will be reached from their masters
+         if (GetEdgeMaster(enode) >= 0) { continue; }
+
+         nc_edges.Append(MeshId(enode, elem, j, Geometry::SEGMENT));
+      }
+   }
+
+   // traverse the edges in chunks (in parallel) to find their slaves
+   const int nchunks = (nc_edges.Size() + traversal_chunk_size - 1) /
+                       traversal_chunk_size;
+   std::vector<TraversalChunk> chunks(nchunks);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for schedule(dynamic)
+#endif
+   for (int c = 0; c < nchunks; c++)
+   {
+      TraversalChunk &chunk = chunks[c];
+      const int begin = c*traversal_chunk_size;
+      const int end = std::min(begin + traversal_chunk_size, nc_edges.Size());
+      chunk.ends.SetSize(end - begin);
+      for (int k = begin; k < end; k++)
+      {
+         const MeshId &id = nc_edges[k];
+         const Element &el = elements[id.element];
+         const int* ev = GI[el.Geom()].edges[id.local];
+         int node[2] = { el.node[ev[0]], el.node[ev[1]] };
+
          // prepare edge interval for slave traversal, handle orientation
          double t0 = 0.0, t1 = 1.0;
          int v0index = nodes[node[0]].vert_index;
@@ -3115,27 +3279,47 @@ void NCMesh::BuildEdgeList()
          int flags = (v0index > v1index) ? 1 : 0;
 
          // try traversing the edge to find slave edges
-         int sb = edge_list.slaves.Size();
-         TraverseEdge(node[0], node[1], t0, t1, flags, 0, matrix_map);
+         TraverseEdge(node[0], node[1], t0, t1, flags, 0, chunk.slaves,
+                      chunk.matrix_maps[Geometry::SEGMENT]);
+         chunk.ends[k - begin] = chunk.slaves.Size();
+      }
+   }
+
+   // merge the chunks in order, so the lists do not depend on the threads
+   MatrixMap matrix_maps[Geometry::NumGeom];
+   for (int c = 0; c < nchunks; c++)
+   {
+      TraversalChunk &chunk = chunks[c];
+      chunk.RenumberMatrices(matrix_maps);
 
-         int se = edge_list.slaves.Size();
+      int sb = 0;
+      for (int k = 0; k < chunk.ends.Size(); k++)
+      {
+         const MeshId &id = nc_edges[c*traversal_chunk_size + k];
+         const int edge_index = nodes[id.index].edge_index;
+         const int se = chunk.ends[k];
          if (sb < se)
          {
             // found slaves, this is a master face; add it to the list
+            const int offset = edge_list.slaves.Size() - sb;
             edge_list.masters.Append(
-               Master(nd.edge_index, elem, j, Geometry::SEGMENT, sb, se));
+               Master(edge_index, id.element, id.local, Geometry::SEGMENT,
+                      offset + sb, offset + se));
 
             // also, set the master index for the slaves
             for (int i = sb; i < se; i++)
             {
-               edge_list.slaves[i].master = nd.edge_index;
+               edge_list.slaves.Append(chunk.slaves[i]);
+               edge_list.slaves.Last().master = edge_index;
             }
          }
          else
          {
             // no slaves, this is a conforming edge
-            edge_list.conforming.Append(MeshId(nd.edge_index, elem, j));
+            edge_list.conforming.Append(
+               MeshId(edge_index, id.element, id.local));
          }
+         sb = se;
       }
    }
 
@@ -3152,7 +3336,8 @@ void NCMesh::BuildEdgeList()
    }
 
    // export unique point matrices
-   matrix_map.ExportMatrices(edge_list.point_matrices[Geometry::SEGMENT]);
+   matrix_maps[Geometry::SEGMENT].ExportMatrices(
+      edge_list.point_matrices[Geometry::SEGMENT]);
 }
 
 void NCMesh::BuildVertexList()
@@ -3235,7 +3420,7 @@ long NCMesh::NCList::TotalSize() const
    return conforming.Size() + masters.Size() + slaves.Size();
 }
 
-const NCMesh::MeshId& NCMesh::NCList::LookUp(int index, int *type) const
+void NCMesh::NCList::BuildIndex() const
 {
    if (!inv_index.Size())
    {
@@ -3271,6 +3456,11 @@ const NCMesh::MeshId& NCMesh::NCList::LookUp(int index, int *type) const
          inv_index[slaves[i].index] = (i << 2) + 2;
       }
    }
+}
+
+const NCMesh::MeshId& NCMesh::NCList::LookUp(int index, int *type) const
+{
+   BuildIndex();
 
    MFEM_ASSERT(index >= 0 && index < inv_index.Size(), "");
    int key = inv_index[index];
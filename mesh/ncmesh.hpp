@@ -78,6 +78,7 @@ struct CoarseFineTransformations
 void Swap(CoarseFineTransformations &a, CoarseFineTransformations &b);
 
 struct MatrixMap; // for internal use
+struct TraversalChunk; // for internal use
 
 
 /** \brief A class for non-conforming AMR. The class is not used directly
@@ -220,6 +221,10 @@ public:
 
       const MeshId& LookUp(int index, int *type = NULL) const;
 
+      /** Build the inverse index of LookUp() now instead of on its first
+          call, so that LookUp() can then be called from multiple threads. */
+      void BuildIndex() const;
+
       ~NCList() { Clear(); }
    private:
       mutable Array<int> inv_index;
@@ -397,6 +402,23 @@ protected: // implementation
    int Geoms; ///< bit mask of element geometries present, see InitGeomFlags()
    bool Legacy; ///< true if the mesh was loaded from the legacy v1.1 format
 
+   struct Node;
+   struct Face;
+
+#ifdef MFEM_NCMESH_OPEN_HASH
+   // faster lookups, but more memory per node/face, see OpenHashTable; the
+   // nodes and faces then have no chaining link
+   typedef OpenHashed2 NodeHashed;
+   typedef OpenHashed4 FaceHashed;
+   typedef OpenHashTable<Node> NodeTable;
+   typedef OpenHashTable<Face> FaceTable;
+#else
+   typedef Hashed2 NodeHashed;
+   typedef Hashed4 FaceHashed;
+   typedef HashTable<Node> NodeTable;
+   typedef HashTable<Face> FaceTable;
+#endif
+
    /** A Node can hold a vertex, an edge, or both. Elements directly point to
        their corner nodes, but edge nodes also exist and can be accessed using
        a hash-table given their two end-point node IDs. All nodes can be
@@ -405,7 +427,7 @@ protected: // implementation
        available with this mechanism. The new elements "sign in" to the nodes
        by increasing the reference counts of their vertices and edges. The
        parent element "signs off" its nodes by decrementing the ref counts. */
-   struct Node : public Hashed2
+   struct Node : public NodeHashed
    {
       char vert_refc, edge_refc;
       int vert_index, edge_index;
@@ -425,7 +447,7 @@ protected: // implementation
        node IDs. A face knows about the one or two elements that are using it.
        A face that is not on the boundary and only has one element referencing
        it is either a master or a slave face. */
-   struct Face : public Hashed4
+   struct Face : public FaceHashed
    {
       int attribute; ///< boundary element attribute, -1 if internal face
       int index;     ///< face number in the Mesh
@@ -472,8 +494,8 @@ protected: // implementation
 
    // primary data
 
-   HashTable<Node> nodes; // associative container holding all Nodes
-   HashTable<Face> faces; // associative container holding all Faces
+   NodeTable nodes; // associative container holding all Nodes
+   FaceTable faces; // associative container holding all Faces
 
    BlockArray<Element> elements; // storage for all Elements
    Array<int> free_element_ids;  // unused element ids - indices into 'elements'
@@ -540,7 +562,7 @@ protected: // implementation
    // refinement/derefinement
 
    Array<Refinement> ref_stack; ///< stack of scheduled refinements (temporary)
-   HashTable<Node> shadow; ///< temporary storage for reparented nodes
+   NodeTable shadow; ///< temporary storage for reparented nodes
    Array<Triple<int, int, int> > reparents; ///< scheduled node reparents (tmp)
 
    Table derefinements; ///< possible derefinements, see GetDerefinementTable
@@ -645,16 +667,20 @@ protected: // implementation
                            int elem, const PointMatrix &pm,
                            PointMatrix &reordered) const;
 
+   // NOTE: the traversals only read the mesh and append the slaves they find
+   // to 'slaves', so that BuildFaceList/BuildEdgeList can run them in threads
    void TraverseQuadFace(int vn0, int vn1, int vn2, int vn3,
-                         const PointMatrix& pm, int level, Face* eface[4],
-                         MatrixMap &matrix_map);
+                         const PointMatrix& pm, int level,
+                         const Face* eface[4], Array<Slave> &slaves,
+                         MatrixMap &matrix_map) const;
    bool TraverseTriFace(int vn0, int vn1, int vn2,
                         const PointMatrix& pm, int level,
-                        MatrixMap &matrix_map);
+                        Array<Slave> &slaves, MatrixMap &matrix_map) const;
    void TraverseTetEdge(int vn0, int vn1, const Point &p0, const Point &p1,
-                        MatrixMap &matrix_map);
+                        Array<Slave> &slaves, MatrixMap &matrix_map) const;
    void TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
-                     int level, MatrixMap &matrix_map);
+                     int level, Array<Slave> &slaves,
+                     MatrixMap &matrix_map) const;
 
    virtual void BuildFaceList();
    virtual void BuildEdgeList();
@@ -914,6 +940,7 @@ public:
 
    friend class ParNCMesh; // for ParNCMesh::ElementSet
    friend struct MatrixMap;
+   friend struct TraversalChunk;
    friend struct PointMatrixHash;
 };
 
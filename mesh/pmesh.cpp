@@ -3609,7 +3609,37 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
-void ParMesh::RebalanceImpl(const Array<int> *partition)
+void ParMesh::Rebalance(const Vector &elem_cost)
+{
+   RebalanceImpl(NULL, &elem_cost); // weighted SFC-based partition
+}
+
+double ParMesh::GetLoadImbalance(const Vector *elem_cost) const
+{
+   double local_cost = GetNE();
+   if (elem_cost)
+   {
+      MFEM_VERIFY(elem_cost->Size() == GetNE(),
+                  "Size of the cost array must match the number "
+                  "of local mesh elements (ParMesh::GetNE()).");
+      local_cost = elem_cost->Sum();
+   }
+   double max_cost, total_cost;
+   MPI_Allreduce(&local_cost, &max_cost, 1, MPI_DOUBLE, MPI_MAX, MyComm);
+   MPI_Allreduce(&local_cost, &total_cost, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   return (total_cost > 0.0) ? max_cost * NRanks / total_cost : 1.0;
+}
+
+bool ParMesh::RebalanceIfImbalanced(double max_imbalance,
+                                    const Vector *elem_cost)
+{
+   if (GetLoadImbalance(elem_cost) <= max_imbalance) { return false; }
+   RebalanceImpl(NULL, elem_cost);
+   return true;
+}
+
+void ParMesh::RebalanceImpl(const Array<int> *partition,
+                            const Vector *elem_cost)
 {
    if (Conforming())
    {
@@ -3626,7 +3656,7 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance(partition);
+   pncmesh->Rebalance(partition, elem_cost);
 
    ParMesh* pmesh2 = new ParMesh(*pncmesh);
    pncmesh->OnMeshUpdated(pmesh2);
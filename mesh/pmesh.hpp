@@ -145,7 +145,8 @@ protected:
                                           double threshold, int nc_limit = 0,
                                           int op = 1);
 
-   void RebalanceImpl(const Array<int> *partition);
+   void RebalanceImpl(const Array<int> *partition,
+                      const Vector *elem_cost = NULL);
 
    void DeleteFaceNbrData();
 
@@ -384,6 +385,29 @@ public:
        for 0 <= i < GetNE(). */
    void Rebalance(const Array<int> &partition);
 
+   /** Load balance a nonconforming mesh by splitting the global space-filling
+       sequence of elements into pieces of equal total cost. The cost of local
+       element 'i' is elem_cost[i] >= 0, for 0 <= i < GetNE(), e.g., its number
+       of DOFs or quadrature points. Each rank receives at least one element if
+       the mesh has at least as many elements as ranks, even when an element
+       costs more than the average cost per rank. */
+   void Rebalance(const Vector &elem_cost);
+
+   /** Return the load imbalance, i.e., the maximum over the ranks of the local
+       cost divided by the average cost. The cost of each element is 1, or
+       (*elem_cost)[i] for local element 'i' if @a elem_cost is given. */
+   double GetLoadImbalance(const Vector *elem_cost = NULL) const;
+
+   /** Rebalance the mesh, see Rebalance(const Vector &), only if the load
+       imbalance, see GetLoadImbalance(), exceeds @a max_imbalance (e.g. 1.1).
+       Returns true if the mesh was rebalanced. Otherwise the mesh is not
+       modified, so the spaces and grid functions need no update. Note that an
+       element costing more than @a max_imbalance times the average cost per
+       rank keeps the imbalance above the threshold, so the mesh is then
+       rebalanced on every call. */
+   bool RebalanceIfImbalanced(double max_imbalance,
+                              const Vector *elem_cost = NULL);
+
    /// Save the mesh in a parallel mesh format.
    void ParPrint(std::ostream &out) const;
 
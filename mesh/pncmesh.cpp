@@ -1649,7 +1649,8 @@ void ParNCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 
 //// Rebalance /////////////////////////////////////////////////////////////////
 
-void ParNCMesh::Rebalance(const Array<int> *custom_partition)
+void ParNCMesh::Rebalance(const Array<int> *custom_partition,
+                          const Vector *elem_cost)
 {
    send_rebalance_dofs.clear();
    recv_rebalance_dofs.clear();
@@ -1657,7 +1658,19 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
    Array<int> old_elements;
    leaf_elements.GetSubArray(0, NElements, old_elements);
 
-   if (!custom_partition) // SFC based partitioning
+   MFEM_VERIFY(!custom_partition || !elem_cost,
+               "Only one of custom_partition and elem_cost can be given.");
+
+   if (elem_cost) // weighted SFC based partitioning
+   {
+      Array<int> new_ranks(leaf_elements.Size());
+      new_ranks = -1;
+
+      int target_elements = WeightedPartition(*elem_cost, new_ranks);
+
+      RedistributeElements(new_ranks, target_elements, true);
+   }
+   else if (!custom_partition) // SFC based partitioning
    {
       Array<int> new_ranks(leaf_elements.Size());
       new_ranks = -1;
@@ -1710,6 +1723,87 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
    Prune();
 }
 
+int ParNCMesh::WeightedPartition(const Vector &elem_cost,
+                                 Array<int> &new_ranks) const
+{
+   MFEM_VERIFY(elem_cost.Size() == NElements,
+               "Size of the cost array must match the number "
+               "of local mesh elements (ParMesh::GetNE()).");
+
+   const double *cost = elem_cost.HostRead();
+   double local_cost = 0.0, total_cost = 0.0, first_cost = 0.0;
+   for (int i = 0; i < NElements; i++)
+   {
+      MFEM_VERIFY(cost[i] >= 0.0, "element costs must be nonnegative");
+      local_cost += cost[i];
+   }
+   MPI_Allreduce(&local_cost, &total_cost, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   MPI_Scan(&local_cost, &first_cost, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   first_cost -= local_cost;
+
+   long local_elems = NElements, total_elems = 0, first_elem_global = 0;
+   MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM, MyComm);
+   MPI_Scan(&local_elems, &first_elem_global, 1, MPI_LONG, MPI_SUM, MyComm);
+   first_elem_global -= local_elems;
+
+   // Each element goes to the rank whose cost interval contains the midpoint
+   // of the element's cost interval, so the new partition is monotone along
+   // the space-filling curve. Zero total cost falls back to equal counts.
+   Array<long> rank_elems(NRanks);
+   rank_elems = 0;
+   double cost_sum = first_cost;
+   for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      if (el.rank != MyRank) { continue; }
+
+      int rank;
+      if (total_cost > 0.0)
+      {
+         const double c = cost[el.index];
+         rank = (int) ((cost_sum + 0.5*c) * NRanks / total_cost);
+         rank = std::min(rank, NRanks-1);
+         cost_sum += c;
+      }
+      else
+      {
+         rank = Partition(first_elem_global + j, total_elems);
+      }
+      rank_elems[rank]++;
+      j++;
+   }
+   MPI_Allreduce(MPI_IN_PLACE, rank_elems.GetData(), NRanks, MPI_LONG,
+                 MPI_SUM, MyComm);
+
+   // Global index of the first element of each rank. An element costing more
+   // than total_cost/NRanks can leave some ranks without elements, so move the
+   // boundaries to give each rank at least one element, if there are enough.
+   Array<long> first(NRanks+1);
+   first[0] = 0;
+   for (int r = 0; r < NRanks; r++) { first[r+1] = first[r] + rank_elems[r]; }
+   if (total_elems >= NRanks)
+   {
+      for (int r = 1; r < NRanks; r++)
+      {
+         first[r] = std::max(first[r], first[r-1] + 1);
+      }
+      for (int r = NRanks-1; r > 0; r--)
+      {
+         first[r] = std::min(first[r], first[r+1] - 1);
+      }
+   }
+
+   for (int i = 0, j = 0, r = 0; i < leaf_elements.Size(); i++)
+   {
+      if (elements[leaf_elements[i]].rank != MyRank) { continue; }
+      while (first[r+1] <= first_elem_global + j) { r++; }
+      new_ranks[i] = r;
+      j++;
+   }
+
+   return first[MyRank+1] - first[MyRank];
+}
+
 void ParNCMesh::RedistributeElements(Array<int> &new_ranks, int target_elements,
                                      bool record_comm)
 {
@@ -100,8 +100,11 @@ public:
        The default partitioning strategy is based on equal splitting of the
        space-filling sequence of leaf elements (custom_partition == NULL).
        Alternatively, a used-defined element-rank assignment array can be
-       passed. */
-   void Rebalance(const Array<int> *custom_partition = NULL);
+       passed. If an array of element costs is given instead, elem_cost[i] >= 0
+       being the cost of the local element i, the space-filling sequence is
+       split into pieces of equal total cost. */
+   void Rebalance(const Array<int> *custom_partition = NULL,
+                  const Vector *elem_cost = NULL);
 
 
    // interface for ParFiniteElementSpace
@@ -312,6 +315,12 @@ protected: // implementation
    long PartitionFirstIndex(int rank, long total_elements) const
    { return (rank * total_elements + NRanks-1) / NRanks; }
 
+   /** Assign new ranks to the owned leaves by splitting the space-filling
+       sequence into pieces of equal total cost, keeping at least one element
+       on each rank if there are enough. Returns the number of elements this
+       rank will own. */
+   int WeightedPartition(const Vector &elem_cost, Array<int> &new_ranks) const;
+
    virtual void BuildFaceList();
    virtual void BuildEdgeList();
    virtual void BuildVertexList();
@@ -35,6 +35,7 @@
 #include "general/zstr.hpp"
 #include "general/version.hpp"
 #include "general/globals.hpp"
+#include "general/kernel_dispatch.hpp"
 #ifdef MFEM_USE_MPI
 #include "general/communication.hpp"
 #endif
@@ -0,0 +1,453 @@
+//                 MFEM Kernel Benchmarks - Performance Miniapp
+//
+// Compile with: make kernels
+//
+// Sample runs:  kernels
+//               kernels -d 3 -omin 1 -omax 8 -s 1e6
+//               kernels -d 2 -k restriction,interp -csv kernels.csv
+//               kernels -d 3 -a partial,none -json kernels.json
+//               kernels -d 3 -bw 200 -fp 3000 -json kernels.json
+//               kernels -d 3 -a partial -k mass,diffusion -simd
+//               kernels -d 3 -a partial -k mass,diffusion -fused
+//
+// Device runs:  kernels -d 3 -dev cuda -json kernels-cuda.json
+//               kernels -d 3 -dev raja-cuda -a partial
+//
+// Description:  This miniapp measures the throughput of the main finite
+//               element kernels used by the assembly levels of MFEM:
+//
+//               - restriction: ElementRestriction::Mult/MultTranspose,
+//               - interp:      QuadratureInterpolator values/derivatives,
+//               - mass:        MassIntegrator setup, action and diagonal,
+//               - diffusion:   DiffusionIntegrator setup, action and diagonal,
+//
+//               sweeping the polynomial order, the dimension (2D/3D Cartesian
+//               meshes from Mesh::MakeCartesian2D/3D), and the assembly level
+//               (FULL, ELEMENT, PARTIAL, and NONE with libCEED devices). For
+//               every measurement the miniapp reports the run time, the
+//               throughput in DOFs/s, and an estimate of the memory bandwidth
+//               (GB/s) and of the floating point rate (GFLOP/s) based on a
+//               simple model of the bytes moved and of the operations
+//               performed by each kernel. When the peak bandwidth and flop
+//               rate of the machine are given, the achieved fraction of the
+//               roofline bound is reported as well.
+//
+//               The results can be written in CSV and/or JSON format, so that
+//               performance regressions can be tracked between releases.
+
+#include "mfem.hpp"
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace mfem;
+
+// One line of benchmark output.
+struct BenchResult
+{
+   string kernel;    // kernel name, e.g. "mass-mult"
+   string level;     // assembly level, or "-" for the standalone kernels
+   int dim, order, q1d, ne;
+   long long ndofs;  // number of (scalar) L-vector DOFs
+   int reps;         // number of timed repetitions
+   double time;      // time per repetition in seconds
+   double bytes;     // model: bytes moved per repetition
+   double flops;     // model: floating point operations per repetition
+
+   double MDofs() const { return 1e-6*ndofs/time; }
+   double GBs() const { return 1e-9*bytes/time; }
+   double GFlops() const { return 1e-9*flops/time; }
+   double Intensity() const { return bytes > 0.0 ? flops/bytes : 0.0; }
+   /// Fraction of the roofline bound min(peak_fp, AI*peak_bw) achieved.
+   double Roofline(double peak_bw, double peak_fp) const
+   {
+      if (peak_bw <= 0.0 || peak_fp <= 0.0 || bytes <= 0.0) { return 0.0; }
+      const double bound = min(peak_fp, Intensity()*peak_bw);
+      return bound > 0.0 ? GFlops()/bound : GBs()/peak_bw;
+   }
+};
+
+// Run 'kernel' (after one warm-up call) until at least 'min_time' seconds have
+// elapsed and return the average time per call.
+template <typename Kernel>
+static double Measure(Kernel &&kernel, double min_time, int &reps)
+{
+   kernel();
+   MFEM_DEVICE_SYNC;
+   StopWatch sw;
+   sw.Clear();
+   sw.Start();
+   reps = 0;
+   do
+   {
+      kernel();
+      MFEM_DEVICE_SYNC;
+      reps++;
+   }
+   while (sw.RealTime() < min_time);
+   sw.Stop();
+   return sw.RealTime()/reps;
+}
+
+// Number of flops for the sum-factorized interpolation of one scalar field
+// from D^dim nodes to Q^dim points (or the transpose operation).
+static double SumFactFlops(int dim, int D, int Q)
+{
+   if (dim == 2) { return 2.0*(Q*D*D + Q*Q*D); }
+   return 2.0*(1.0*Q*D*D*D + 1.0*Q*Q*D*D + 1.0*Q*Q*Q*D);
+}
+
+static bool Selected(const char *list, const char *name)
+{
+   if (!strcmp(list, "all")) { return true; }
+   const size_t len = strlen(name);
+   for (const char *s = strstr(list, name); s; s = strstr(s + 1, name))
+   {
+      const bool start = (s == list || s[-1] == ',');
+      const bool end = (s[len] == '\0' || s[len] == ',');
+      if (start && end) { return true; }
+   }
+   return false;
+}
+
+static const char *LevelName(AssemblyLevel level)
+{
+   switch (level)
+   {
+      case AssemblyLevel::FULL: return "full";
+      case AssemblyLevel::ELEMENT: return "element";
+      case AssemblyLevel::PARTIAL: return "partial";
+      case AssemblyLevel::NONE: return "none";
+      default: return "legacy";
+   }
+}
+
+static void PrintHeader(ostream &os)
+{
+   os << setw(20) << left << "kernel" << setw(9) << "level" << right
+      << setw(4) << "dim" << setw(4) << "p" << setw(4) << "q"
+      << setw(10) << "dofs" << setw(8) << "reps" << setw(12) << "time [s]"
+      << setw(11) << "MDOF/s" << setw(9) << "GB/s" << setw(10) << "GFLOP/s"
+      << setw(8) << "AI" << setw(8) << "%roof" << '\n';
+}
+
+static void Print(ostream &os, const BenchResult &r, double bw, double fp)
+{
+   os << setw(20) << left << r.kernel << setw(9) << r.level << right
+      << setw(4) << r.dim << setw(4) << r.order << setw(4) << r.q1d
+      << setw(10) << r.ndofs << setw(8) << r.reps
+      << setw(12) << setprecision(4) << scientific << r.time
+      << fixed << setprecision(2)
+      << setw(11) << r.MDofs() << setw(9) << r.GBs()
+      << setw(10) << r.GFlops() << setw(8) << r.Intensity()
+      << setw(8) << setprecision(1) << 100.0*r.Roofline(bw, fp) << '\n';
+   os.unsetf(ios_base::floatfield);
+   os << setprecision(6) << flush;
+}
+
+static void WriteCSV(ostream &os, const vector<BenchResult> &res,
+                     double bw, double fp)
+{
+   os << "kernel,level,dim,order,q1d,ne,ndofs,reps,time,mdofs_per_s,"
+      "gbytes_per_s,gflops_per_s,intensity,roofline\n";
+   os << setprecision(8);
+   for (const BenchResult &r : res)
+   {
+      os << r.kernel << ',' << r.level << ',' << r.dim << ',' << r.order << ','
+         << r.q1d << ',' << r.ne << ',' << r.ndofs << ',' << r.reps << ','
+         << r.time << ',' << r.MDofs() << ',' << r.GBs() << ','
+         << r.GFlops() << ',' << r.Intensity() << ','
+         << r.Roofline(bw, fp) << '\n';
+   }
+}
+
+static void WriteJSON(ostream &os, const vector<BenchResult> &res,
+                      const char *device, double bw, double fp)
+{
+   os << setprecision(8);
+   os << "{\n  \"mfem_version\": \"" << GetVersionStr() << "\",\n"
+      << "  \"device\": \"" << device << "\",\n"
+      << "  \"peak_bandwidth\": " << bw << ",\n"
+      << "  \"peak_gflops\": " << fp << ",\n"
+      << "  \"results\": [";
+   for (size_t i = 0; i < res.size(); i++)
+   {
+      const BenchResult &r = res[i];
+      os << (i ? ",\n" : "\n")
+         << "    {\"kernel\": \"" << r.kernel << "\", \"level\": \""
+         << r.level << "\", \"dim\": " << r.dim << ", \"order\": " << r.order
+         << ", \"q1d\": " << r.q1d << ", \"ne\": " << r.ne
+         << ", \"ndofs\": " << r.ndofs << ", \"reps\": " << r.reps
+         << ", \"time\": " << r.time << ", \"mdofs_per_s\": " << r.MDofs()
+         << ", \"gbytes_per_s\": " << r.GBs()
+         << ", \"gflops_per_s\": " << r.GFlops()
+         << ", \"intensity\": " << r.Intensity()
+         << ", \"roofline\": " << r.Roofline(bw, fp) << "}";
+   }
+   os << "\n  ]\n}\n";
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   int dim = 0;
+   int order_min = 1;
+   int order_max = 8;
+   int q_add = 1;
+   double size = 1e5;
+   double min_time = 0.1;
+   const char *kernels = "all";
+   const char *levels = "full,element,partial,none";
+   const char *device_config = "cpu";
+   const char *csv_file = "";
+   const char *json_file = "";
+   double peak_bw = 0.0;
+   double peak_fp = 0.0;
+   bool pa_simd = false;
+   bool pa_fused = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&dim, "-d", "--dim",
+                  "Dimension of the Cartesian meshes: 2, 3, or 0 for both.");
+   args.AddOption(&order_min, "-omin", "--order-min",
+                  "Smallest polynomial order in the sweep.");
+   args.AddOption(&order_max, "-omax", "--order-max",
+                  "Largest polynomial order in the sweep.");
+   args.AddOption(&q_add, "-qa", "--quad-add",
+                  "Number of 1D quadrature points minus the number of 1D "
+                  "DOFs, i.e. q1d = p + 1 + qa.");
+   args.AddOption(&size, "-s", "--size",
+                  "Target number of DOFs in each problem.");
+   args.AddOption(&min_time, "-t", "--min-time",
+                  "Minimum run time (in seconds) of each measurement.");
+   args.AddOption(&kernels, "-k", "--kernels",
+                  "Comma-separated list of kernels to run: restriction, "
+                  "interp, mass, diffusion; or 'all'.");
+   args.AddOption(&levels, "-a", "--assembly-levels",
+                  "Comma-separated list of assembly levels for the mass and "
+                  "diffusion kernels: full, element, partial, none.");
+   args.AddOption(&device_config, "-dev", "--device",
+                  "Device configuration string, see Device::Configure().");
+   args.AddOption(&csv_file, "-csv", "--csv-file",
+                  "Write the results to this file in CSV format.");
+   args.AddOption(&json_file, "-json", "--json-file",
+                  "Write the results to this file in JSON format.");
+   args.AddOption(&peak_bw, "-bw", "--peak-bandwidth",
+                  "Peak memory bandwidth of the machine in GB/s (optional, "
+                  "used for the roofline fraction).");
+   args.AddOption(&peak_fp, "-fp", "--peak-gflops",
+                  "Peak floating point rate of the machine in GFLOP/s "
+                  "(optional, used for the roofline fraction).");
+   args.AddOption(&pa_simd, "-simd", "--pa-simd", "-no-simd", "--no-pa-simd",
+                  "Use the CPU partial assembly kernels vectorized across "
+                  "elements, see BilinearForm::UsePASIMD().");
+   args.AddOption(&pa_fused, "-fused", "--pa-fused", "-no-fused",
+                  "--no-pa-fused",
+                  "Fuse the element restriction with the partial assembly "
+                  "kernels, see BilinearForm::UsePAFused().");
+   args.Parse();
+   if (!args.Good() || order_min < 1 || order_max < order_min ||
+       (dim != 0 && dim != 2 && dim != 3))
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Enable hardware devices such as GPUs, and programming models such as
+   //    CUDA, OCCA, RAJA and OpenMP based on command line options.
+   Device device(device_config);
+   device.Print();
+
+   const AssemblyLevel all_levels[] =
+   {
+      AssemblyLevel::FULL, AssemblyLevel::ELEMENT,
+      AssemblyLevel::PARTIAL, AssemblyLevel::NONE
+   };
+   const int dim_min = dim ? dim : 2, dim_max = dim ? dim : 3;
+   vector<BenchResult> results;
+   PrintHeader(cout);
+
+   // 3. Sweep dimensions and orders.
+   for (int d = dim_min; d <= dim_max; d++)
+   {
+      for (int p = order_min; p <= order_max; p++)
+      {
+         // 3a. Cartesian mesh with approximately 'size' DOFs of order p.
+         const int n = max(1, (int) round(pow(size, 1.0/d)/p));
+         Mesh mesh = (d == 2) ?
+                     Mesh::MakeCartesian2D(n, n, Element::QUADRILATERAL) :
+                     Mesh::MakeCartesian3D(n, n, n, Element::HEXAHEDRON);
+         mesh.EnsureNodes();
+
+         H1_FECollection fec(p, d);
+         FiniteElementSpace fes(&mesh, &fec);
+         const int ne = mesh.GetNE();
+         const long long ndofs = fes.GetVSize();
+         const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+         const int D = p + 1, Q = p + 1 + q_add;
+         const IntegrationRule &ir = IntRules.Get(geom, 2*Q - 1);
+         const int nd = fes.GetFE(0)->GetDof(), nq = ir.GetNPoints();
+         const double sf = SumFactFlops(d, D, Q);
+
+         auto add = [&](const char *kernel, const char *level, int reps,
+                        double time, double bytes, double flops)
+         {
+            BenchResult r = {kernel, level, d, p, Q, ne, ndofs, reps, time,
+                             bytes, flops
+                            };
+            Print(cout, r, peak_bw, peak_fp);
+            results.push_back(r);
+         };
+
+         const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
+         const Operator *R = fes.GetElementRestriction(ordering);
+         Vector x(fes.GetVSize()), y(fes.GetVSize());
+         Vector ex(R->Height()), ey(R->Height());
+         x.UseDevice(true);
+         y.UseDevice(true);
+         ex.UseDevice(true);
+         ey.UseDevice(true);
+         x.Randomize(1);
+         ex.Randomize(2);
+         int reps;
+
+         // Bytes moved by the element restriction: E-vector writes/reads,
+         // L-vector reads/writes and the integer index arrays.
+         const double r_bytes = 8.0*ne*nd + 8.0*ndofs + 4.0*ne*nd;
+         const double rt_bytes = r_bytes + 4.0*(ndofs + 1);
+
+         // 3b. Element restriction.
+         if (Selected(kernels, "restriction"))
+         {
+            double t = Measure([&]() { R->Mult(x, ex); }, min_time, reps);
+            add("restriction-mult", "-", reps, t, r_bytes, 0.0);
+            t = Measure([&]() { R->MultTranspose(ex, y); }, min_time, reps);
+            add("restriction-multt", "-", reps, t, rt_bytes, 1.0*ne*nd);
+         }
+
+         // 3c. Quadrature interpolation of a scalar field.
+         if (Selected(kernels, "interp"))
+         {
+            const QuadratureInterpolator *qi =
+               fes.GetQuadratureInterpolator(ir);
+            qi->SetOutputLayout(QVectorLayout::byVDIM);
+            Vector qval(ne*nq), qder(d*ne*nq);
+            qval.UseDevice(true);
+            qder.UseDevice(true);
+            double t = Measure([&]() { qi->Values(ex, qval); }, min_time, reps);
+            add("interp-values", "-", reps, t, 8.0*ne*(nd + nq), ne*sf);
+            t = Measure([&]() { qi->Derivatives(ex, qder); }, min_time, reps);
+            add("interp-derivatives", "-", reps, t, 8.0*ne*(nd + d*nq),
+                d*ne*sf);
+         }
+
+         // 3d. Mass and diffusion operators for all assembly levels.
+         for (int integ = 0; integ < 2; integ++)
+         {
+            const bool mass = (integ == 0);
+            if (!Selected(kernels, mass ? "mass" : "diffusion")) { continue; }
+            const char *name = mass ? "mass" : "diffusion";
+            // quadrature data per point and pointwise flops per point
+            const int qd = mass ? 1 : d*(d+1)/2;
+            const double q_flops = mass ? 1.0 : 2.0*d*d;
+            const double pa_flops =
+               ne*((mass ? 2.0 : 2.0*d)*sf + q_flops*nq);
+            const double e_bytes = 3.0*8.0*ne*nd + r_bytes + rt_bytes;
+
+            for (AssemblyLevel level : all_levels)
+            {
+               if (!Selected(levels, LevelName(level))) { continue; }
+               // The matrix-free level is currently only available with libCEED
+               if (level == AssemblyLevel::NONE && !DeviceCanUseCeed())
+               {
+                  continue;
+               }
+               BilinearForm a(&fes);
+               a.SetAssemblyLevel(level);
+               a.UsePASIMD(pa_simd);
+               a.UsePAFused(pa_fused);
+               BilinearFormIntegrator *bfi = mass ?
+                                             (BilinearFormIntegrator*) new MassIntegrator :
+                                             (BilinearFormIntegrator*) new DiffusionIntegrator;
+               bfi->SetIntRule(&ir);
+               a.AddDomainIntegrator(bfi);
+
+               const string setup = string(name) + "-setup";
+               const string mult = string(name) + "-mult";
+               const string diag = string(name) + "-diagonal";
+               const char *lname = LevelName(level);
+
+               // Setup: geometric factors, quadrature data and, for the
+               // FULL/ELEMENT levels, the local/global matrices.
+               double t = Measure([&]() { a.Assemble(); }, min_time, reps);
+               double s_bytes = 8.0*ne*nq*(d*d + qd);
+               if (level == AssemblyLevel::ELEMENT ||
+                   level == AssemblyLevel::FULL)
+               {
+                  s_bytes += 8.0*ne*nd*nd;
+               }
+               add(setup.c_str(), lname, reps, t,
+                   level == AssemblyLevel::NONE ? 0.0 : s_bytes, 0.0);
+
+               // Operator action.
+               double m_bytes = e_bytes, m_flops = pa_flops;
+               switch (level)
+               {
+                  case AssemblyLevel::FULL:
+                  {
+                     const double nnz = a.SpMat().NumNonZeroElems();
+                     m_bytes = 12.0*nnz + 8.0*2*ndofs + 4.0*(ndofs + 1);
+                     m_flops = 2.0*nnz;
+                     break;
+                  }
+                  case AssemblyLevel::ELEMENT:
+                     m_bytes += 8.0*ne*nd*nd;
+                     m_flops = 2.0*ne*nd*nd;
+                     break;
+                  case AssemblyLevel::PARTIAL:
+                     m_bytes += 8.0*ne*nq*qd;
+                     break;
+                  case AssemblyLevel::NONE:
+                     // geometry recomputed from the (linear) mesh nodes
+                     m_bytes += 8.0*d*ne*(1 << d);
+                     m_flops += ne*(d*d*SumFactFlops(d, 2, Q) + 3.0*d*d*nq);
+                     break;
+                  default: break;
+               }
+               t = Measure([&]() { a.Mult(x, y); }, min_time, reps);
+               add(mult.c_str(), lname, reps, t, m_bytes, m_flops);
+
+               // Diagonal of the partially assembled operator.
+               if (level == AssemblyLevel::PARTIAL)
+               {
+                  t = Measure([&]() { a.AssembleDiagonal(y); }, min_time, reps);
+                  add(diag.c_str(), lname, reps, t,
+                      8.0*ne*(nd + nq*qd) + rt_bytes, ne*d*sf);
+               }
+            }
+         }
+      }
+   }
+
+   // 4. Save the results in machine-readable form.
+   if (strlen(csv_file) > 0)
+   {
+      ofstream ofs(csv_file);
+      WriteCSV(ofs, results, peak_bw, peak_fp);
+      cout << "Results written to " << csv_file << endl;
+   }
+   if (strlen(json_file) > 0)
+   {
+      ofstream ofs(json_file);
+      WriteJSON(ofs, results, device_config, peak_bw, peak_fp);
+      cout << "Results written to " << json_file << endl;
+   }
+
+   return 0;
+}
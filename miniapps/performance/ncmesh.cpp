@@ -0,0 +1,207 @@
+//                 MFEM NCMesh Benchmarks - Performance Miniapp
+//
+// Compile with: make ncmesh
+//
+// Sample runs:  ncmesh
+//               ncmesh -d 2 -n 32 -l 6
+//               ncmesh -d 3 -n 8 -l 4 -f 0.3 -csv ncmesh.csv
+//               ncmesh -d 3 -n 8 -l 4 -mem
+//
+// Description:  This miniapp measures the run time and the memory usage of the
+//               nonconforming mesh (NCMesh) operations of an AMR cycle. A 2D
+//               or 3D Cartesian mesh is refined over a number of levels, each
+//               time refining a random fraction of the elements. The timed
+//               operations are:
+//
+//               - refine:    Mesh::GeneralRefinement, i.e., NCMesh::Refine
+//                            followed by the construction of the new Mesh
+//                            from the NCMesh (NCMesh::GetMeshComponents),
+//               - nc-refine: NCMesh::Refine alone,
+//               - lists:     NCMesh::GetFaceList and NCMesh::GetEdgeList,
+//               - derefine:  Mesh::DerefineByError on the finest mesh with a
+//                            random error indicator, i.e., NCMesh::Derefine
+//                            followed by the construction of the new Mesh.
+//
+//               For each operation the miniapp reports the number of leaf
+//               elements, the run time, the throughput in elements/s and the
+//               memory used by the NCMesh. The results can be written in CSV
+//               format to compare different versions of the library. The
+//               NCMesh node/face hash table is the chained HashTable, unless
+//               the library is compiled with -DMFEM_NCMESH_OPEN_HASH, which
+//               selects the faster but larger OpenHashTable. With the -mem
+//               option, the memory used by each NCMesh component is printed
+//               at the end.
+
+#include "mfem.hpp"
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace mfem;
+
+// One line of benchmark output.
+struct BenchResult
+{
+   string op;      // operation name, e.g. "refine"
+   int level;      // refinement level
+   long elems;     // number of leaf elements after the operation
+   double time;    // run time in seconds
+   long memory;    // NCMesh memory usage in bytes after the operation
+
+   double MElems() const { return time > 0.0 ? 1e-6*elems/time : 0.0; }
+};
+
+static double RandReal() { return rand()/(RAND_MAX + 1.0); }
+
+static void PrintHeader(ostream &os)
+{
+   os << setw(10) << "op" << setw(7) << "level" << setw(12) << "elements"
+      << setw(12) << "time [s]" << setw(13) << "MElems/s"
+      << setw(13) << "memory [MB]" << '\n';
+}
+
+static void Print(ostream &os, const BenchResult &r)
+{
+   os << setw(10) << r.op << setw(7) << r.level << setw(12) << r.elems
+      << setw(12) << setprecision(4) << r.time
+      << setw(13) << setprecision(4) << r.MElems()
+      << setw(13) << setprecision(4) << r.memory/1048576.0 << endl;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   int dim = 3;
+   int n = 4;
+   int levels = 4;
+   double fraction = 0.5;
+   int seed = 1;
+   const char *csv_file = "";
+   bool mem_detail = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&dim, "-d", "--dim",
+                  "Mesh dimension: 2 or 3.");
+   args.AddOption(&n, "-n", "--elements-1d",
+                  "Number of elements of the initial mesh in each direction.");
+   args.AddOption(&levels, "-l", "--levels",
+                  "Number of random refinement levels.");
+   args.AddOption(&fraction, "-f", "--fraction",
+                  "Fraction of the elements refined at each level, and "
+                  "derefinement threshold.");
+   args.AddOption(&seed, "-s", "--seed",
+                  "Seed of the random number generator.");
+   args.AddOption(&csv_file, "-csv", "--csv-file",
+                  "Write the results in CSV format to this file.");
+   args.AddOption(&mem_detail, "-mem", "--memory-detail", "-no-mem",
+                  "--no-memory-detail",
+                  "Print the memory used by each NCMesh component.");
+   args.Parse();
+   if (!args.Good() || (dim != 2 && dim != 3))
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+#ifdef MFEM_NCMESH_OPEN_HASH
+   cout << "NCMesh hash table: open addressing (OpenHashTable)\n";
+#else
+   cout << "NCMesh hash table: chaining (HashTable)\n";
+#endif
+
+   // 2. Create the initial nonconforming Cartesian mesh.
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(n, n, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(n, n, n, Element::HEXAHEDRON);
+   mesh.EnsureNCMesh();
+   srand(seed);
+
+   vector<BenchResult> results;
+   auto record = [&](const char *op, int level, double time)
+   {
+      BenchResult r = { op, level, mesh.GetNE(), time,
+                        mesh.ncmesh->MemoryUsage()
+                      };
+      results.push_back(r);
+      Print(cout, r);
+   };
+
+   PrintHeader(cout);
+   StopWatch sw;
+
+   // 3. Refine a random fraction of the elements on each level.
+   for (int l = 1; l <= levels; l++)
+   {
+      Array<Refinement> refs;
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         if (RandReal() < fraction) { refs.Append(Refinement(e)); }
+      }
+
+      double nc_time;
+      {
+         NCMesh ncmesh(*mesh.ncmesh);
+         sw.Clear();
+         sw.Start();
+         ncmesh.Refine(refs);
+         sw.Stop();
+         nc_time = sw.RealTime();
+      }
+
+      sw.Clear();
+      sw.Start();
+      mesh.GeneralRefinement(refs);
+      sw.Stop();
+      record("nc-refine", l, nc_time);
+      record("refine", l, sw.RealTime());
+
+      {
+         NCMesh ncmesh(*mesh.ncmesh);
+         sw.Clear();
+         sw.Start();
+         ncmesh.GetFaceList();
+         ncmesh.GetEdgeList();
+         sw.Stop();
+         record("lists", l, sw.RealTime());
+      }
+   }
+
+   // 4. Derefine with a random error indicator.
+   {
+      Array<double> elem_error(mesh.GetNE());
+      for (int e = 0; e < mesh.GetNE(); e++) { elem_error[e] = RandReal(); }
+      sw.Clear();
+      sw.Start();
+      mesh.DerefineByError(elem_error, fraction, 0, 0);
+      sw.Stop();
+      record("derefine", levels, sw.RealTime());
+   }
+
+   // 5. Print the memory used by the NCMesh components of the final mesh,
+   //    in bytes: nodes and faces are "<items> + <index> + <free ids>".
+   if (mem_detail)
+   {
+      cout << "\nNCMesh memory detail [bytes]:\n";
+      mesh.ncmesh->PrintMemoryDetail();
+   }
+
+   // 6. Save the results.
+   if (strlen(csv_file) > 0)
+   {
+      ofstream ofs(csv_file);
+      ofs << "op,level,elements,time,melems_per_s,memory\n";
+      for (const BenchResult &r : results)
+      {
+         ofs << r.op << ',' << r.level << ',' << r.elems << ',' << r.time
+             << ',' << r.MElems() << ',' << r.memory << '\n';
+      }
+      cout << "Results written to " << csv_file << endl;
+   }
+
+   return 0;
+}
@@ -17,6 +17,160 @@
 
 using namespace mfem;
 
+namespace zz_batched
+{
+
+double Solution(const Vector &x)
+{
+   double r = 1.0;
+   for (int d = 0; d < x.Size(); d++) { r *= sin(3.0*x(d) + d); }
+   return r;
+}
+
+double Conductivity(const Vector &x) { return 1.0 + x(0)*x(0); }
+
+// Forwards the element flux methods only, so that the ZZ estimator uses the
+// element-by-element evaluation of the fluxes and energies
+class ElementFluxIntegrator : public BilinearFormIntegrator
+{
+   BilinearFormIntegrator &integ;
+public:
+   ElementFluxIntegrator(BilinearFormIntegrator &integ_) : integ(integ_) { }
+
+   virtual void ComputeElementFlux(const FiniteElement &el,
+                                   ElementTransformation &Trans,
+                                   Vector &u, const FiniteElement &fluxelem,
+                                   Vector &flux, bool with_coef = true)
+   { integ.ComputeElementFlux(el, Trans, u, fluxelem, flux, with_coef); }
+
+   virtual double ComputeFluxEnergy(const FiniteElement &fluxelem,
+                                    ElementTransformation &Trans,
+                                    Vector &flux, Vector *d_energy = NULL)
+   { return integ.ComputeFluxEnergy(fluxelem, Trans, flux, d_energy); }
+};
+
+TEST_CASE("Batched ZZ Error Estimator", "[ErrorEstimator]")
+{
+   const int dim = GENERATE(2, 3);
+   const bool simplex = GENERATE(false, true);
+   const bool curved = GENERATE(false, true);
+   const int order = 2;
+   CAPTURE(dim, simplex, curved);
+
+   const Element::Type type = (dim == 2) ?
+                              (simplex ? Element::TRIANGLE :
+                               Element::QUADRILATERAL) :
+                              (simplex ? Element::TETRAHEDRON :
+                               Element::HEXAHEDRON);
+   Mesh mesh = (dim == 2) ? Mesh::MakeCartesian2D(3, 3, type) :
+               Mesh::MakeCartesian3D(2, 2, 2, type);
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      mesh.SetAttribute(e, 1 + e % 2);
+   }
+   mesh.SetAttributes();
+   // Refine a few elements nonconformingly, as in an AMR loop
+   mesh.EnsureNCMesh();
+   Array<int> refs;
+   refs.Append(0);
+   refs.Append(mesh.GetNE() - 1);
+   mesh.GeneralRefinement(refs);
+   if (curved) { mesh.SetCurvature(2); }
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction u(&fes);
+   FunctionCoefficient u_coeff(Solution);
+   u.ProjectCoefficient(u_coeff);
+
+   H1_FECollection flux_fec(order, dim);
+   FiniteElementSpace flux_fes(&mesh, &flux_fec, dim);
+
+   FunctionCoefficient kappa(Conductivity);
+   DiffusionIntegrator integ1, integ2(kappa);
+   DiffusionIntegrator *integs[] = { &integ1, &integ2 };
+   for (DiffusionIntegrator *integ : integs)
+   {
+      Vector batched_flux;
+      REQUIRE(integ->ComputeElementFluxes(fes, u, flux_fes, batched_flux));
+      ElementFluxIntegrator elem_integ(*integ);
+      for (int subdomains = 0; subdomains < 2; subdomains++)
+      {
+         GridFunction flux(&flux_fes), elem_flux(&flux_fes);
+         Vector err, elem_err;
+         Array<int> flags, elem_flags;
+         double total = ZZErrorEstimator(*integ, u, flux, err, &flags,
+                                         subdomains);
+         double elem_total = ZZErrorEstimator(elem_integ, u, elem_flux,
+                                              elem_err, &elem_flags,
+                                              subdomains);
+         REQUIRE(total > 0.0);
+         REQUIRE(total == MFEM_Approx(elem_total, 1e-12));
+         elem_flux -= flux;
+         REQUIRE(elem_flux.Normlinf() == MFEM_Approx(0.0, 1e-12));
+         elem_err -= err;
+         REQUIRE(elem_err.Normlinf() == MFEM_Approx(0.0, 1e-12));
+         for (int i = 0; i < flags.Size(); i++)
+         {
+            REQUIRE(flags[i] == elem_flags[i]);
+         }
+      }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel Batched ZZ Error Estimator",
+          "[ErrorEstimator], [Parallel]")
+{
+   const int dim = GENERATE(2, 3);
+   const int order = 2;
+   CAPTURE(dim);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(3, 3, 3, Element::HEXAHEDRON);
+   mesh.EnsureNCMesh();
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   // Refine the first local element on each rank nonconformingly
+   Array<int> refs;
+   if (pmesh.GetNE() > 0) { refs.Append(0); }
+   pmesh.GeneralRefinement(refs);
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParGridFunction u(&fes);
+   FunctionCoefficient u_coeff(Solution);
+   u.ProjectCoefficient(u_coeff);
+
+   H1_FECollection flux_fec(order, dim);
+   ParFiniteElementSpace flux_fes(&pmesh, &flux_fec, dim);
+
+   // The fluxes are averaged over the shared dofs by ParGridFunction, with
+   // the same result for the batched and element-by-element fluxes
+   FunctionCoefficient kappa(Conductivity);
+   DiffusionIntegrator integ(kappa);
+   ElementFluxIntegrator elem_integ(integ);
+   ParGridFunction flux(&flux_fes), elem_flux(&flux_fes);
+   Vector err, elem_err;
+   double total = ZZErrorEstimator(integ, u, flux, err);
+   double elem_total = ZZErrorEstimator(elem_integ, u, elem_flux, elem_err);
+   REQUIRE(total > 0.0);
+   REQUIRE(total == MFEM_Approx(elem_total, 1e-12));
+   elem_err -= err;
+   REQUIRE(elem_err.Normlinf() == MFEM_Approx(0.0, 1e-12));
+
+   // The shared dofs of the averaged flux agree on all ranks
+   Vector master_flux(flux);
+   flux_fes.GroupComm().Bcast<double>(master_flux);
+   master_flux -= flux;
+   REQUIRE(master_flux.Normlinf() == MFEM_Approx(0.0, 1e-12));
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace zz_batched
+
 #if defined(MFEM_USE_MPI)
 
 namespace testhelper
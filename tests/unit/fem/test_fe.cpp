@@ -676,3 +676,39 @@ TEST_CASE("L2 Wedge Finite Element",
       }
    }
 }
+
+TEST_CASE("Shared DofToQuad", "[DofToQuad][FiniteElement]")
+{
+   H1_QuadrilateralElement fe(2);
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 4);
+
+   for (DofToQuad::Mode mode : {DofToQuad::FULL, DofToQuad::TENSOR})
+   {
+      const DofToQuad &maps = fe.GetDofToQuad(ir, mode);
+      REQUIRE(maps.mode == mode);
+      REQUIRE(maps.IntRule == &ir);
+
+      // Copies of the rule share the maps, also after they are deleted
+      IntegrationRule *ir_copy = new IntegrationRule(ir);
+      REQUIRE(&fe.GetDofToQuad(*ir_copy, mode) == &maps);
+      REQUIRE(maps.IntRule == ir_copy);
+      delete ir_copy;
+      REQUIRE(&fe.GetDofToQuad(ir, mode) == &maps);
+      REQUIRE(maps.IntRule == &ir);
+
+      // ... but other rules do not
+      const IntegrationRule &ir2 = IntRules.Get(Geometry::SQUARE, 2);
+      REQUIRE(&fe.GetDofToQuad(ir2, mode) != &maps);
+   }
+   REQUIRE(&fe.GetDofToQuad(ir, DofToQuad::FULL) !=
+           &fe.GetDofToQuad(ir, DofToQuad::TENSOR));
+
+   ND_HexahedronElement nd(2);
+   const IntegrationRule &hir = IntRules.Get(Geometry::CUBE, 4);
+   const IntegrationRule hir_copy(hir);
+   const DofToQuad &closed = nd.GetDofToQuad(hir, DofToQuad::TENSOR);
+   const DofToQuad &open = nd.GetDofToQuadOpen(hir, DofToQuad::TENSOR);
+   REQUIRE(&closed != &open);
+   REQUIRE(&nd.GetDofToQuad(hir_copy, DofToQuad::TENSOR) == &closed);
+   REQUIRE(&nd.GetDofToQuadOpen(hir_copy, DofToQuad::TENSOR) == &open);
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace gridfunc_errors
+{
+
+static double exact_func(const Vector &x)
+{
+   double r = 1.0 + x(0)*x(0);
+   for (int d = 1; d < x.Size(); d++) { r += sin(2.0*x(d)); }
+   return r;
+}
+
+static double weight_func(const Vector &x)
+{
+   return 1.0 + x(0);
+}
+
+// Element-by-element evaluation of the Lp errors, as in the element loops of
+// GridFunction::ComputeElementLpErrors()
+static void ElementLpErrors(const GridFunction &u, double p, Coefficient &exsol,
+                            Coefficient &weight, Vector &error)
+{
+   const FiniteElementSpace &fes = *u.FESpace();
+   error.SetSize(fes.GetNE());
+   Vector vals;
+   for (int i = 0; i < fes.GetNE(); i++)
+   {
+      const FiniteElement *fe = fes.GetFE(i);
+      const IntegrationRule &ir =
+         IntRules.Get(fe->GetGeomType(), 2*fe->GetOrder() + 3);
+      u.GetValues(i, ir, vals);
+      ElementTransformation *T = fes.GetElementTransformation(i);
+      error(i) = 0.0;
+      for (int j = 0; j < ir.GetNPoints(); j++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(j);
+         T->SetIntPoint(&ip);
+         double err = fabs(vals(j) - exsol.Eval(*T, ip));
+         if (p < infinity())
+         {
+            err = pow(err, p)*weight.Eval(*T, ip);
+            error(i) += ip.weight*T->Weight()*err;
+         }
+         else
+         {
+            error(i) = std::max(error(i), err*weight.Eval(*T, ip));
+         }
+      }
+   }
+}
+
+TEST_CASE("GridFunction Errors and Projections", "[GridFunction]")
+{
+   const int dim = GENERATE(2, 3);
+   const bool simplex = GENERATE(false, true);
+   const bool curved = GENERATE(false, true);
+   const bool dg = GENERATE(false, true);
+   const int order = 2;
+   CAPTURE(dim, simplex, curved, dg);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 3, simplex ? Element::TRIANGLE :
+                                     Element::QUADRILATERAL, true) :
+               Mesh::MakeCartesian3D(2, 2, 2, simplex ? Element::TETRAHEDRON :
+                                     Element::HEXAHEDRON);
+   if (curved)
+   {
+      mesh.SetCurvature(2);
+      GridFunction &nodes = *mesh.GetNodes();
+      for (int i = 0; i < nodes.Size(); i++)
+      {
+         nodes(i) += 0.02*sin(3.0*nodes(i));
+      }
+   }
+
+   FiniteElementCollection *fec = dg ?
+                                  (FiniteElementCollection*)
+                                  new L2_FECollection(order, dim) :
+                                  new H1_FECollection(order, dim);
+   FiniteElementSpace fes(&mesh, fec);
+   FunctionCoefficient exsol(exact_func), weight(weight_func);
+
+   // The nodal projection is the one of the element loop
+   GridFunction u(&fes), u_ref(&fes);
+   u.ProjectCoefficient(exsol);
+   Array<int> vdofs;
+   Vector vals;
+   for (int i = 0; i < fes.GetNE(); i++)
+   {
+      fes.GetElementVDofs(i, vdofs);
+      vals.SetSize(vdofs.Size());
+      fes.GetFE(i)->Project(exsol, *fes.GetElementTransformation(i), vals);
+      u_ref.SetSubVector(vdofs, vals);
+   }
+   u_ref -= u;
+   REQUIRE(u_ref.Normlinf() == MFEM_Approx(0.0, 1e-12));
+
+   // Perturb the projection to get nonzero errors
+   for (int i = 0; i < u.Size(); i++) { u(i) += 0.01*sin(i); }
+
+   ConstantCoefficient one(1.0);
+   Vector error, error_ref;
+   for (double p : { 1.0, 2.0, infinity() })
+   {
+      CAPTURE(p);
+      ElementLpErrors(u, p, exsol, one, error_ref);
+      const double norm_ref = (p < infinity()) ?
+                              pow(error_ref.Sum(), 1.0/p) : error_ref.Max();
+      REQUIRE(u.ComputeLpError(p, exsol) == MFEM_Approx(norm_ref));
+
+      error.SetSize(fes.GetNE());
+      u.ComputeElementLpErrors(p, exsol, error);
+      for (int i = 0; i < error_ref.Size() && p < infinity(); i++)
+      {
+         error_ref(i) = pow(error_ref(i), 1.0/p);
+      }
+      error -= error_ref;
+      REQUIRE(error.Normlinf() == MFEM_Approx(0.0, 1e-12));
+
+      ElementLpErrors(u, p, exsol, weight, error_ref);
+      const double wnorm_ref = (p < infinity()) ?
+                               pow(error_ref.Sum(), 1.0/p) : error_ref.Max();
+      REQUIRE(u.ComputeLpError(p, exsol, &weight) == MFEM_Approx(wnorm_ref));
+   }
+   REQUIRE(u.ComputeL2Error(exsol) == MFEM_Approx(u.ComputeLpError(2.0, exsol)));
+
+   // The error computation does not add nodes to the mesh
+   REQUIRE((mesh.GetNodes() != NULL) == curved);
+
+   delete fec;
+}
+
+} // namespace gridfunc_errors
@@ -0,0 +1,99 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace hybridization
+{
+
+// Hybridize the H(div) mass + div-div operator of ex4 and solve the reduced
+// system; return the matrix H, the reduced r.h.s. and the solution.
+static void HybridizedSolve(FiniteElementSpace &fes, FiniteElementSpace &hfes,
+                            const Array<int> &ess_tdofs, const Vector &b,
+                            bool batched, SparseMatrix *&H, Vector &b_r,
+                            Vector &x)
+{
+   Hybridization hyb(&fes, &hfes);
+   hyb.SetConstraintIntegrator(new NormalTraceJumpIntegrator());
+   hyb.Init(ess_tdofs);
+   hyb.UseBatched(batched);
+   REQUIRE(hyb.UsesBatched() == batched);
+
+   VectorFEMassIntegrator mass;
+   DivDivIntegrator divdiv;
+   DenseMatrix elmat, elmat2;
+   for (int e = 0; e < fes.GetNE(); e++)
+   {
+      const FiniteElement &fe = *fes.GetFE(e);
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      mass.AssembleElementMatrix(fe, T, elmat);
+      divdiv.AssembleElementMatrix(fe, T, elmat2);
+      elmat += elmat2;
+      hyb.AssembleMatrix(e, elmat);
+   }
+   hyb.Finalize();
+   H = new SparseMatrix(hyb.GetMatrix());
+
+   hyb.ReduceRHS(b, b_r);
+   Vector x_r(b_r.Size());
+   x_r = 0.0;
+   GSSmoother prec(*H);
+   PCG(*H, prec, b_r, x_r, 0, 1000, 1e-24, 0.0);
+
+   x.SetSize(b.Size());
+   x = 0.0;
+   hyb.ComputeSolution(b, x_r, x);
+}
+
+TEST_CASE("Batched Hybridization", "[Hybridization]")
+{
+   const int order = 1;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh mesh = (dim == 2) ?
+                  Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL) :
+                  Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+      RT_FECollection fec(order, dim);
+      DG_Interface_FECollection hfec(order, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      FiniteElementSpace hfes(&mesh, &hfec);
+
+      // essential b.c. on the first boundary attribute
+      Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdofs;
+      ess_bdr = 0;
+      ess_bdr[0] = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+
+      Vector b(fes.GetVSize());
+      b.Randomize(1);
+
+      SparseMatrix *H0, *H1;
+      Vector b_r0, b_r1, x0, x1;
+      HybridizedSolve(fes, hfes, ess_tdofs, b, false, H0, b_r0, x0);
+      HybridizedSolve(fes, hfes, ess_tdofs, b, true, H1, b_r1, x1);
+
+      H1->Add(-1.0, *H0);
+      REQUIRE(H1->MaxNorm() == MFEM_Approx(0.0, 1e-12*H0->MaxNorm()));
+      b_r1 -= b_r0;
+      REQUIRE(b_r1.Normlinf() == MFEM_Approx(0.0, 1e-12*b_r0.Normlinf()));
+      x1 -= x0;
+      REQUIRE(x1.Normlinf() == MFEM_Approx(0.0, 1e-8*x0.Normlinf()));
+      REQUIRE(x0.Normlinf() > 0.0);
+
+      delete H1;
+      delete H0;
+   }
+}
+
+} // namespace hybridization
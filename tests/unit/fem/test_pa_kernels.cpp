@@ -12,6 +12,7 @@
 #include "unit_tests.hpp"
 #include "mfem.hpp"
 #include <fstream>
+#include <functional>
 #include <iostream>
 
 using namespace mfem;
@@ -324,6 +325,106 @@ TEST_CASE("PA Vector Diffusion", "[PartialAssembly], [VectorPA]")
    }
 }
 
+// Relative difference between the PA action and diagonal of INTEGRATOR and the
+// legacy assembly, using Gauss-Legendre rules with q1d = order + 1 + q_add.
+template <typename INTEGRATOR>
+double test_pa_specialization(int dim, int order, int q_add, int vdim)
+{
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(2, 2, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(1, 1, 1, Element::HEXAHEDRON);
+   mesh.EnsureNodes();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vdim);
+   const int q1d = order + 1 + q_add;
+   const IntegrationRule &ir =
+      IntRules.Get(mesh.GetElementBaseGeometry(0), 2*q1d - 1);
+
+   GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+   Vector diag_fa, diag_pa(fes.GetVSize());
+   x.Randomize(1);
+
+   BilinearForm blf_fa(&fes);
+   INTEGRATOR *integ_fa = new INTEGRATOR;
+   integ_fa->SetIntRule(&ir);
+   blf_fa.AddDomainIntegrator(integ_fa);
+   blf_fa.Assemble();
+   blf_fa.Finalize();
+   blf_fa.Mult(x, y_fa);
+   blf_fa.SpMat().GetDiag(diag_fa);
+
+   BilinearForm blf_pa(&fes);
+   blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   INTEGRATOR *integ_pa = new INTEGRATOR;
+   integ_pa->SetIntRule(&ir);
+   blf_pa.AddDomainIntegrator(integ_pa);
+   blf_pa.Assemble();
+   blf_pa.Mult(x, y_pa);
+   blf_pa.AssembleDiagonal(diag_pa);
+
+   const double y_norm = y_fa.Normlinf(), diag_norm = diag_fa.Normlinf();
+   y_fa -= y_pa;
+   diag_fa -= diag_pa;
+   return y_fa.Normlinf()/y_norm + diag_fa.Normlinf()/diag_norm;
+}
+
+TEST_CASE("PA Kernel Specializations", "[PartialAssembly]")
+{
+   // All the (dim, D1D, Q1D) below are registered in PAKernelSpecs, so the
+   // generic kernels must not be used.
+   KernelFallback::Action action = KernelFallback::GetAction();
+   KernelFallback::SetAction(KernelFallback::COUNT);
+   KernelFallback::Reset();
+
+   // The geometric factors support at most 8 quadrature points in 1D.
+   auto q_add = GENERATE(0, 1, 2);
+
+   SECTION("2D")
+   {
+      for (int order = 1; order + 1 + q_add <= 8; order++)
+      {
+         INFO("order = " << order << ", q_add = " << q_add);
+         REQUIRE(test_pa_specialization<MassIntegrator>(2, order, q_add, 1)
+                 == MFEM_Approx(0.0));
+         REQUIRE(test_pa_specialization<DiffusionIntegrator>(2, order, q_add, 1)
+                 == MFEM_Approx(0.0));
+         REQUIRE(test_pa_specialization<VectorMassIntegrator>(2, order, q_add, 2)
+                 == MFEM_Approx(0.0));
+      }
+   }
+
+   SECTION("3D")
+   {
+      for (int order = 1; order + 1 + q_add <= 8; order++)
+      {
+         INFO("order = " << order << ", q_add = " << q_add);
+         REQUIRE(test_pa_specialization<MassIntegrator>(3, order, q_add, 1)
+                 == MFEM_Approx(0.0));
+         REQUIRE(test_pa_specialization<DiffusionIntegrator>(3, order, q_add, 1)
+                 == MFEM_Approx(0.0));
+      }
+      for (int order = 1; order <= 3; order++)
+      {
+         INFO("order = " << order << ", q_add = " << q_add);
+         REQUIRE(test_pa_specialization<VectorMassIntegrator>(3, order, q_add, 3)
+                 == MFEM_Approx(0.0));
+      }
+   }
+
+   REQUIRE(KernelFallback::GetCount() == 0);
+
+   SECTION("Fallback")
+   {
+      // D1D = 2, Q1D = 5 is not registered: the generic kernel is counted.
+      REQUIRE(test_pa_specialization<MassIntegrator>(2, 1, 3, 1)
+              == MFEM_Approx(0.0));
+      REQUIRE(KernelFallback::GetCount("PAMassApply") == 1);
+      REQUIRE(KernelFallback::GetCount("PAMassDiagonal") == 1);
+   }
+
+   KernelFallback::SetAction(action);
+}
+
 void velocity_function(const Vector &x, Vector &v)
 {
    int dim = x.Size();
@@ -453,4 +554,629 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
 
 } // test case
 
+// Relative difference between the PA action computed with the SIMD kernels
+// and with the standard kernels, using q1d = order + 2 quadrature points.
+double test_pa_simd(const char *meshname, int order, int vdim,
+                    std::function<BilinearFormIntegrator*()> new_integ)
+{
+   INFO("mesh=" << meshname << ", order=" << order);
+   Mesh mesh(meshname, 1, 1);
+   mesh.EnsureNodes();
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vdim);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh.GetElementBaseGeometry(0), 2*order + 3);
+
+   GridFunction x(&fes), y(&fes), y_simd(&fes);
+   x.Randomize(1);
+
+   BilinearForm blf(&fes);
+   blf.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   BilinearFormIntegrator *integ = new_integ();
+   integ->SetIntRule(&ir);
+   blf.AddDomainIntegrator(integ);
+   blf.Assemble();
+   blf.Mult(x, y);
+
+   REQUIRE(integ->SupportsPASIMD());
+   blf.UsePASIMD();
+   blf.Mult(x, y_simd);
+
+   const double y_norm = y.Normlinf();
+   y -= y_simd;
+   return y.Normlinf()/y_norm;
+}
+
+TEST_CASE("PA SIMD Kernels", "[PartialAssembly]")
+{
+   SECTION("Interleaved layout")
+   {
+      const int W = PA_SIMD_WIDTH;
+      const int ne = 2*W + 1, nd = 5, vdim = 2;
+      Vector x(ne*nd*vdim), xi, x2;
+      x.Randomize(1);
+      PASIMDInterleave(ne, nd, vdim, x, xi);
+      REQUIRE(xi.Size() == PASIMDSize(ne, nd, vdim));
+      for (int e = 0; e < ne; e++)
+      {
+         REQUIRE(xi(((e/W*vdim + 1)*nd + 3)*W + e%W) == x((e*vdim + 1)*nd + 3));
+      }
+      PASIMDDeinterleave(ne, nd, vdim, xi, x2);
+      x2 -= x;
+      REQUIRE(x2.Normlinf() == 0.0);
+   }
+
+   SECTION("Interleaved restriction")
+   {
+      Mesh mesh("../../data/star-q3.mesh", 1, 1);
+      H1_FECollection h1_fec(2, 2);
+      L2_FECollection l2_fec(2, 2, BasisType::GaussLobatto);
+      for (int l2 = 0; l2 <= 1; l2++)
+      {
+         for (int ordering = Ordering::byNODES; ordering <= Ordering::byVDIM;
+              ordering++)
+         {
+            INFO("L2=" << l2 << ", ordering=" << ordering);
+            const FiniteElementCollection *fec = l2 ? (FiniteElementCollection*)
+                                                 &l2_fec : &h1_fec;
+            FiniteElementSpace fes(&mesh, fec, 2, ordering);
+            const Operator *R =
+               fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+            const int ne = fes.GetNE(), vdim = fes.GetVDim();
+            const int nd = R->Height() / (ne * vdim);
+
+            Vector x(fes.GetVSize()), ex(R->Height()), exi, exi2, y, y2;
+            x.Randomize(1);
+            R->Mult(x, ex);
+            PASIMDInterleave(ne, nd, vdim, ex, exi);
+            exi2.SetSize(exi.Size());
+            exi2 = 1.0;
+            const ElementRestriction *H1R =
+               dynamic_cast<const ElementRestriction*>(R);
+            const L2ElementRestriction *L2R =
+               dynamic_cast<const L2ElementRestriction*>(R);
+            REQUIRE((l2 ? (void*)L2R : (void*)H1R) != nullptr);
+            if (H1R) { H1R->MultInterleaved(x, exi2); }
+            else { L2R->MultInterleaved(x, exi2); }
+            exi2 -= exi;
+            REQUIRE(exi2.Normlinf() == 0.0);
+
+            y.SetSize(x.Size());
+            y2.SetSize(x.Size());
+            PASIMDDeinterleave(ne, nd, vdim, exi, ex);
+            R->MultTranspose(ex, y);
+            if (H1R) { H1R->MultTransposeInterleaved(exi, y2); }
+            else { L2R->MultTransposeInterleaved(exi, y2); }
+            y2 -= y;
+            REQUIRE(y2.Normlinf() == MFEM_Approx(0.0));
+         }
+      }
+   }
+
+   auto order = GENERATE(1, 2, 3);
+
+   FunctionCoefficient q([](const Vector &x) { return 1.0 + x(0)*x(0); });
+   auto mq_func = [](const Vector &x, DenseMatrix &m)
+   {
+      m = 0.0;
+      for (int i = 0; i < x.Size(); i++)
+      {
+         m(i,i) = 2.0 + x(i);
+         m(i,(i+1)%x.Size()) = 0.5;
+      }
+   };
+
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      const char *mesh = (dim == 2) ? "../../data/star-q3.mesh" :
+                         "../../data/fichera-q3.mesh";
+      MatrixFunctionCoefficient mq(dim, mq_func);
+      VectorFunctionCoefficient vel(dim, velocity_function);
+
+      REQUIRE(test_pa_simd(mesh, order, 1, [&]()
+      { return new MassIntegrator(q); }) == MFEM_Approx(0.0));
+      REQUIRE(test_pa_simd(mesh, order, 1, [&]()
+      { return new DiffusionIntegrator(q); }) == MFEM_Approx(0.0));
+      REQUIRE(test_pa_simd(mesh, order, 1, [&]()
+      { return new DiffusionIntegrator(mq); }) == MFEM_Approx(0.0));
+      REQUIRE(test_pa_simd(mesh, order, dim, [&]()
+      { return new VectorMassIntegrator; }) == MFEM_Approx(0.0));
+      REQUIRE(test_pa_simd(mesh, order, 1, [&]()
+      { return new ConvectionIntegrator(vel, -1.0); }) == MFEM_Approx(0.0));
+   }
+}
+
+// Relative difference between the PA action (and transposed action) fused with
+// the element restriction and the standard PA action.
+double test_pa_fused(const char *meshname, int order,
+                     std::function<BilinearFormIntegrator*()> new_integ)
+{
+   INFO("mesh=" << meshname << ", order=" << order);
+   Mesh mesh(meshname, 1, 1);
+   mesh.EnsureNodes();
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh.GetElementBaseGeometry(0), 2*order + 3);
+
+   GridFunction x(&fes), y(&fes), y_fused(&fes);
+   x.Randomize(1);
+
+   BilinearForm blf(&fes);
+   blf.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   BilinearFormIntegrator *integ = new_integ();
+   integ->SetIntRule(&ir);
+   blf.AddDomainIntegrator(integ);
+   blf.Assemble();
+   blf.Mult(x, y);
+
+   // The transposed fused action must satisfy (A^T x, z) = (x, A z); the
+   // standard PA action is not transposed for nonsymmetric diffusion.
+   GridFunction z(&fes), Az(&fes), yt_fused(&fes);
+   z.Randomize(2);
+   blf.Mult(z, Az);
+
+   REQUIRE(integ->SupportsPAFused());
+   blf.UsePAFused();
+   blf.Mult(x, y_fused);
+   const ElementRestriction &R = static_cast<const ElementRestriction&>(
+                                    *fes.GetElementRestriction(
+                                       ElementDofOrdering::LEXICOGRAPHIC));
+   yt_fused = 0.0;
+   integ->AddMultTransposePAFused(R, R.GetElementColoring(), x, yt_fused);
+
+   const double y_norm = y.Normlinf();
+   y -= y_fused;
+   const double xAz = x*Az;
+   return std::max(y.Normlinf()/y_norm, std::abs(yt_fused*z - xAz)/xAz);
+}
+
+TEST_CASE("PA Fused Kernels", "[PartialAssembly]")
+{
+   SECTION("Element coloring")
+   {
+      Mesh mesh("../../data/fichera-q3.mesh", 1, 1);
+      H1_FECollection fec(2, 3);
+      FiniteElementSpace fes(&mesh, &fec);
+      const ElementRestriction *R = dynamic_cast<const ElementRestriction*>(
+                                       fes.GetElementRestriction(
+                                          ElementDofOrdering::LEXICOGRAPHIC));
+      REQUIRE(R != nullptr);
+      const Table &colors = R->GetElementColoring();
+      REQUIRE(colors.Size_of_connections() == fes.GetNE());
+      Array<int> owner(fes.GetNDofs()), dofs;
+      for (int c = 0; c < colors.Size(); c++)
+      {
+         owner = -1;
+         for (int k = 0; k < colors.RowSize(c); k++)
+         {
+            const int e = colors.GetRow(c)[k];
+            fes.GetElementDofs(e, dofs);
+            for (int d = 0; d < dofs.Size(); d++)
+            {
+               const int j = dofs[d] >= 0 ? dofs[d] : -1 - dofs[d];
+               REQUIRE(owner[j] == -1);
+               owner[j] = e;
+            }
+         }
+      }
+   }
+
+   auto order = GENERATE(1, 2, 3);
+
+   FunctionCoefficient q([](const Vector &x) { return 1.0 + x(0)*x(0); });
+   auto mq_func = [](const Vector &x, DenseMatrix &m)
+   {
+      m = 0.0;
+      for (int i = 0; i < x.Size(); i++)
+      {
+         m(i,i) = 2.0 + x(i);
+         m(i,(i+1)%x.Size()) = 0.5;
+      }
+   };
+
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      const char *mesh = (dim == 2) ? "../../data/star-q3.mesh" :
+                         "../../data/fichera-q3.mesh";
+      MatrixFunctionCoefficient mq(dim, mq_func);
+
+      REQUIRE(test_pa_fused(mesh, order, [&]()
+      { return new MassIntegrator(q); }) == MFEM_Approx(0.0));
+      REQUIRE(test_pa_fused(mesh, order, [&]()
+      { return new DiffusionIntegrator(q); }) == MFEM_Approx(0.0));
+      REQUIRE(test_pa_fused(mesh, order, [&]()
+      { return new DiffusionIntegrator(mq); }) == MFEM_Approx(0.0));
+   }
+}
+
+// The action on subsets of the elements, summed dof by dof, is bitwise
+// identical to the standard PA action
+TEST_CASE("PA Element Subsets", "[PartialAssembly]")
+{
+   auto order = GENERATE(1, 2, 3);
+   auto dim = GENERATE(2, 3);
+   INFO("dim=" << dim << ", order=" << order);
+
+   Mesh mesh(dim == 2 ? "../../data/star-q3.mesh" :
+             "../../data/fichera-q3.mesh", 1, 1);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient q([](const Vector &x) { return 1.0 + x(0)*x(0); });
+
+   BilinearForm blf(&fes);
+   blf.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   BilinearFormIntegrator *mass = new MassIntegrator(q);
+   BilinearFormIntegrator *diff = new DiffusionIntegrator(q);
+   blf.AddDomainIntegrator(diff);
+   blf.AddDomainIntegrator(mass);
+   blf.Assemble();
+   REQUIRE(mass->SupportsPAElements());
+   REQUIRE(diff->SupportsPAElements());
+
+   GridFunction x(&fes), y(&fes), y_sub(&fes);
+   x.Randomize(1);
+   blf.Mult(x, y);
+
+   // Three subsets of the elements, processed in a different order, and two
+   // subsets of the dofs
+   const ElementRestriction &R = static_cast<const ElementRestriction&>(
+                                    *fes.GetElementRestriction(
+                                       ElementDofOrdering::LEXICOGRAPHIC));
+   Array<int> elems[3], dofs[2];
+   for (int e = 0; e < fes.GetNE(); e++) { elems[e % 3].Append(e); }
+   for (int j = 0; j < fes.GetNDofs(); j++) { dofs[j % 2].Append(j); }
+   Vector ex(R.Height()), ey(R.Height());
+   ex = 0.0;
+   ey = 0.0;
+   for (int k = 2; k >= 0; k--)
+   {
+      R.MultElements(elems[k], x, ex);
+      diff->AddMultPAElements(elems[k], ex, ey);
+      mass->AddMultPAElements(elems[k], ex, ey);
+   }
+   y_sub = 0.0;
+   R.MultTransposeDofs(dofs[1], ey, y_sub);
+   R.MultTransposeDofs(dofs[0], ey, y_sub);
+
+   y_sub -= y;
+   REQUIRE(y_sub.Normlinf() == 0.0);
+}
+
+TEST_CASE("PA NURBS", "[PartialAssembly], [NURBS]")
+{
+   auto mesh_file = GENERATE("../../data/disc-nurbs.mesh",
+                             "../../data/square-nurbs.mesh",
+                             "../../data/pipe-nurbs.mesh");
+   auto elevate = GENERATE(0, 1);
+   Mesh mesh(mesh_file, 1, 1);
+   if (elevate) { mesh.DegreeElevate(elevate); }
+   if (mesh.Dimension() == 2) { mesh.UniformRefinement(); }
+   NURBSFECollection fec(mesh.NURBSext->GetOrder());
+   FiniteElementSpace fes(&mesh, &fec);
+
+   FunctionCoefficient q([](const Vector &x) { return 1.0 + x(0)*x(0); });
+   for (int integ = 0; integ < 2; integ++)
+   {
+      INFO("mesh=" << mesh_file << ", elevate=" << elevate
+           << ", integrator=" << integ);
+      BilinearForm blf_fa(&fes), blf_pa(&fes);
+      blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      if (integ == 0)
+      {
+         blf_fa.AddDomainIntegrator(new MassIntegrator(q));
+         blf_pa.AddDomainIntegrator(new MassIntegrator(q));
+      }
+      else
+      {
+         blf_fa.AddDomainIntegrator(new DiffusionIntegrator(q));
+         blf_pa.AddDomainIntegrator(new DiffusionIntegrator(q));
+      }
+      blf_fa.Assemble();
+      blf_fa.Finalize();
+      blf_pa.Assemble();
+
+      Vector x(fes.GetVSize()), y_fa(x.Size()), y_pa(x.Size());
+      x.Randomize(1);
+      blf_fa.Mult(x, y_fa);
+      blf_pa.Mult(x, y_pa);
+      y_pa -= y_fa;
+      REQUIRE(y_pa.Normlinf() <= 1e-12*y_fa.Normlinf());
+
+      Vector diag_fa(x.Size()), diag_pa(x.Size());
+      blf_fa.SpMat().GetDiag(diag_fa);
+      blf_pa.AssembleDiagonal(diag_pa);
+      diag_pa -= diag_fa;
+      REQUIRE(diag_pa.Normlinf() <= 1e-12*diag_fa.Normlinf());
+   }
+}
+
+// Relative difference between the action and the diagonal of a PA form with
+// the given storage of the quadrature data and with the default storage. The
+// storage actually used is returned in @a used: it must be the given one,
+// which saves memory, or the PAStorage::DOUBLE fallback, which does not.
+double test_pa_storage(Mesh &mesh, int order, PAStorage storage,
+                       std::function<BilinearFormIntegrator*()> new_integ,
+                       PAStorage &used)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   GridFunction x(&fes), y(&fes), y_s(&fes), d(&fes), d_s(&fes);
+   x.Randomize(1);
+
+   BilinearForm blf(&fes), blf_s(&fes);
+   BilinearFormIntegrator *integ_d = new_integ();
+   blf.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf.AddDomainIntegrator(integ_d);
+   blf.Assemble();
+   blf.Mult(x, y);
+   blf.AssembleDiagonal(d);
+
+   BilinearFormIntegrator *integ = new_integ();
+   blf_s.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf_s.SetPAStorage(storage);
+   blf_s.AddDomainIntegrator(integ);
+   blf_s.Assemble();
+   used = integ->GetPAStorageUsed();
+   REQUIRE((used == storage || used == PAStorage::DOUBLE));
+   if (used == PAStorage::DOUBLE)
+   {
+      REQUIRE(integ->GetPAMemoryUsage() == integ_d->GetPAMemoryUsage());
+   }
+   else
+   {
+      REQUIRE(integ->GetPAMemoryUsage() < integ_d->GetPAMemoryUsage());
+   }
+   blf_s.Mult(x, y_s);
+   blf_s.AssembleDiagonal(d_s);
+
+   const double y_norm = y.Normlinf(), d_norm = d.Normlinf();
+   y -= y_s;
+   d -= d_s;
+   return std::max(y.Normlinf()/y_norm, d.Normlinf()/d_norm);
+}
+
+TEST_CASE("PA Storage", "[PartialAssembly]")
+{
+   auto order = GENERATE(1, 3);
+   FunctionCoefficient q([](const Vector &x) { return 1.0 + x(0)*x(0); });
+
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      const char *mesh_file = (dim == 2) ? "../../data/star-q3.mesh" :
+                              "../../data/fichera-q3.mesh";
+      INFO("dim=" << dim << ", order=" << order);
+      Mesh mesh(mesh_file, 1, 1);
+      // Meshes without nodes use linear nodes, as in the default storage
+      Mesh mesh_lin = (dim == 2) ?
+                      Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL) :
+                      Mesh::MakeCartesian3D(3, 3, 3, Element::HEXAHEDRON);
+
+      for (Mesh *m : {&mesh, &mesh_lin})
+      {
+         const PAStorage fly = PAStorage::ON_THE_FLY;
+         PAStorage used;
+         // The data is recomputed in the same way in double precision. The
+         // diffusion data is larger than the nodes and the coefficient values
+         // on linear 3D meshes, but not always on curved or 2D meshes.
+         const bool fly_saves = (dim == 3 && m == &mesh_lin);
+         REQUIRE(test_pa_storage(*m, order, fly, [&]()
+         { return new DiffusionIntegrator(q); }, used) == MFEM_Approx(0.0));
+         if (fly_saves) { REQUIRE(used == fly); }
+         REQUIRE(test_pa_storage(*m, order, fly, [&]()
+         { return new DiffusionIntegrator; }, used) == MFEM_Approx(0.0));
+         if (fly_saves) { REQUIRE(used == fly); }
+         // The nodes and the coefficient values are larger than the mass data
+         REQUIRE(test_pa_storage(*m, order, fly, [&]()
+         { return new MassIntegrator(q); }, used) == 0.0);
+         REQUIRE(used == PAStorage::DOUBLE);
+
+         // The single precision data gives single precision accuracy
+         const PAStorage fl = PAStorage::FLOAT;
+         REQUIRE(test_pa_storage(*m, order, fl, [&]()
+         { return new MassIntegrator(q); }, used) < 1e-6);
+         REQUIRE(used == fl);
+         REQUIRE(test_pa_storage(*m, order, fl, [&]()
+         { return new DiffusionIntegrator(q); }, used) < 1e-6);
+         REQUIRE(used == fl);
+      }
+   }
+
+   SECTION("Unsupported integrators")
+   {
+      Mesh mesh("../../data/star-q3.mesh", 1, 1);
+      H1_FECollection fec(order, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm blf(&fes);
+      blf.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      blf.SetPAStorage(PAStorage::FLOAT);
+      DenseMatrix m(2);
+      m = 0.5;
+      MatrixConstantCoefficient mq(m);
+      BilinearFormIntegrator *integ = new DiffusionIntegrator(mq);
+      blf.AddDomainIntegrator(integ);
+      blf.Assemble();
+      REQUIRE(integ->GetPAStorageUsed() == PAStorage::DOUBLE);
+   }
+}
+
+TEST_CASE("PA Float Operator", "[PartialAssembly]")
+{
+   auto order = GENERATE(1, 3);
+
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      const char *mesh_file = (dim == 2) ? "../../data/star-q3.mesh" :
+                              "../../data/fichera-q3.mesh";
+      INFO("dim=" << dim << ", order=" << order);
+      Mesh mesh(mesh_file, 1, 1);
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      Array<int> ess_tdof_list;
+      fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+      FunctionCoefficient q([](const Vector &x) { return 1.0 + x(0)*x(0); });
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.SetPAStorage(PAStorage::FLOAT);
+      a.AddDomainIntegrator(new DiffusionIntegrator(q));
+      a.AddDomainIntegrator(new MassIntegrator);
+      a.Assemble();
+      OperatorPtr A;
+      a.FormSystemMatrix(ess_tdof_list, A);
+
+      // Same action and diagonal as the double precision operator, which uses
+      // the same single precision data
+      const int n = fes.GetTrueVSize();
+      Vector x(n), y(n), diag(n);
+      x.Randomize(1);
+      A->Mult(x, y);
+      a.AssembleDiagonal(diag);
+      diag.SetSubVector(ess_tdof_list, 1.0);
+
+      FloatPABilinearFormOperator Af(a, ess_tdof_list);
+      FloatVector xf(x), yf(n), diagf;
+      Af.Mult(xf, yf);
+      Af.AssembleDiagonal(diagf);
+      Vector y2, diag2;
+      yf.GetDouble(y2);
+      diagf.GetDouble(diag2);
+      const double y_norm = y.Normlinf(), d_norm = diag.Normlinf();
+      y2 -= y;
+      diag2 -= diag;
+      REQUIRE(y2.Normlinf()/y_norm < 1e-5);
+      REQUIRE(diag2.Normlinf()/d_norm < 1e-7);
+
+      // Single precision Chebyshev smoother as the preconditioner of a double
+      // precision solve
+      OperatorJacobiSmoother invD(diag, ess_tdof_list, 1.0);
+      ProductOperator DA(&invD, A.Ptr(), false, false);
+      PowerMethod power;
+      Vector ev(n);
+      const double max_eig = power.EstimateLargestEigenvalue(DA, ev, 10, 1e-8);
+      FloatOperatorChebyshevSmoother S(&Af, diagf, ess_tdof_list, 2, max_eig);
+      FloatSolverAdaptor P(S);
+
+      Vector b(n), u(n), r(n);
+      b.Randomize(2);
+      b.SetSubVector(ess_tdof_list, 0.0);
+      u = 0.0;
+      CGSolver cg;
+      cg.SetRelTol(1e-12);
+      cg.SetMaxIter(500);
+      cg.SetOperator(*A);
+      cg.SetPreconditioner(P);
+      cg.Mult(b, u);
+      REQUIRE(cg.GetConverged());
+      A->Mult(u, r);
+      r -= b;
+      REQUIRE(r.Norml2() <= 1e-10*b.Norml2());
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+// Gives access to the unconstrained operator of a ConstrainedOperator.
+struct ConstrainedOperatorAccess : public ConstrainedOperator
+{
+   static const Operator *Unconstrained(const Operator &op)
+   {
+      const ConstrainedOperator &c =
+         dynamic_cast<const ConstrainedOperator&>(op);
+      return c.*(&ConstrainedOperatorAccess::A);
+   }
+};
+
+TEST_CASE("PA Overlap", "[Parallel], [PartialAssembly]")
+{
+   auto order = GENERATE(1, 3);
+   auto dim = GENERATE(2, 3);
+   INFO("dim=" << dim << ", order=" << order);
+
+   Mesh smesh = (dim == 2) ?
+                Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL) :
+                Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   ParMesh mesh(MPI_COMM_WORLD, smesh);
+   smesh.Clear();
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list;
+   fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+   FunctionCoefficient q([](const Vector &x) { return 1.0 + x(0)*x(0); });
+   ParBilinearForm blf(&fes);
+   blf.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf.AddDomainIntegrator(new DiffusionIntegrator(q));
+   blf.AddDomainIntegrator(new MassIntegrator);
+   blf.Assemble();
+
+   const int n = fes.GetTrueVSize();
+   Vector x(n), y(n), y_overlap(n), y_fused(n), yt(n), yt_overlap(n);
+   x.Randomize(1);
+
+   // Standard action: the overlap is opt-in
+   REQUIRE(!blf.UsesPAOverlap());
+   OperatorHandle A, A_overlap;
+   blf.FormSystemMatrix(ess_tdof_list, A);
+   const Operator *rap = ConstrainedOperatorAccess::Unconstrained(*A);
+   REQUIRE(dynamic_cast<const PAOverlapOperator*>(rap) == NULL);
+   A->Mult(x, y);
+   rap->MultTranspose(x, yt);
+
+   // Same result, bit for bit, with overlap. On one rank there is no halo
+   // exchange to overlap and the standard action is used.
+   const bool halo = mesh.GetNRanks() > 1;
+   blf.UsePAOverlap();
+   REQUIRE(blf.UsesPAOverlap());
+   blf.FormSystemMatrix(ess_tdof_list, A_overlap);
+   const Operator *rap_overlap =
+      ConstrainedOperatorAccess::Unconstrained(*A_overlap);
+   REQUIRE((dynamic_cast<const PAOverlapOperator*>(rap_overlap) != NULL) ==
+           halo);
+   A_overlap->Mult(x, y_overlap);
+   y_overlap -= y;
+   REQUIRE(y_overlap.Normlinf() == 0.0);
+   rap_overlap->MultTranspose(x, yt_overlap);
+   yt_overlap -= yt;
+   REQUIRE(yt_overlap.Normlinf() == 0.0);
+
+   // Same linear system
+   ParGridFunction u(&fes), u2(&fes), b(&fes);
+   u.Randomize(2);
+   b.Randomize(3);
+   u2 = u;
+   Vector X, B, X2, B2;
+   OperatorHandle A2;
+   blf.FormLinearSystem(ess_tdof_list, u, b, A, X, B);
+   blf.UsePAOverlap(false);
+   blf.FormLinearSystem(ess_tdof_list, u2, b, A2, X2, B2);
+   rap = ConstrainedOperatorAccess::Unconstrained(*A);
+   REQUIRE((dynamic_cast<const PAOverlapOperator*>(rap) != NULL) == halo);
+   rap = ConstrainedOperatorAccess::Unconstrained(*A2);
+   REQUIRE(dynamic_cast<const PAOverlapOperator*>(rap) == NULL);
+   X2 -= X;
+   B2 -= B;
+   REQUIRE(X2.Normlinf() == 0.0);
+   REQUIRE(B2.Normlinf() == 0.0);
+
+   // The fused action does not use the overlap and agrees up to round-off
+   blf.UsePAOverlap();
+   blf.UsePAFused();
+   blf.FormSystemMatrix(ess_tdof_list, A);
+   rap = ConstrainedOperatorAccess::Unconstrained(*A);
+   REQUIRE(dynamic_cast<const PAOverlapOperator*>(rap) == NULL);
+   A->Mult(x, y_fused);
+   y_fused -= y;
+   double error = y_fused.Normlinf()/y.Normlinf();
+   MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   REQUIRE(error == MFEM_Approx(0.0));
+}
+
+#endif // MFEM_USE_MPI
+
 } // namespace pa_kernels
@@ -0,0 +1,390 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace pointeval
+{
+
+// Linear functions are exactly represented also on curved meshes
+static double lin_func(const Vector &x)
+{
+   double r = 1.0;
+   for (int d = 0; d < x.Size(); d++) { r += (d + 2.0)*x(d); }
+   return r;
+}
+
+static void vec_func(const Vector &x, Vector &v)
+{
+   v.SetSize(x.Size());
+   for (int d = 0; d < x.Size(); d++) { v(d) = lin_func(x) + d; }
+}
+
+// Perturbation of the unit square/cube that keeps its boundary fixed
+static void perturb(const Vector &x, Vector &y)
+{
+   y = x;
+   double s = 1.0;
+   for (int d = 0; d < x.Size(); d++) { s *= sin(M_PI*x(d)); }
+   for (int d = 0; d < x.Size(); d++) { y(d) += 0.05*s*(d + 1.0); }
+}
+
+static double rand_real() { return rand()/(RAND_MAX + 1.0); }
+
+static void RandomPoints(int dim, int npts, int ordering, Vector &pos,
+                         DenseMatrix &pts)
+{
+   pos.SetSize(dim*npts);
+   pts.SetSize(dim, npts);
+   for (int i = 0; i < npts; i++)
+   {
+      for (int d = 0; d < dim; d++)
+      {
+         const double x = 0.02 + 0.96*rand_real();
+         pts(d, i) = x;
+         pos(ordering == Ordering::byNODES ? d*npts + i : i*dim + d) = x;
+      }
+   }
+}
+
+TEST_CASE("Native Point Evaluation", "[PointEvaluator]")
+{
+   const int dim = GENERATE(2, 3);
+   const bool simplex = GENERATE(false, true);
+   const bool curved = GENERATE(false, true);
+   const int ne = 4, npts = 50;
+   CAPTURE(dim, simplex, curved);
+   srand(189548);
+
+   const Element::Type type = (dim == 2) ?
+                              (simplex ? Element::TRIANGLE :
+                               Element::QUADRILATERAL) :
+                              (simplex ? Element::TETRAHEDRON :
+                               Element::HEXAHEDRON);
+   Mesh mesh = (dim == 2) ? Mesh::MakeCartesian2D(ne, ne, type) :
+               Mesh::MakeCartesian3D(ne, ne, ne, type);
+   if (dim == 3 && simplex) { mesh.ReorientTetMesh(); }
+   if (curved)
+   {
+      mesh.SetCurvature(2);
+      mesh.Transform(perturb);
+   }
+
+   PointEvaluator eval(mesh);
+
+   Vector pos, vals, x(dim);
+   DenseMatrix pts;
+   RandomPoints(dim, npts, Ordering::byNODES, pos, pts);
+   eval.FindPoints(pos);
+   // The reference positions map back to the given points
+   {
+      const Array<int> &elem = eval.GetElem();
+      const Array<unsigned int> &code = eval.GetCode();
+      const Vector &ref = eval.GetReferencePosition();
+      REQUIRE(ref.Size() == dim*npts);
+      for (int i = 0; i < npts; i++)
+      {
+         REQUIRE(code[i] != PointEvaluator::NotFound);
+         REQUIRE(elem[i] >= 0);
+         ElementTransformation *T = mesh.GetElementTransformation(elem[i]);
+         T->Transform(eval.GetIntegrationPoints()[i], x);
+         Vector p;
+         pts.GetColumnReference(i, p);
+         x -= p;
+         REQUIRE(x.Normlinf() == MFEM_Approx(0.0, 1e-10));
+      }
+   }
+
+   FunctionCoefficient f_coeff(lin_func);
+   VectorFunctionCoefficient v_coeff(dim, vec_func);
+
+   SECTION("Scalar H1 and L2")
+   {
+      H1_FECollection h1_fec(2, dim);
+      L2_FECollection l2_fec(2, dim);
+      FiniteElementCollection *fecs[] = { &h1_fec, &l2_fec };
+      for (FiniteElementCollection *fec : fecs)
+      {
+         FiniteElementSpace fes(&mesh, fec);
+         GridFunction u(&fes);
+         u.ProjectCoefficient(f_coeff);
+         eval.Interpolate(u, vals);
+         REQUIRE(vals.Size() == npts);
+         for (int i = 0; i < npts; i++)
+         {
+            pts.GetColumn(i, x);
+            REQUIRE(vals(i) == MFEM_Approx(lin_func(x), 1e-10));
+         }
+      }
+   }
+
+   SECTION("Vector H1 and Nedelec")
+   {
+      const int ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+      H1_FECollection h1_fec(2, dim);
+      ND_FECollection nd_fec(2, dim);
+      FiniteElementSpace h1_fes(&mesh, &h1_fec, dim, ordering);
+      FiniteElementSpace nd_fes(&mesh, &nd_fec);
+      GridFunction u(&h1_fes), w(&nd_fes);
+      u.ProjectCoefficient(v_coeff);
+      w.ProjectCoefficient(v_coeff);
+
+      Vector v, wvals;
+      eval.Interpolate(u, vals);
+      eval.Interpolate(w, wvals);
+      REQUIRE(vals.Size() == dim*npts);
+      REQUIRE(wvals.Size() == dim*npts);
+      for (int i = 0; i < npts; i++)
+      {
+         pts.GetColumn(i, x);
+         vec_func(x, v);
+         for (int d = 0; d < dim; d++)
+         {
+            const int k = (ordering == Ordering::byNODES) ? d*npts + i :
+                          i*dim + d;
+            REQUIRE(vals(k) == MFEM_Approx(v(d), 1e-10));
+            if (!curved)
+            {
+               REQUIRE(wvals(d*npts + i) == MFEM_Approx(v(d), 1e-10));
+            }
+         }
+      }
+   }
+
+   SECTION("Moving points")
+   {
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      GridFunction u(&fes);
+      u.ProjectCoefficient(f_coeff);
+
+      // Move the points by up to a tenth of the mesh size in each step, using
+      // a different ordering of the coordinates
+      DenseMatrix new_pts(pts);
+      Vector new_pos(dim*npts), vals_find;
+      for (int step = 0; step < 3; step++)
+      {
+         for (int i = 0; i < npts; i++)
+         {
+            for (int d = 0; d < dim; d++)
+            {
+               double &y = new_pts(d, i);
+               y += 0.2*(rand_real() - 0.5)/ne;
+               y = std::min(0.99, std::max(0.01, y));
+               new_pos(i*dim + d) = y;
+            }
+         }
+         eval.MovePoints(new_pos, Ordering::byVDIM);
+         eval.Interpolate(u, vals);
+         for (int i = 0; i < npts; i++)
+         {
+            REQUIRE(eval.GetCode()[i] != PointEvaluator::NotFound);
+            new_pts.GetColumn(i, x);
+            REQUIRE(vals(i) == MFEM_Approx(lin_func(x), 1e-10));
+         }
+
+         PointEvaluator eval_find(mesh);
+         eval_find.FindPoints(new_pos, Ordering::byVDIM);
+         eval_find.Interpolate(u, vals_find);
+         vals_find -= vals;
+         REQUIRE(vals_find.Normlinf() == MFEM_Approx(0.0, 1e-10));
+      }
+   }
+
+   SECTION("Points outside of the mesh")
+   {
+      H1_FECollection fec(1, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      GridFunction u(&fes);
+      u.ProjectCoefficient(f_coeff);
+
+      // The first point is outside of the bounding box, the second one is
+      // outside of the mesh but inside of the element bounding boxes
+      Vector out_pos(2*dim);
+      out_pos = 0.5;
+      out_pos(0) = 2.0;
+      out_pos(1) = 1.01;
+      eval.SetDefaultInterpolationValue(-7.0);
+      eval.Interpolate(out_pos, u, vals);
+      for (int i = 0; i < 2; i++)
+      {
+         REQUIRE(eval.GetCode()[i] == PointEvaluator::NotFound);
+         REQUIRE(eval.GetElem()[i] == -1);
+         REQUIRE(vals(i) == -7.0);
+      }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel Native Point Evaluation", "[PointEvaluator], [Parallel]")
+{
+   const int dim = GENERATE(2, 3);
+   const int ne = 4, npts = 50;
+   CAPTURE(dim);
+
+   int rank, nranks;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+   srand(189548 + rank);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(ne, ne, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(ne, ne, ne, Element::HEXAHEDRON);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   H1_FECollection fec(2, dim);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParGridFunction u(&fes);
+   FunctionCoefficient f_coeff(lin_func);
+   u.ProjectCoefficient(f_coeff);
+
+   // Each rank has its own points, anywhere in the domain
+   Vector pos, vals, x(dim);
+   DenseMatrix pts;
+   RandomPoints(dim, npts, Ordering::byNODES, pos, pts);
+   ParPointEvaluator eval(pmesh);
+   eval.FindPoints(pos);
+   eval.Interpolate(u, vals);
+   for (int i = 0; i < npts; i++)
+   {
+      REQUIRE(eval.GetCode()[i] != PointEvaluator::NotFound);
+      REQUIRE(eval.GetProc()[i] < (unsigned int)nranks);
+      pts.GetColumn(i, x);
+      REQUIRE(vals(i) == MFEM_Approx(lin_func(x), 1e-10));
+   }
+
+   SECTION("Moving points")
+   {
+      // Move the points by up to half of the mesh size, so that some of them
+      // change ranks
+      Vector new_pos(pos);
+      for (int i = 0; i < dim*npts; i++)
+      {
+         double &y = new_pos(i);
+         y += (rand_real() - 0.5)/ne;
+         y = std::min(0.99, std::max(0.01, y));
+      }
+      eval.MovePoints(new_pos);
+      eval.Interpolate(u, vals);
+      for (int i = 0; i < npts; i++)
+      {
+         REQUIRE(eval.GetCode()[i] != PointEvaluator::NotFound);
+         for (int d = 0; d < dim; d++) { x(d) = new_pos(d*npts + i); }
+         REQUIRE(vals(i) == MFEM_Approx(lin_func(x), 1e-10));
+      }
+   }
+
+   SECTION("Partition boundaries and points outside the domain")
+   {
+      // All vertices of the Cartesian mesh, many of which are shared by the
+      // partitions of several ranks, followed by points outside the domain
+      const int nv = (dim == 2) ? (ne+1)*(ne+1) : (ne+1)*(ne+1)*(ne+1);
+      const int nout = 3;
+      Vector vpos(dim*(nv + nout));
+      for (int i = 0; i < nv; i++)
+      {
+         int k = i;
+         for (int d = 0; d < dim; d++)
+         {
+            vpos(i*dim + d) = double(k % (ne+1))/ne;
+            k /= ne+1;
+         }
+      }
+      for (int i = nv; i < nv + nout; i++)
+      {
+         for (int d = 0; d < dim; d++) { vpos(i*dim + d) = 0.5; }
+      }
+      vpos(nv*dim) = 1.5;
+      vpos((nv+1)*dim + dim-1) = -0.25;
+      vpos((nv+2)*dim) = vpos((nv+2)*dim + 1) = 1.0 + 1e-3;
+
+      const double default_value = -1.0e10;
+      eval.SetDefaultInterpolationValue(default_value);
+      eval.FindPoints(vpos, Ordering::byVDIM);
+      eval.Interpolate(u, vals);
+      REQUIRE(vals.Size() == nv + nout);
+      int nonlocal = 0;
+      for (int i = 0; i < nv; i++)
+      {
+         for (int d = 0; d < dim; d++) { x(d) = vpos(i*dim + d); }
+         REQUIRE(eval.GetCode()[i] != PointEvaluator::NotFound);
+         REQUIRE(eval.GetProc()[i] < (unsigned int)nranks);
+         if (eval.GetProc()[i] != (unsigned int)rank) { nonlocal++; }
+         REQUIRE(vals(i) == MFEM_Approx(lin_func(x), 1e-10));
+      }
+      for (int i = nv; i < nv + nout; i++)
+      {
+         REQUIRE(eval.GetCode()[i] == PointEvaluator::NotFound);
+         REQUIRE(eval.GetProc()[i] == (unsigned int)rank);
+         REQUIRE(vals(i) == default_value);
+      }
+
+      // On more than one rank, some of the vertices are owned by other ranks
+      int total_nonlocal;
+      MPI_Allreduce(&nonlocal, &total_nonlocal, 1, MPI_INT, MPI_SUM,
+                    MPI_COMM_WORLD);
+      REQUIRE((nranks == 1 || total_nonlocal > 0));
+   }
+
+   SECTION("Several evaluators")
+   {
+      // Consecutive searches of two evaluators, with messages of unknown
+      // sizes, must not take each other's messages
+      ParPointEvaluator eval2(pmesh);
+      Vector vals2;
+      for (int it = 0; it < 3; it++)
+      {
+         eval.FindPoints(pos);
+         eval2.FindPoints(pos);
+         eval2.Interpolate(u, vals2);
+         eval.Interpolate(u, vals);
+         for (int i = 0; i < npts; i++)
+         {
+            REQUIRE(eval2.GetProc()[i] == eval.GetProc()[i]);
+            REQUIRE(vals2(i) == vals(i));
+         }
+      }
+   }
+
+   SECTION("Independently partitioned meshes")
+   {
+      // Evaluate u at the element centers of a mesh with another partitioning
+      Array<int> partitioning(mesh.GetNE());
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         partitioning[e] = nranks - 1 - (e*nranks)/mesh.GetNE();
+      }
+      ParMesh pmesh2(MPI_COMM_WORLD, mesh, partitioning.GetData());
+      const int ne2 = pmesh2.GetNE();
+      Vector centers(dim*ne2);
+      for (int e = 0; e < ne2; e++)
+      {
+         const Geometry::Type geom = pmesh2.GetElementBaseGeometry(e);
+         pmesh2.GetElementTransformation(e)->Transform(
+            Geometries.GetCenter(geom), x);
+         for (int d = 0; d < dim; d++) { centers(e*dim + d) = x(d); }
+      }
+      eval.FindPoints(centers, Ordering::byVDIM);
+      eval.Interpolate(u, vals);
+      for (int e = 0; e < ne2; e++)
+      {
+         for (int d = 0; d < dim; d++) { x(d) = centers(e*dim + d); }
+         REQUIRE(vals(e) == MFEM_Approx(lin_func(x), 1e-10));
+      }
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace pointeval
@@ -159,4 +159,96 @@ TEST_CASE("Quadrature Function Coefficients",
 
 }
 
+static double proj_func(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + sin(3.0*x(1));
+}
+
+static double proj_td_func(const Vector &x, double t)
+{
+   return t*x(0) - x(1);
+}
+
+TEST_CASE("Coefficient Projection on Quadrature Functions",
+          "[Quadrature Function Coefficients]")
+{
+   const int order = 2;
+   auto el_type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE);
+
+   Mesh mesh = Mesh::MakeCartesian2D(3, 3, el_type, true, 1.0, 1.0);
+   mesh.SetCurvature(order);
+   mesh.SetAttribute(0, 2);
+   mesh.SetAttributes();
+
+   H1_FECollection fec(order, 2);
+   FiniteElementSpace fes(&mesh, &fec), vfes(&mesh, &fec, 2);
+   FunctionCoefficient func(proj_func), td_func(proj_td_func);
+   td_func.SetTime(0.5);
+   GridFunction u(&fes), vu(&vfes);
+   u.ProjectCoefficient(func);
+   vu.Randomize(1);
+
+   const IntegrationRule &ir =
+      IntRules.Get(mesh.GetElementBaseGeometry(0), 2*order + 1);
+   QuadratureSpace qs(&mesh, ir);
+   REQUIRE(qs.GetSize() == mesh.GetNE()*ir.GetNPoints());
+   QuadratureFunction qf(&qs), qf_ref(&qs);
+
+   ConstantCoefficient two(2.0);
+   Vector pw(2);
+   pw(0) = 3.0;
+   pw(1) = -1.0;
+   PWConstCoefficient pw_coeff(pw);
+   GridFunctionCoefficient u_coeff(&u), vu_coeff(&vu, 2);
+   SumCoefficient sum(u_coeff, func, 2.0, -0.5), sum_const(1.0, u_coeff);
+   ProductCoefficient prod(func, td_func), prod_const(4.0, pw_coeff);
+   RatioCoefficient ratio(td_func, func), ratio_const(u_coeff, 2.0);
+   PowerCoefficient power(func, 1.5);
+
+   Coefficient *coeffs[] = { &two, &pw_coeff, &func, &td_func, &u_coeff,
+                             &vu_coeff, &sum, &sum_const, &prod, &prod_const,
+                             &ratio, &ratio_const, &power
+                           };
+   for (Coefficient *coeff : coeffs)
+   {
+      coeff->Project(qf);
+      coeff->Coefficient::Project(qf_ref);
+      qf -= qf_ref;
+      REQUIRE(qf.Normlinf() == MFEM_Approx(0.0, 1e-12));
+   }
+
+   // The nodes of the H1 elements are not a tensor-product rule
+   const IntegrationRule &nodes = fes.GetFE(0)->GetNodes();
+   QuadratureSpace qs_nodes(&mesh, nodes);
+   QuadratureFunction qn(&qs_nodes), qn_ref(&qs_nodes);
+   Coefficient *fe_coeffs[] = { &func, &u_coeff, &vu_coeff };
+   for (Coefficient *coeff : fe_coeffs)
+   {
+      coeff->Project(qn);
+      coeff->Coefficient::Project(qn_ref);
+      qn -= qn_ref;
+      REQUIRE(qn.Normlinf() == MFEM_Approx(0.0, 1e-12));
+   }
+
+   // The coefficient of a QuadratureFunction is copied
+   u_coeff.Project(qf_ref);
+   QuadratureFunctionCoefficient qf_coeff(qf_ref);
+   qf = 0.0;
+   qf_coeff.Project(qf);
+   qf -= qf_ref;
+   REQUIRE(qf.Normlinf() == 0.0);
+
+   // The shared setup of the partial assembly uses the projection
+   Vector pa_coeff;
+   EvalPACoefficient(&two, mesh, ir, pa_coeff);
+   REQUIRE(pa_coeff.Size() == 1);
+   EvalPACoefficient(NULL, mesh, ir, pa_coeff, false);
+   REQUIRE(pa_coeff.Size() == qs.GetSize());
+   REQUIRE(pa_coeff.Min() == 1.0);
+   EvalPACoefficient(&sum, mesh, ir, pa_coeff);
+   sum.Coefficient::Project(qf_ref);
+   pa_coeff -= qf_ref;
+   REQUIRE(pa_coeff.Normlinf() == MFEM_Approx(0.0, 1e-12));
+}
+
 } // namespace qf_coeff
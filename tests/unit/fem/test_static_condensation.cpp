@@ -0,0 +1,102 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace static_condensation
+{
+
+// Statically condense the mass + diffusion operator; return the Schur
+// complement, the reduced r.h.s. and the solution of the full system.
+static void CondensedSolve(FiniteElementSpace &fes, BilinearForm &a,
+                           const Vector &b, bool batched, SparseMatrix *&S,
+                           Vector &B, Vector &x)
+{
+   StaticCondensation sc(&fes);
+   sc.Init(false, false);
+   sc.UseBatched(batched);
+   REQUIRE(sc.UsesBatched() == batched);
+
+   DenseMatrix elmat;
+   for (int e = 0; e < fes.GetNE(); e++)
+   {
+      a.ComputeElementMatrix(e, elmat);
+      sc.AssembleMatrix(e, elmat);
+   }
+   sc.Finalize();
+   S = new SparseMatrix(sc.GetMatrix());
+
+   sc.ReduceRHS(b, B);
+   Vector X(B.Size());
+   X = 0.0;
+   GSSmoother prec(*S);
+   PCG(*S, prec, B, X, 0, 1000, 1e-24, 0.0);
+   sc.ComputeSolution(b, X, x);
+}
+
+TEST_CASE("Batched Static Condensation", "[StaticCondensation]")
+{
+   const int order = 3;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int vdim = 1; vdim <= 2; vdim++)
+      {
+         Mesh mesh = (dim == 2) ?
+                     Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL) :
+                     Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(&mesh, &fec, vdim);
+
+         ConstantCoefficient one(1.0);
+         BilinearForm a(&fes);
+         if (vdim == 1)
+         {
+            a.AddDomainIntegrator(new MassIntegrator(one));
+            a.AddDomainIntegrator(new DiffusionIntegrator(one));
+         }
+         else
+         {
+            a.AddDomainIntegrator(new VectorMassIntegrator(one));
+            a.AddDomainIntegrator(new VectorDiffusionIntegrator(one));
+         }
+         a.Assemble();
+         a.Finalize();
+
+         Vector b(fes.GetVSize());
+         b.Randomize(1);
+
+         SparseMatrix *S0, *S1;
+         Vector B0, B1, x0, x1;
+         CondensedSolve(fes, a, b, false, S0, B0, x0);
+         CondensedSolve(fes, a, b, true, S1, B1, x1);
+
+         S1->Add(-1.0, *S0);
+         REQUIRE(S1->MaxNorm() == MFEM_Approx(0.0, 1e-12*S0->MaxNorm()));
+         B1 -= B0;
+         REQUIRE(B1.Normlinf() == MFEM_Approx(0.0, 1e-12*B0.Normlinf()));
+
+         // The recovered solution solves the full system
+         Vector r(b);
+         a.SpMat().AddMult(x1, r, -1.0);
+         REQUIRE(r.Normlinf() == MFEM_Approx(0.0, 1e-8*b.Normlinf()));
+         x1 -= x0;
+         REQUIRE(x1.Normlinf() == MFEM_Approx(0.0, 1e-8*x0.Normlinf()));
+
+         delete S1;
+         delete S0;
+      }
+   }
+}
+
+} // namespace static_condensation
@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+#include <cstdlib>
+
+using namespace mfem;
+
+// Overloads selecting the two- or four-parent interface of the tables.
+template <typename Table>
+static int GetId(Table &t, const Hashed2 &, const int k[4])
+{ return t.GetId(k[0], k[1]); }
+
+template <typename Table>
+static int GetId(Table &t, const Hashed4 &, const int k[4])
+{ return t.GetId(k[0], k[1], k[2], k[3]); }
+
+template <typename Table>
+static int FindId(const Table &t, const Hashed2 &, const int k[4])
+{ return t.FindId(k[0], k[1]); }
+
+template <typename Table>
+static int FindId(const Table &t, const Hashed4 &, const int k[4])
+{ return t.FindId(k[0], k[1], k[2], k[3]); }
+
+template <typename Table>
+static void Reparent(Table &t, const Hashed2 &, int id, const int k[4])
+{ t.Reparent(id, k[0], k[1]); }
+
+template <typename Table>
+static void Reparent(Table &t, const Hashed4 &, int id, const int k[4])
+{ t.Reparent(id, k[0], k[1], k[2], k[3]); }
+
+static void GetKey(const Hashed2 &item, int k[4])
+{ k[0] = item.p1; k[1] = item.p2; k[2] = k[3] = -1; }
+
+static void GetKey(const Hashed4 &item, int k[4])
+{ k[0] = item.p1; k[1] = item.p2; k[2] = item.p3; k[3] = -1; }
+
+static void GetKey(const OpenHashed2 &item, int k[4])
+{ k[0] = item.p1; k[1] = item.p2; k[2] = k[3] = -1; }
+
+static void GetKey(const OpenHashed4 &item, int k[4])
+{ k[0] = item.p1; k[1] = item.p2; k[2] = item.p3; k[3] = -1; }
+
+// Apply the same random sequence of insertions, deletions and reparentings
+// to a HashTable of T and an OpenHashTable of U and check that both return the
+// same ids.
+template <typename T, typename U>
+static void TestHashTables()
+{
+   HashTable<T> chained(64, 16);
+   OpenHashTable<U> open(64, 16);
+   const T tag = T();
+
+   const int range = 200;
+   srand(12345);
+   for (int i = 0; i < 20000; i++)
+   {
+      int k[4];
+      k[0] = rand() % range;
+      k[1] = range + rand() % range;
+      k[2] = 2*range + rand() % range;
+      k[3] = (rand() % 2) ? -1 : 3*range + rand() % range;
+
+      const int op = rand() % 10;
+      if (op < 5) // insert, or find an existing item
+      {
+         const int id = GetId(chained, tag, k);
+         REQUIRE(GetId(open, tag, k) == id);
+      }
+      else if (op < 8) // delete, if the item exists
+      {
+         const int id = FindId(chained, tag, k);
+         REQUIRE(FindId(open, tag, k) == id);
+         if (id >= 0)
+         {
+            chained.Delete(id);
+            open.Delete(id);
+         }
+      }
+      else // move an existing item to a free key
+      {
+         const int id = rand() % (chained.NumIds() + 1);
+         if (id >= chained.NumIds() || !chained.IdExists(id)) { continue; }
+         REQUIRE(open.IdExists(id));
+         const int found = FindId(chained, tag, k);
+         REQUIRE(FindId(open, tag, k) == found);
+         if (found >= 0) { continue; }
+         Reparent(chained, tag, id, k);
+         Reparent(open, tag, id, k);
+         REQUIRE(FindId(chained, tag, k) == id);
+         REQUIRE(FindId(open, tag, k) == id);
+      }
+      REQUIRE(chained.Size() == open.Size());
+      REQUIRE(chained.NumIds() == open.NumIds());
+   }
+
+   // All items are stored under the same key in both tables.
+   int count = 0;
+   for (typename OpenHashTable<U>::iterator it(open.begin());
+        it != open.end(); ++it)
+   {
+      int k[4], kc[4];
+      GetKey(*it, k);
+      REQUIRE(chained.IdExists(it.index()));
+      GetKey(chained[it.index()], kc);
+      for (int j = 0; j < 4; j++) { REQUIRE(k[j] == kc[j]); }
+      REQUIRE(FindId(open, tag, k) == it.index());
+      count++;
+   }
+   REQUIRE(count == chained.Size());
+
+   // Deleting most items shrinks the open addressing index.
+   const long mem = open.MemoryUsage();
+   for (int id = 0; id < open.NumIds(); id++)
+   {
+      if (open.IdExists(id) && id % 16) { open.Delete(id); }
+   }
+   REQUIRE(open.MemoryUsage() < mem);
+   for (int id = 0; id < open.NumIds(); id++)
+   {
+      if (!open.IdExists(id)) { continue; }
+      int k[4];
+      GetKey(open[id], k);
+      REQUIRE(FindId(open, tag, k) == id);
+   }
+}
+
+TEST_CASE("HashTable and OpenHashTable", "[HashTable]")
+{
+   SECTION("Hashed2")
+   {
+      TestHashTables<Hashed2, OpenHashed2>();
+   }
+   SECTION("Hashed4")
+   {
+      TestHashTables<Hashed4, OpenHashed4>();
+   }
+}
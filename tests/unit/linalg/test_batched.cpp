@@ -0,0 +1,270 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace batched
+{
+
+// Random batch of ne matrices of size m x n; SPD matrices when spd is true
+static void RandomBatch(int m, int n, int ne, DenseTensor &A, bool spd = false)
+{
+   A.SetSize(m, n, ne);
+   for (int e = 0; e < ne; e++)
+   {
+      DenseMatrix R(m, n);
+      Vector col;
+      for (int j = 0; j < n; j++)
+      {
+         R.GetColumnReference(j, col);
+         col.Randomize(e*n + j + 1);
+      }
+      if (spd)
+      {
+         MultAAt(R, A(e));
+         for (int i = 0; i < m; i++) { A(e)(i,i) += m; }
+      }
+      else
+      {
+         A(e) = R;
+      }
+   }
+}
+
+// Maximum difference between the matrices of two batches
+static double MaxDiff(const DenseTensor &A, const DenseTensor &B)
+{
+   double diff = 0.0;
+   for (int e = 0; e < A.SizeK(); e++)
+   {
+      DenseMatrix D(A(e));
+      D -= B(e);
+      diff = std::max(diff, D.MaxMaxNorm());
+   }
+   return diff;
+}
+
+// Deep copy of a batch of matrices
+static void Copy(const DenseTensor &A, DenseTensor &B)
+{
+   B.SetSize(A.SizeI(), A.SizeJ(), A.SizeK());
+   B.GetMemory().CopyFrom(A.GetMemory(), A.TotalSize());
+}
+
+// Run the batched functions in the standard layout, or in the interleaved
+// layout, converting the inputs and the outputs
+struct BatchRunner
+{
+   BatchLayout layout;
+
+   void In(const DenseTensor &A, DenseTensor &Ai) const
+   {
+      if (layout == BatchLayout::STANDARD) { Copy(A, Ai); }
+      else { BatchInterleave(A, Ai); }
+   }
+   void Out(const DenseTensor &Ai, int ne, DenseTensor &A) const
+   {
+      if (layout == BatchLayout::STANDARD) { Copy(Ai, A); }
+      else { BatchDeinterleave(Ai, ne, A); }
+   }
+   void In(const Vector &x, int m, Vector &xi) const
+   {
+      if (layout == BatchLayout::STANDARD) { xi = x; }
+      else { BatchInterleave(x, m, xi); }
+   }
+   void Out(const Vector &xi, int m, int ne, Vector &x) const
+   {
+      if (layout == BatchLayout::STANDARD) { x = xi; }
+      else { BatchDeinterleave(xi, m, ne, x); }
+   }
+};
+
+TEST_CASE("Batched Linear Algebra", "[DenseMatrix]")
+{
+   // Specialized and generic sizes
+   auto m = GENERATE(1, 3, 8, 11, 27);
+   auto layout = GENERATE(BatchLayout::STANDARD, BatchLayout::INTERLEAVED);
+   const int ne = 6, n = 5;
+   INFO("m = " << m << ", interleaved = "
+        << (layout == BatchLayout::INTERLEAVED));
+   const double tol = 1e-12;
+   BatchRunner run{layout};
+
+   DenseTensor A, S, B;
+   RandomBatch(m, m, ne, A);
+   RandomBatch(m, m, ne, S, true);
+   RandomBatch(m, n, ne, B);
+   for (int e = 0; e < ne; e++)
+   {
+      for (int i = 0; i < m; i++) { A(e)(i,i) += m; }
+   }
+   Vector x(m*ne);
+   x.Randomize(7);
+
+   DenseTensor Ai, Si, Bi, Ci, C;
+   Vector xi, yi, y;
+   run.In(A, Ai);
+   run.In(S, Si);
+   run.In(B, Bi);
+   run.In(x, m, xi);
+
+   SECTION("GEMM")
+   {
+      BatchMult(Ai, Bi, Ci, 2.0, 0.0, layout);
+      BatchMult(Ai, Bi, Ci, 3.0, -1.0, layout);
+      run.Out(Ci, ne, C);
+      DenseTensor Cd(m, n, ne);
+      for (int e = 0; e < ne; e++) { Mult(A(e), B(e), Cd(e)); }
+      REQUIRE(MaxDiff(C, Cd) < tol*m);
+
+      BatchMultAtB(Ai, Bi, Ci, 1.0, 0.0, layout);
+      run.Out(Ci, ne, C);
+      for (int e = 0; e < ne; e++) { MultAtB(A(e), B(e), Cd(e)); }
+      REQUIRE(MaxDiff(C, Cd) < tol*m);
+   }
+
+   SECTION("GEMV")
+   {
+      Vector yd(m*ne), yd2(m*ne);
+      for (int e = 0; e < ne; e++)
+      {
+         Vector xe(x.GetData() + e*m, m), ye(yd.GetData() + e*m, m);
+         Vector ye2(yd2.GetData() + e*m, m);
+         A(e).Mult(xe, ye);
+         A(e).MultTranspose(xe, ye2);
+      }
+      BatchMult(Ai, xi, yi, 1.0, 0.0, layout);
+      run.Out(yi, m, ne, y);
+      y -= yd;
+      REQUIRE(y.Normlinf() < tol*m);
+
+      BatchMultTranspose(Ai, xi, yi, 1.0, 0.0, layout);
+      BatchMultTranspose(Ai, xi, yi, -1.0, 3.0, layout);
+      run.Out(yi, m, ne, y);
+      y.Add(-2.0, yd2);
+      REQUIRE(y.Normlinf() < tol*m);
+   }
+
+   SECTION("Cholesky")
+   {
+      DenseTensor Li(Si), L;
+      BatchCholeskyFactor(Li, layout);
+
+      // L L^t = S
+      DenseTensor Lt(m, m, ne);
+      run.Out(Li, ne, L);
+      C.SetSize(m, m, ne);
+      for (int e = 0; e < ne; e++)
+      {
+         if (m > 1) { REQUIRE(L(e)(0,m-1) == 0.0); }
+         Lt(e).Transpose(L(e));
+         Mult(L(e), Lt(e), C(e));
+      }
+      REQUIRE(MaxDiff(C, S) < tol*m*m);
+
+      // Cholesky and triangular solves
+      Vector si;
+      BatchMult(Si, xi, si, 1.0, 0.0, layout);
+      BatchCholeskySolve(Li, si, layout);
+      run.Out(si, m, ne, y);
+      y -= x;
+      REQUIRE(y.Normlinf() < tol*m);
+
+      BatchMult(Li, xi, yi, 1.0, 0.0, layout);
+      BatchTriangularSolve(Li, yi, true, false, layout);
+      run.Out(yi, m, ne, y);
+      y -= x;
+      REQUIRE(y.Normlinf() < tol*m);
+
+      // Upper triangular solves with L^t
+      DenseTensor Lti;
+      run.In(Lt, Lti);
+      BatchMult(Lti, xi, yi, 1.0, 0.0, layout);
+      BatchTriangularSolve(Lti, yi, false, false, layout);
+      run.Out(yi, m, ne, y);
+      y -= x;
+      REQUIRE(y.Normlinf() < tol*m);
+      BatchMultTranspose(Lti, xi, yi, 1.0, 0.0, layout);
+      BatchTriangularSolve(Lti, yi, false, true, layout);
+      run.Out(yi, m, ne, y);
+      y -= x;
+      REQUIRE(y.Normlinf() < tol*m);
+   }
+
+   SECTION("Inverse")
+   {
+      DenseTensor Ainvi, Ainv;
+      BatchInverse(Ai, Ainvi, layout);
+      run.Out(Ainvi, ne, Ainv);
+      DenseTensor Ad(m, m, ne);
+      for (int e = 0; e < ne; e++)
+      {
+         DenseMatrixInverse inv(A(e));
+         inv.GetInverseMatrix(Ad(e));
+      }
+      REQUIRE(MaxDiff(Ainv, Ad) < tol);
+   }
+
+   SECTION("Symmetric Eigensystem")
+   {
+      Vector evi, ev;
+      DenseTensor Vi, V;
+      BatchSymmetricEigensystem(Si, evi, Vi, layout);
+      run.Out(evi, m, ne, ev);
+      run.Out(Vi, ne, V);
+      for (int e = 0; e < ne; e++)
+      {
+         Vector lambda(ev.GetData() + e*m, m);
+         for (int i = 1; i < m; i++) { REQUIRE(lambda(i-1) <= lambda(i)); }
+
+         // S V = V diag(lambda) and V^t V = I
+         DenseMatrix SV(m), VL(V(e)), VtV(m);
+         Mult(S(e), V(e), SV);
+         VL.RightScaling(lambda);
+         SV -= VL;
+         REQUIRE(SV.MaxMaxNorm() < tol*lambda.Normlinf());
+         MultAtB(V(e), V(e), VtV);
+         for (int i = 0; i < m; i++) { VtV(i,i) -= 1.0; }
+         REQUIRE(VtV.MaxMaxNorm() < tol);
+
+         // The sum of the eigenvalues is the trace
+         REQUIRE(lambda.Sum() == MFEM_Approx(S(e).Trace()));
+      }
+   }
+}
+
+TEST_CASE("Batched Interleave", "[DenseMatrix]")
+{
+   const int m = 3, n = 2, ne = 2*BATCH_SIMD_WIDTH + 1;
+   DenseTensor A, Ai, A2;
+   RandomBatch(m, n, ne, A);
+   BatchInterleave(A, Ai);
+   REQUIRE(Ai.SizeK() == 3*BATCH_SIMD_WIDTH);
+   // The padding matrices are the identity
+   REQUIRE(Ai.HostRead()[m*n*Ai.SizeK() - 1] == 0.0);
+   REQUIRE(Ai.HostRead()[Ai.SizeK()*m*n - BATCH_SIMD_WIDTH*m*n +
+                         BATCH_SIMD_WIDTH - 1] == 1.0);
+   BatchDeinterleave(Ai, ne, A2);
+   REQUIRE(MaxDiff(A, A2) == 0.0);
+
+   Vector x(m*ne), xi, x2;
+   x.Randomize(1);
+   BatchInterleave(x, m, xi);
+   REQUIRE(xi.Size() == m*3*BATCH_SIMD_WIDTH);
+   BatchDeinterleave(xi, m, ne, x2);
+   x2 -= x;
+   REQUIRE(x2.Normlinf() == 0.0);
+}
+
+} // namespace batched
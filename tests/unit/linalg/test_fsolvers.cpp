@@ -0,0 +1,348 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace fsolvers
+{
+
+// Relative difference between a double vector and the double version of a
+// single precision one
+static double RelDiff(const Vector &x, const FloatVector &xf)
+{
+   Vector y;
+   xf.GetDouble(y);
+   y -= x;
+   return y.Normlinf() / x.Normlinf();
+}
+
+TEST_CASE("FloatVector", "[FloatVector]")
+{
+   const int n = 100;
+   Vector x(n), y(n);
+   x.Randomize(1);
+   y.Randomize(2);
+
+   FloatVector xf(x), yf(n);
+   yf.SetFromDouble(y);
+   REQUIRE(xf.Size() == n);
+   REQUIRE(RelDiff(x, xf) < 1e-7);
+   REQUIRE((xf*yf) == MFEM_Approx(x*y, 1e-6));
+   REQUIRE(xf.Norml2() == MFEM_Approx(x.Norml2(), 1e-6));
+
+   xf.Add(-0.5, yf);
+   x.Add(-0.5, y);
+   REQUIRE(RelDiff(x, xf) < 1e-6);
+
+   xf *= 3.0;
+   x *= 3.0;
+   REQUIRE(RelDiff(x, xf) < 1e-6);
+
+   FloatVector zf(xf);
+   zf = 2.0f;
+   REQUIRE(zf(n-1) == 2.0f);
+   REQUIRE(RelDiff(x, xf) < 1e-6);
+
+   Array<int> list(2);
+   list[0] = 0;
+   list[1] = 7;
+   zf.SetSubVector(list, -1.0f);
+   REQUIRE(zf(0) == -1.0f);
+   REQUIRE(zf(7) == -1.0f);
+   REQUIRE(zf(1) == 2.0f);
+}
+
+TEST_CASE("Float Smoothers", "[FloatVector]")
+{
+   const int order = 2, cheb_order = 3;
+   Mesh mesh = Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL);
+   H1_FECollection fec(order, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new MassIntegrator);
+   a.Assemble();
+   SparseMatrix A;
+   a.FormSystemMatrix(ess_tdof_list, A);
+   const int n = A.Height();
+
+   FloatSparseMatrix Af(A);
+   REQUIRE(Af.NumNonZeroElems() == A.NumNonZeroElems());
+
+   Vector x(n), y(n), diag;
+   x.Randomize(3);
+   FloatVector xf(x), yf(n), diagf;
+   A.Mult(x, y);
+   Af.Mult(xf, yf);
+   REQUIRE(RelDiff(y, yf) < 1e-5);
+
+   A.GetDiag(diag);
+   Af.GetDiag(diagf);
+   REQUIRE(RelDiff(diag, diagf) < 1e-7);
+
+   SECTION("Jacobi")
+   {
+      OperatorJacobiSmoother S(diag, ess_tdof_list, 0.8);
+      FloatOperatorJacobiSmoother Sf(diagf, ess_tdof_list, 0.8);
+      S.Mult(x, y);
+      Sf.Mult(xf, yf);
+      REQUIRE(RelDiff(y, yf) < 1e-6);
+
+      // Iterative mode: one more Jacobi iteration
+      S.SetOperator(A);
+      Sf.SetOperator(Af);
+      S.iterative_mode = Sf.iterative_mode = true;
+      S.Mult(x, y);
+      Sf.Mult(xf, yf);
+      REQUIRE(RelDiff(y, yf) < 1e-5);
+   }
+
+   SECTION("Chebyshev")
+   {
+      OperatorJacobiSmoother invD(diag, ess_tdof_list, 1.0);
+      ProductOperator DA(&invD, &A, false, false);
+      PowerMethod power;
+      Vector ev(n);
+      const double max_eig = power.EstimateLargestEigenvalue(DA, ev, 20, 1e-8);
+
+      OperatorChebyshevSmoother S(&A, diag, ess_tdof_list, cheb_order,
+                                  max_eig);
+      FloatOperatorChebyshevSmoother Sf(&Af, diagf, ess_tdof_list,
+                                        cheb_order, max_eig);
+      S.Mult(x, y);
+      Sf.Mult(xf, yf);
+      REQUIRE(RelDiff(y, yf) < 1e-5);
+
+      // The single precision smoother preconditions a double precision solve
+      // to full accuracy
+      FloatSolverAdaptor P(Sf);
+      Vector b(n), u(n), r(n);
+      b.Randomize(4);
+      for (int i = 0; i < ess_tdof_list.Size(); i++)
+      {
+         b(ess_tdof_list[i]) = 0.0;
+      }
+      u = 0.0;
+      CGSolver cg;
+      cg.SetRelTol(1e-12);
+      cg.SetMaxIter(200);
+      cg.SetOperator(A);
+      cg.SetPreconditioner(P);
+      cg.Mult(b, u);
+      REQUIRE(cg.GetConverged());
+      A.Mult(u, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 1e-10*b.Norml2());
+
+      // Same number of iterations as with the double precision smoother, up to
+      // the round-off
+      CGSolver cg2;
+      cg2.SetRelTol(1e-12);
+      cg2.SetMaxIter(200);
+      cg2.SetOperator(A);
+      cg2.SetPreconditioner(S);
+      u = 0.0;
+      cg2.Mult(b, u);
+      REQUIRE(std::abs(cg.GetNumIterations() - cg2.GetNumIterations()) <= 2);
+   }
+}
+
+// Dense matrix Q diag(s) Q with Q a Householder reflection and s log-spaced
+// from 1 to 1/cond
+static void IllConditionedMatrix(int n, double cond, DenseMatrix &A)
+{
+   Vector v(n), s(n);
+   v.Randomize(5);
+   v /= v.Norml2();
+   for (int i = 0; i < n; i++) { s(i) = pow(cond, -i/(n - 1.0)); }
+   DenseMatrix Q(n);
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = 0; j < n; j++) { Q(i,j) = (i == j) - 2.0*v(i)*v(j); }
+   }
+   DenseMatrix QS(Q);
+   QS.RightScaling(s);
+   A.SetSize(n);
+   MultABt(QS, Q, A);
+}
+
+TEST_CASE("Float LU", "[FloatVector]")
+{
+   const int m = 7, ne = 5;
+   DenseTensor M(m, m, ne);
+   for (int e = 0; e < ne; e++)
+   {
+      Vector col;
+      for (int j = 0; j < m; j++)
+      {
+         M(e).GetColumnReference(j, col);
+         col.Randomize(e*m + j + 1);
+         col(j) += 1.0;
+      }
+   }
+
+   Vector x(m*ne), b(m*ne), y(m*ne);
+   x.Randomize(1);
+   for (int e = 0; e < ne; e++)
+   {
+      Vector xe(x.GetData() + e*m, m), be(b.GetData() + e*m, m);
+      M(e).Mult(xe, be);
+   }
+
+   // Same solution as the double precision factorization, up to the round-off
+   // of the factors
+   Array<float> lu;
+   Array<int> ipiv;
+   BatchLUFactor(M, lu, ipiv);
+   REQUIRE(lu.Size() == m*m*ne);
+   y = b;
+   BatchLUSolve(lu, ipiv, y);
+   y -= x;
+   REQUIRE(y.Normlinf() < 1e-4*x.Normlinf());
+
+   FloatBatchLUSolver S(M);
+   S.Mult(b, y);
+   y -= x;
+   REQUIRE(y.Normlinf() < 1e-4*x.Normlinf());
+
+   // The dense solver factors the same matrices
+   FloatLUSolver lu0(M(0));
+   Vector x0(x.GetData(), m), b0(b.GetData(), m), y0(m);
+   lu0.Mult(b0, y0);
+   y0 -= x0;
+   REQUIRE(y0.Normlinf() < 1e-4*x0.Normlinf());
+   REQUIRE(lu0.MemoryUsage() == m*m*sizeof(float) + m*sizeof(int));
+}
+
+TEST_CASE("Mixed Precision LU", "[FloatVector]")
+{
+   auto method = GENERATE(IterativeRefinementSolver::IR,
+                          IterativeRefinementSolver::GMRES_IR);
+
+   SECTION("SparseMatrix with dense factors")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+      H1_FECollection fec(3, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+      SparseMatrix A;
+      a.FormSystemMatrix(ess_tdof_list, A);
+      const int n = A.Height();
+
+      Vector b(n), x(n), r(n);
+      b.Randomize(2);
+      x.Randomize(3); // ignored: iterative_mode is false
+
+      // The factors are those of an explicit dense copy, which is not needed
+      // afterwards, and the residuals use the SparseMatrix
+      MixedPrecisionLUSolver S(method);
+      {
+         DenseMatrix D;
+         A.ToDenseMatrix(D);
+         S.SetFactorOperator(D);
+      }
+      S.SetOperator(A);
+      S.Mult(b, x);
+      REQUIRE(S.GetConverged());
+      REQUIRE(S.GetNumIterations() <= 4);
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() <= 1e-12*b.Norml2());
+      REQUIRE(S.GetFinalNorm() == MFEM_Approx(r.Norml2(), 1e-3));
+      REQUIRE(S.GetLUSolver().MemoryUsage() < (long) (n*n*sizeof(double)));
+   }
+
+   SECTION("Ill-conditioned")
+   {
+      // The correction of the plain refinement is too inaccurate, while GMRES
+      // preconditioned with the single precision factors converges
+      const int n = 40;
+      DenseMatrix A;
+      IllConditionedMatrix(n, 1e8, A);
+      Vector b(n), x(n), r(n);
+      b.Randomize(4);
+
+      MixedPrecisionLUSolver S(A, method);
+      S.SetRelTol(1e-10);
+      S.Mult(b, x);
+      A.Mult(x, r);
+      r -= b;
+      if (method == IterativeRefinementSolver::IR)
+      {
+         REQUIRE(!S.GetConverged());
+      }
+      else
+      {
+         REQUIRE(S.GetConverged());
+         REQUIRE(S.GetNumInnerIterations() > 0);
+         REQUIRE(r.Norml2() <= 1e-10*b.Norml2());
+      }
+   }
+}
+
+// Counts the factorizations of a FloatLUSolver
+class CountingLUSolver : public FloatLUSolver
+{
+public:
+   int count = 0;
+
+   virtual void SetOperator(const Operator &op)
+   {
+      count++;
+      FloatLUSolver::SetOperator(op);
+   }
+};
+
+TEST_CASE("Iterative Refinement Setup", "[FloatVector]")
+{
+   auto method = GENERATE(IterativeRefinementSolver::IR,
+                          IterativeRefinementSolver::GMRES_IR);
+
+   // The low precision solver is set up once for each new operator, e.g. in
+   // each Newton step, also when GMRES uses it as its preconditioner
+   const int n = 10;
+   DenseMatrix A1, A2;
+   IllConditionedMatrix(n, 10.0, A1);
+   IllConditionedMatrix(n, 100.0, A2);
+   Vector b(n), x(n), r(n);
+   b.Randomize(5);
+
+   CountingLUSolver lu;
+   IterativeRefinementSolver S(method);
+   S.SetRelTol(1e-12);
+   S.SetMaxIter(20);
+   S.SetPreconditioner(lu);
+   S.SetOperator(A1);
+   REQUIRE(lu.count == 1);
+   S.SetOperator(A2);
+   REQUIRE(lu.count == 2);
+
+   S.Mult(b, x);
+   REQUIRE(S.GetConverged());
+   A2.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Norml2() <= 1e-12*b.Norml2());
+   REQUIRE(lu.count == 2);
+}
+
+} // namespace fsolvers
@@ -355,6 +355,44 @@ TEST_CASE("First order ODE methods",
       REQUIRE(conv_rate + tol > 5.0);
    }
 
+   // Embedded pairs with fixed steps: all steps are accepted and the step size
+   // is not changed
+   auto fixed_steps = [](AdaptiveODESolver *ode_solver)
+   {
+      ode_solver->SetTolerances(0.0, infinity());
+      ode_solver->SetStepFactorLimits(1.0, 1.0);
+      return ode_solver;
+   };
+
+   SECTION("BogackiShampine32Solver")
+   {
+      std::cout <<"\nTesting BogackiShampine32Solver" << std::endl;
+      double conv_rate =
+         check.order(fixed_steps(new BogackiShampine32Solver));
+      REQUIRE(conv_rate + tol > 3.0);
+   }
+
+   SECTION("DormandPrince54Solver")
+   {
+      std::cout <<"\nTesting DormandPrince54Solver" << std::endl;
+      double conv_rate = check.order(fixed_steps(new DormandPrince54Solver));
+      REQUIRE(conv_rate + tol > 5.0);
+   }
+
+   SECTION("SDIRK21EmbeddedSolver")
+   {
+      std::cout <<"\nTesting SDIRK21EmbeddedSolver" << std::endl;
+      double conv_rate = check.order(fixed_steps(new SDIRK21EmbeddedSolver));
+      REQUIRE(conv_rate + tol > 2.0);
+   }
+
+   SECTION("SDIRK43EmbeddedSolver")
+   {
+      std::cout <<"\nTesting SDIRK43EmbeddedSolver" << std::endl;
+      double conv_rate = check.order(fixed_steps(new SDIRK43EmbeddedSolver));
+      REQUIRE(conv_rate + tol > 4.0);
+   }
+
    // Adams-Moulton
    SECTION("AM0Solver()")
    {
@@ -412,3 +450,198 @@ TEST_CASE("First order ODE methods",
       REQUIRE(conv_rate + tol > 5.0);
    }
 }
+
+TEST_CASE("Adaptive ODE methods",
+          "[ODE1]")
+{
+   // du/dt = -A u with A = [[0, -1], [1, 0]] (rotation) or
+   // A = diag(lambda, 1) (stiff for large lambda)
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      DenseMatrix A, T;
+      Vector r;
+   public:
+      ODE(const DenseMatrix &A_) : TimeDependentOperator(2, 0.0), A(A_),
+         T(2), r(2) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         A.Mult(u, dudt);
+         dudt.Neg();
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &dudt)
+      {
+         A.Mult(u, r);
+         r.Neg();
+         T = A;
+         T *= dt;
+         T(0,0) += 1.0;
+         T(1,1) += 1.0;
+         T.Invert();
+         T.Mult(r, dudt);
+      }
+   };
+
+   DenseMatrix A(2);
+   A = 0.0;
+   A(0,1) = -1.0;
+   A(1,0) = 1.0;
+   ODE rotation(A);
+   const double t_final = 2.0*M_PI;
+
+   // Integrate the rotation with tolerance tol and return the error at t_final
+   auto run = [&](AdaptiveODESolver &ode_solver, double tol, int &steps)
+   {
+      Vector u(2);
+      u = 1.0;
+      double t = 0.0, dt = 0.1;
+      ode_solver.SetTolerances(tol, tol);
+      ode_solver.Init(rotation);
+      ode_solver.Run(u, t, dt, t_final);
+      REQUIRE(t == t_final);
+      steps = ode_solver.GetNumSteps();
+      u -= 1.0;
+      return u.Normlinf();
+   };
+
+   SECTION("Tolerance")
+   {
+      BogackiShampine32Solver bs32;
+      DormandPrince54Solver dp54;
+      SDIRK21EmbeddedSolver sdirk21;
+      SDIRK43EmbeddedSolver sdirk43;
+      AdaptiveODESolver *solvers[4] = { &bs32, &dp54, &sdirk21, &sdirk43 };
+      int steps[4][2];
+      for (int i = 0; i < 4; i++)
+      {
+         INFO("solver " << i);
+         const double err_coarse = run(*solvers[i], 1e-4, steps[i][0]);
+         const double err_fine = run(*solvers[i], 1e-7, steps[i][1]);
+         REQUIRE(err_coarse < 1e-2);
+         REQUIRE(err_fine < 1e-5);
+         REQUIRE(err_fine < err_coarse);
+         REQUIRE(steps[i][1] > steps[i][0]);
+         REQUIRE(solvers[i]->GetNumRejectedSteps() < steps[i][1]/4 + 2);
+      }
+      // Higher order pairs take fewer steps
+      REQUIRE(steps[1][1] < steps[0][1]);
+      REQUIRE(steps[3][1] < steps[2][1]);
+   }
+
+   SECTION("Stiff")
+   {
+      DenseMatrix B(2);
+      B = 0.0;
+      B(0,0) = 1e4;
+      B(1,1) = 1.0;
+      ODE stiff(B);
+
+      SDIRK43EmbeddedSolver sdirk43;
+      sdirk43.SetTolerances(1e-6, 1e-8);
+      sdirk43.Init(stiff);
+      Vector u(2);
+      u = 1.0;
+      double t = 0.0, dt = 1e-6;
+      sdirk43.Run(u, t, dt, 1.0);
+      // The step size is limited by accuracy, not by stability: an explicit
+      // method would need more than 5000 steps
+      REQUIRE(sdirk43.GetNumSteps() < 500);
+      REQUIRE(std::abs(u(0)) < 1e-6);
+      REQUIRE(std::abs(u(1) - exp(-1.0)) < 1e-5);
+   }
+}
+
+TEST_CASE("IMEX ODE methods",
+          "[ODE1]")
+{
+   // du/dt = f_E(u) + f_I(u) with the non-stiff rotation f_E(u) = R u and the
+   // stiff f_I(u) = -D u, D = diag(d0, d1); R and D do not commute.
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      double d[2];
+   public:
+      ODE(double d0, double d1) : TimeDependentOperator(2, 0.0, IMPLICIT)
+      { d[0] = d0; d[1] = d1; }
+
+      virtual void ExplicitMult(const Vector &u, Vector &v) const
+      {
+         v(0) = u(1);
+         v(1) = -u(0);
+      }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         ExplicitMult(u, dudt);
+         dudt(0) -= d[0]*u(0);
+         dudt(1) -= d[1]*u(1);
+      }
+
+      // Solve k = -D (u + dt k) for the implicit part only
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &k)
+      {
+         for (int i = 0; i < 2; i++) { k(i) = -d[i]*u(i)/(1.0 + dt*d[i]); }
+      }
+   };
+
+   const double t_final = 1.0;
+   ODE ode(1.0, 2.0);
+   Vector u0(2);
+   u0(0) = 1.0;
+   u0(1) = 0.5;
+
+   // Reference solution
+   Vector u_ref(u0);
+   {
+      RK8Solver rk8;
+      rk8.Init(ode);
+      double t = 0.0, dt = t_final/200;
+      for (int i = 0; i < 200; i++) { rk8.Step(u_ref, t, dt); }
+   }
+
+   auto error = [&](ODESolver &solver, int steps)
+   {
+      Vector u(u0);
+      solver.Init(ode);
+      double t = 0.0;
+      for (int i = 0; i < steps; i++)
+      {
+         double dt = t_final/steps;
+         solver.Step(u, t, dt);
+      }
+      REQUIRE(t == MFEM_Approx(t_final));
+      u -= u_ref;
+      return u.Normlinf();
+   };
+   auto order = [&](ODESolver &solver)
+   {
+      return log(error(solver, 20)/error(solver, 40))/log(2.0);
+   };
+
+   ARS222Solver ars222;
+   ARS443Solver ars443;
+   ARK3Solver ark3;
+   ARK4Solver ark4;
+   REQUIRE(order(ars222) > 1.9);
+   REQUIRE(order(ars443) > 2.9);
+   REQUIRE(order(ark3) > 2.9);
+   REQUIRE(order(ark4) > 3.9);
+
+   RK4Solver rk4_e;
+   SDIRK33Solver sdirk33_i;
+   SplittingSolver lie(rk4_e, sdirk33_i, SplittingSolver::LIE);
+   SplittingSolver strang(rk4_e, sdirk33_i, SplittingSolver::STRANG);
+   REQUIRE(order(lie) > 0.9);
+   REQUIRE(order(strang) > 1.9);
+
+   // Stability with a very stiff implicit part and a step size much larger
+   // than the explicit stability limit of f_I
+   ODE stiff(1e6, 1e8);
+   Vector u(u0);
+   ark4.Init(stiff);
+   double t = 0.0, dt = 0.1;
+   for (int i = 0; i < 10; i++) { ark4.Step(u, t, dt); }
+   REQUIRE(u.Normlinf() < 1e-3);
+}
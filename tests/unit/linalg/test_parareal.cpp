@@ -0,0 +1,244 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace parareal
+{
+
+// du/dt = -A u for the 1D Laplacian A with homogeneous Dirichlet conditions
+class HeatODE : public TimeDependentOperator
+{
+private:
+   DenseMatrix A, T;
+   Vector r;
+
+public:
+   HeatODE(int n) : TimeDependentOperator(n, 0.0), A(n), T(n), r(n)
+   {
+      const double h = 1.0/(n + 1);
+      A = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+         A(i,i) = 2.0/(h*h);
+         if (i > 0) { A(i,i-1) = -1.0/(h*h); }
+         if (i < n-1) { A(i,i+1) = -1.0/(h*h); }
+      }
+   }
+
+   void Mult(const Vector &u, Vector &dudt) const override
+   {
+      A.Mult(u, dudt);
+      dudt.Neg();
+   }
+
+   void ImplicitSolve(const double dt, const Vector &u, Vector &dudt) override
+   {
+      A.Mult(u, r);
+      r.Neg();
+      T = A;
+      T *= dt;
+      for (int i = 0; i < T.Height(); i++) { T(i,i) += 1.0; }
+      T.Invert();
+      T.Mult(r, dudt);
+   }
+};
+
+class CountingMonitor : public IterativeSolverMonitor
+{
+public:
+   int calls = 0;
+   double last_norm = -1.0;
+
+   void MonitorResidual(int it, double norm, const Vector &r,
+                        bool final) override
+   {
+      calls++;
+      last_norm = norm;
+   }
+};
+
+TEST_CASE("Parareal", "[Parareal]")
+{
+   const int n = 15, num_slices = 16, fine_steps = 20;
+   const double tf = 0.1;
+   HeatODE ode(n);
+   Vector x0(n);
+   for (int i = 0; i < n; i++) { x0(i) = sin(M_PI*(i+1)/(n+1)) + 0.1*(i%3); }
+
+   // Sequential fine solution
+   SDIRK33Solver fine;
+   BackwardEulerSolver coarse;
+   Vector x_fine(x0);
+   {
+      fine.Init(ode);
+      const double dt = tf/(num_slices*fine_steps);
+      double t = 0.0;
+      for (int i = 0; i < num_slices*fine_steps; i++)
+      {
+         double h = dt;
+         fine.Step(x_fine, t, h);
+      }
+   }
+
+   SECTION("Exact after N iterations")
+   {
+      PararealSolver parareal(fine, coarse);
+      parareal.SetNumSlices(4);
+      parareal.SetFineSteps(fine_steps*num_slices/4);
+      parareal.SetRelTol(0.0);
+      parareal.SetMaxIter(10);
+      parareal.SetPrintLevel(-1);
+      Vector x(x0);
+      parareal.Solve(ode, x, 0.0, tf);
+      REQUIRE(parareal.GetNumIterations() == 4);
+      REQUIRE(parareal.GetConverged());
+      x -= x_fine;
+      REQUIRE(x.Normlinf() == MFEM_Approx(0.0, 1e-12));
+   }
+
+   SECTION("Convergence")
+   {
+      CountingMonitor monitor;
+      PararealSolver parareal(fine, coarse);
+      parareal.SetNumSlices(num_slices);
+      parareal.SetFineSteps(fine_steps);
+      parareal.SetRelTol(1e-5);
+      parareal.SetMaxIter(num_slices);
+      parareal.SetMonitor(monitor);
+      Vector x(x0);
+      parareal.Solve(ode, x, 0.0, tf);
+      REQUIRE(parareal.GetConverged());
+      REQUIRE(parareal.GetNumIterations() < num_slices/2);
+      REQUIRE(monitor.calls == parareal.GetNumIterations());
+      REQUIRE(monitor.last_norm == parareal.GetFinalNorm());
+      x -= x_fine;
+      REQUIRE(x.Normlinf() < 1e-4*x0.Normlinf());
+
+      // MGRIT with FCF-relaxation needs fewer iterations
+      MGRITSolver mgrit(fine, coarse);
+      mgrit.SetNumSlices(num_slices);
+      mgrit.SetFineSteps(fine_steps);
+      mgrit.SetRelTol(1e-5);
+      mgrit.SetMaxIter(num_slices);
+      x = x0;
+      mgrit.Solve(ode, x, 0.0, tf);
+      REQUIRE(mgrit.GetConverged());
+      REQUIRE(mgrit.GetNumIterations() < parareal.GetNumIterations());
+      x -= x_fine;
+      REQUIRE(x.Normlinf() < 1e-4*x0.Normlinf());
+
+      // With F-relaxation only, MGRIT is Parareal
+      mgrit.SetFCFRelaxation(false);
+      x = x0;
+      mgrit.Solve(ode, x, 0.0, tf);
+      REQUIRE(mgrit.GetNumIterations() == parareal.GetNumIterations());
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel Parareal", "[Parareal], [Parallel]")
+{
+   int world_size;
+   MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+
+   const int n = 15, num_slices = 16, fine_steps = 20;
+   const double tf = 0.1;
+   HeatODE ode(n);
+   Vector x0(n);
+   for (int i = 0; i < n; i++) { x0(i) = sin(M_PI*(i+1)/(n+1)) + 0.1*(i%3); }
+
+   SDIRK33Solver fine;
+   BackwardEulerSolver coarse;
+
+   // All ranks in time, and two ranks in space if possible. The ODE is not
+   // distributed: each space rank holds a copy of the vectors.
+   Array<int> time_procs;
+   time_procs.Append(world_size);
+   if (world_size % 2 == 0 && world_size > 2)
+   {
+      time_procs.Append(world_size/2);
+   }
+
+   for (int k = 0; k < time_procs.Size(); k++)
+   {
+      SpaceTimeCommunicator st(MPI_COMM_WORLD, time_procs[k]);
+
+      for (int fcf = 0; fcf <= 2; fcf++)
+      {
+         PararealSolver parareal_s(fine, coarse);
+         PararealSolver parareal_p(st, fine, coarse);
+         MGRITSolver mgrit_s(fine, coarse);
+         MGRITSolver mgrit_p(st, fine, coarse);
+         // fcf == 0: Parareal, 1: MGRIT with FCF-relaxation, 2: without
+         mgrit_s.SetFCFRelaxation(fcf == 1);
+         mgrit_p.SetFCFRelaxation(fcf == 1);
+         PararealSolver &serial = (fcf == 0) ? parareal_s : mgrit_s;
+         PararealSolver &par = (fcf == 0) ? parareal_p : mgrit_p;
+
+         for (PararealSolver *s : {&serial, &par})
+         {
+            s->SetNumSlices(num_slices);
+            s->SetFineSteps(fine_steps);
+            s->SetRelTol(1e-5);
+            s->SetMaxIter(num_slices);
+            s->SetPrintLevel(-1);
+         }
+
+         // The slices are distributed over the time ranks, but the iterates
+         // are the same as in the sequential algorithm
+         Vector x_s(x0), x_p(x0);
+         serial.Solve(ode, x_s, 0.0, tf);
+         par.Solve(ode, x_p, 0.0, tf);
+         REQUIRE(par.GetConverged());
+         REQUIRE(par.GetNumIterations() == serial.GetNumIterations());
+         x_p -= x_s;
+         REQUIRE(x_p.Normlinf() == MFEM_Approx(0.0, 1e-12));
+
+         int first, last;
+         par.GetLocalSlices(first, last);
+         int local = last - first, total;
+         MPI_Allreduce(&local, &total, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+         REQUIRE(local >= 1);
+         REQUIRE(total == num_slices*(world_size/time_procs[k]));
+      }
+
+      // Exact after as many iterations as slices
+      const int steps = fine_steps*num_slices/time_procs[k];
+      PararealSolver parareal(st, fine, coarse);
+      parareal.SetNumSlices(time_procs[k]);
+      parareal.SetFineSteps(steps);
+      parareal.SetRelTol(0.0);
+      parareal.SetMaxIter(time_procs[k] + 2);
+      parareal.SetPrintLevel(-1);
+      Vector x(x0), x_fine(x0);
+      parareal.Solve(ode, x, 0.0, tf);
+      REQUIRE(parareal.GetNumIterations() == time_procs[k]);
+      fine.Init(ode);
+      const double dt = tf/(time_procs[k]*steps);
+      double t = 0.0;
+      for (int i = 0; i < time_procs[k]*steps; i++)
+      {
+         double h = dt;
+         fine.Step(x_fine, t, h);
+      }
+      x -= x_fine;
+      REQUIRE(x.Normlinf() == MFEM_Approx(0.0, 1e-12));
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace parareal
@@ -180,3 +180,109 @@ TEST_CASE("MakeSimplicial", "[Mesh]")
    // on the original mesh, but it doesn't happen for these test cases.
    REQUIRE(simplex_mesh.GetNE() == orig_mesh.GetNE()*factor);
 }
+
+static void ShiftAndScale(const Vector &x, Vector &y)
+{
+   y.SetSize(x.Size());
+   for (int d = 0; d < x.Size(); d++) { y(d) = 0.5 + (d + 2.0)*x(d); }
+}
+
+TEST_CASE("Shared GeometricFactors", "[Mesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+   mesh.SetCurvature(2);
+
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 4);
+   const int det = GeometricFactors::DETERMINANTS;
+   const int jac = GeometricFactors::JACOBIANS;
+
+   // One object per rule, extended with the factors that are requested later
+   const GeometricFactors *geom = mesh.GetGeometricFactors(ir, det);
+   REQUIRE(mesh.GetGeometricFactors(ir, jac) == geom);
+   REQUIRE((geom->computed_factors & (det | jac)) == (det | jac));
+   REQUIRE(geom->J.Size() > 0);
+   REQUIRE(geom->detJ.Size() > 0);
+   const long mem = mesh.GeometricFactorsMemoryUsage();
+   REQUIRE(mem > 0);
+
+   // Copies of the rule share the same object
+   IntegrationRule ir_copy(ir);
+   REQUIRE(mesh.GetGeometricFactors(ir_copy, det | jac) == geom);
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() == mem);
+   // ... but different rules do not
+   const IntegrationRule &ir2 = IntRules.Get(Geometry::SQUARE, 2);
+   REQUIRE(mesh.GetGeometricFactors(ir2, det) != geom);
+
+   const IntegrationRule &fir = IntRules.Get(Geometry::SEGMENT, 4);
+   const int fdet = FaceGeometricFactors::DETERMINANTS;
+   const int fnor = FaceGeometricFactors::NORMALS;
+   const FaceGeometricFactors *fgeom =
+      mesh.GetFaceGeometricFactors(fir, fdet, FaceType::Interior);
+   REQUIRE(mesh.GetFaceGeometricFactors(fir, fnor, FaceType::Interior) ==
+           fgeom);
+   REQUIRE(mesh.GetFaceGeometricFactors(fir, fdet, FaceType::Boundary) !=
+           fgeom);
+
+   // The factors are updated in place after the nodes are modified
+   mesh.Transform(ShiftAndScale);
+   REQUIRE(mesh.GetGeometricFactors(ir, det) == geom);
+   GeometricFactors fresh(&mesh, ir, det | jac);
+   Vector diff(geom->detJ);
+   diff -= fresh.detJ;
+   REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+   diff = geom->J;
+   diff -= fresh.J;
+   REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+   // The jacobian determinants are 2*3 times larger
+   REQUIRE(geom->detJ.Min() == MFEM_Approx(6.0/9.0));
+
+   REQUIRE(mesh.GetFaceGeometricFactors(fir, fdet, FaceType::Interior) ==
+           fgeom);
+   FaceGeometricFactors ffresh(&mesh, fir, fdet | fnor, FaceType::Interior);
+   diff = fgeom->detJ;
+   diff -= ffresh.detJ;
+   REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+   diff = fgeom->normal;
+   diff -= ffresh.normal;
+   REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+
+   // External modifications of the nodes require NodesUpdated()
+   *mesh.GetNodes() *= 2.0;
+   mesh.NodesUpdated();
+   REQUIRE(mesh.GetGeometricFactors(ir, det)->detJ.Min() ==
+           MFEM_Approx(4*6.0/9.0));
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() ==
+           mem + mesh.GetGeometricFactors(ir2, det)->MemoryUsage() +
+           fgeom->MemoryUsage() +
+           mesh.GetFaceGeometricFactors(fir, fdet,
+                                        FaceType::Boundary)->MemoryUsage());
+}
+
+TEST_CASE("Released GeometricFactors", "[Mesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 4);
+   const IntegrationRule &ir2 = IntRules.Get(Geometry::SQUARE, 2);
+   const int det = GeometricFactors::DETERMINANTS;
+
+   const GeometricFactors *geom = mesh.GetGeometricFactors(ir, det);
+   const long mem = mesh.GeometricFactorsMemoryUsage();
+   const GeometricFactors *geom2 = mesh.GetGeometricFactors(ir2, det);
+   REQUIRE(mesh.GetGeometricFactors(ir, det) == geom);
+
+   // The factors are deleted when their last user releases them
+   mesh.ReleaseGeometricFactors(geom2);
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() == mem);
+   mesh.ReleaseGeometricFactors(geom);
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() == mem);
+   mesh.ReleaseGeometricFactors(geom);
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() == 0);
+
+   const IntegrationRule &fir = IntRules.Get(Geometry::SEGMENT, 4);
+   const int fdet = FaceGeometricFactors::DETERMINANTS;
+   const FaceGeometricFactors *fgeom =
+      mesh.GetFaceGeometricFactors(fir, fdet, FaceType::Interior);
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() == fgeom->MemoryUsage());
+   mesh.ReleaseGeometricFactors(fgeom);
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() == 0);
+}
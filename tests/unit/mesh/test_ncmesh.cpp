@@ -115,6 +115,77 @@ TEST_CASE("NCMesh PA diagonal", "[NCMesh]")
 
 } // test case
 
+// Check that 'list' contains each of the 'num' edges/faces exactly once and
+// that the slaves of each master point back to it. (Unrefined boundary faces
+// are not listed.)
+static void CheckNCList(const Mesh &mesh, const NCMesh::NCList &list, int num,
+                        bool faces)
+{
+   Array<int> count(num);
+   count = 0;
+   for (int i = 0; i < list.conforming.Size(); i++)
+   {
+      count[list.conforming[i].index]++;
+   }
+   for (int i = 0; i < list.masters.Size(); i++)
+   {
+      const NCMesh::Master &master = list.masters[i];
+      count[master.index]++;
+      REQUIRE(master.slaves_begin < master.slaves_end);
+      for (int j = master.slaves_begin; j < master.slaves_end; j++)
+      {
+         REQUIRE(list.slaves[j].master == master.index);
+      }
+   }
+   for (int i = 0; i < list.slaves.Size(); i++)
+   {
+      // negative indices are edge-face constraints
+      if (list.slaves[i].index >= 0) { count[list.slaves[i].index]++; }
+   }
+   for (int i = 0; i < num; i++)
+   {
+      REQUIRE(count[i] <= 1);
+      if (!faces || mesh.FaceIsInterior(i)) { REQUIRE(count[i] == 1); }
+   }
+}
+
+// Test case: Verify the face and edge lists of a 3D NCMesh with many hanging
+//            faces, whose slaves are found by traversals in parallel chunks:
+//            the lists must cover all faces and edges, and a continuous
+//            quadratic must satisfy the hanging node constraints.
+TEST_CASE("NCMesh face and edge lists", "[NCMesh]")
+{
+   auto type = GENERATE(Element::HEXAHEDRON, Element::TETRAHEDRON);
+
+   Mesh mesh = Mesh::MakeCartesian3D(6, 6, 6, type);
+   mesh.EnsureNCMesh(true);
+   for (int l = 0; l < 2; l++)
+   {
+      Array<int> refs;
+      for (int e = 0; e < mesh.GetNE(); e += 3) { refs.Append(e); }
+      mesh.GeneralRefinement(refs);
+   }
+
+   CheckNCList(mesh, mesh.ncmesh->GetFaceList(), mesh.GetNumFaces(), true);
+   CheckNCList(mesh, mesh.ncmesh->GetEdgeList(), mesh.GetNEdges(), false);
+   REQUIRE(mesh.ncmesh->GetFaceList().masters.Size() > 256);
+
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient quad([](const Vector &x)
+   {
+      return x(0)*x(0) - 2.0*x(1)*x(2) + x(2);
+   });
+   GridFunction x(&fes), y(&fes);
+   x.ProjectCoefficient(quad);
+
+   Vector x_true(fes.GetTrueVSize());
+   fes.GetConformingRestriction()->Mult(x, x_true);
+   fes.GetConformingProlongation()->Mult(x_true, y);
+   y -= x;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0, EPS));
+}
+
 #ifdef MFEM_USE_MPI
 
 // Test case: Verify that a conforming mesh yields the same norm for the
@@ -189,6 +189,101 @@ TEST_CASE("ParMeshMakeSimplicial", "[Parallel], [ParMesh]")
    REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
 }
 
+TEST_CASE("ParMeshWeightedRebalance", "[Parallel], [ParMesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   mesh.EnsureNCMesh();
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+
+   // Refine near a corner, so the default partition is unbalanced
+   Vector center;
+   for (int l = 0; l < 2; l++)
+   {
+      Array<int> refs;
+      for (int e = 0; e < pmesh.GetNE(); e++)
+      {
+         pmesh.GetElementCenter(e, center);
+         if (center(0) < 0.3 && center(1) < 0.3) { refs.Append(e); }
+      }
+      pmesh.GeneralRefinement(refs);
+   }
+
+   // Elements in the right half are more expensive
+   auto element_cost = [&](Vector &cost)
+   {
+      cost.SetSize(pmesh.GetNE());
+      for (int e = 0; e < pmesh.GetNE(); e++)
+      {
+         pmesh.GetElementCenter(e, center);
+         cost(e) = (center(0) > 0.5) ? 4.0 : 1.0;
+      }
+   };
+
+   H1_FECollection fec(1, 2);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParGridFunction x(&fes);
+   FunctionCoefficient f([](const Vector &p) { return p(0) + 2.0*p(1); });
+   x.ProjectCoefficient(f);
+
+   Vector cost;
+   element_cost(cost);
+   const double total_cost = cost.Sum();
+   double global_cost;
+   MPI_Allreduce(&total_cost, &global_cost, 1, MPI_DOUBLE, MPI_SUM,
+                 MPI_COMM_WORLD);
+
+   pmesh.Rebalance(cost);
+   fes.Update();
+   x.Update();
+
+   // The solution is transferred exactly and the cost is balanced up to the
+   // cost of one element
+   REQUIRE(x.ComputeL2Error(f) == MFEM_Approx(0.0));
+   element_cost(cost);
+   const double avg_cost = global_cost / pmesh.GetNRanks();
+   REQUIRE(cost.Sum() <= avg_cost + 4.0);
+   const double imbalance = pmesh.GetLoadImbalance(&cost);
+   REQUIRE(imbalance <= 1.0 + 4.0 / avg_cost);
+
+   // No migration below the threshold
+   const long sequence = pmesh.GetSequence();
+   REQUIRE(!pmesh.RebalanceIfImbalanced(imbalance + 0.1, &cost));
+   REQUIRE(pmesh.GetSequence() == sequence);
+}
+
+TEST_CASE("ParMeshWeightedRebalanceExpensiveElement", "[Parallel], [ParMesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+   mesh.EnsureNCMesh();
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+
+   // One element costs more than all the others together
+   Vector center, cost(pmesh.GetNE());
+   for (int e = 0; e < pmesh.GetNE(); e++)
+   {
+      pmesh.GetElementCenter(e, center);
+      cost(e) = (center(0) < 0.25 && center(1) < 0.25) ? 1000.0 : 1.0;
+   }
+
+   H1_FECollection fec(1, 2);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParGridFunction x(&fes);
+   FunctionCoefficient f([](const Vector &p) { return p(0) + 2.0*p(1); });
+   x.ProjectCoefficient(f);
+
+   pmesh.Rebalance(cost);
+   fes.Update();
+   x.Update();
+
+   // No rank is left without elements
+   int min_ne, total_ne, ne = pmesh.GetNE();
+   MPI_Allreduce(&ne, &min_ne, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+   MPI_Allreduce(&ne, &total_ne, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+   REQUIRE(min_ne >= 1);
+   REQUIRE(total_ne == 16);
+   REQUIRE(x.ComputeL2Error(f) == MFEM_Approx(0.0));
+}
+
 #endif // MFEM_USE_MPI
 
 } // namespace mfem